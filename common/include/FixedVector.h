@@ -0,0 +1,126 @@
+/**
+ * @headerfile FixedVector.h
+ * This file defines the FixedVector class which is an array with a capacity fixed at compile time, stored
+ * inside the object.
+ *
+ * @author Olivier
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+    /**
+     * @brief FixedVector is an array that stores up to Capacity elements in place, without allocation. Copying
+     * it copies the elements in place, so an object holding it can be copied without touching the heap.
+     * @note The interface follows the subset of std::vector used by the physics world, so one can be
+     * replaced by the other. The allocator given at construction is ignored.
+     * @tparam T The type of the elements, it must be default constructible.
+     * @tparam Capacity The maximum number of elements.
+     */
+    template<typename T, std::size_t Capacity>
+    class FixedVector
+    {
+        static_assert(Capacity > 0, "The capacity of a fixed vector must not be zero.");
+
+    private:
+        std::array<T, Capacity> _elements{};
+        std::size_t _size = 0;
+
+    public:
+        constexpr FixedVector() noexcept = default;
+
+        template<typename AllocatorType>
+        constexpr explicit FixedVector([[maybe_unused]] const AllocatorType& allocator) noexcept {}
+
+        [[nodiscard]] constexpr T& operator[](const std::size_t index) noexcept { return _elements[index]; }
+
+        [[nodiscard]] constexpr const T& operator[](const std::size_t index) const noexcept
+        {
+            return _elements[index];
+        }
+
+        [[nodiscard]] constexpr T* data() noexcept { return _elements.data(); }
+        [[nodiscard]] constexpr const T* data() const noexcept { return _elements.data(); }
+
+        [[nodiscard]] constexpr T* begin() noexcept { return _elements.data(); }
+        [[nodiscard]] constexpr const T* begin() const noexcept { return _elements.data(); }
+        [[nodiscard]] constexpr T* end() noexcept { return _elements.data() + _size; }
+        [[nodiscard]] constexpr const T* end() const noexcept { return _elements.data() + _size; }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return _size; }
+
+        [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+
+        [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+        /**
+         * @brief reserve is a method that checks that the array can store the number of elements given in
+         * parameter, there is nothing to allocate.
+         */
+        void reserve(const std::size_t newCapacity) const
+        {
+            if (newCapacity > Capacity)
+            {
+                throw std::length_error("Fixed vector capacity exceeded");
+            }
+        }
+
+        /**
+         * @brief resize is a method that changes the number of elements of the array, the new elements are
+         * copies of the value given in parameter. The removed elements are reset to a default element, so that
+         * the content of the array beyond its size never depends on its history.
+         */
+        void resize(const std::size_t newSize, const T& value = T())
+        {
+            reserve(newSize);
+
+            for (std::size_t i = _size; i < newSize; i++)
+            {
+                _elements[i] = value;
+            }
+
+            for (std::size_t i = newSize; i < _size; i++)
+            {
+                _elements[i] = T();
+            }
+
+            _size = newSize;
+        }
+
+        /**
+         * @brief assign is a method that replaces the content of the array by the number of copies of the value
+         * given in parameter.
+         */
+        void assign(const std::size_t newSize, const T& value)
+        {
+            clear();
+            resize(newSize, value);
+        }
+
+        void push_back(const T& value)
+        {
+            reserve(_size + 1);
+            _elements[_size++] = value;
+        }
+
+        /**
+         * @brief clear is a method that resets all the elements to a default element.
+         */
+        constexpr void clear() noexcept
+        {
+            for (std::size_t i = 0; i < _size; i++)
+            {
+                _elements[i] = T();
+            }
+
+            _size = 0;
+        }
+
+        /**
+         * @brief shrink_to_fit does nothing, the storage of the array is part of the object.
+         */
+        constexpr void shrink_to_fit() noexcept {}
+    };
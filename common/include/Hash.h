@@ -0,0 +1,67 @@
+/**
+ * @headerfile Hash.h
+ * This file defines the XxHash64 class which calculates the 64-bit xxHash of a stream of bytes.
+ *
+ * @author Olivier
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief XxHash64 is a class that calculates the xxHash64 of bytes given in several parts, the result is the
+ * same as if they were given at once. The bytes are mixed by stripes of 32 bytes in four independent lanes,
+ * which the processor runs in parallel.
+ * @note The bytes are read as little endian words, the hashes are the ones of the reference implementation
+ * on a little endian machine.
+ */
+class XxHash64
+{
+private:
+    static constexpr std::size_t _stripeSize = 32;
+
+    std::array<std::uint64_t, 4> _lanes{};
+    std::array<unsigned char, _stripeSize> _buffer{};
+    std::size_t _bufferSize = 0;
+    std::uint64_t _totalSize = 0;
+    std::uint64_t _seed = 0;
+
+    void consumeStripe(const unsigned char* stripe) noexcept;
+
+public:
+    explicit XxHash64(std::uint64_t seed = 0) noexcept;
+
+    /**
+     * @brief Reset is a method that forgets the bytes given to the hash and starts again with the seed given
+     * in parameter.
+     */
+    void Reset(std::uint64_t seed = 0) noexcept;
+
+    /**
+     * @brief Update is a method that adds the bytes given in parameter at the end of the hashed stream.
+     */
+    void Update(const void* data, std::size_t size) noexcept;
+
+    /**
+     * @brief UpdateValue is a method that adds the bytes of the value given in parameter at the end of the
+     * hashed stream.
+     * @note The type must not have padding bytes, their content is not defined and would change the hash.
+     */
+    template<typename T>
+    void UpdateValue(const T& value) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only the trivially copyable values can be hashed.");
+
+        Update(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Digest is a method that calculates the hash of the bytes given until now. More bytes can be given
+     * after it.
+     */
+    [[nodiscard]] std::uint64_t Digest() const noexcept;
+};
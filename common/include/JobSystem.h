@@ -0,0 +1,158 @@
+/**
+ * @headerfile JobSystem.h
+ * This file defines the JobSystem class which splits loops between a pool of worker threads.
+ *
+ * @author Olivier
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+    /**
+     * @brief JobSystem is a class that runs the iterations of a loop on a pool of worker threads and on the
+     * calling thread. The loop is cut in chunks and each thread gets a contiguous range of chunks: it takes
+     * its chunks from the front of its range, and when its range is empty it steals chunks from the back of
+     * the range of another thread.
+     * @note The chunks can run in any order and on any thread, so a chunk must only write the results of its
+     * own iterations (for example at their index in an array). Reading the results in index order after
+     * ParallelFor gives the same result whatever the number of threads.
+     * @note The workers are not part of the state of the owner: a copy starts its own workers and a
+     * copy-assignment keeps the workers of the destination.
+     */
+    class JobSystem
+    {
+    public:
+        /**
+         * @brief JobFunction is the type of the function that runs the iterations [begin, end) of a loop.
+         */
+        using JobFunction = void (*)(void* context, std::size_t begin, std::size_t end);
+
+    private:
+        /**
+         * @brief ChunkRange is a struct that stores the range of chunks [Begin, End) owned by a thread. Both
+         * bounds are packed in a single atomic so the owner and the thieves can take chunks without a lock.
+         */
+        struct alignas(64) ChunkRange
+        {
+            std::atomic<std::uint64_t> Bounds{0};
+        };
+
+        std::vector<std::thread> _workers;
+        std::unique_ptr<ChunkRange[]> _chunkRanges;
+
+        std::mutex _mutex;
+        std::condition_variable _workAvailable;
+        std::uint64_t _batch = 0;
+        bool _isStopping = false;
+
+        // The loop being run.
+        JobFunction _function = nullptr;
+        void* _context = nullptr;
+        std::size_t _iterationCount = 0;
+        std::size_t _chunkSize = 0;
+
+        std::atomic<std::size_t> _remainingChunks{0};
+        std::atomic<std::size_t> _busyWorkers{0};
+
+        static constexpr std::uint64_t packBounds(const std::uint32_t begin, const std::uint32_t end) noexcept
+        {
+            return static_cast<std::uint64_t>(begin) << 32 | end;
+        }
+
+        /**
+         * @brief workerLoop is the method run by each worker thread: it waits for a loop and runs chunks
+         * until no chunk is left.
+         * @param threadIdx The index of the thread (0 is the thread calling ParallelFor).
+         * @param lastBatch The index of the last loop started before the worker.
+         */
+        void workerLoop(std::size_t threadIdx, std::uint64_t lastBatch) noexcept;
+
+        /**
+         * @brief runChunks is a method that runs the chunks of the thread, then the chunks stolen from the
+         * other threads, until all chunks are taken.
+         * @param threadIdx The index of the thread running the chunks.
+         */
+        void runChunks(std::size_t threadIdx) noexcept;
+
+        /**
+         * @brief popFront is a method that takes the first chunk of the range of the thread.
+         * @return True if a chunk was taken.
+         */
+        [[nodiscard]] bool popFront(std::size_t threadIdx, std::uint32_t& chunk) noexcept;
+
+        /**
+         * @brief stealBack is a method that takes the last chunk of the range of another thread.
+         * @return True if a chunk was stolen.
+         */
+        [[nodiscard]] bool stealBack(std::size_t threadIdx, std::uint32_t& chunk) noexcept;
+
+        /**
+         * @brief run is a method that cuts the loop in chunks, shares them between the threads and waits
+         * until all the chunks are done.
+         */
+        void run(JobFunction function, void* context, std::size_t iterationCount, std::size_t chunkSize) noexcept;
+
+    public:
+        JobSystem() noexcept = default;
+
+        JobSystem(const JobSystem& other) noexcept : JobSystem() { Start(other.ThreadCount()); }
+        JobSystem& operator=(const JobSystem&) noexcept { return *this; }
+
+        ~JobSystem() noexcept { Stop(); }
+
+        /**
+         * @brief Start is a method that starts the worker threads. The previous workers are stopped.
+         * @param threadCount The number of threads running the loops, including the calling thread. A value of 1
+         * (or less) starts no worker and the loops run on the calling thread.
+         */
+        void Start(int threadCount) noexcept;
+
+        /**
+         * @brief Stop is a method that stops and joins the worker threads.
+         */
+        void Stop() noexcept;
+
+        /**
+         * @brief ParallelFor is a method that calls the function on all the chunks of the range [0, count) and
+         * returns when all the chunks are done. The calling thread runs chunks too.
+         * @note ParallelFor must not be called from a chunk.
+         * @param count The number of iterations of the loop.
+         * @param chunkSize The number of iterations of a chunk, the last chunk can be smaller.
+         * @param function The function called with the range [begin, end) of each chunk.
+         */
+        template<typename Func>
+        void ParallelFor(const std::size_t count, const std::size_t chunkSize, Func&& function) noexcept
+        {
+            if (count == 0) return;
+
+            if (_workers.empty() || count <= chunkSize)
+            {
+                function(std::size_t{0}, count);
+                return;
+            }
+
+            using FunctionType = std::remove_reference_t<Func>;
+
+            run([](void* context, const std::size_t begin, const std::size_t end)
+                {
+                    (*static_cast<FunctionType*>(context))(begin, end);
+                },
+                const_cast<void*>(static_cast<const void*>(&function)), count, chunkSize);
+        }
+
+        /**
+         * @brief ThreadCount is a method that gives the number of threads running the loops, including the
+         * calling thread.
+         * @return The number of threads running the loops.
+         */
+        [[nodiscard]] int ThreadCount() const noexcept { return static_cast<int>(_workers.size()) + 1; }
+    };
@@ -0,0 +1,144 @@
+/**
+ * @headerfile PagedVector.h
+ * This file defines the PagedVector class which is an array whose elements are never moved in memory.
+ *
+ * @author Olivier
+ */
+
+#pragma once
+
+#include "Allocator.h"
+
+#include <cstddef>
+#include <new>
+
+    /**
+     * @brief PagedVector is an array that stores its elements in fixed size pages allocated with the allocator
+     * given at construction. Growing the array only allocates new pages, so the references to its elements
+     * stay valid until the array is cleared or destroyed.
+     * @note The interface follows the subset of std::vector used by the physics world, so one can be
+     * replaced by the other.
+     * @tparam T The type of the elements.
+     * @tparam PageSize The number of elements of a page, it must be a power of two.
+     */
+    template<typename T, std::size_t PageSize = 256>
+    class PagedVector
+    {
+        static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "The page size must be a power of two.");
+
+    private:
+        StandardAllocator<T> _allocator;
+        AllocVector<T*> _pages;
+        std::size_t _size = 0;
+
+        static constexpr std::size_t pageIndex(const std::size_t index) noexcept { return index / PageSize; }
+        static constexpr std::size_t indexInPage(const std::size_t index) noexcept { return index & (PageSize - 1); }
+
+    public:
+        explicit PagedVector(const StandardAllocator<T>& allocator) noexcept :
+            _allocator(allocator),
+            _pages{ StandardAllocator<T*>{allocator} } {}
+
+        /**
+         * @brief The copy uses the allocator of the source array, like std::vector.
+         */
+        PagedVector(const PagedVector& other) noexcept : PagedVector(other._allocator)
+        {
+            *this = other;
+        }
+
+        /**
+         * @brief The copy-assignment keeps the allocator and the pages of the destination array.
+         */
+        PagedVector& operator=(const PagedVector& other) noexcept
+        {
+            if (this == &other) return *this;
+
+            clear();
+            reserve(other._size);
+
+            for (std::size_t i = 0; i < other._size; i++)
+            {
+                new (&(*this)[i]) T(other[i]);
+            }
+
+            _size = other._size;
+
+            return *this;
+        }
+
+        ~PagedVector() noexcept
+        {
+            clear();
+
+            for (auto* page : _pages)
+            {
+                _allocator.deallocate(page, PageSize);
+            }
+        }
+
+        [[nodiscard]] T& operator[](const std::size_t index) noexcept
+        {
+            return _pages[pageIndex(index)][indexInPage(index)];
+        }
+
+        [[nodiscard]] const T& operator[](const std::size_t index) const noexcept
+        {
+            return _pages[pageIndex(index)][indexInPage(index)];
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return _size; }
+
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+        /**
+         * @brief capacity is a method that gives the number of elements the allocated pages can store.
+         */
+        [[nodiscard]] std::size_t capacity() const noexcept { return _pages.size() * PageSize; }
+
+        /**
+         * @brief reserve is a method that allocates the pages needed to store the number of elements given
+         * in parameter. The existing elements are not moved.
+         */
+        void reserve(const std::size_t newCapacity) noexcept
+        {
+            while (capacity() < newCapacity)
+            {
+                _pages.push_back(_allocator.allocate(PageSize));
+            }
+        }
+
+        /**
+         * @brief resize is a method that changes the number of elements of the array, the new elements are
+         * copies of the value given in parameter. The existing elements are not moved.
+         */
+        void resize(const std::size_t newSize, const T& value = T()) noexcept
+        {
+            reserve(newSize);
+
+            for (std::size_t i = _size; i < newSize; i++)
+            {
+                new (&(*this)[i]) T(value);
+            }
+
+            for (std::size_t i = newSize; i < _size; i++)
+            {
+                (*this)[i].~T();
+            }
+
+            _size = newSize;
+        }
+
+        /**
+         * @brief clear is a method that destroys all the elements but keeps the allocated pages.
+         */
+        void clear() noexcept
+        {
+            for (std::size_t i = 0; i < _size; i++)
+            {
+                (*this)[i].~T();
+            }
+
+            _size = 0;
+        }
+    };
@@ -0,0 +1,150 @@
+#include "Hash.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr std::uint64_t Prime1 = 11400714785074694791ULL;
+    constexpr std::uint64_t Prime2 = 14029467366897019727ULL;
+    constexpr std::uint64_t Prime3 = 1609587929392839161ULL;
+    constexpr std::uint64_t Prime4 = 9650029242287828579ULL;
+    constexpr std::uint64_t Prime5 = 2870177450012600261ULL;
+
+    [[nodiscard]] constexpr std::uint64_t rotateLeft(const std::uint64_t value, const int bits) noexcept
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    [[nodiscard]] std::uint64_t read64(const unsigned char* bytes) noexcept
+    {
+        std::uint64_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    [[nodiscard]] std::uint32_t read32(const unsigned char* bytes) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t round(std::uint64_t lane, const std::uint64_t input) noexcept
+    {
+        lane += input * Prime2;
+        lane = rotateLeft(lane, 31);
+        return lane * Prime1;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t mergeRound(std::uint64_t hash, const std::uint64_t lane) noexcept
+    {
+        hash ^= round(0, lane);
+        return hash * Prime1 + Prime4;
+    }
+}
+
+XxHash64::XxHash64(const std::uint64_t seed) noexcept
+{
+    Reset(seed);
+}
+
+void XxHash64::Reset(const std::uint64_t seed) noexcept
+{
+    _seed = seed;
+    _lanes = { seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1 };
+    _bufferSize = 0;
+    _totalSize = 0;
+}
+
+void XxHash64::consumeStripe(const unsigned char* stripe) noexcept
+{
+    _lanes[0] = round(_lanes[0], read64(stripe));
+    _lanes[1] = round(_lanes[1], read64(stripe + 8));
+    _lanes[2] = round(_lanes[2], read64(stripe + 16));
+    _lanes[3] = round(_lanes[3], read64(stripe + 24));
+}
+
+void XxHash64::Update(const void* data, std::size_t size) noexcept
+{
+    auto bytes = static_cast<const unsigned char*>(data);
+    _totalSize += size;
+
+    // Complete the stripe started by the previous updates.
+    if (_bufferSize > 0)
+    {
+        const auto count = std::min(size, _stripeSize - _bufferSize);
+        std::memcpy(_buffer.data() + _bufferSize, bytes, count);
+        _bufferSize += count;
+        bytes += count;
+        size -= count;
+
+        if (_bufferSize < _stripeSize) return;
+
+        consumeStripe(_buffer.data());
+        _bufferSize = 0;
+    }
+
+    while (size >= _stripeSize)
+    {
+        consumeStripe(bytes);
+        bytes += _stripeSize;
+        size -= _stripeSize;
+    }
+
+    std::memcpy(_buffer.data(), bytes, size);
+    _bufferSize = size;
+}
+
+std::uint64_t XxHash64::Digest() const noexcept
+{
+    std::uint64_t hash;
+
+    if (_totalSize >= _stripeSize)
+    {
+        hash = rotateLeft(_lanes[0], 1) + rotateLeft(_lanes[1], 7) +
+               rotateLeft(_lanes[2], 12) + rotateLeft(_lanes[3], 18);
+
+        for (const auto lane : _lanes)
+        {
+            hash = mergeRound(hash, lane);
+        }
+    }
+    else
+    {
+        hash = _seed + Prime5;
+    }
+
+    hash += _totalSize;
+
+    // Mix the bytes which do not fill a stripe.
+    const unsigned char* bytes = _buffer.data();
+    const unsigned char* end = bytes + _bufferSize;
+
+    for (; bytes + 8 <= end; bytes += 8)
+    {
+        hash ^= round(0, read64(bytes));
+        hash = rotateLeft(hash, 27) * Prime1 + Prime4;
+    }
+
+    if (bytes + 4 <= end)
+    {
+        hash ^= static_cast<std::uint64_t>(read32(bytes)) * Prime1;
+        hash = rotateLeft(hash, 23) * Prime2 + Prime3;
+        bytes += 4;
+    }
+
+    for (; bytes < end; bytes++)
+    {
+        hash ^= *bytes * Prime5;
+        hash = rotateLeft(hash, 11) * Prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
@@ -0,0 +1,173 @@
+#include "JobSystem.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+#include <algorithm>
+
+void JobSystem::Start(int threadCount) noexcept
+{
+    Stop();
+
+    if (threadCount < 1) threadCount = 1;
+
+    _chunkRanges = std::make_unique<ChunkRange[]>(threadCount);
+    _workers.reserve(threadCount - 1);
+
+    for (std::size_t threadIdx = 1; threadIdx < static_cast<std::size_t>(threadCount); threadIdx++)
+    {
+        // The worker must not miss a loop started before it reaches its wait, so it gets the last loop index now.
+        _workers.emplace_back([this, threadIdx, lastBatch = _batch]()
+        {
+            workerLoop(threadIdx, lastBatch);
+        });
+    }
+}
+
+void JobSystem::Stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+
+    _workAvailable.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+
+    _workers.clear();
+    _chunkRanges.reset();
+    _isStopping = false;
+}
+
+void JobSystem::workerLoop(const std::size_t threadIdx, std::uint64_t lastBatch) noexcept
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workAvailable.wait(lock, [this, lastBatch]() { return _isStopping || _batch != lastBatch; });
+
+            if (_isStopping) return;
+
+            lastBatch = _batch;
+        }
+
+        runChunks(threadIdx);
+
+        // The results of the chunks are published with the release.
+        _busyWorkers.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool JobSystem::popFront(const std::size_t threadIdx, std::uint32_t& chunk) noexcept
+{
+    auto& bounds = _chunkRanges[threadIdx].Bounds;
+    auto packed = bounds.load(std::memory_order_acquire);
+
+    while (true)
+    {
+        const auto begin = static_cast<std::uint32_t>(packed >> 32);
+        const auto end = static_cast<std::uint32_t>(packed);
+
+        if (begin >= end) return false;
+
+        if (bounds.compare_exchange_weak(packed, packBounds(begin + 1, end),
+                                         std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            chunk = begin;
+            return true;
+        }
+    }
+}
+
+bool JobSystem::stealBack(const std::size_t threadIdx, std::uint32_t& chunk) noexcept
+{
+    const auto threadCount = _workers.size() + 1;
+
+    for (std::size_t offset = 1; offset < threadCount; offset++)
+    {
+        auto& bounds = _chunkRanges[(threadIdx + offset) % threadCount].Bounds;
+        auto packed = bounds.load(std::memory_order_acquire);
+
+        while (true)
+        {
+            const auto begin = static_cast<std::uint32_t>(packed >> 32);
+            const auto end = static_cast<std::uint32_t>(packed);
+
+            if (begin >= end) break;
+
+            if (bounds.compare_exchange_weak(packed, packBounds(begin, end - 1),
+                                             std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                chunk = end - 1;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::runChunks(const std::size_t threadIdx) noexcept
+{
+    std::uint32_t chunk = 0;
+
+    while (popFront(threadIdx, chunk) || stealBack(threadIdx, chunk))
+    {
+        const auto begin = static_cast<std::size_t>(chunk) * _chunkSize;
+        const auto end = std::min(begin + _chunkSize, _iterationCount);
+
+        _function(_context, begin, end);
+
+        _remainingChunks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void JobSystem::run(const JobFunction function, void* context, const std::size_t iterationCount,
+                    const std::size_t chunkSize) noexcept
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif // TRACY_ENABLE
+
+    const auto threadCount = _workers.size() + 1;
+    const auto chunkCount = (iterationCount + chunkSize - 1) / chunkSize;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _function = function;
+        _context = context;
+        _iterationCount = iterationCount;
+        _chunkSize = chunkSize;
+
+        // Each thread starts with a contiguous range of chunks, so it touches contiguous memory until it steals.
+        for (std::size_t threadIdx = 0; threadIdx < threadCount; threadIdx++)
+        {
+            const auto begin = static_cast<std::uint32_t>(chunkCount * threadIdx / threadCount);
+            const auto end = static_cast<std::uint32_t>(chunkCount * (threadIdx + 1) / threadCount);
+
+            _chunkRanges[threadIdx].Bounds.store(packBounds(begin, end), std::memory_order_relaxed);
+        }
+
+        _remainingChunks.store(chunkCount, std::memory_order_relaxed);
+        _busyWorkers.store(_workers.size(), std::memory_order_relaxed);
+        _batch++;
+    }
+
+    _workAvailable.notify_all();
+
+    runChunks(0);
+
+    // Wait for the workers to leave the loop too, so that the next loop can reuse the ranges.
+    while (_remainingChunks.load(std::memory_order_acquire) != 0 ||
+           _busyWorkers.load(std::memory_order_acquire) != 0)
+    {
+        std::this_thread::yield();
+    }
+}
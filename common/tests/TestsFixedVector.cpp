@@ -0,0 +1,69 @@
+#include "Allocator.h"
+#include "FixedVector.h"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+static HeapAllocator TestHeapAllocator;
+
+TEST(FixedVector, ResizeKeepsValues)
+{
+    FixedVector<int, 16> vector{ StandardAllocator<int>{TestHeapAllocator} };
+    vector.resize(3, 7);
+
+    EXPECT_EQ(vector.size(), 3);
+    EXPECT_EQ(vector.capacity(), 16);
+
+    vector[1] = 2;
+    vector.resize(10, 5);
+
+    EXPECT_EQ(vector.size(), 10);
+    EXPECT_EQ(vector[0], 7);
+    EXPECT_EQ(vector[1], 2);
+    EXPECT_EQ(vector[2], 7);
+    EXPECT_EQ(vector[9], 5);
+}
+
+TEST(FixedVector, ShrinkingResetsTheRemovedElements)
+{
+    FixedVector<int, 4> vector;
+    vector.resize(4, 9);
+    vector.resize(1);
+
+    // The storage beyond the size is reset, so two arrays with the same elements have the same bytes.
+    EXPECT_EQ(vector.data()[3], 0);
+
+    vector.push_back(2);
+
+    EXPECT_EQ(vector.size(), 2);
+    EXPECT_EQ(vector[1], 2);
+}
+
+TEST(FixedVector, ExceedingTheCapacityThrows)
+{
+    FixedVector<int, 4> vector;
+    vector.resize(4);
+
+    EXPECT_THROW(vector.resize(5), std::length_error);
+    EXPECT_THROW(vector.push_back(1), std::length_error);
+    EXPECT_EQ(vector.size(), 4);
+}
+
+TEST(FixedVector, CopyIsIndependent)
+{
+    FixedVector<int, 8> vector;
+    vector.resize(6, 1);
+
+    auto copy = vector;
+    copy[5] = 3;
+
+    EXPECT_EQ(copy.size(), 6);
+    EXPECT_EQ(vector[5], 1);
+    EXPECT_EQ(copy[5], 3);
+
+    vector.clear();
+
+    EXPECT_TRUE(vector.empty());
+    EXPECT_EQ(copy[0], 1);
+}
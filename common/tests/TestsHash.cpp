@@ -0,0 +1,65 @@
+#include "Hash.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <string>
+
+static std::uint64_t HashString(const std::string& text, const std::uint64_t seed = 0)
+{
+    XxHash64 hash(seed);
+    hash.Update(text.data(), text.size());
+    return hash.Digest();
+}
+
+TEST(XxHash64, MatchesTheReferenceHashes)
+{
+    EXPECT_EQ(HashString(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(HashString("abc"), 0x44BC2CF5AD770999ULL);
+
+    // Longer than a stripe, so the four lanes are used.
+    EXPECT_EQ(HashString("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1ULL);
+}
+
+TEST(XxHash64, SplitUpdatesGiveTheSameHash)
+{
+    std::string text;
+
+    for (int i = 0; i < 200; i++)
+    {
+        text.push_back(static_cast<char>(i * 7 + 3));
+    }
+
+    const auto expected = HashString(text, 42);
+
+    for (std::size_t split : { 1, 5, 31, 32, 33, 64, 199 })
+    {
+        XxHash64 hash(42);
+
+        for (std::size_t i = 0; i < text.size(); i += split)
+        {
+            hash.Update(text.data() + i, std::min(split, text.size() - i));
+        }
+
+        EXPECT_EQ(hash.Digest(), expected) << "split " << split;
+    }
+}
+
+TEST(XxHash64, OrderOfTheValuesChangesTheHash)
+{
+    XxHash64 hashA;
+    hashA.UpdateValue(1.f);
+    hashA.UpdateValue(2.f);
+
+    XxHash64 hashB;
+    hashB.UpdateValue(2.f);
+    hashB.UpdateValue(1.f);
+
+    EXPECT_NE(hashA.Digest(), hashB.Digest());
+
+    hashB.Reset();
+    hashB.UpdateValue(1.f);
+    hashB.UpdateValue(2.f);
+
+    EXPECT_EQ(hashA.Digest(), hashB.Digest());
+}
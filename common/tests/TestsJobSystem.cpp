@@ -0,0 +1,102 @@
+#include "JobSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+struct ThreadCountFixture : public ::testing::TestWithParam<int>{};
+
+INSTANTIATE_TEST_SUITE_P(JobSystem, ThreadCountFixture, testing::Values(
+        -1, 1, 2, 4, 7
+        ));
+
+TEST_P(ThreadCountFixture, Start)
+{
+    JobSystem jobSystem;
+    jobSystem.Start(GetParam());
+
+    EXPECT_EQ(jobSystem.ThreadCount(), std::max(GetParam(), 1));
+
+    jobSystem.Stop();
+
+    EXPECT_EQ(jobSystem.ThreadCount(), 1);
+}
+
+TEST_P(ThreadCountFixture, ParallelForRunsEachIterationOnce)
+{
+    JobSystem jobSystem;
+    jobSystem.Start(GetParam());
+
+    for (std::size_t count : { 0, 1, 63, 64, 65, 1000, 10007 })
+    {
+        std::vector<std::atomic<int>> runCounts(count);
+
+        jobSystem.ParallelFor(count, 64, [&runCounts](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                runCounts[i]++;
+            }
+        });
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            EXPECT_EQ(runCounts[i], 1);
+        }
+    }
+}
+
+TEST_P(ThreadCountFixture, ParallelForResultsDoNotDependOnTheThreadCount)
+{
+    JobSystem jobSystem;
+    jobSystem.Start(GetParam());
+
+    std::vector<float> values(5000);
+
+    // Many loops in a row, so the workers of a loop are still running when the next one starts.
+    for (int loop = 0; loop < 200; loop++)
+    {
+        jobSystem.ParallelFor(values.size(), 16, [&values, loop](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                values[i] = values[i] * 0.5f + static_cast<float>(i * loop) * 0.25f;
+            }
+        });
+    }
+
+    std::vector<float> expectedValues(values.size());
+
+    for (int loop = 0; loop < 200; loop++)
+    {
+        for (std::size_t i = 0; i < expectedValues.size(); i++)
+        {
+            expectedValues[i] = expectedValues[i] * 0.5f + static_cast<float>(i * loop) * 0.25f;
+        }
+    }
+
+    EXPECT_EQ(values, expectedValues);
+}
+
+TEST(JobSystem, CopyStartsItsOwnWorkers)
+{
+    JobSystem jobSystem;
+    jobSystem.Start(3);
+
+    JobSystem copy = jobSystem;
+    EXPECT_EQ(copy.ThreadCount(), 3);
+
+    JobSystem other;
+    other = jobSystem;
+    EXPECT_EQ(other.ThreadCount(), 1);
+
+    std::atomic<int> sum{0};
+    copy.ParallelFor(100, 10, [&sum](std::size_t begin, std::size_t end)
+    {
+        sum += static_cast<int>(end - begin);
+    });
+
+    EXPECT_EQ(sum, 100);
+}
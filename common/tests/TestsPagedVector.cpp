@@ -0,0 +1,53 @@
+#include "PagedVector.h"
+
+#include "gtest/gtest.h"
+
+static HeapAllocator TestHeapAllocator;
+
+TEST(PagedVector, ResizeKeepsValues)
+{
+    PagedVector<int, 4> vector{ StandardAllocator<int>{TestHeapAllocator} };
+    vector.resize(3, 7);
+
+    EXPECT_EQ(vector.size(), 3);
+    EXPECT_EQ(vector.capacity(), 4);
+
+    vector[1] = 2;
+    vector.resize(10, 5);
+
+    EXPECT_EQ(vector.size(), 10);
+    EXPECT_EQ(vector[0], 7);
+    EXPECT_EQ(vector[1], 2);
+    EXPECT_EQ(vector[2], 7);
+    EXPECT_EQ(vector[9], 5);
+}
+
+TEST(PagedVector, GrowingDoesNotMoveTheElements)
+{
+    PagedVector<int, 4> vector{ StandardAllocator<int>{TestHeapAllocator} };
+    vector.resize(2, 0);
+
+    int* firstElement = &vector[0];
+
+    vector.resize(1000, 0);
+
+    EXPECT_EQ(&vector[0], firstElement);
+}
+
+TEST(PagedVector, CopyIsIndependent)
+{
+    PagedVector<int, 4> vector{ StandardAllocator<int>{TestHeapAllocator} };
+    vector.resize(6, 1);
+
+    auto copy = vector;
+    copy[5] = 3;
+
+    EXPECT_EQ(copy.size(), 6);
+    EXPECT_EQ(vector[5], 1);
+    EXPECT_EQ(copy[5], 3);
+
+    vector.clear();
+
+    EXPECT_TRUE(vector.empty());
+    EXPECT_EQ(copy[0], 1);
+}
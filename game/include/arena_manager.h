@@ -1,13 +1,13 @@
 #pragma once
 
 #include "game_constants.h"
-#include "World.h"
+#include "game_world.h"
 
 #include <array>
 
 class ArenaManager {
 public:
-  void Init(PhysicsEngine::World* world) noexcept;
+  void Init(GameWorld* world) noexcept;
 
   [[nodiscard]] PhysicsEngine::ColliderRef GetWallColRef(std::size_t idx) const noexcept {
     return wall_col_refs[idx];
@@ -52,5 +52,5 @@ private:
 
   std::array<PhysicsEngine::ColliderRef, kTotalWallCount> wall_col_refs{};
 
-  PhysicsEngine::World* world_ = nullptr;
+  GameWorld* world_ = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "types.h"
+
+#include <array>
+#include <cstddef>
+
+/**
+ * \brief FrameRingBuffer is a class which stores a value per frame for the
+ * last Size frames, in place, so that its memory does not depend on the
+ * length of the game.
+ *
+ * A frame is mapped to its slot with a mask, which is why Size must be a power
+ * of two. Each slot remembers the frame of its value, to detect the reading of
+ * a frame which was never written or which was replaced by a newer one.
+ */
+template <typename T, std::size_t Size>
+class FrameRingBuffer {
+  static_assert(Size > 0 && (Size & (Size - 1)) == 0,
+                "The size of a frame ring buffer must be a power of two.");
+
+ public:
+  FrameRingBuffer() noexcept { Clear(); }
+
+  [[nodiscard]] static constexpr std::size_t size() noexcept { return Size; }
+
+  /**
+   * \brief Contains is a method which checks if the value of the frame given
+   * in parameter is still in the ring buffer.
+   */
+  [[nodiscard]] bool Contains(FrameNbr frame) const noexcept {
+    return frame >= 0 && frames_[slot(frame)] == frame;
+  }
+
+  /**
+   * \brief The value of the frame given in parameter, the frame must be in
+   * the ring buffer (see Contains).
+   */
+  [[nodiscard]] T& operator[](FrameNbr frame) noexcept {
+    return values_[slot(frame)];
+  }
+
+  [[nodiscard]] const T& operator[](FrameNbr frame) const noexcept {
+    return values_[slot(frame)];
+  }
+
+  /**
+   * \brief Set is a method which writes the value of the frame given in
+   * parameter, it replaces the value of the frame Size frames before.
+   */
+  void Set(FrameNbr frame, const T& value) noexcept {
+    const auto idx = slot(frame);
+    values_[idx] = value;
+    frames_[idx] = frame;
+  }
+
+  void Clear() noexcept {
+    values_.fill(T());
+    frames_.fill(-1);
+  }
+
+ private:
+  std::array<T, Size> values_{};
+  std::array<FrameNbr, Size> frames_{};
+
+  [[nodiscard]] static constexpr std::size_t slot(FrameNbr frame) noexcept {
+    return static_cast<std::size_t>(frame) & (Size - 1);
+  }
+};
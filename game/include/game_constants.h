@@ -11,6 +11,36 @@
 namespace game_constants {
   constexpr float kFixedDeltaTime = 1 / 50.f;
 
+  /**
+   * \brief kMaxRollbackFrameCount is the number of frames kept in the ring
+   * buffer of game state snapshots, aka the maximum rollback window. Here 16
+   * frames corresponds to 320 ms at a fixed 50fps, a misprediction older than
+   * that resimulates from the confirmed frame.
+   */
+  constexpr int kMaxRollbackFrameCount = 16;
+
+  /**
+   * \brief kMaxConfirmationLagFrameCount is the number of frames the current
+   * frame can be ahead of the frame to confirm beyond the rollback window. It
+   * absorbs the latency of the confirmations, a client further ahead waits for
+   * them.
+   */
+  constexpr int kMaxConfirmationLagFrameCount = 48;
+
+  /**
+   * \brief kInputRingSize is the number of frames of inputs kept for each
+   * player, from the frame to confirm to the current frame. Here 64 frames
+   * corresponds to 1.28 s at a fixed 50fps.
+   */
+  constexpr int kInputRingSize = 64;
+
+  static_assert((kInputRingSize & (kInputRingSize - 1)) == 0,
+                "The input ring size must be a power of two.");
+  static_assert(kInputRingSize >=
+                kMaxRollbackFrameCount + kMaxConfirmationLagFrameCount,
+                "The input ring must cover the rollback window and the "
+                "confirmation lag.");
+
   constexpr int kLocalPlayer1InputId = 0;
   constexpr int kLocalPlayer2InputId = 0;
 
@@ -45,4 +75,18 @@ namespace game_constants {
 
   constexpr Math::Vec2F kMainPlatformPos = Math::Vec2F(6.40f, 5.f);
 
+  /**
+   * \brief The collision layers of the game colliders. The category of a
+   * collider tells what it is when it touches a player.
+   */
+  constexpr int kPlayerLayer = 0;
+  constexpr int kBorderWallLayer = 1;
+  constexpr int kSquareWallLayer = 2;
+  constexpr int kProjectileLayer = 3;
+
+  constexpr std::uint32_t kPlayerCategory = 1u << kPlayerLayer;
+  constexpr std::uint32_t kBorderWallCategory = 1u << kBorderWallLayer;
+  constexpr std::uint32_t kSquareWallCategory = 1u << kSquareWallLayer;
+  constexpr std::uint32_t kProjectileCategory = 1u << kProjectileLayer;
+
 }
@@ -1,8 +1,11 @@
 #pragma once
 
-#include "World.h"
+#include "game_world.h"
 #include "player_manager.h"
 
+#include <array>
+#include <type_traits>
+
 /**
  * \brief GameState is a struct containing all the variables that describe
  * the state of the game.
@@ -10,8 +13,24 @@
  * These variables are the one that are copied when a rollback is needed.
  */
 struct GameState {
-  PhysicsEngine::World world{};
+  GameWorld world{};
   PlayerManager player_manager{};
   ProjectileManager projectile_manager{};
   bool is_game_finished = false;
-};
\ No newline at end of file
+};
+
+/**
+ * \brief GameStateSnapshot is a struct containing a copy of the state of the
+ * game at a frame.
+ *
+ * It is trivially copyable, so saving and restoring it are memcpys.
+ */
+struct GameStateSnapshot {
+  GameWorld::State world{};
+  std::array<Player, game_constants::kMaxPlayerCount> players{};
+  std::array<Projectile, ProjectileManager::kMaxProjectileCount> projectiles{};
+  bool is_game_finished = false;
+};
+
+static_assert(std::is_trivially_copyable_v<GameStateSnapshot>,
+              "A game state snapshot must be copied with a memcpy.");
\ No newline at end of file
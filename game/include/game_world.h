@@ -0,0 +1,32 @@
+#pragma once
+
+#include "World.h"
+
+/**
+ * \brief GameWorldConfig is the configuration of the physics world of the game.
+ *
+ * The game only uses circles and rectangles and the quad tree, the code of
+ * the other shapes and broad phases is not compiled. The bodies, colliders
+ * and contacts are stored in place in the world, up to kGameWorldCapacity of
+ * each, so that the rollback restores the world with a memcpy.
+ */
+struct GameWorldConfig : PhysicsEngine::DefaultWorldConfig {
+  static constexpr std::size_t kGameWorldCapacity = 128;
+
+  static constexpr std::uint8_t BroadPhaseTypes =
+      PhysicsEngine::BroadPhaseTypeBit(PhysicsEngine::BroadPhaseType::QuadTree);
+  static constexpr std::uint8_t ShapeTypes =
+      PhysicsEngine::ShapeTypeBit(Math::ShapeType::Circle) |
+      PhysicsEngine::ShapeTypeBit(Math::ShapeType::Rectangle);
+
+  static constexpr std::size_t MaxBodyCount = kGameWorldCapacity;
+  static constexpr std::size_t MaxColliderCount = kGameWorldCapacity;
+  static constexpr std::size_t MaxContactCount = kGameWorldCapacity;
+};
+
+extern template class PhysicsEngine::BasicWorld<GameWorldConfig>;
+
+using GameWorld = PhysicsEngine::BasicWorld<GameWorldConfig>;
+
+static_assert(GameWorld::IsStateTriviallyCopyable,
+              "The state of the game world must be copied with a memcpy.");
@@ -4,8 +4,8 @@
 #include "types.h"
 #include "game_constants.h"
 
-#include <Common-cpp/inc/CustomType.h>
-
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 
 namespace input {
@@ -31,46 +31,72 @@ extern std::array<Math::Vec2F, game_constants::kMaxPlayerCount> mouse_pos;
 [[nodiscard]] PlayerInput GetPlayerInput(int input_profile_id) noexcept;
 [[nodiscard]] Math::Vec2F CalculateDirToMouse(Math::Vec2F pos, PlayerId player_id) noexcept;
 
-class FrameInput final : public ExitGames::Common::CustomType<FrameInput, 1> {
-  typedef CustomType<FrameInput, 1> super;
-
+/**
+ * \brief FrameInputRecord is a class which stores the input of a player for a
+ * frame: the frame number, the direction to the mouse quantized on 16 bits per
+ * axis and the pressed buttons.
+ *
+ * It is trivially copyable, so the buffers of inputs are copied and compared
+ * as plain memory. It is serialized for the network only by the network
+ * adapter (see network_input.h).
+ */
+class FrameInputRecord {
  public:
-  FrameInput() noexcept = default;
-  FrameInput(Math::Vec2F dir_to_mouse, FrameNbr frame_nbr,
-             input::PlayerInput input) noexcept;
-  FrameInput(FrameInput&& toMove) noexcept = default;
-  FrameInput& operator=(FrameInput&& toMove) noexcept = default;
-  FrameInput(const FrameInput& toCopy) noexcept = default;
-  FrameInput& operator=(const FrameInput& toCopy) noexcept = default;
-  ~FrameInput() override = default;
-
-  ExitGames::Common::JString& toString(ExitGames::Common::JString& retStr,
-                                       bool withTypes) const override;
-  bool compare(const CustomTypeBase& other) const override;
-  void deserialize(const nByte* pData, short length) override;
-  short serialize(nByte* pRetVal) const override;
-  void duplicate(CustomTypeBase* pRetVal) const override;
-
-  bool operator==(const FrameInput& other) const noexcept;
+  constexpr FrameInputRecord() noexcept = default;
+  FrameInputRecord(Math::Vec2F dir_to_mouse, FrameNbr frame_nbr,
+                   PlayerInput input) noexcept;
+  constexpr FrameInputRecord(FrameNbr frame_nbr, std::int16_t aim_x,
+                             std::int16_t aim_y, PlayerInput input) noexcept
+      : frame_nbr_(frame_nbr), aim_x_(aim_x), aim_y_(aim_y), input_(input) {}
+
+  /**
+   * \brief kAimScale is the quantized value of a direction component of 1.
+   */
+  static constexpr float kAimScale = 32767.f;
+
+  [[nodiscard]] constexpr bool operator==(
+      const FrameInputRecord& other) const noexcept {
+    return frame_nbr_ == other.frame_nbr_ && IsSameInput(other);
+  }
 
+  /**
+   * \brief IsSameInput is a method which checks if the other frame input
+   * gives the same input to the simulation, whatever its frame number.
+   */
+  [[nodiscard]] constexpr bool IsSameInput(
+      const FrameInputRecord& other) const noexcept {
+    return aim_x_ == other.aim_x_ && aim_y_ == other.aim_y_ &&
+           input_ == other.input_;
+  }
+
+  /**
+   * \brief dir_to_mouse is the direction to the mouse restored from its
+   * quantized value, it is the one used by the simulation on all the clients.
+   */
   [[nodiscard]] Math::Vec2F dir_to_mouse() const noexcept {
-    return dir_to_mouse_;
+    return Math::Vec2F(aim_x_ / kAimScale, aim_y_ / kAimScale);
   }
 
-  [[nodiscard]] FrameNbr frame_nbr() const noexcept { return frame_nbr_; }
-  [[nodiscard]] input::PlayerInput input() const noexcept { return input_; }
+  [[nodiscard]] constexpr FrameNbr frame_nbr() const noexcept {
+    return frame_nbr_;
+  }
+  [[nodiscard]] constexpr std::int16_t aim_x() const noexcept { return aim_x_; }
+  [[nodiscard]] constexpr std::int16_t aim_y() const noexcept { return aim_y_; }
+  [[nodiscard]] constexpr PlayerInput input() const noexcept { return input_; }
 
  private:
-  Math::Vec2F dir_to_mouse_ = Math::Vec2F::Zero();
   FrameNbr frame_nbr_ = 0;
-  input::PlayerInput input_ = 0;
-
-  static nByte serialization_protocol_;
+  std::int16_t aim_x_ = 0;
+  std::int16_t aim_y_ = 0;
+  PlayerInput input_ = 0;
 };
 
+static_assert(std::is_trivially_copyable_v<FrameInputRecord>,
+              "The frame inputs must be copyable as plain memory.");
+
 struct FrameToConfirm {
   Checksum checksum;
-  std::vector<FrameInput> frame_inputs{};
+  std::vector<FrameInputRecord> frame_inputs{};
 };
 
 }  // namespace input
\ No newline at end of file
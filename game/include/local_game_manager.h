@@ -8,14 +8,14 @@
  *
  * It is designed for local multiplayer.
  */
-class LocalGameManager : public PhysicsEngine::ContactListener {
+class LocalGameManager {
 public:
   constexpr explicit LocalGameManager() noexcept = default;
   LocalGameManager(LocalGameManager&& other) noexcept = default;
   LocalGameManager& operator=(LocalGameManager&& other) noexcept = default;
   LocalGameManager(const LocalGameManager& other) noexcept = default;
   LocalGameManager& operator=(const LocalGameManager& other) noexcept = default;
-  ~LocalGameManager() noexcept override = default;
+  virtual ~LocalGameManager() noexcept = default;
 
   virtual void Init(int input_profile_id) noexcept;
   void FixedUpdate() noexcept;
@@ -25,7 +25,7 @@ public:
     player_id_ = player_id;
   }
 
-  void SetPlayerInput(const input::FrameInput& input, PlayerId player_id) noexcept;
+  void SetPlayerInput(const input::FrameInputRecord& input, PlayerId player_id) noexcept;
 
   /**
    * \brief Copy is a method which copies the states of the game. It used
@@ -34,6 +34,23 @@ public:
    */
   void Rollback(const LocalGameManager& game_manager) noexcept;
 
+  /**
+   * \brief SaveSnapshot is a method which copies the state of the game in the
+   * snapshot given in parameter.
+   */
+  void SaveSnapshot(GameStateSnapshot& snapshot) const noexcept;
+
+  /**
+   * \brief RestoreSnapshot is a method which replaces the state of the game by
+   * the snapshot given in parameter, saved by this game manager or another one.
+   */
+  void RestoreSnapshot(const GameStateSnapshot& snapshot) noexcept;
+
+  /**
+   * \brief ComputeChecksum is a method which hashes the whole simulation
+   * state in a single stream: the physics world, the players, the projectiles
+   * and the end of the game.
+   */
   [[nodiscard]] Checksum ComputeChecksum() const noexcept;
 
   [[nodiscard]] const PlayerManager& player_manager() const noexcept {
@@ -67,17 +84,13 @@ protected:
 
   float fixed_frame_timer_ = game_constants::kFixedDeltaTime;
 
-  void OnTriggerEnter(
-      PhysicsEngine::ColliderRef colliderRefA,
-      PhysicsEngine::ColliderRef colliderRefB) noexcept override{}
-  void OnTriggerStay(PhysicsEngine::ColliderRef colliderRefA,
-                     PhysicsEngine::ColliderRef colliderRefB) noexcept override{}
-  void OnTriggerExit(PhysicsEngine::ColliderRef colliderRefA,
-                     PhysicsEngine::ColliderRef colliderRefB) noexcept override{}
+  /**
+   * \brief ProcessContactEvents is a method which reads the contact events of
+   * the last world update in bulk.
+   */
+  void ProcessContactEvents() noexcept;
+
   void OnCollisionEnter(
       PhysicsEngine::ColliderRef colliderRefA,
-      PhysicsEngine::ColliderRef colliderRefB) noexcept override;
-  void OnCollisionExit(
-      PhysicsEngine::ColliderRef colliderRefA,
-      PhysicsEngine::ColliderRef colliderRefB) noexcept override {}
+      PhysicsEngine::ColliderRef colliderRefB) noexcept;
 };
\ No newline at end of file
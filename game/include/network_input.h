@@ -0,0 +1,40 @@
+#pragma once
+
+#include "event.h"
+#include "input.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * \brief network_input is a namespace that stores the adapter between the
+ * frame inputs of the game and the events of the network interface.
+ *
+ * The frame inputs are written in the events as an array of bytes, each
+ * field in little endian, so that the game and the rollback never depend on
+ * the Photon serialization.
+ */
+namespace network_input {
+
+/**
+ * \brief kFrameInputByteCount is the size of a frame input in an event: the
+ * frame number, the two aim components and the buttons.
+ */
+constexpr std::size_t kFrameInputByteCount = 9;
+
+/**
+ * \brief PutFrameInputs is a function which writes the frame inputs given in
+ * parameter in the event content at the kPlayerInput key.
+ */
+void PutFrameInputs(ExitGames::Common::Hashtable& event_content,
+                    const std::vector<input::FrameInputRecord>& frame_inputs);
+
+/**
+ * \brief GetFrameInputs is a function which reads the frame inputs of the
+ * event content at the kPlayerInput key, they are appended to the vector
+ * given in parameter.
+ */
+void GetFrameInputs(const ExitGames::Common::Hashtable& event_content,
+                    std::vector<input::FrameInputRecord>& frame_inputs);
+
+}  // namespace network_input
@@ -30,13 +30,23 @@ public:
     network_event_queue_.push(network_event);
   }
 
+  [[nodiscard]] const RollbackManager& rollback_manager() const noexcept {
+    return rollback_manager_;
+  }
+
 private:
   void PollNetworkEvents() noexcept;
+
+  /**
+   * \brief RaiseInputEvent is a method which sends the local inputs which are
+   * not confirmed yet, the other client takes the ones it did not receive.
+   */
+  void RaiseInputEvent() noexcept;
   void SendFrameConfirmationEvent(
-    const std::vector<input::FrameInput>& remote_frame_inputs) noexcept;
+    const std::vector<input::FrameInputRecord>& remote_frame_inputs) noexcept;
 
   std::queue<NetworkEvent> network_event_queue_{};
-  std::vector<input::FrameInput> frame_inputs_{};
+  std::vector<input::FrameInputRecord> frame_inputs_{};
 
   RollbackManager rollback_manager_;
   NetworkInterface* network_interface_ = nullptr;
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "World.h"
+#include "game_world.h"
 #include "game_constants.h"
 #include "input.h"
 #include "projectile_manager.h"
@@ -26,7 +26,7 @@ struct Player {
  */
 class PlayerManager {
  public:
-  void RegisterWorld(PhysicsEngine::World* world) noexcept { world_ = world; }
+  void RegisterWorld(GameWorld* world) noexcept { world_ = world; }
   void RegisterProjectileManager(ProjectileManager* proj_manager) noexcept {
     projectile_manager_ = proj_manager;
   }
@@ -41,10 +41,19 @@ class PlayerManager {
    * player_manager The player manager to be copied.
    */
   void Rollback(const PlayerManager& player_manager) noexcept;
+  void Rollback(const std::array<Player, game_constants::kMaxPlayerCount>& players) noexcept;
 
-  [[nodiscard]] Checksum ComputeChecksum() const noexcept;
+  /**
+   * \brief HashState is a method which adds the states of the players to the
+   * hash given in parameter.
+   */
+  void HashState(XxHash64& hash) const noexcept;
+
+  [[nodiscard]] const std::array<Player, game_constants::kMaxPlayerCount>& players() const noexcept {
+    return players_;
+  }
 
-  void SetPlayerInput(const input::FrameInput& input, PlayerId player_id);
+  void SetPlayerInput(const input::FrameInputRecord& input, PlayerId player_id);
 
   void ApplyOneDamageToPlayer(std::size_t player_idx) noexcept;
 
@@ -71,7 +80,7 @@ class PlayerManager {
  private:
   void Move(const Player& player) const noexcept;
   std::array<Player, game_constants::kMaxPlayerCount> players_{};
-  PhysicsEngine::World* world_ = nullptr;
+  GameWorld* world_ = nullptr;
   ProjectileManager* projectile_manager_ = nullptr;
 
   static constexpr float kShootCooldown = 0.5f;
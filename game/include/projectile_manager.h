@@ -1,7 +1,7 @@
 #pragma once
 
 #include "types.h"
-#include "World.h"
+#include "game_world.h"
 
 /**
  * \brief Projectile is a struct containing all the variables that describe
@@ -21,14 +21,18 @@ struct Projectile {
  */
 class ProjectileManager {
 public:
-  void Init(PhysicsEngine::World* world) noexcept;
+  void Init(GameWorld* world) noexcept;
   void CreateProjectile(Math::Vec2F position, Math::Vec2F mov_dir) noexcept;
   void FixedUpdate() noexcept;
   void Deinit() noexcept;
   void OnCollisionEnter(PhysicsEngine::ColliderRef colliderRefA,
                       PhysicsEngine::ColliderRef colliderRefB) noexcept;
 
-  Checksum ComputeChecksum() const noexcept;
+  /**
+   * \brief HashState is a method which adds the states of the projectiles to
+   * the hash given in parameter.
+   */
+  void HashState(XxHash64& hash) const noexcept;
   void Rollback(const ProjectileManager& projectile_manager) noexcept;
 
 
@@ -45,13 +49,19 @@ public:
   }
 
   static constexpr std::int16_t kMaxProjectileCount = 100;
+  static constexpr float kProjectileRadius = 0.125f;
+
+  void Rollback(const std::array<Projectile, kMaxProjectileCount>& projectiles) noexcept;
+
+  [[nodiscard]] const std::array<Projectile, kMaxProjectileCount>& projectiles() const noexcept {
+    return projectiles_;
+  }
 
  private:
   static constexpr float kProjectileMoveAmplitude = 7.f;
   static constexpr std::int8_t kMaxCollisionCount = 4;
   static constexpr float kProjectileMass = 2.5f;
-  static constexpr float kProjectileRadius = 0.125f;
 
   std::array<Projectile, kMaxProjectileCount> projectiles_{};
-  PhysicsEngine::World* world_ = nullptr;
+  GameWorld* world_ = nullptr;
 };
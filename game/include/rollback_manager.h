@@ -1,6 +1,7 @@
 #pragma once
 
 #include "local_game_manager.h"
+#include "frame_ring_buffer.h"
 #include "input.h"
 #include "types.h"
 
@@ -19,6 +20,15 @@
  * master client once all the inputs for a frame have been received.
  * All other clients receive the checksum of this game state and verify if it
  * corresponds to their checksum for this given state.
+ *
+ * The state of the current game at the start of each of the last frames is
+ * kept in a ring buffer of snapshots, so that a misprediction is corrected by
+ * resimulating only the frames from the first mispredicted one.
+ *
+ * The inputs of the frames which are not confirmed yet are kept in a ring
+ * buffer of kInputRingSize frames per player. The current frame does not go
+ * further than the ring buffer from the frame to confirm, the current game
+ * waits for the confirmations instead.
  */
 class RollbackManager {
  public:
@@ -26,28 +36,69 @@ class RollbackManager {
     current_game_manager_ = current_game_manager;
     confirmed_game_manager_.Init(current_game_manager->input_profile_id());
 
-    for (std::size_t i = 0; i < game_constants::kMaxPlayerCount; i++) {
-      inputs_[i].resize(kMaxFrameCount);
-    }
+    snapshots_.resize(game_constants::kMaxRollbackFrameCount);
   }
 
   void Deinit() noexcept;
 
-  void SetLocalPlayerInput(const input::FrameInput& local_input, PlayerId player_id) noexcept;
-  void SetRemotePlayerInput(const std::vector<input::FrameInput>& new_remote_inputs,
+  void SetLocalPlayerInput(const input::FrameInputRecord& local_input, PlayerId player_id) noexcept;
+  void SetRemotePlayerInput(const std::vector<input::FrameInputRecord>& new_remote_inputs,
                             PlayerId player_id);
 
-  void SimulateUntilCurrentFrame() const noexcept;
+  /**
+   * \brief SaveCurrentFrameSnapshot is a method which saves the state of the
+   * current game before the update of the current frame in the ring buffer.
+   */
+  void SaveCurrentFrameSnapshot() noexcept;
+
+  /**
+   * \brief SimulateUntilCurrentFrame is a method which restores the state of
+   * the current game at the start of the frame given in parameter and
+   * simulates it again until the last simulated frame, the current frame
+   * included once its update is made. A frame which is not in the ring buffer
+   * anymore is simulated again from the confirmed frame.
+   * \param first_frame The first frame whose inputs changed.
+   */
+  void SimulateUntilCurrentFrame(FrameNbr first_frame) noexcept;
   Checksum ConfirmFrame() noexcept;
 
-  [[nodiscard]] const input::FrameInput& GetLastPlayerInput(
-    PlayerId player_id) const noexcept;
+  /**
+   * \brief PredictCurrentFrameInput is a method which gives the input of the
+   * player for the current frame. An input not received yet is predicted with
+   * the last received one. The input is recorded as the one used by the frame,
+   * to be compared with the real input when it is received.
+   */
+  [[nodiscard]] const input::FrameInputRecord& PredictCurrentFrameInput(
+    PlayerId player_id) noexcept;
 
   [[nodiscard]] FrameNbr current_frame() const noexcept {
     return current_frame_;
   }
 
-  void IncreaseCurrentFrame() noexcept { current_frame_++; }
+  void IncreaseCurrentFrame() noexcept {
+    current_frame_++;
+    is_current_frame_simulated_ = false;
+  }
+
+  /**
+   * \brief SetCurrentFrameSimulated is a method which tells that the update of
+   * the current frame is made. The inputs received while the current game
+   * waits for the confirmations are then compared and simulated again up to
+   * the current frame included.
+   */
+  void SetCurrentFrameSimulated() noexcept {
+    is_current_frame_simulated_ = true;
+  }
+
+  /**
+   * \brief CanIncreaseCurrentFrame is a method which checks if the inputs of
+   * the next frame fit in the ring buffer without replacing the ones of a frame
+   * which is not confirmed yet.
+   */
+  [[nodiscard]] bool CanIncreaseCurrentFrame() const noexcept {
+    return current_frame_ + 1 - frame_to_confirm_ <
+           game_constants::kInputRingSize;
+  }
 
   [[nodiscard]] FrameNbr confirmed_frame() const noexcept {
     return confirmed_frame_;
@@ -61,6 +112,30 @@ class RollbackManager {
     return frame_to_confirm_;
   }
 
+  /**
+   * \brief first_mispredicted_frame is the earliest frame whose received
+   * input differed from its prediction in the last remote inputs, -1 if all
+   * the predictions were right.
+   */
+  [[nodiscard]] FrameNbr first_mispredicted_frame() const noexcept {
+    return first_mispredicted_frame_;
+  }
+
+  /**
+   * \brief rollback_count is the number of remote inputs which corrected a
+   * misprediction and caused a rollback, avoided_rollback_count the number of
+   * remote inputs for already simulated frames which confirmed all the
+   * predictions, and resimulated_frame_count the number of frames simulated
+   * again by the rollbacks.
+   */
+  [[nodiscard]] int rollback_count() const noexcept { return rollback_count_; }
+  [[nodiscard]] int avoided_rollback_count() const noexcept {
+    return avoided_rollback_count_;
+  }
+  [[nodiscard]] int resimulated_frame_count() const noexcept {
+    return resimulated_frame_count_;
+  }
+
  private:
   /**
    * \brief current_game_manager_ is a pointer to local client's GameManager.
@@ -95,16 +170,72 @@ class RollbackManager {
   FrameNbr confirmed_frame_ = -1;
 
   /**
-   * \brief kMaxFrameCount is the maximum of frame that the game can last.
-   * Here 30'000 corresponds to 10 minutes at a fixed 50fps.
+   * \brief is_current_frame_simulated_ tells if the update of the current
+   * frame is made, it is false between the increase of the current frame and
+   * its update.
    */
-  static constexpr FrameNbr kMaxFrameCount = 30'000;
+  bool is_current_frame_simulated_ = false;
 
-  std::array<std::vector<input::FrameInput>,
+  FrameNbr first_mispredicted_frame_ = -1;
+  int rollback_count_ = 0;
+  int avoided_rollback_count_ = 0;
+  int resimulated_frame_count_ = 0;
+
+  /**
+   * \brief inputs_ stores for each player the input used by each frame since
+   * the frame to confirm: the received one, or the predicted one until it is
+   * received.
+   */
+  std::array<FrameRingBuffer<input::FrameInputRecord, game_constants::kInputRingSize>,
              game_constants::kMaxPlayerCount> inputs_{};
   /**
    * \brief last_inputs_ is an array which stores the last inputs received by the
    * different players.
    */
-  std::array<input::FrameInput, 2> last_inputs_{};
+  std::array<input::FrameInputRecord, 2> last_inputs_{};
+
+  /**
+   * \brief FrameSnapshot is a struct which stores the state of the current
+   * game at the start of a frame.
+   */
+  struct FrameSnapshot {
+    FrameNbr frame_nbr = -1;
+    GameStateSnapshot state{};
+  };
+
+  /**
+   * \brief snapshots_ is the ring buffer of the snapshots of the last
+   * kMaxRollbackFrameCount frames, indexed by frame number.
+   */
+  std::vector<FrameSnapshot> snapshots_{};
+
+  /**
+   * \brief last_simulated_frame is the last frame whose update was made by the
+   * current game with the inputs recorded for it.
+   */
+  [[nodiscard]] FrameNbr last_simulated_frame() const noexcept {
+    return is_current_frame_simulated_ ? current_frame_ : current_frame_ - 1;
+  }
+
+  [[nodiscard]] FrameSnapshot& snapshot(FrameNbr frame) noexcept {
+    return snapshots_[static_cast<std::size_t>(frame) % snapshots_.size()];
+  }
+
+  /**
+   * \brief record_input is a method which records the input of the player for
+   * the frame given in parameter. An input which would replace the one of a
+   * frame not confirmed yet is an overrun of the ring buffer, it is reported
+   * and dropped.
+   */
+  void record_input(PlayerId player_id, FrameNbr frame,
+                    const input::FrameInputRecord& input) noexcept;
+
+  /**
+   * \brief recorded_input is a method which gives the input of the player
+   * recorded for the frame given in parameter. A frame which is not in the
+   * ring buffer anymore is reported and the last input of the player is used
+   * instead.
+   */
+  [[nodiscard]] const input::FrameInputRecord& recorded_input(
+      PlayerId player_id, FrameNbr frame) const noexcept;
 };
\ No newline at end of file
@@ -9,13 +9,13 @@
  * value to simulate the network delay.
  */
 struct SimulationInput {
-  std::vector<input::FrameInput> frame_inputs;
+  std::vector<input::FrameInputRecord> frame_inputs;
   float delay = 0.f;
 };
 
 struct SimulationFrameToConfirm {
-  int check_sum = 0;
-  std::vector<input::FrameInput> frame_inputs{};
+  Checksum check_sum = 0;
+  std::vector<input::FrameInputRecord> frame_inputs{};
   float delay = 0.f;
 };
 
@@ -2,7 +2,11 @@
 
 #include <cstdint>
 
-using Checksum = int;
-using FrameNbr = std::int16_t;
+/**
+ * \brief Checksum is the 64-bit hash of a game state, long long is the 64-bit
+ * integer of the network serialization.
+ */
+using Checksum = long long;
+using FrameNbr = std::int32_t;
 using PlayerId = std::int8_t;
 using ClientId = std::int8_t;
\ No newline at end of file
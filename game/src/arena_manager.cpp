@@ -1,6 +1,6 @@
 #include "arena_manager.h"
 
-void ArenaManager::Init(PhysicsEngine::World* world) noexcept {
+void ArenaManager::Init(GameWorld* world) noexcept {
   world_ = world;
 
   for (int i = 0; i < game_constants::kArenaBorderWallCount; i++) {
@@ -13,6 +13,7 @@ void ArenaManager::Init(PhysicsEngine::World* world) noexcept {
     auto& col = world_->GetCollider(wall_col_refs[i]);
     col.SetShape(wall_shapes[i]);
     col.SetRestitution(0.f);
+    col.SetCategoryBits(game_constants::kBorderWallCategory);
   }
 
   for (int i = 0; i < game_constants::kArenaSquareWallCount; i++) {
@@ -26,5 +27,6 @@ void ArenaManager::Init(PhysicsEngine::World* world) noexcept {
     auto& col = world_->GetCollider(wall_col_refs[idx]);
     col.SetShape(game_constants::kSquareWallRect);
     col.SetRestitution(0.f);
+    col.SetCategoryBits(game_constants::kSquareWallCategory);
   }
 }
\ No newline at end of file
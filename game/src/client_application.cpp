@@ -10,8 +10,6 @@ void ClientApplication::Setup() noexcept {
 
   render_texture_ = raylib::LoadRenderTexture(raylib::GetScreenWidth(),
                                               raylib::GetScreenHeight());
-
-  input::FrameInput::registerType();
 }
 
 void ClientApplication::Update() noexcept {
@@ -41,6 +39,4 @@ void ClientApplication::DrawImGui() noexcept {
 void ClientApplication::TearDown() noexcept {
   network_manager_.Disconnect();
   client_.Deinit();
-
-  input::FrameInput::registerType();
 }
\ No newline at end of file
@@ -0,0 +1,5 @@
+#include "game_world.h"
+
+#include "WorldImpl.h"
+
+template class PhysicsEngine::BasicWorld<GameWorldConfig>;
@@ -2,9 +2,11 @@
 #include "Metrics.h"
 #include "engine.h"
 
-#include <Common-cpp/inc/Common.h>
 #include <raylib_wrapper.h>
 
+#include <algorithm>
+#include <cmath>
+
 
 namespace input {
 
@@ -68,76 +70,24 @@ Math::Vec2F CalculateDirToMouse(const Math::Vec2F pos, PlayerId player_id) noexc
   return  (mouse_pos[player_id] - pos).Normalized();
 }
 
-nByte FrameInput::serialization_protocol_ =
-    ExitGames::Common::SerializationProtocol::DEFAULT;
-
-FrameInput::FrameInput(Math::Vec2F dir_to_mouse, FrameNbr frame_nbr,
-                       PlayerInput input) noexcept
-    : dir_to_mouse_(dir_to_mouse), frame_nbr_(frame_nbr), input_(input) {}
-
-ExitGames::Common::JString& FrameInput::toString(
-    ExitGames::Common::JString& retStr, bool withTypes) const {
-  return retStr =
-             ExitGames::Common::JString(L"<") +
-             (withTypes ? ExitGames::Common::JString(L"(") + EG_STR_UCHAR + L")"
-                        : L"") +
-             dir_to_mouse_.X + L", " + dir_to_mouse_.Y + L", " +
-             (withTypes ? ExitGames::Common::JString(L"(") + EG_STR_UCHAR + L")"
-                        : L"") +
-             frame_nbr_ + L">" +
-             (withTypes ? ExitGames::Common::JString(L"(") + EG_STR_UCHAR + L")"
-                        : L"") +
-             input_ + L">";
-}
-
-bool FrameInput::compare(const CustomTypeBase& other) const {
-  return dir_to_mouse_ ==
-             dynamic_cast<const FrameInput&>(other).dir_to_mouse_ &&
-         frame_nbr_ == dynamic_cast<const FrameInput&>(other).frame_nbr_ &&
-         input_ == dynamic_cast<const FrameInput&>(other).input_;
-}
-
-void FrameInput::deserialize(const nByte* pData, short length) {
-  ExitGames::Common::Deserializer d(pData, length, serialization_protocol_);
-  ExitGames::Common::Object o{};
-
-  d.pop(o);
-  dir_to_mouse_.X = ExitGames::Common::ValueObject<float>(o).getDataCopy();
-
-  d.pop(o);
-  dir_to_mouse_.Y = ExitGames::Common::ValueObject<float>(o).getDataCopy();
-
-  d.pop(o);
-  frame_nbr_ = ExitGames::Common::ValueObject<FrameNbr>(o).getDataCopy();
-
-  d.pop(o);
-  input_ = ExitGames::Common::ValueObject<input::PlayerInput>(o).getDataCopy();
-}
-
-short FrameInput::serialize(nByte* pRetVal) const {
-  ExitGames::Common::Serializer s(serialization_protocol_);
-
-  s.push(dir_to_mouse_.X);
-  s.push(dir_to_mouse_.Y);
-  s.push(frame_nbr_);
-  s.push(input_);
+namespace {
 
-  if (pRetVal) {
-    MEMCPY(pRetVal, s.getData(), s.getSize());
+std::int16_t QuantizeAim(const float value) noexcept {
+  if (!std::isfinite(value)) {
+    return 0;
   }
 
-  return static_cast<short>(s.getSize());
-}
-
-void FrameInput::duplicate(CustomTypeBase* pRetVal) const {
-  *reinterpret_cast<FrameInput*>(pRetVal) = *this;
-}
-
-bool FrameInput::operator==(const FrameInput& other) const noexcept {
-  return dir_to_mouse_ == other.dir_to_mouse_ &&
-         frame_nbr_ == other.frame_nbr_ && input_ == other.input_;
+  return static_cast<std::int16_t>(
+      std::lround(std::clamp(value, -1.f, 1.f) * FrameInputRecord::kAimScale));
 }
 
+}  // namespace
 
+FrameInputRecord::FrameInputRecord(Math::Vec2F dir_to_mouse, FrameNbr frame_nbr,
+                                   PlayerInput input) noexcept
+    : frame_nbr_(frame_nbr),
+      aim_x_(QuantizeAim(dir_to_mouse.X)),
+      aim_y_(QuantizeAim(dir_to_mouse.Y)),
+      input_(input) {}
 
 }  // namespace input
\ No newline at end of file
@@ -6,7 +6,13 @@
 
 void LocalGameManager::Init(int input_profile_id) noexcept {
   game_state_.world.Init(Math::Vec2F(0.f, 0.f), game_constants::kGameBodyCount);
-  game_state_.world.SetContactListener(this);
+  game_state_.world.SetContactEventsEnabled(true);
+
+  // The walls never move, their pairs are rejected by the broad phase.
+  for (const auto wall_layer : {game_constants::kBorderWallLayer, game_constants::kSquareWallLayer}) {
+    game_state_.world.SetLayersCollide(wall_layer, game_constants::kBorderWallLayer, false);
+    game_state_.world.SetLayersCollide(wall_layer, game_constants::kSquareWallLayer, false);
+  }
 
   game_state_.player_manager.RegisterWorld(&game_state_.world);
   game_state_.player_manager.RegisterProjectileManager(&game_state_.projectile_manager);
@@ -31,6 +37,7 @@ void LocalGameManager::FixedUpdate() noexcept {
   }
 
   game_state_.world.Update(game_constants::kFixedDeltaTime);
+  ProcessContactEvents();
 
   game_state_.player_manager.FixedUpdate();
   game_state_.projectile_manager.FixedUpdate();
@@ -43,7 +50,7 @@ void LocalGameManager::Deinit() noexcept {
   game_state_.is_game_finished = false;
 }
 
-void LocalGameManager::SetPlayerInput(const input::FrameInput& input, PlayerId player_id) noexcept {
+void LocalGameManager::SetPlayerInput(const input::FrameInputRecord& input, PlayerId player_id) noexcept {
   game_state_.player_manager.SetPlayerInput(input, player_id);
 }
 
@@ -52,63 +59,90 @@ void LocalGameManager::Rollback(const LocalGameManager& game_manager) noexcept {
   ZoneScoped;
 #endif  // TRACY_ENABLE
 
-  game_state_.world = game_manager.game_state_.world;
-  game_state_.world.SetContactListener(this);
+  game_state_.world.RestoreState(game_manager.game_state_.world.GetState());
   game_state_.player_manager.Rollback(game_manager.game_state_.player_manager);
   game_state_.projectile_manager.Rollback(game_manager.game_state_.projectile_manager);
 
   game_state_.is_game_finished = game_manager.game_state_.is_game_finished;
 }
 
+void LocalGameManager::SaveSnapshot(GameStateSnapshot& snapshot) const noexcept {
+#ifdef TRACY_ENABLE
+  ZoneScoped;
+#endif  // TRACY_ENABLE
+
+  game_state_.world.SaveState(snapshot.world);
+  snapshot.players = game_state_.player_manager.players();
+  snapshot.projectiles = game_state_.projectile_manager.projectiles();
+  snapshot.is_game_finished = game_state_.is_game_finished;
+}
+
+void LocalGameManager::RestoreSnapshot(const GameStateSnapshot& snapshot) noexcept {
+#ifdef TRACY_ENABLE
+  ZoneScoped;
+#endif  // TRACY_ENABLE
+
+  game_state_.world.RestoreState(snapshot.world);
+  game_state_.player_manager.Rollback(snapshot.players);
+  game_state_.projectile_manager.Rollback(snapshot.projectiles);
+  game_state_.is_game_finished = snapshot.is_game_finished;
+}
+
 Checksum LocalGameManager::ComputeChecksum() const noexcept {
 #ifdef TRACY_ENABLE
   ZoneScoped;
 #endif  // TRACY_ENABLE
 
-  Checksum checksum = 0;
+  XxHash64 hash;
+
+  game_state_.world.HashState(hash);
+  game_state_.player_manager.HashState(hash);
+  game_state_.projectile_manager.HashState(hash);
+  hash.UpdateValue(game_state_.is_game_finished);
 
-  checksum += game_state_.player_manager.ComputeChecksum();
-  checksum += game_state_.projectile_manager.ComputeChecksum();
+  return static_cast<Checksum>(hash.Digest());
+}
+
+void LocalGameManager::ProcessContactEvents() noexcept {
+#ifdef TRACY_ENABLE
+  ZoneScoped;
+#endif  // TRACY_ENABLE
 
-  return checksum;
+  for (const auto& event : game_state_.world.ContactEvents()) {
+    if (event.Type == PhysicsEngine::ContactEventType::CollisionEnter) {
+      OnCollisionEnter(event.Pair.ColliderA, event.Pair.ColliderB);
+    }
+  }
 }
 
 void LocalGameManager::OnCollisionEnter(
     PhysicsEngine::ColliderRef colliderRefA,
     PhysicsEngine::ColliderRef colliderRefB) noexcept {
+  auto& world = game_state_.world;
 
   for (std::size_t player_idx = 0; player_idx < game_constants::kMaxPlayerCount; player_idx++) {
     const auto& player_col_ref = game_state_.player_manager.GetPlayerColRef(player_idx);
 
     if (colliderRefA == player_col_ref || colliderRefB == player_col_ref)
     {
-      const auto other_player_idx = player_idx == 0 ? 1 : 0;
-      const auto& other_player_col_ref =
-          game_state_.player_manager.GetPlayerColRef(other_player_idx);
-      if (colliderRefA == other_player_col_ref ||
-          colliderRefB == other_player_col_ref) {
-        game_state_.player_manager.LaunchSpinTimer(player_idx);
-        game_state_.player_manager.LaunchSpinTimer(other_player_idx);
-        return;
-      }
+      // The category of the other collider tells what the player touched.
+      const auto& other_col_ref = colliderRefA == player_col_ref ? colliderRefB : colliderRefA;
 
-      for (std::size_t wall_idx = 0; wall_idx < game_constants::kArenaBorderWallCount; wall_idx++)
-      {
-        const auto& wall_col_ref = arena_manager_.GetWallColRef(wall_idx);
-        if (colliderRefA == wall_col_ref || colliderRefB == wall_col_ref)
-        {
-          game_state_.player_manager.ApplyOneDamageToPlayer(player_idx);
+      switch (world.GetCollider(other_col_ref).CategoryBits()) {
+        case game_constants::kPlayerCategory: {
+          const auto other_player_idx = player_idx == 0 ? 1 : 0;
+          game_state_.player_manager.LaunchSpinTimer(player_idx);
+          game_state_.player_manager.LaunchSpinTimer(other_player_idx);
           return;
         }
-      }
-
-      for (std::size_t proj_idx = 0; proj_idx < ProjectileManager::kMaxProjectileCount; proj_idx++)
-      {
-        const auto& proj_col_ref = projectile_manager().GetProjectile(proj_idx).collider_ref;
-        if (colliderRefA == proj_col_ref || colliderRefB == proj_col_ref) {
+        case game_constants::kBorderWallCategory:
+          game_state_.player_manager.ApplyOneDamageToPlayer(player_idx);
+          return;
+        case game_constants::kProjectileCategory:
           game_state_.player_manager.LaunchSpinTimer(player_idx);
           return;
-        }
+        default:
+          break;
       }
     }
   }
@@ -0,0 +1,78 @@
+#include "network_input.h"
+
+#include <Common-cpp/inc/Common.h>
+
+namespace network_input {
+
+namespace {
+
+void WriteUint(nByte* bytes, std::uint32_t value, std::size_t byte_count) noexcept {
+  for (std::size_t i = 0; i < byte_count; i++) {
+    bytes[i] = static_cast<nByte>(value >> (8 * i));
+  }
+}
+
+[[nodiscard]] std::uint32_t ReadUint(const nByte* bytes,
+                                     std::size_t byte_count) noexcept {
+  std::uint32_t value = 0;
+
+  for (std::size_t i = 0; i < byte_count; i++) {
+    value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+  }
+
+  return value;
+}
+
+}  // namespace
+
+void PutFrameInputs(ExitGames::Common::Hashtable& event_content,
+                    const std::vector<input::FrameInputRecord>& frame_inputs) {
+  std::vector<nByte> bytes(frame_inputs.size() * kFrameInputByteCount);
+  nByte* it = bytes.data();
+
+  for (const auto& frame_input : frame_inputs) {
+    WriteUint(it, static_cast<std::uint32_t>(frame_input.frame_nbr()), 4);
+    WriteUint(it + 4, static_cast<std::uint16_t>(frame_input.aim_x()), 2);
+    WriteUint(it + 6, static_cast<std::uint16_t>(frame_input.aim_y()), 2);
+    it[8] = frame_input.input();
+    it += kFrameInputByteCount;
+  }
+
+  event_content.put<nByte, nByte*>(
+      static_cast<nByte>(NetworkEventKey::kPlayerInput), bytes.data(),
+      static_cast<int>(bytes.size()));
+}
+
+void GetFrameInputs(const ExitGames::Common::Hashtable& event_content,
+                    std::vector<input::FrameInputRecord>& frame_inputs) {
+  const auto input_value = event_content.getValue(
+      static_cast<nByte>(NetworkEventKey::kPlayerInput));
+
+  if (input_value == nullptr) {
+    return;
+  }
+
+  const nByte* bytes =
+      ExitGames::Common::ValueObject<nByte*>(input_value).getDataCopy();
+
+  const int byte_count =
+      *ExitGames::Common::ValueObject<nByte*>(input_value).getSizes();
+
+  const auto inputs_count =
+      byte_count > 0
+          ? static_cast<std::size_t>(byte_count) / kFrameInputByteCount
+          : 0;
+  frame_inputs.reserve(frame_inputs.size() + inputs_count);
+
+  for (std::size_t i = 0; i < inputs_count; i++) {
+    const nByte* it = bytes + i * kFrameInputByteCount;
+    frame_inputs.emplace_back(
+        static_cast<FrameNbr>(ReadUint(it, 4)),
+        static_cast<std::int16_t>(ReadUint(it + 4, 2)),
+        static_cast<std::int16_t>(ReadUint(it + 6, 2)), it[8]);
+  }
+
+  ExitGames::Common::MemoryManagement::deallocateArray(bytes);
+}
+
+}  // namespace network_input
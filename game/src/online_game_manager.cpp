@@ -1,5 +1,6 @@
 #include "online_game_manager.h"
 #include "Metrics.h"
+#include "network_input.h"
 
 void OnlineGameManager::RegisterNetworkInterface(
     NetworkInterface* network_interface) noexcept {
@@ -20,18 +21,32 @@ void OnlineGameManager::FixedUpdateCurrentFrame() noexcept {
     return;
   }
 
+  if (!rollback_manager_.CanIncreaseCurrentFrame()) {
+    // Too far ahead of the confirmations, wait for them instead of replacing
+    // the inputs of the frames which are not confirmed yet. The inputs are
+    // sent again, the last input event may have been lost and the other
+    // client cannot confirm anything without it. The current frame is already
+    // simulated, a misprediction simulates it again.
+    PollNetworkEvents();
+    RaiseInputEvent();
+    return;
+  }
+
   rollback_manager_.IncreaseCurrentFrame();
 
   PollNetworkEvents();
   SendInputEvent();
 
+  rollback_manager_.SaveCurrentFrameSnapshot();
+
   for (PlayerId player_id = 0; player_id < game_constants::kMaxPlayerCount;
        player_id++) {
-    const auto input = rollback_manager_.GetLastPlayerInput(player_id);
+    const auto input = rollback_manager_.PredictCurrentFrameInput(player_id);
     SetPlayerInput(input, player_id);
   }
 
   LocalGameManager::FixedUpdate();
+  rollback_manager_.SetCurrentFrameSimulated();
 }
 
 void OnlineGameManager::Deinit() noexcept {
@@ -74,28 +89,34 @@ void OnlineGameManager::SendInputEvent() noexcept {
 
   const auto pos = game_state_.player_manager.GetPlayerPosition(player_id_);
   const auto dir_to_mouse = input::CalculateDirToMouse(pos, player_id_);
-  const input::FrameInput frame_input(dir_to_mouse, current_frame, input);
+  const input::FrameInputRecord frame_input(dir_to_mouse, current_frame, input);
   
   rollback_manager_.SetLocalPlayerInput(frame_input, player_id_);
   frame_inputs_.push_back(frame_input);
 
+  RaiseInputEvent();
+}
+
+void OnlineGameManager::RaiseInputEvent() noexcept {
+  if (frame_inputs_.empty()) {
+    return;
+  }
+
   ExitGames::Common::Hashtable event;
-  event.put<nByte, input::FrameInput*>(
-      static_cast<nByte>(NetworkEventKey::kPlayerInput), frame_inputs_.data(),
-      frame_inputs_.size());
+  network_input::PutFrameInputs(event, frame_inputs_);
 
   network_interface_->RaiseEvent(false, NetworkEventCode::kInput, event);
 }
 
 void OnlineGameManager::SendFrameConfirmationEvent(
-    const std::vector<input::FrameInput>& remote_frame_inputs) noexcept {
+    const std::vector<input::FrameInputRecord>& remote_frame_inputs) noexcept {
 #ifdef TRACY_ENABLE
   ZoneScoped;
 #endif  // TRACY_ENABLE
 
   auto frame_to_confirm_it = std::find_if(
       remote_frame_inputs.begin(), remote_frame_inputs.end(),
-      [this](const input::FrameInput& frame_input) {
+      [this](const input::FrameInputRecord& frame_input) {
         return frame_input.frame_nbr() == rollback_manager_.frame_to_confirm();
       });
 
@@ -110,7 +131,7 @@ void OnlineGameManager::SendFrameConfirmationEvent(
     // a frame greater than the local current frame.
     const auto current_frame_it =
         std::find_if(remote_frame_inputs.begin(), remote_frame_inputs.end(),
-                     [current_frame](const input::FrameInput& frame_input) {
+                     [current_frame](const input::FrameInputRecord& frame_input) {
                        return frame_input.frame_nbr() == current_frame;
                      });
 
@@ -125,12 +146,11 @@ void OnlineGameManager::SendFrameConfirmationEvent(
       break;
     }
 
-    const int check_sum = rollback_manager_.ConfirmFrame();
+    const Checksum check_sum = rollback_manager_.ConfirmFrame();
 
     ExitGames::Common::Hashtable event_check_sum;
     event_check_sum.put(static_cast<nByte>(NetworkEventKey::kCheckSum), check_sum);
-    event_check_sum.put(static_cast<nByte>(NetworkEventKey::kPlayerInput),
-                        frame_inputs_.data(), frame_inputs_.size());
+    network_input::PutFrameInputs(event_check_sum, frame_inputs_);
 
     network_interface_->RaiseEvent(true, NetworkEventCode::kFrameConfirmation,
                                    event_check_sum);
@@ -145,32 +165,16 @@ void OnlineGameManager::OnInputReceived(
   ZoneScoped;
 #endif  // TRACY_ENABLE
 
-  std::vector<input::FrameInput> remote_frame_inputs{};
-
-  const auto input_value =
-      event_content.getValue(static_cast<nByte>(NetworkEventKey::kPlayerInput));
+  std::vector<input::FrameInputRecord> remote_frame_inputs{};
+  network_input::GetFrameInputs(event_content, remote_frame_inputs);
 
-  const input::FrameInput* inputs =
-      ExitGames::Common::ValueObject<input::FrameInput*>(input_value)
-          .getDataCopy();
-
-  const int inputs_count =
-      *ExitGames::Common::ValueObject<input::FrameInput*>(input_value)
-           .getSizes();
-
-  if (inputs_count <= 0)
+  if (remote_frame_inputs.empty())
   {
     std::cerr << "remote input event is empty at confirmed frame ." << 
         rollback_manager_.confirmed_frame() << '\n';
     return;
   }
 
-  remote_frame_inputs.reserve(inputs_count);
-  for (int i = 0; i < inputs_count; i++) {
-    input::FrameInput frame_input{inputs[i]};
-    remote_frame_inputs.push_back(frame_input);
-  }
-
   if (remote_frame_inputs.back().frame_nbr() <=
       rollback_manager_.last_remote_input_frame()) {
     // received old input, no need to send confirm packet.
@@ -184,8 +188,6 @@ void OnlineGameManager::OnInputReceived(
   if (player_id_ == kMasterClientId) {
     SendFrameConfirmationEvent(remote_frame_inputs);
   }
-
-  ExitGames::Common::MemoryManagement::deallocateArray(inputs);
 }
 
 void OnlineGameManager::OnFrameConfirmationReceived(
@@ -200,34 +202,21 @@ void OnlineGameManager::OnFrameConfirmationReceived(
   }
 
   Checksum checksum = 0;
-  std::vector<input::FrameInput> frame_inputs{};
+  std::vector<input::FrameInputRecord> frame_inputs{};
 
   const auto checksum_value =
       event_content.getValue(static_cast<nByte>(NetworkEventKey::kCheckSum));
-  checksum = ExitGames::Common::ValueObject<int>(checksum_value).getDataCopy();
+  checksum =
+      ExitGames::Common::ValueObject<Checksum>(checksum_value).getDataCopy();
 
-  const auto input_value =
-      event_content.getValue(static_cast<nByte>(NetworkEventKey::kPlayerInput));
+  network_input::GetFrameInputs(event_content, frame_inputs);
 
-  const input::FrameInput* inputs =
-      ExitGames::Common::ValueObject<input::FrameInput*>(input_value)
-          .getDataCopy();
-
-  const int inputs_count =
-      *ExitGames::Common::ValueObject<input::FrameInput*>(input_value).getSizes();
-
-  if (inputs_count <= 0) {
+  if (frame_inputs.empty()) {
     std::cerr << "remote input event is empty at confirmed frame ."
               << rollback_manager_.confirmed_frame() << '\n';
     //return;
   }
 
-  frame_inputs.reserve(inputs_count);
-  for (int i = 0; i < inputs_count; i++) {
-    input::FrameInput frame_input = inputs[i];
-    frame_inputs.push_back(frame_input);
-  }
-
   if (!frame_inputs.empty())
   {
     // If we did not receive the inputs before the frame to confirm, add them.
@@ -237,7 +226,7 @@ void OnlineGameManager::OnFrameConfirmationReceived(
     }
   }
 
-  const int check_sum = rollback_manager_.ConfirmFrame();
+  const Checksum check_sum = rollback_manager_.ConfirmFrame();
 
   if (check_sum != checksum) {
     std::cerr << "Not same checksum for frame: "
@@ -252,5 +241,4 @@ void OnlineGameManager::OnFrameConfirmationReceived(
                                  ExitGames::Common::Hashtable());
 
   frame_inputs_.erase(frame_inputs_.begin());
-  ExitGames::Common::MemoryManagement::deallocateArray(inputs);
 }
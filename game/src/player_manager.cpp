@@ -29,6 +29,7 @@ void PlayerManager::Init() noexcept {
                     game_constants::kPlayerMainColLength * 0.5f);
     collider.SetShape(Math::CircleF(Math::Vec2F::Zero(), half_size.X));
     collider.SetRestitution(0.3f);
+    collider.SetCategoryBits(game_constants::kPlayerCategory);
 
     players_[i].main_col_ref = main_col_ref;
   }
@@ -75,6 +76,19 @@ void PlayerManager::FixedUpdate() noexcept {
           world_->GetCollider(player.main_col_ref).GetBodyRef());
 
       const auto proj_pos = body.Position() + player.dir_to_mouse * 0.75f;
+
+      // Do not spawn the projectile in a wall or on the other side of it.
+      const PhysicsEngine::QueryFilter wall_filter{
+          game_constants::kBorderWallCategory |
+          game_constants::kSquareWallCategory};
+      const auto wall_hit = world_->CircleCast(
+          Math::CircleF(body.Position(), ProjectileManager::kProjectileRadius),
+          proj_pos - body.Position(), wall_filter);
+
+      if (wall_hit.Hit) {
+        continue;
+      }
+
       projectile_manager_->CreateProjectile(proj_pos, player.dir_to_mouse);
 
       player.shoot_timer = kShootCooldown;
@@ -127,48 +141,27 @@ void PlayerManager::Rollback(const PlayerManager& player_manager) noexcept {
   players_ = player_manager.players_;
 }
 
-// Function to compute checksum for the players state.
-Checksum PlayerManager::ComputeChecksum() const noexcept {
-  Checksum checksum = 0;
+void PlayerManager::Rollback(
+    const std::array<Player, game_constants::kMaxPlayerCount>& players) noexcept {
+  players_ = players;
+}
 
+void PlayerManager::HashState(XxHash64& hash) const noexcept {
+  // The bodies of the players are hashed with the world, the fields are
+  // hashed one by one to skip the padding of the struct.
   for (const auto& player : players_) {
-    const auto& body_ref = world_->GetCollider(player.main_col_ref).GetBodyRef();
-    const auto& body = world_->GetBody(body_ref);
-
-    const auto& pos = body.Position();
-    const auto* pos_ptr = reinterpret_cast<const Checksum*>(&pos);
-
-    // Add position
-    for (size_t i = 0; i < sizeof(Math::Vec2F) / sizeof(Checksum); i++) {
-      checksum += pos_ptr[i];
-    }
-
-    // Add velocity
-    const auto& velocity = body.Velocity();
-    const auto* velocity_ptr = reinterpret_cast<const Checksum*>(&velocity);
-    for (size_t i = 0; i < sizeof(Math::Vec2F) / sizeof(Checksum); i++) {
-      checksum += velocity_ptr[i];
-    }
-
-    // Add input.
-    checksum += player.input;
-
-    // Add shoot_timer.
-    const auto* shoot_timer_ptr = reinterpret_cast<const Checksum*>(&player.shoot_timer);
-    checksum += *shoot_timer_ptr;
-
-    // Add hp.
-    checksum += player.hp;
-
-    // Add damage_timer.
-    const auto* damage_timer_ptr = reinterpret_cast<const Checksum*>(&player.damage_timer);
-    checksum += *damage_timer_ptr;
+    hash.UpdateValue(player.main_col_ref);
+    hash.UpdateValue(player.jump_col_ref);
+    hash.UpdateValue(player.dir_to_mouse);
+    hash.UpdateValue(player.shoot_timer);
+    hash.UpdateValue(player.damage_timer);
+    hash.UpdateValue(player.spin_timer);
+    hash.UpdateValue(player.hp);
+    hash.UpdateValue(player.input);
   }
-
-  return checksum;
 }
 
-void PlayerManager::SetPlayerInput(const input::FrameInput& input, PlayerId player_id) {
+void PlayerManager::SetPlayerInput(const input::FrameInputRecord& input, PlayerId player_id) {
   players_[player_id].input = input.input();
   players_[player_id].dir_to_mouse = input.dir_to_mouse();
 }
@@ -214,7 +207,7 @@ Math::Vec2F PlayerManager::GetJumpColliderPosition(
 
 Math::CircleF PlayerManager::GetJumpColliderShape(std::size_t idx) const noexcept {
    const auto& col = world_->GetCollider(players_[idx].jump_col_ref);
-   return std::get<Math::CircleF>(col.Shape());
+   return col.Circle();
 }
 
 bool PlayerManager::IsPlayerWalking(std::size_t idx) const noexcept {
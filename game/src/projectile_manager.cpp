@@ -5,7 +5,7 @@
 #include <iostream>
 #include <algorithm>
 
-void ProjectileManager::Init(PhysicsEngine::World* world) noexcept {
+void ProjectileManager::Init(GameWorld* world) noexcept {
   world_ = world;
 
   for (std::size_t i = 0; i < kMaxProjectileCount; i++)
@@ -19,6 +19,8 @@ void ProjectileManager::Init(PhysicsEngine::World* world) noexcept {
     auto& collider = world_->GetCollider(projectiles_[i].collider_ref);
     collider.SetShape(Math::CircleF(Math::Vec2F::Zero(), kProjectileRadius));
     collider.SetRestitution(1.f);
+    collider.SetIsBullet(true);
+    collider.SetCategoryBits(game_constants::kProjectileCategory);
     collider.SetEnabled(false);
   }
 }
@@ -88,43 +90,23 @@ void ProjectileManager::OnCollisionEnter(
   }
 }
 
-Checksum ProjectileManager::ComputeChecksum() const noexcept {
-  Checksum checksum = 0;
-
+void ProjectileManager::HashState(XxHash64& hash) const noexcept {
+  // The bodies and the colliders of the projectiles are hashed with the world.
   for (const auto& proj : projectiles_) {
-    const auto& body_ref = world_->GetCollider(proj.collider_ref).GetBodyRef();
-    const auto& body = world_->GetBody(body_ref);
-
-    // Add position.
-    const auto& pos = body.Position();
-    const auto* pos_ptr = reinterpret_cast<const Checksum*>(&pos);
-    for (size_t i = 0; i < sizeof(Math::Vec2F) / sizeof(Checksum); i++) {
-      checksum += pos_ptr[i];
-    }
-
-    // Add velocity.
-    const auto& velocity = body.Velocity();
-    const auto* velocity_ptr = reinterpret_cast<const Checksum*>(&velocity);
-    for (size_t i = 0; i < sizeof(Math::Vec2F) / sizeof(Checksum); i++) {
-      checksum += velocity_ptr[i];
-    }
-
-    // Add collision count.
-    checksum += proj.collision_count;
-
-    // Add is enabled.
-    const auto& collider = world_->GetCollider(proj.collider_ref);
-    const auto& is_enabled = collider.Enabled();
-    checksum += is_enabled ? 1 : 0;
+    hash.UpdateValue(proj.collider_ref);
+    hash.UpdateValue(proj.collision_count);
   }
-
-  return checksum;
 }
 
 void ProjectileManager::Rollback(const ProjectileManager& projectile_manager) noexcept {
   projectiles_ = projectile_manager.projectiles_;
 }
 
+void ProjectileManager::Rollback(
+    const std::array<Projectile, kMaxProjectileCount>& projectiles) noexcept {
+  projectiles_ = projectiles;
+}
+
 Math::Vec2F ProjectileManager::GetProjectilePosition(std::size_t idx) const noexcept {
   const auto& body_ref =
       world_->GetCollider(projectiles_[idx].collider_ref).GetBodyRef();
@@ -145,5 +127,5 @@ Math::Vec2F ProjectileManager::GetProjectileVelocity(
 Math::CircleF ProjectileManager::GetProjectileCircle(std::size_t idx) const noexcept {
   const auto& collider = world_->GetCollider(projectiles_[idx].collider_ref);
 
-  return std::get<Math::CircleF>(collider.Shape());
+  return collider.Circle();
 }
\ No newline at end of file
@@ -1,29 +1,38 @@
 #include "rollback_manager.h"
 #include "local_game_manager.h"
 
+#include <iostream>
+
 void RollbackManager::Deinit() noexcept {
   current_frame_ = -1;
+  is_current_frame_simulated_ = false;
   frame_to_confirm_ = 0;
   confirmed_frame_ = -1;
   last_remote_input_frame_ = -1;
+  first_mispredicted_frame_ = -1;
+  rollback_count_ = 0;
+  avoided_rollback_count_ = 0;
+  resimulated_frame_count_ = 0;
   confirmed_game_manager_.Deinit();
 
-  for (auto& inputs_vec : inputs_)
+  for (auto& player_inputs : inputs_)
   {
-    inputs_vec.clear();
+    player_inputs.Clear();
   }
 
-  last_inputs_.fill(input::FrameInput());
+  snapshots_.clear();
+
+  last_inputs_.fill(input::FrameInputRecord());
 }
 
-void RollbackManager::SetLocalPlayerInput(const input::FrameInput& local_input,
+void RollbackManager::SetLocalPlayerInput(const input::FrameInputRecord& local_input,
                                           PlayerId player_id) noexcept {
-  inputs_[player_id][local_input.frame_nbr()] = local_input;
+  record_input(player_id, local_input.frame_nbr(), local_input);
   last_inputs_[player_id] = local_input;
 }
 
 void RollbackManager::SetRemotePlayerInput(
-    const std::vector<input::FrameInput>& new_remote_inputs, PlayerId player_id) {
+    const std::vector<input::FrameInputRecord>& new_remote_inputs, PlayerId player_id) {
   // Retrieve the last new remote frame input.
   auto last_new_remote_input = new_remote_inputs.back();
 
@@ -41,7 +50,7 @@ void RollbackManager::SetRemotePlayerInput(
   if (last_new_remote_input.frame_nbr() > current_frame_) {
     const auto& current_frame_it =
         std::find_if(new_remote_inputs.begin(), new_remote_inputs.end(),
-                     [this](const input::FrameInput& frame_input) {
+                     [this](const input::FrameInputRecord& frame_input) {
                        return frame_input.frame_nbr() == current_frame_;
                      });
     last_new_remote_input = *current_frame_it;
@@ -50,25 +59,30 @@ void RollbackManager::SetRemotePlayerInput(
   // Find the position of the first missing input
   auto missing_input_it = std::find_if(
       new_remote_inputs.begin(), new_remote_inputs.end(),
-      [this](const input::FrameInput& frame_input) {
+      [this](const input::FrameInputRecord& frame_input) {
         return frame_input.frame_nbr() == last_remote_input_frame_ + 1;
       });
 
-  bool must_rollback = false;
+  // The first simulated frame whose received input is not the one predicted.
+  FrameNbr first_mispredicted_frame = -1;
+  bool has_predicted_frame = false;
 
   // Iterate over the missing inputs and update the inputs array
   for (FrameNbr frame = last_remote_input_frame_ + 1;
        frame <= last_new_remote_input.frame_nbr(); frame++) {
-    // Get the input for the current frame
-    const auto input = missing_input_it->input();
-
-    // Check if rollback is necessary
-    if (last_remote_input_frame_ > -1 && input != last_inputs_[player_id].input()) {
-      must_rollback = true;
+    // Check if rollback is necessary, only the simulated frames used a
+    // prediction.
+    if (frame <= last_simulated_frame()) {
+      has_predicted_frame = true;
+
+      if (first_mispredicted_frame == -1 &&
+          !missing_input_it->IsSameInput(recorded_input(player_id, frame))) {
+        first_mispredicted_frame = frame;
+      }
     }
 
     // Update the inputs array
-    inputs_[player_id][frame] = *missing_input_it;
+    record_input(player_id, frame, *missing_input_it);
 
     // Move to the next missing input
     ++missing_input_it;
@@ -77,12 +91,17 @@ void RollbackManager::SetRemotePlayerInput(
   // Predict inputs for frames up to the current frame with the last remote input.
   for (FrameNbr frame = last_new_remote_input.frame_nbr();
        frame <= current_frame_; frame++) {
-    inputs_[player_id][frame] = last_new_remote_input;
+    record_input(player_id, frame, last_new_remote_input);
   }
 
   // Rollback if necessary.
-  if (must_rollback) {
-    SimulateUntilCurrentFrame();
+  first_mispredicted_frame_ = first_mispredicted_frame;
+
+  if (first_mispredicted_frame > -1) {
+    rollback_count_++;
+    SimulateUntilCurrentFrame(first_mispredicted_frame);
+  } else if (has_predicted_frame) {
+    avoided_rollback_count_++;
   }
 
   // Update last inputs and last remote input frame.
@@ -90,33 +109,57 @@ void RollbackManager::SetRemotePlayerInput(
   last_remote_input_frame_ = last_new_remote_input.frame_nbr();
 }
 
+void RollbackManager::SaveCurrentFrameSnapshot() noexcept {
+#ifdef TRACY_ENABLE
+  ZoneScoped;
+#endif
+
+  auto& frame_snapshot = snapshot(current_frame_);
+  current_game_manager_->SaveSnapshot(frame_snapshot.state);
+  frame_snapshot.frame_nbr = current_frame_;
+}
 
-void RollbackManager::SimulateUntilCurrentFrame() const noexcept {
+void RollbackManager::SimulateUntilCurrentFrame(FrameNbr first_frame) noexcept {
 #ifdef TRACY_ENABLE
   ZoneScoped;
 #endif
 
-  current_game_manager_->Rollback(confirmed_game_manager_);
+  const auto& first_snapshot = snapshot(first_frame);
+
+  if (first_snapshot.frame_nbr == first_frame) {
+    current_game_manager_->RestoreSnapshot(first_snapshot.state);
+  } else {
+    // The frame left the ring buffer, start again from the confirmed frame.
+    current_game_manager_->Rollback(confirmed_game_manager_);
+    first_frame = static_cast<FrameNbr>(confirmed_frame_ + 1);
+  }
+
+  const auto last_frame = last_simulated_frame();
+  resimulated_frame_count_ += last_frame - first_frame + 1;
+
+  for (FrameNbr frame = first_frame; frame <= last_frame; frame++) {
+    // The snapshots of the simulated frames are replaced by the corrected ones.
+    auto& frame_snapshot = snapshot(frame);
+    current_game_manager_->SaveSnapshot(frame_snapshot.state);
+    frame_snapshot.frame_nbr = frame;
 
-  for (FrameNbr frame = static_cast<FrameNbr>(confirmed_frame_ + 1); 
-      frame < current_frame_; frame++) {
     for (PlayerId player_id = 0; player_id < game_constants::kMaxPlayerCount;
          player_id++) {
-      const auto input = inputs_[player_id][frame];
+      const auto input = recorded_input(player_id, frame);
       current_game_manager_->SetPlayerInput(input, player_id);
     }
 
     current_game_manager_->FixedUpdate();
   }
 
-  // The Fixed update of the current frame is made in the main loop after polling
-  // received events from network.
+  // Unless it is already made, the Fixed update of the current frame is made
+  // in the main loop after polling received events from network.
 }
 
 Checksum RollbackManager::ConfirmFrame() noexcept {
   for (PlayerId player_id = 0; player_id < game_constants::kMaxPlayerCount;
        player_id++) {
-    const auto input = inputs_[player_id][frame_to_confirm_];
+    const auto input = recorded_input(player_id, frame_to_confirm_);
     confirmed_game_manager_.SetPlayerInput(input, player_id);
   }
 
@@ -129,7 +172,34 @@ Checksum RollbackManager::ConfirmFrame() noexcept {
   return checksum;
 }
 
-const input::FrameInput& RollbackManager::GetLastPlayerInput(
-    const PlayerId player_id) const noexcept {
-  return last_inputs_[player_id];
+const input::FrameInputRecord& RollbackManager::PredictCurrentFrameInput(
+    const PlayerId player_id) noexcept {
+  if (current_frame_ > last_remote_input_frame_) {
+    record_input(player_id, current_frame_, last_inputs_[player_id]);
+  }
+
+  return recorded_input(player_id, current_frame_);
+}
+
+void RollbackManager::record_input(const PlayerId player_id,
+                                   const FrameNbr frame,
+                                   const input::FrameInputRecord& input) noexcept {
+  if (frame - frame_to_confirm_ >= game_constants::kInputRingSize) {
+    std::cerr << "Input ring buffer overrun at frame " << frame
+              << ", the frame to confirm is " << frame_to_confirm_ << '\n';
+    return;
+  }
+
+  inputs_[player_id].Set(frame, input);
+}
+
+const input::FrameInputRecord& RollbackManager::recorded_input(
+    const PlayerId player_id, const FrameNbr frame) const noexcept {
+  if (!inputs_[player_id].Contains(frame)) {
+    std::cerr << "Input of player " << static_cast<int>(player_id)
+              << " at frame " << frame << " is not in the ring buffer.\n";
+    return last_inputs_[player_id];
+  }
+
+  return inputs_[player_id][frame];
 }
@@ -21,8 +21,6 @@ void SimulationApp::Setup() noexcept {
 
   mock_networks_[0].RegisterOtherClientNetwork(&mock_networks_[1]);
   mock_networks_[1].RegisterOtherClientNetwork(&mock_networks_[0]);
-
- input::FrameInput::registerType();
 }
 
 void SimulationApp::Update() noexcept {
@@ -85,6 +83,4 @@ void SimulationApp::TearDown() noexcept {
   for (const auto& render_target : render_targets_) {
     raylib::UnloadRenderTexture(render_target);
   }
-
-  input::FrameInput::unregisterType();
 }
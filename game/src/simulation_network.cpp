@@ -1,4 +1,5 @@
 #include "simulation_network.h"
+#include "network_input.h"
 
 #include "Random.h"
 
@@ -18,17 +19,6 @@ void SimulationNetwork::RaiseEvent(
     return;
   }
 
-  const auto input_value =
-      event_data.getValue(static_cast<nByte>(NetworkEventKey::kPlayerInput));
-
-  const input::FrameInput* inputs =
-      ExitGames::Common::ValueObject<input::FrameInput*>(input_value)
-          .getDataCopy();
-
-  const int inputs_count =
-      *ExitGames::Common::ValueObject<input::FrameInput*>(input_value)
-           .getSizes();
-
   ExitGames::Common::Hashtable simulated_event = event_data;
   const auto delay =
       reliable ? 0.08f
@@ -48,21 +38,8 @@ void SimulationNetwork::ReceiveEvent(
     case NetworkEventCode::kInput: {
       SimulationInput simulation_input{};
 
-      const auto input_value = event_content.getValue(
-          static_cast<nByte>(NetworkEventKey::kPlayerInput));
-
-      const input::FrameInput* inputs =
-          ExitGames::Common::ValueObject<input::FrameInput*>(input_value)
-              .getDataCopy();
-
-      const int inputs_count =
-          *ExitGames::Common::ValueObject<input::FrameInput*>(input_value)
-               .getSizes();
-
-      for (int i = 0; i < inputs_count; i++) {
-        input::FrameInput frame_input{inputs[i]};
-        simulation_input.frame_inputs.push_back(frame_input);
-      }
+      network_input::GetFrameInputs(event_content,
+                                    simulation_input.frame_inputs);
 
       const auto delay_value =
           event_content.getValue(static_cast<nByte>(NetworkEventKey::kDelay));
@@ -71,8 +48,6 @@ void SimulationNetwork::ReceiveEvent(
 
       waiting_input_queue_.push_back(simulation_input);
 
-      ExitGames::Common::MemoryManagement::deallocateArray(inputs);
-
       break;
     }
     case NetworkEventCode::kFrameConfirmation: {
@@ -81,22 +56,10 @@ void SimulationNetwork::ReceiveEvent(
       const auto check_sum_value = event_content.getValue(
           static_cast<nByte>(NetworkEventKey::kCheckSum));
       frame_to_confirm.check_sum =
-          ExitGames::Common::ValueObject<int>(check_sum_value).getDataCopy();
-
-      const auto input_value = event_content.getValue(
-          static_cast<nByte>(NetworkEventKey::kPlayerInput));
-
-      const input::FrameInput* inputs =
-          ExitGames::Common::ValueObject<input::FrameInput*>(input_value)
-              .getDataCopy();
+          ExitGames::Common::ValueObject<Checksum>(check_sum_value).getDataCopy();
 
-      const int inputs_count =
-          *ExitGames::Common::ValueObject<input::FrameInput*>(input_value)
-               .getSizes();
-
-      for (int i = 0; i < inputs_count; i++) {
-        frame_to_confirm.frame_inputs.push_back(inputs[i]);
-      }
+      network_input::GetFrameInputs(event_content,
+                                    frame_to_confirm.frame_inputs);
 
       const auto delay_value =
           event_content.getValue(static_cast<nByte>(NetworkEventKey::kDelay));
@@ -104,8 +67,6 @@ void SimulationNetwork::ReceiveEvent(
           ExitGames::Common::ValueObject<float>(delay_value).getDataCopy();
 
       waiting_frame_queue_.push_back(frame_to_confirm);
-
-      ExitGames::Common::MemoryManagement::deallocateArray(inputs);
       break;
     }
   }
@@ -118,9 +79,7 @@ void SimulationNetwork::PollInputPackets() {
 
     if (it->delay <= 0.f) {
       ExitGames::Common::Hashtable event_data;
-      event_data.put(static_cast<nByte>(NetworkEventKey::kPlayerInput),
-                     it->frame_inputs.data(),
-                     static_cast<int>(it->frame_inputs.size()));
+      network_input::PutFrameInputs(event_data, it->frame_inputs);
 
       NetworkEvent network_event{NetworkEventCode::kInput, event_data};
       client_->OnNetworkEventReceived(network_event);
@@ -141,9 +100,7 @@ void SimulationNetwork::PollConfirmFramePackets() {
       ExitGames::Common::Hashtable event_data;
       event_data.put(static_cast<nByte>(NetworkEventKey::kCheckSum),
                      frame_it->check_sum);
-      event_data.put(static_cast<nByte>(NetworkEventKey::kPlayerInput),
-                     frame_it->frame_inputs.data(),
-                     static_cast<int>(frame_it->frame_inputs.size()));
+      network_input::PutFrameInputs(event_data, frame_it->frame_inputs);
 
       NetworkEvent network_event{NetworkEventCode::kFrameConfirmation,
                                  event_data};
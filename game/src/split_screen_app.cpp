@@ -14,8 +14,6 @@ void SplitScreenApp::Setup() noexcept {
     render_targets_[i] =
         raylib::LoadRenderTexture(texture_size.X, texture_size.Y);
   }
-
-  input::FrameInput::registerType();
 }
 
 void SplitScreenApp::Update() noexcept {
@@ -68,6 +66,4 @@ void SplitScreenApp::TearDown() noexcept {
   for (const auto& render_target : render_targets_) {
     raylib::UnloadRenderTexture(render_target);
   }
-
-  input::FrameInput::unregisterType();
 }
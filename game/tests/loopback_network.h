@@ -0,0 +1,37 @@
+#pragma once
+
+#include "online_game_manager.h"
+#include "network_interface.h"
+
+/**
+ * \brief LoopbackNetwork is a network interface which delivers the raised
+ * events directly to the event queue of another game manager. It can lose the
+ * next input event to simulate an unreliable packet which never arrives.
+ */
+class LoopbackNetwork final : public NetworkInterface {
+public:
+  explicit LoopbackNetwork(OnlineGameManager& receiver) noexcept
+      : receiver_(receiver) {}
+
+  void JoinRandomOrCreateRoom() noexcept override {}
+  void LeaveRoom() noexcept override {}
+
+  void RaiseEvent(bool reliable, NetworkEventCode event_code,
+                  const ExitGames::Common::Hashtable& event_data) noexcept override {
+    if (!reliable && event_code == NetworkEventCode::kInput && drop_next_input_) {
+      drop_next_input_ = false;
+      return;
+    }
+
+    receiver_.PushNetworkEvent(NetworkEvent{event_code, event_data});
+  }
+
+  void ReceiveEvent(int, NetworkEventCode,
+                    const ExitGames::Common::Hashtable&) noexcept override {}
+
+  void DropNextInput() noexcept { drop_next_input_ = true; }
+
+private:
+  OnlineGameManager& receiver_;
+  bool drop_next_input_ = false;
+};
@@ -0,0 +1,78 @@
+#include "online_game_manager.h"
+#include "loopback_network.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+TEST(OnlineGameManager, RecoversFromAnInputLostAtTheRingLimit) {
+  OnlineGameManager master;
+  OnlineGameManager client;
+  LoopbackNetwork to_client(client);
+  LoopbackNetwork to_master(master);
+
+  master.RegisterNetworkInterface(&to_client);
+  client.RegisterNetworkInterface(&to_master);
+  master.SetPlayerId(0);
+  client.SetPlayerId(1);
+  master.Init(game_constants::kLocalPlayer1InputId);
+  client.Init(game_constants::kLocalPlayer2InputId);
+
+  // The client plays first so that the master confirms each of its frames.
+  for (int i = 0; i < 5; i++) {
+    client.FixedUpdateCurrentFrame();
+    master.FixedUpdateCurrentFrame();
+  }
+
+  // The master is paused, the client runs alone until its input ring is full.
+  while (client.rollback_manager().CanIncreaseCurrentFrame()) {
+    client.FixedUpdateCurrentFrame();
+  }
+
+  // The master confirms one frame, which lets the client go one frame further
+  // once it received the confirmation, but the input event of this frame is
+  // lost.
+  master.FixedUpdateCurrentFrame();
+  client.FixedUpdateCurrentFrame();
+  ASSERT_TRUE(client.rollback_manager().CanIncreaseCurrentFrame());
+
+  const auto stalled_frame = client.rollback_manager().current_frame() + 1;
+  to_master.DropNextInput();
+  client.FixedUpdateCurrentFrame();
+
+  ASSERT_EQ(client.rollback_manager().current_frame(), stalled_frame);
+  ASSERT_FALSE(client.rollback_manager().CanIncreaseCurrentFrame());
+
+  // The master catches up with the stalled client while its aim changes at
+  // each frame, so the client mispredicted the inputs of the master up to its
+  // current frame included.
+  for (int i = 0; master.rollback_manager().current_frame() < stalled_frame; i++) {
+    ASSERT_TRUE(master.rollback_manager().CanIncreaseCurrentFrame());
+
+    const auto angle = 0.3f * static_cast<float>(i);
+    input::mouse_pos[0] = Math::Vec2F(100.f * std::cos(angle), 100.f * std::sin(angle));
+    master.FixedUpdateCurrentFrame();
+  }
+
+  // The stalled client corrects its simulated frames, the current one too.
+  client.FixedUpdateCurrentFrame();
+
+  ASSERT_EQ(client.rollback_manager().current_frame(), stalled_frame);
+  EXPECT_EQ(client.rollback_manager().first_mispredicted_frame(), stalled_frame);
+  EXPECT_EQ(client.ComputeChecksum(), master.ComputeChecksum());
+
+  for (int i = 0; i < 2 * game_constants::kInputRingSize; i++) {
+    master.FixedUpdateCurrentFrame();
+    client.FixedUpdateCurrentFrame();
+  }
+
+  EXPECT_GT(master.rollback_manager().confirmed_frame(), stalled_frame);
+  EXPECT_GT(client.rollback_manager().confirmed_frame(), stalled_frame);
+  EXPECT_GT(client.rollback_manager().current_frame(),
+            stalled_frame + game_constants::kInputRingSize);
+
+  // Both games play the same frame with the same inputs.
+  ASSERT_EQ(client.rollback_manager().current_frame(),
+            master.rollback_manager().current_frame());
+  EXPECT_EQ(client.ComputeChecksum(), master.ComputeChecksum());
+}
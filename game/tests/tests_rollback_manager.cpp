@@ -0,0 +1,117 @@
+#include "online_game_manager.h"
+#include "loopback_network.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+/**
+ * \brief LoopbackGames is a struct which stores a master and a client
+ * connected by loopback networks. They play a few frames together, the client
+ * first so that the master confirms each of its frames.
+ */
+struct LoopbackGames {
+  OnlineGameManager master;
+  OnlineGameManager client;
+  LoopbackNetwork to_client{client};
+  LoopbackNetwork to_master{master};
+
+  LoopbackGames() noexcept {
+    input::mouse_pos.fill(Math::Vec2F::Zero());
+
+    master.RegisterNetworkInterface(&to_client);
+    client.RegisterNetworkInterface(&to_master);
+    master.SetPlayerId(0);
+    client.SetPlayerId(1);
+    master.Init(game_constants::kLocalPlayer1InputId);
+    client.Init(game_constants::kLocalPlayer2InputId);
+
+    for (int i = 0; i < 5; i++) {
+      client.FixedUpdateCurrentFrame();
+      master.FixedUpdateCurrentFrame();
+    }
+  }
+
+  /**
+   * \brief SetMasterAim is a method which moves the mouse of the master, so
+   * that the aim of its next inputs is not the one predicted by the client.
+   */
+  static void SetMasterAim(Math::Vec2F target) noexcept {
+    input::mouse_pos[0] = target;
+  }
+};
+}  // namespace
+
+TEST(RollbackManager, CorrectPredictionAvoidsTheRollback) {
+  LoopbackGames games;
+  const auto& rollback_manager = games.client.rollback_manager();
+
+  // The client predicts the inputs of the paused master.
+  for (int i = 0; i < 5; i++) {
+    games.client.FixedUpdateCurrentFrame();
+  }
+
+  const auto rollback_count = rollback_manager.rollback_count();
+  const auto avoided_rollback_count = rollback_manager.avoided_rollback_count();
+  const auto resimulated_frame_count = rollback_manager.resimulated_frame_count();
+
+  // The master plays the same input, the simulated frame was right.
+  games.master.FixedUpdateCurrentFrame();
+  games.client.FixedUpdateCurrentFrame();
+
+  EXPECT_EQ(rollback_manager.last_remote_input_frame(),
+            games.master.rollback_manager().current_frame());
+  EXPECT_EQ(rollback_manager.first_mispredicted_frame(), -1);
+  EXPECT_EQ(rollback_manager.avoided_rollback_count(), avoided_rollback_count + 1);
+  EXPECT_EQ(rollback_manager.rollback_count(), rollback_count);
+  EXPECT_EQ(rollback_manager.resimulated_frame_count(), resimulated_frame_count);
+}
+
+TEST(RollbackManager, LateDivergentInputResimulatesFromItsFrame) {
+  LoopbackGames games;
+  const auto& rollback_manager = games.client.rollback_manager();
+
+  // The client predicts the inputs of the paused master.
+  for (int i = 0; i < 10; i++) {
+    games.client.FixedUpdateCurrentFrame();
+  }
+
+  const auto last_simulated_frame = rollback_manager.current_frame();
+  const auto rollback_count = rollback_manager.rollback_count();
+  const auto resimulated_frame_count = rollback_manager.resimulated_frame_count();
+
+  // The master changes its aim at its fourth frame, only the input event of
+  // its fifth frame arrives and it brings all of its inputs late.
+  FrameNbr first_changed_frame = -1;
+
+  for (int i = 0; i < 5; i++) {
+    if (i == 3) {
+      games.SetMasterAim(Math::Vec2F(100.f, 100.f));
+      first_changed_frame = games.master.rollback_manager().current_frame() + 1;
+    }
+
+    if (i < 4) {
+      games.to_client.DropNextInput();
+    }
+
+    games.master.FixedUpdateCurrentFrame();
+  }
+
+  games.client.FixedUpdateCurrentFrame();
+
+  // The confirmed frame is before the mispredicted one, the rollback starts
+  // from the snapshot of the mispredicted frame instead.
+  ASSERT_LT(rollback_manager.confirmed_frame() + 1, first_changed_frame);
+  EXPECT_EQ(rollback_manager.first_mispredicted_frame(), first_changed_frame);
+  EXPECT_EQ(rollback_manager.rollback_count(), rollback_count + 1);
+  EXPECT_EQ(rollback_manager.resimulated_frame_count(),
+            resimulated_frame_count + last_simulated_frame - first_changed_frame + 1);
+
+  // The client simulated its frames again with the inputs played by the
+  // master, both games are the same once the master reaches the client.
+  while (games.master.rollback_manager().current_frame() <
+         rollback_manager.current_frame()) {
+    games.master.FixedUpdateCurrentFrame();
+  }
+
+  EXPECT_EQ(games.client.ComputeChecksum(), games.master.ComputeChecksum());
+}
@@ -191,6 +191,11 @@ namespace Math
         {
             return _scalars[index];
         }
+
+        [[nodiscard]] NOALIAS const std::array<T, N>& Scalars() const noexcept
+        {
+            return _scalars;
+        }
     };
 
     using FourScalarF = NScalar<float, 4>;
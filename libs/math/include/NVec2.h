@@ -37,6 +37,8 @@ namespace Math
             }
         }
 
+        constexpr NVec2(const std::array<T, N> xs, const std::array<T, N> ys) noexcept : _x(xs), _y(ys) {}
+
     private:
         std::array<T, N> _x = std::array<T, N>();
         std::array<T, N> _y = std::array<T, N>();
@@ -410,6 +412,24 @@ namespace Math
         return *this;
     }
 
+    template<>
+    [[nodiscard]] NOALIAS inline FourVec2F FourVec2F::operator*(const std::array<float, 4> array1N) const noexcept
+    {
+        FourVec2F result = FourVec2F();
+
+        __m128 x1 = _mm_loadu_ps(_x.data());
+        __m128 y1 = _mm_loadu_ps(_y.data());
+        __m128 scalars = _mm_loadu_ps(array1N.data());
+
+        __m128 x1s = _mm_mul_ps(x1, scalars);
+        __m128 y1s = _mm_mul_ps(y1, scalars);
+
+        _mm_storeu_ps(result._x.data(), x1s);
+        _mm_storeu_ps(result._y.data(), y1s);
+
+        return result;
+    }
+
     template<>
     [[nodiscard]] inline FourVec2F FourVec2F::operator/(const FourVec2F& nVec2) const
     {
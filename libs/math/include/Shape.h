@@ -2,6 +2,7 @@
 
 #include "Vec2.h"
 
+#include <utility>
 #include <vector>
 
 namespace Math
@@ -122,6 +123,31 @@ namespace Math
     using RectangleF = Rectangle<float>;
     using RectangleI = Rectangle<int>;
 
+    /**
+     * @brief PolygonView is a non-owning view on the vertices of a polygon, used to test polygons whose
+     * vertices are stored elsewhere (in a fixed size array for example) without copying them.
+     */
+    template <typename T>
+    class PolygonView
+    {
+    public:
+        constexpr PolygonView(const Vec2<T>* vertices, int verticesCount) noexcept :
+            _vertices(vertices), _verticesCount(verticesCount) {}
+
+    private:
+        const Vec2<T>* _vertices = nullptr;
+        int _verticesCount = 0;
+
+    public:
+        [[nodiscard]] constexpr int VerticesCount() const noexcept { return _verticesCount; }
+        [[nodiscard]] constexpr const Vec2<T>& operator[](int index) const noexcept { return _vertices[index]; }
+
+        [[nodiscard]] constexpr const Vec2<T>* begin() const noexcept { return _vertices; }
+        [[nodiscard]] constexpr const Vec2<T>* end() const noexcept { return _vertices + _verticesCount; }
+    };
+
+    using PolygonViewF = PolygonView<float>;
+
     template <typename T>
     class Polygon
     {
@@ -130,16 +156,21 @@ namespace Math
          * @brief Construct a new Polygon object
          * @param vertices the vertices of the polygon
          */
-        constexpr explicit Polygon(std::vector<Vec2<T>> vertices) noexcept : _vertices(vertices) {}
+        constexpr explicit Polygon(std::vector<Vec2<T>> vertices) noexcept : _vertices(std::move(vertices)) {}
 
     private:
         std::vector<Vec2<T>> _vertices;
 
     public:
-        [[nodiscard]] constexpr std::vector<Vec2<T>> Vertices() const noexcept { return _vertices; }
+        [[nodiscard]] const std::vector<Vec2<T>>& Vertices() const noexcept { return _vertices; }
         [[nodiscard]] constexpr int VerticesCount() const noexcept { return _vertices.size(); }
 
-        void SetVertices(std::vector<Vec2<T>> vertices) noexcept { _vertices = vertices; }
+        void SetVertices(std::vector<Vec2<T>> vertices) noexcept { _vertices = std::move(vertices); }
+
+        [[nodiscard]] PolygonView<T> View() const noexcept
+        {
+            return PolygonView<T>(_vertices.data(), VerticesCount());
+        }
 
         [[nodiscard]] constexpr Vec2<T> Center() const noexcept
         {
@@ -179,7 +210,7 @@ namespace Math
 			    vertex += vec;
 		    }
 
-		    return Polygon<T>(vertices);
+		    return Polygon<T>(std::move(vertices));
 	    }
     };
 
@@ -252,69 +283,56 @@ namespace Math
         return Intersect(rectangle, circle);
     }
 
+    /**
+     * @brief IsSeparatingAxisFound is a function that checks if one of the edge normals of the first polygon
+     * separates the projections of the two polygons.
+     */
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Polygon<T> polygon1, const Polygon<T> polygon2) noexcept
+    [[nodiscard]] constexpr bool IsSeparatingAxisFound(const PolygonView<T> polygon1, const PolygonView<T> polygon2) noexcept
     {
-        // Separate axis theorem
-        // Check if any of the edges of polygon1 is a separating axis
         for (int i = 0, j = polygon1.VerticesCount() - 1; i < polygon1.VerticesCount(); j = i++)
         {
-            const auto edge = polygon1.Vertices()[i] - polygon1.Vertices()[j];
+            const auto edge = polygon1[i] - polygon1[j];
             const auto normal = Vec2<T>(-edge.Y, edge.X);
 
-            const auto startProjection1 = polygon1.Vertices()[0].Dot(normal);
-            const auto startProjection2 = polygon2.Vertices()[0].Dot(normal);
+            const auto startProjection1 = polygon1[0].Dot(normal);
+            const auto startProjection2 = polygon2[0].Dot(normal);
 
             Vec2<T> projection1 = Vec2<T>(startProjection1, startProjection1);
             Vec2<T> projection2 = Vec2<T>(startProjection2, startProjection2);
 
-            for (const auto& vertex : polygon1.Vertices())
+            for (const auto& vertex : polygon1)
             {
                 const auto projection = vertex.Dot(normal);
 
                 projection1 = Vec2<T>(Math::Min(projection1.X, projection), Math::Max(projection1.Y, projection));
             }
 
-            for (const auto& vertex : polygon2.Vertices())
+            for (const auto& vertex : polygon2)
             {
                 const auto projection = vertex.Dot(normal);
 
                 projection2 = Vec2<T>(Math::Min(projection2.X, projection), Math::Max(projection2.Y, projection));
             }
 
-            if (projection1.Y < projection2.X || projection2.Y < projection1.X) return false;
+            if (projection1.Y < projection2.X || projection2.Y < projection1.X) return true;
         }
 
-        // Check if any of the edges of polygon2 is a separating axis
-        for (int i = 0, j = polygon2.VerticesCount() - 1; i < polygon2.VerticesCount(); j = i++)
-        {
-            const auto edge = polygon2.Vertices()[i] - polygon2.Vertices()[j];
-            const auto normal = Vec2<T>(-edge.Y, edge.X);
-
-            const auto startProjection1 = polygon1.Vertices()[0].Dot(normal);
-            const auto startProjection2 = polygon2.Vertices()[0].Dot(normal);
-
-            Vec2<T> projection1 = Vec2<T>(startProjection1, startProjection1);
-            Vec2<T> projection2 = Vec2<T>(startProjection2, startProjection2);
-
-            for (const auto& vertex : polygon1.Vertices())
-            {
-                const auto projection = vertex.Dot(normal);
-
-                projection1 = Vec2<T>(Math::Min(projection1.X, projection), Math::Max(projection1.Y, projection));
-            }
-
-            for (const auto& vertex : polygon2.Vertices())
-            {
-                const auto projection = vertex.Dot(normal);
-
-                projection2 = Vec2<T>(Math::Min(projection2.X, projection), Math::Max(projection2.Y, projection));
-            }
+        return false;
+    }
 
-            if (projection1.Y < projection2.X || projection2.Y < projection1.X) return false;
-        }
+    template <typename T>
+    [[nodiscard]] constexpr bool Intersect(const PolygonView<T> polygon1, const PolygonView<T> polygon2) noexcept
+    {
+        // Separate axis theorem
+        // Check if any of the edges of polygon1 or of polygon2 is a separating axis
+        return !IsSeparatingAxisFound(polygon1, polygon2) && !IsSeparatingAxisFound(polygon2, polygon1);
+    }
 
-        return true;
+    template <typename T>
+    [[nodiscard]] bool Intersect(const Polygon<T>& polygon1, const Polygon<T>& polygon2) noexcept
+    {
+        return Intersect(polygon1.View(), polygon2.View());
     }
 
     template<typename T>
@@ -335,12 +353,12 @@ namespace Math
     }
 
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Polygon<T> polygon, const Circle<T> circle) noexcept
+    [[nodiscard]] constexpr bool Intersect(const PolygonView<T> polygon, const Circle<T> circle) noexcept
     {
         const auto center = circle.Center();
         const auto radius = circle.Radius();
 
-        for (const auto &vertex: polygon.Vertices())
+        for (const auto &vertex: polygon)
         {
             if (circle.Contains(vertex))
             {
@@ -350,8 +368,8 @@ namespace Math
 
         for (int i = 0, j = polygon.VerticesCount() - 1; i < polygon.VerticesCount(); j = i++)
         {
-            const auto p1 = polygon.Vertices()[i];
-            const auto p2 = polygon.Vertices()[j];
+            const auto p1 = polygon[i];
+            const auto p2 = polygon[j];
 
             // Calculate the closest point on the edge to the circle's center.
             Vec2<T> closest = ClosestPointOnSegment(p1, p2, center);
@@ -367,27 +385,51 @@ namespace Math
     }
 
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Circle<T> circle, const Polygon<T> polygon) noexcept
+    [[nodiscard]] constexpr bool Intersect(const Circle<T> circle, const PolygonView<T> polygon) noexcept
     {
         return Intersect(polygon, circle);
     }
 
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Polygon<T> polygon, const Rectangle<T> rectangle) noexcept
+    [[nodiscard]] bool Intersect(const Polygon<T>& polygon, const Circle<T> circle) noexcept
+    {
+        return Intersect(polygon.View(), circle);
+    }
+
+    template <typename T>
+    [[nodiscard]] bool Intersect(const Circle<T> circle, const Polygon<T>& polygon) noexcept
+    {
+        return Intersect(polygon.View(), circle);
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr bool Intersect(const PolygonView<T> polygon, const Rectangle<T> rectangle) noexcept
     {
-        Polygon<T> rectToPolygon = Polygon<T>({
+        const Vec2<T> rectVertices[] = {
             rectangle.MinBound(),
             Vec2<T>(rectangle.MinBound().X, rectangle.MaxBound().Y),
             rectangle.MaxBound(),
             Vec2<T>(rectangle.MaxBound().X, rectangle.MinBound().Y)
-        });
+        };
 
-        return Intersect(polygon, rectToPolygon);
+        return Intersect(polygon, PolygonView<T>(rectVertices, 4));
     }
 
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Rectangle<T> rectangle, const Polygon<T> polygon) noexcept
+    [[nodiscard]] constexpr bool Intersect(const Rectangle<T> rectangle, const PolygonView<T> polygon) noexcept
     {
         return Intersect(polygon, rectangle);
     }
-}
\ No newline at end of file
+
+    template <typename T>
+    [[nodiscard]] bool Intersect(const Polygon<T>& polygon, const Rectangle<T> rectangle) noexcept
+    {
+        return Intersect(polygon.View(), rectangle);
+    }
+
+    template <typename T>
+    [[nodiscard]] bool Intersect(const Rectangle<T> rectangle, const Polygon<T>& polygon) noexcept
+    {
+        return Intersect(polygon.View(), rectangle);
+    }
+}
@@ -0,0 +1,203 @@
+/**
+ * @author Olivier
+ * Compares the broad phase algorithms on a scene looking like the arena: circles of the size of the
+ * players and projectiles spread uniformly and moving a little between two frames. The second argument
+ * of the benchmarks adds the four border walls of the arena as static colliders.
+ */
+
+#include "AabbTree.h"
+#include "QuadTree.h"
+#include "SpatialHashGrid.h"
+#include "SweepAndPrune.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace PhysicsEngine;
+
+static HeapAllocator BenchHeapAllocator;
+
+/**
+ * @brief Scene is a struct that stores the colliders of the benchmark in their simplified shape. The
+ * arena is scaled with the collider count so that the density stays the one of a 100 colliders arena.
+ */
+struct Scene
+{
+    std::vector<Math::Vec2F> Centers;
+    std::vector<Math::Vec2F> Velocities;
+    std::vector<float> Radii;
+    std::vector<Math::RectangleF> Walls;
+    Math::Vec2F ArenaSize;
+
+    explicit Scene(const std::size_t colliderCount, const bool withWalls)
+    {
+        const float scale = std::sqrt(static_cast<float>(colliderCount) / 100.f);
+        ArenaSize = Math::Vec2F(12.8f * scale, 7.2f * scale);
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> xDis(0.f, ArenaSize.X);
+        std::uniform_real_distribution<float> yDis(0.f, ArenaSize.Y);
+        std::uniform_real_distribution<float> velDis(-1.f, 1.f);
+        std::uniform_real_distribution<float> radiusDis(0.125f, 0.26f);
+
+        for (std::size_t i = 0; i < colliderCount; i++)
+        {
+            Centers.emplace_back(xDis(gen), yDis(gen));
+            Velocities.emplace_back(velDis(gen), velDis(gen));
+            Radii.push_back(radiusDis(gen));
+        }
+
+        if (withWalls)
+        {
+            constexpr float thickness = 0.2f;
+
+            Walls.emplace_back(Math::Vec2F(0.f, -thickness), Math::Vec2F(ArenaSize.X, 0.f));
+            Walls.emplace_back(Math::Vec2F(0.f, ArenaSize.Y), Math::Vec2F(ArenaSize.X, ArenaSize.Y + thickness));
+            Walls.emplace_back(Math::Vec2F(-thickness, 0.f), Math::Vec2F(0.f, ArenaSize.Y));
+            Walls.emplace_back(Math::Vec2F(ArenaSize.X, 0.f), Math::Vec2F(ArenaSize.X + thickness, ArenaSize.Y));
+        }
+    }
+
+    /**
+     * @brief Step is a method that moves the colliders during one fixed time step of 20 ms and makes them
+     * bounce on the arena limits.
+     */
+    void Step() noexcept
+    {
+        constexpr float deltaTime = 0.02f;
+
+        for (std::size_t i = 0; i < Centers.size(); i++)
+        {
+            Centers[i] += Velocities[i] * deltaTime;
+
+            if (Centers[i].X < 0.f || Centers[i].X > ArenaSize.X) Velocities[i].X = -Velocities[i].X;
+            if (Centers[i].Y < 0.f || Centers[i].Y > ArenaSize.Y) Velocities[i].Y = -Velocities[i].Y;
+        }
+    }
+
+    /**
+     * @brief ForEachCollider is a method that calls the function with the simplified shape, the reference and
+     * the static state of each collider (the walls come after the moving colliders).
+     */
+    template<typename Func>
+    void ForEachCollider(Func func) const noexcept
+    {
+        for (std::size_t i = 0; i < Centers.size(); i++)
+        {
+            func(Math::RectangleF::FromCenter(Centers[i], Math::Vec2F(Radii[i], Radii[i])), ColliderRef{ i, 0 }, false);
+        }
+
+        for (std::size_t i = 0; i < Walls.size(); i++)
+        {
+            func(Walls[i], ColliderRef{ Centers.size() + i, 0 }, true);
+        }
+    }
+
+    [[nodiscard]] std::size_t ColliderCount() const noexcept { return Centers.size() + Walls.size(); }
+};
+
+static void BM_QuadTree(benchmark::State& state)
+{
+    Scene scene(state.range(0), state.range(1));
+
+    QuadTree quadTree;
+    quadTree.Init(scene.ColliderCount());
+
+    for (auto _ : state)
+    {
+        scene.Step();
+
+        quadTree.Clear();
+        quadTree.SetRootNodeBoundary(Math::RectangleF(Math::Vec2F::Zero(), scene.ArenaSize));
+
+        scene.ForEachCollider([&quadTree](Math::RectangleF rect, ColliderRef colRef, bool)
+        {
+            quadTree.Insert(rect, colRef);
+        });
+
+        quadTree.CalculatePossiblePairs();
+        benchmark::DoNotOptimize(quadTree.PossiblePairs().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_QuadTree)->ArgsProduct({ {100, 1000, 10000}, {0, 1} });
+
+static void BM_SweepAndPrune(benchmark::State& state)
+{
+    Scene scene(state.range(0), state.range(1));
+
+    SweepAndPrune sweepAndPrune{ BenchHeapAllocator };
+    sweepAndPrune.Init(scene.ColliderCount());
+
+    for (auto _ : state)
+    {
+        scene.Step();
+
+        scene.ForEachCollider([&sweepAndPrune](Math::RectangleF rect, ColliderRef colRef, bool)
+        {
+            sweepAndPrune.Insert(rect, colRef);
+        });
+
+        sweepAndPrune.CalculatePossiblePairs();
+        benchmark::DoNotOptimize(sweepAndPrune.PossiblePairs().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SweepAndPrune)->ArgsProduct({ {100, 1000, 10000}, {0, 1} });
+
+static void BM_AabbTree(benchmark::State& state)
+{
+    Scene scene(state.range(0), state.range(1));
+
+    AabbTree aabbTree{ BenchHeapAllocator };
+    aabbTree.Init(scene.ColliderCount());
+
+    for (auto _ : state)
+    {
+        scene.Step();
+
+        scene.ForEachCollider([&aabbTree](Math::RectangleF rect, ColliderRef colRef, bool isStatic)
+        {
+            aabbTree.Insert(rect, colRef, isStatic);
+        });
+
+        aabbTree.CalculatePossiblePairs();
+        benchmark::DoNotOptimize(aabbTree.PossiblePairs().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AabbTree)->ArgsProduct({ {100, 1000, 10000}, {0, 1} });
+
+static void BM_SpatialHashGrid(benchmark::State& state)
+{
+    Scene scene(state.range(0), state.range(1));
+
+    SpatialHashGrid grid{ BenchHeapAllocator };
+    grid.Init(scene.ColliderCount());
+
+    for (auto _ : state)
+    {
+        scene.Step();
+
+        grid.Clear();
+
+        scene.ForEachCollider([&grid](Math::RectangleF rect, ColliderRef colRef, bool)
+        {
+            grid.Insert(rect, colRef);
+        });
+
+        grid.CalculatePossiblePairs();
+        benchmark::DoNotOptimize(grid.PossiblePairs().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpatialHashGrid)->ArgsProduct({ {100, 1000, 10000}, {0, 1} });
+
+BENCHMARK_MAIN();
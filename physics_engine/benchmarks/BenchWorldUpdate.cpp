@@ -0,0 +1,96 @@
+/**
+ * @author Olivier
+ * Measures the integration of the bodies in World::Update, without colliders so that only the
+ * integration is measured. One body out of ten is kinematic and one out of twenty is static.
+ * The second benchmark measures a whole update of a crowd of trigger circles with several thread counts.
+ */
+
+#include "World.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+
+using namespace PhysicsEngine;
+
+/**
+ * @brief NullContactListener is a contact listener that ignores the events, so that only the world is measured.
+ */
+class NullContactListener : public ContactListener
+{
+public:
+    void OnTriggerEnter(ColliderRef, ColliderRef) noexcept override {}
+    void OnTriggerStay(ColliderRef, ColliderRef) noexcept override {}
+    void OnTriggerExit(ColliderRef, ColliderRef) noexcept override {}
+    void OnCollisionEnter(ColliderRef, ColliderRef) noexcept override {}
+    void OnCollisionExit(ColliderRef, ColliderRef) noexcept override {}
+};
+
+static void BM_WorldIntegration(benchmark::State& state)
+{
+    const auto bodyCount = static_cast<int>(state.range(0));
+
+    World world;
+    world.Init(Math::Vec2F(0.f, -9.81f), bodyCount);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(-10.f, 10.f);
+
+    for (int i = 0; i < bodyCount; i++)
+    {
+        auto& body = world.GetBody(world.CreateBody());
+        body = Body(Math::Vec2F(dis(gen), dis(gen)), Math::Vec2F(dis(gen), dis(gen)), 1.f);
+        body.SetDamping(0.5f);
+        body.SetBodyType(i % 10 == 9 ? BodyType::Kinematic : i % 20 == 4 ? BodyType::Static : BodyType::Dynamic);
+    }
+
+    for (auto _ : state)
+    {
+        world.Update(0.02f);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * bodyCount);
+}
+BENCHMARK(BM_WorldIntegration)->Arg(100)->Arg(1000)->Arg(10000);
+
+static void BM_WorldUpdateThreads(benchmark::State& state)
+{
+    const auto bodyCount = static_cast<int>(state.range(0));
+
+    World world;
+    world.Init(Math::Vec2F::Zero(), bodyCount, BroadPhaseType::SpatialHash, static_cast<int>(state.range(1)));
+
+    NullContactListener listener;
+    world.SetContactListener(&listener);
+
+    // The arena is scaled with the body count so that the density stays the one of a 100 bodies arena.
+    const float scale = std::sqrt(static_cast<float>(bodyCount) / 100.f);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> xDis(0.f, 12.8f * scale);
+    std::uniform_real_distribution<float> yDis(0.f, 7.2f * scale);
+    std::uniform_real_distribution<float> velDis(-1.f, 1.f);
+
+    for (int i = 0; i < bodyCount; i++)
+    {
+        const auto bodyRef = world.CreateBody();
+        world.GetBody(bodyRef) = Body(Math::Vec2F(xDis(gen), yDis(gen)), Math::Vec2F(velDis(gen), velDis(gen)), 1.f);
+
+        auto& collider = world.GetCollider(world.CreateCollider(bodyRef));
+        collider.SetIsTrigger(true);
+        collider.SetShape(Math::CircleF(Math::Vec2F::Zero(), 0.26f));
+    }
+
+    for (auto _ : state)
+    {
+        world.Update(0.02f);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * bodyCount);
+}
+BENCHMARK(BM_WorldUpdateThreads)->ArgsProduct({ {1000, 10000}, {1, 2, 4} })->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,297 @@
+/**
+ * @headerfile AabbTree.h
+ * This header file defines the AabbTree class which is a broad phase that stores the colliders in a
+ * dynamic bounding volume hierarchy of axis-aligned bounding boxes.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Collider.h"
+
+#include <array>
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief AabbTree is a class that computes the possible pairs of colliders with a dynamic AABB tree.
+     * Each collider is a leaf of the tree (keyed by its index in the world) whose box is fattened by a
+     * margin, so that the leaf is only removed and re-inserted when the collider leaves its fat box.
+     * The tree is kept balanced with rotations, so large colliders (like the arena walls) do not end up
+     * being tested against every other collider like at the root of a quad-tree.
+     * @note The pairs between two static colliders are never emitted. The pairs are sorted by collider
+     * indices, so they do not depend on the structure of the tree, which depends on its history.
+     */
+    class AabbTree
+    {
+    public:
+        /**
+         * @brief NullNode is the index of a node that does not exist.
+         */
+        static constexpr std::uint32_t NullNode = 0xFFFFFFFF;
+
+    private:
+        /**
+         * @brief TreeNode is a struct that stores a node of the tree. The leaves store a collider and the
+         * internal nodes always have two children. The free nodes are linked with their parent index.
+         */
+        struct TreeNode
+        {
+            Math::Vec2F MinBound = Math::Vec2F::Zero();
+            Math::Vec2F MaxBound = Math::Vec2F::Zero();
+
+            std::uint32_t Parent = NullNode;
+            std::uint32_t Child1 = NullNode;
+            std::uint32_t Child2 = NullNode;
+
+            /**
+             * @brief Height is 0 for a leaf and -1 for a free node.
+             */
+            std::int32_t Height = -1;
+
+            std::uint32_t ProxyIdx = NullNode;
+
+            /**
+             * @brief IsStatic is true if all the leaves of the sub-tree of the node are static colliders.
+             */
+            bool IsStatic = false;
+
+            [[nodiscard]] constexpr bool IsLeaf() const noexcept { return Child1 == NullNode; }
+        };
+
+        /**
+         * @brief Proxy is a struct that stores the tight bounds of a collider inserted in the tree and the
+         * index of its leaf. A stamp of 0 means that the proxy is not used.
+         */
+        struct Proxy
+        {
+            ColliderRef ColRef{0, 0};
+            Math::Vec2F MinBound = Math::Vec2F::Zero();
+            Math::Vec2F MaxBound = Math::Vec2F::Zero();
+            CollisionFilter Filter{};
+            std::uint32_t Leaf = NullNode;
+            std::uint32_t Stamp = 0;
+        };
+
+        /**
+         * @brief NodePair is a struct that stores two nodes whose sub-trees must be tested together.
+         */
+        struct NodePair
+        {
+            std::uint32_t A = NullNode;
+            std::uint32_t B = NullNode;
+        };
+
+        AllocVector<TreeNode> _nodes;
+        AllocVector<Proxy> _proxies;
+        AllocVector<NodePair> _stack;
+        AllocVector<ColliderPair> _possiblePairs;
+
+        std::uint32_t _root = NullNode;
+        std::uint32_t _freeNode = NullNode;
+
+        std::size_t _proxyCount = 0;
+        std::size_t _movedCount = 0;
+        std::size_t _lastMovedCount = 0;
+        std::uint32_t _frame = 1;
+
+        /**
+         * @brief AabbMargin is the margin added around the box of a collider in its leaf. A body has to move
+         * by this distance before its leaf is re-inserted.
+         */
+        static constexpr float _aabbMargin = 0.1f;
+
+        /**
+         * @brief MaxQueryStackSize is the number of nodes the stack of a query can hold.
+         */
+        static constexpr std::size_t _maxQueryStackSize = 128;
+
+        [[nodiscard]] std::uint32_t allocateNode() noexcept;
+        void freeNode(std::uint32_t nodeIdx) noexcept;
+
+        /**
+         * @brief insertLeaf is a method that inserts the leaf in the tree next to the sibling which
+         * increases the least the perimeters of the tree boxes, then re-balances the ancestors of the leaf.
+         * @param leaf The index of the leaf to insert.
+         */
+        void insertLeaf(std::uint32_t leaf) noexcept;
+
+        /**
+         * @brief removeLeaf is a method that removes the leaf from the tree (but does not free it) and
+         * re-balances its former ancestors.
+         * @param leaf The index of the leaf to remove.
+         */
+        void removeLeaf(std::uint32_t leaf) noexcept;
+
+        /**
+         * @brief refitAncestors is a method that balances the node given in parameter and all its ancestors
+         * and recalculates their heights and boxes.
+         * @param nodeIdx The index of the first node to refit.
+         */
+        void refitAncestors(std::uint32_t nodeIdx) noexcept;
+
+        /**
+         * @brief fitNode is a method that recalculates the height, the box and the static flag of the
+         * internal node given in parameter from its children.
+         * @param nodeIdx The index of the node to fit.
+         */
+        void fitNode(std::uint32_t nodeIdx) noexcept;
+
+        /**
+         * @brief replaceChild is a method that replaces a child of the parent node given in parameter by
+         * another node, or replaces the root if there is no parent.
+         * @param parentIdx The index of the parent node or NullNode.
+         * @param oldChild The index of the child to replace.
+         * @param newChild The index of the new child.
+         */
+        void replaceChild(std::uint32_t parentIdx, std::uint32_t oldChild, std::uint32_t newChild) noexcept;
+
+        /**
+         * @brief balance is a method that performs a left or right rotation if the node is imbalanced.
+         * @param nodeIdx The index of the node to balance.
+         * @return The index of the new root of the sub-tree.
+         */
+        [[nodiscard]] std::uint32_t balance(std::uint32_t nodeIdx) noexcept;
+
+        /**
+         * @brief addPair is a method that adds the pair of proxies given in parameter to the possible pairs
+         * if their tight boxes overlap.
+         */
+        void addPair(std::uint32_t proxyIdxA, std::uint32_t proxyIdxB) noexcept;
+
+    public:
+        explicit AabbTree(Allocator& allocator) noexcept :
+            _nodes{ StandardAllocator<TreeNode>{allocator} },
+            _proxies{ StandardAllocator<Proxy>{allocator} },
+            _stack{ StandardAllocator<NodePair>{allocator} },
+            _possiblePairs{ StandardAllocator<ColliderPair>{allocator} } {}
+
+        /**
+         * @brief Init is a method that allocates the memory needed to store the number of colliders given
+         * in parameter.
+         * @param colliderCount The number of colliders to reserve memory for.
+         */
+        void Init(std::size_t colliderCount) noexcept;
+
+        /**
+         * @brief Insert is a method that sets the bounds of the collider (in its simplified shape) for the
+         * current frame. The leaf of the collider is only moved in the tree if the new bounds leave its fat
+         * box. A collider which is not inserted before the next call to CalculatePossiblePairs is removed
+         * from the tree.
+         * @param simplifiedShape The simplified shape of the collider (aka its shape in rectangle).
+         * @param colliderRef The collider reference in the world.
+         * @param isStatic If the collider is attached to a static body.
+         * @param filter The collision filter of the collider, the pairs it should not touch are not emitted.
+         */
+        void Insert(Math::RectangleF simplifiedShape, ColliderRef colliderRef, bool isStatic = false,
+                    CollisionFilter filter = {}) noexcept;
+
+        /**
+         * @brief CalculatePossiblePairs is a method that removes the colliders not inserted in the current
+         * frame and calculates the pairs of colliders whose simplified shapes overlap by colliding the tree
+         * with itself. The pairs are sorted by the index of their first collider, then of their second one.
+         */
+        void CalculatePossiblePairs() noexcept;
+
+        /**
+         * @brief Clear is a method that removes all colliders from the tree but keeps its memory.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief Deinit is a method that removes all colliders from the tree and releases its memory.
+         */
+        void Deinit() noexcept;
+
+        /**
+         * @brief PossiblePairs is a method that gives the possible pairs of collider whose simplified shapes
+         * touch each other.
+         * @return The possible pairs of collider whose simplified shapes touch each other.
+         */
+        [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept { return _possiblePairs; }
+
+        /**
+         * @brief Query is a method that calls the visitor given in parameter with the reference of each collider
+         * whose simplified shape (as inserted in the last frame) overlaps the box.
+         * @note The tree is not modified, so several threads can query it at once.
+         * @param bounds The box to look for colliders in.
+         * @param visitor The function called with the collider reference of each collider found.
+         */
+        template<typename Visitor>
+        void Query(const Math::RectangleF bounds, Visitor&& visitor) const noexcept
+        {
+            if (_root == NullNode) return;
+
+            const auto minBound = bounds.MinBound();
+            const auto maxBound = bounds.MaxBound();
+
+            // The tree is balanced, so its height is logarithmic and the stack never holds more than two
+            // nodes per level.
+            std::array<std::uint32_t, _maxQueryStackSize> stack{};
+            std::size_t stackSize = 0;
+
+            stack[stackSize++] = _root;
+
+            while (stackSize > 0)
+            {
+                const auto& node = _nodes[stack[--stackSize]];
+
+                if (node.MaxBound.X < minBound.X || node.MinBound.X > maxBound.X ||
+                    node.MaxBound.Y < minBound.Y || node.MinBound.Y > maxBound.Y)
+                {
+                    continue;
+                }
+
+                if (!node.IsLeaf())
+                {
+                    stack[stackSize++] = node.Child2;
+                    stack[stackSize++] = node.Child1;
+                    continue;
+                }
+
+                // The leaf has the fat box of the proxy, its tight box is tested.
+                const auto& proxy = _proxies[node.ProxyIdx];
+
+                if (proxy.MaxBound.X < minBound.X || proxy.MinBound.X > maxBound.X ||
+                    proxy.MaxBound.Y < minBound.Y || proxy.MinBound.Y > maxBound.Y)
+                {
+                    continue;
+                }
+
+                visitor(proxy.ColRef);
+            }
+        }
+
+        /**
+         * @brief ProxyCount is a method that gives the number of colliders in the tree.
+         * @return The number of colliders in the tree.
+         */
+        [[nodiscard]] std::size_t ProxyCount() const noexcept { return _proxyCount; }
+
+        /**
+         * @brief MovedProxyCount is a method that gives the number of colliders whose leaves were inserted
+         * or re-inserted in the tree during the last frame.
+         * @return The number of colliders inserted or re-inserted in the last frame.
+         */
+        [[nodiscard]] std::size_t MovedProxyCount() const noexcept { return _lastMovedCount; }
+
+        /**
+         * @brief Height is a method that gives the height of the tree (0 if it has a single leaf).
+         * @return The height of the tree or -1 if the tree is empty.
+         */
+        [[nodiscard]] std::int32_t Height() const noexcept
+        {
+            return _root == NullNode ? -1 : _nodes[_root].Height;
+        }
+
+        /**
+         * @brief Validate is a method that checks the structure of the tree: the parent links, the heights,
+         * and that each node box contains the boxes of its children.
+         * @return True if the tree is valid.
+         */
+        [[nodiscard]] bool Validate() const noexcept;
+    };
+}
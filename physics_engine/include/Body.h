@@ -38,7 +38,20 @@ namespace PhysicsEngine
         float _mass = -1.f;
         float _inverseMass = -1.f;
         float _damping = 0.f;
+        float _sleepTime = 0.f;
         BodyType _bodyType = BodyType::Dynamic;
+        bool _isAwake = true;
+
+        /**
+         * @brief wakeUp is a method that wakes the body up if it is sleeping and restarts its sleep timer.
+         */
+        constexpr void wakeUp() noexcept
+        {
+            if (_isAwake) return;
+
+            _isAwake = true;
+            _sleepTime = 0.f;
+        }
 
     public:
         constexpr Body() noexcept = default;
@@ -61,7 +74,11 @@ namespace PhysicsEngine
          * given in parameter.
          * @param newPosition The new position for the body.
          */
-        void constexpr SetPosition(const Math::Vec2F newPosition) noexcept { _position = newPosition; }
+        void constexpr SetPosition(const Math::Vec2F newPosition) noexcept
+        {
+            _position = newPosition;
+            wakeUp();
+        }
 
         /**
          * @brief Velocity is a method that gives the velocity of the body.
@@ -74,7 +91,11 @@ namespace PhysicsEngine
          * given in parameter.
          * @param newVelocity The new velocity for the body.
          */
-        void constexpr SetVelocity(const Math::Vec2F newVelocity) noexcept { _velocity = newVelocity; }
+        void constexpr SetVelocity(const Math::Vec2F newVelocity) noexcept
+        {
+            _velocity = newVelocity;
+            wakeUp();
+        }
 
         /**
          * @brief Mass is a method that gives the mass of the body.
@@ -121,9 +142,14 @@ namespace PhysicsEngine
 
         /**
          * @brief ApplyForce is a method that applies a force to the body and adds it to the sum of the body's forces
+         * @note A sleeping body is woken up.
          * @param force The force to be applied to the body.
          */
-        constexpr void ApplyForce(const Math::Vec2F force) noexcept { _forces += force; }
+        constexpr void ApplyForce(const Math::Vec2F force) noexcept
+        {
+            _forces += force;
+            wakeUp();
+        }
 
         /**
          * @brief Forces is a method that gives the sum of the body's forces.
@@ -139,10 +165,12 @@ namespace PhysicsEngine
         /**
          * @brief ApplyImpulse is a method that applies an impulse to the body and
          * adds it to the sum of the body's impulses.
+         * @note A sleeping body is woken up.
          * @param impulse The impulse to be applied to the body.
          */
         constexpr void ApplyImpulse(const Math::Vec2F impulse) noexcept {
             _impulses += impulse;
+            wakeUp();
         }
 
         /**
@@ -165,6 +193,45 @@ namespace PhysicsEngine
          */
         [[nodiscard]] constexpr bool IsValid() const noexcept { return _mass > 0; }
 
+        /**
+         * @brief IsAwake is a method that checks if the body is awake. A sleeping body is not moved by the world
+         * until something wakes it up (a force, an impulse, a new velocity or position, or a contact with an
+         * awake body).
+         * @return True if the body is awake.
+         */
+        [[nodiscard]] constexpr bool IsAwake() const noexcept { return _isAwake; }
+
+        /**
+         * @brief SetAwake is a method that wakes the body up or puts it to sleep. A body put to sleep loses its
+         * velocity, forces and impulses.
+         * @param isAwake Whether the body is awake or not.
+         */
+        constexpr void SetAwake(const bool isAwake) noexcept
+        {
+            if (isAwake)
+            {
+                wakeUp();
+                return;
+            }
+
+            _isAwake = false;
+            _velocity = Math::Vec2F::Zero();
+            _forces = Math::Vec2F::Zero();
+            _impulses = Math::Vec2F::Zero();
+        }
+
+        /**
+         * @brief SleepTime is a method that gives the time during which the body has been almost at rest.
+         * @return The time during which the body has been almost at rest.
+         */
+        [[nodiscard]] constexpr float SleepTime() const noexcept { return _sleepTime; }
+
+        /**
+         * @brief SetSleepTime is a method that replaces the time during which the body has been almost at rest.
+         * @param sleepTime The new sleep time of the body.
+         */
+        constexpr void SetSleepTime(const float sleepTime) noexcept { _sleepTime = sleepTime; }
+
         /**
          * @brief GetBodyType is a method that gives the body-type of the body.
          * @return The body-type of the body.
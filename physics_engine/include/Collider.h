@@ -7,32 +7,82 @@
 
 #pragma once
 
+#include "CollisionFilter.h"
 #include "WorldRefTypes.h"
 #include "Shape.h"
 
-#include <variant>
+#include <algorithm>
+#include <array>
 #include <utility>
+#include <variant>
+#include <vector>
 
 namespace PhysicsEngine
 {
     /**
      * @brief Collider is a class that represents a generic collider.
+     * @note The shape is stored in the collider itself with a shape type tag: circles and rectangles by
+     * value and polygons in a fixed size vertex array, so a collider never allocates memory and is trivially
+     * copyable (copying the world for a rollback is only a memory copy of the collider array).
      */
     class Collider
     {
+    public:
+        /**
+         * @brief MaxPolygonVertices is the maximum number of vertices of a polygon shape, the next vertices
+         * are ignored.
+         */
+        static constexpr int MaxPolygonVertices = 8;
+
     private:
-        std::variant<Math::CircleF, Math::RectangleF, Math::PolygonF> _shape{
-                     Math::CircleF(Math::Vec2F::Zero(), 0.f)};
+        std::array<Math::Vec2F, MaxPolygonVertices> _polygonVertices{};
+        std::array<Math::Vec2F, MaxPolygonVertices> _polygonNormals{};
+        Math::CircleF _circle{Math::Vec2F::Zero(), 0.f};
+        Math::RectangleF _rectangle{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
+        int _polygonVerticesCount = 0;
+        Math::ShapeType _shapeType = Math::ShapeType::Circle;
+
         BodyRef _bodyRef{};
 
         Math::Vec2F _offset = Math::Vec2F::Zero();
+        CollisionFilter _filter{};
         float _restitution{-1.f};
         float _friction{-1.f};
         bool _isTrigger{false};
+        bool _isBullet{false};
         bool _enabled{false};
         bool _isInitialized{false};
         
 
+        /**
+         * @brief calculatePolygonNormals is a method that calculates the outward normals of the faces of the
+         * polygon shape, using the sign of its area to know its winding.
+         */
+        void calculatePolygonNormals() noexcept
+        {
+            float doubleArea = 0.f;
+
+            for (int i = 0; i < _polygonVerticesCount; i++)
+            {
+                const auto& vertex = _polygonVertices[i];
+                const auto& nextVertex = _polygonVertices[(i + 1) % _polygonVerticesCount];
+
+                doubleArea += vertex.X * nextVertex.Y - nextVertex.X * vertex.Y;
+            }
+
+            const float windingSign = doubleArea < 0.f ? -1.f : 1.f;
+
+            for (int i = 0; i < _polygonVerticesCount; i++)
+            {
+                const auto edge = _polygonVertices[(i + 1) % _polygonVerticesCount] - _polygonVertices[i];
+                const auto length = edge.Length();
+
+                // A degenerated face has no normal, it never separates anything.
+                _polygonNormals[i] = length > Math::Epsilon ?
+                    Math::Vec2F(edge.Y, -edge.X) * (windingSign / length) : Math::Vec2F::Zero();
+            }
+        }
+
     public:
         constexpr Collider() noexcept = default;
         constexpr Collider(float restitution, float friction, bool isTrigger) noexcept
@@ -42,33 +92,108 @@ namespace PhysicsEngine
             _isTrigger = isTrigger;
         }
 
+        /**
+         * @brief GetShapeType is a method that gives the type of the mathematical shape of the collider.
+         * @return The type of the mathematical shape of the collider.
+         */
+        [[nodiscard]] constexpr Math::ShapeType GetShapeType() const noexcept { return _shapeType; }
+
+        /**
+         * @brief Circle is a method that gives the circle shape of the collider.
+         * @note Only meaningful if the shape type of the collider is a circle.
+         * @return The circle shape of the collider.
+         */
+        [[nodiscard]] constexpr const Math::CircleF& Circle() const noexcept { return _circle; }
+
+        /**
+         * @brief Rectangle is a method that gives the rectangle shape of the collider.
+         * @note Only meaningful if the shape type of the collider is a rectangle.
+         * @return The rectangle shape of the collider.
+         */
+        [[nodiscard]] constexpr const Math::RectangleF& Rectangle() const noexcept { return _rectangle; }
+
+        /**
+         * @brief Polygon is a method that gives a view on the vertices of the polygon shape of the collider.
+         * @note Only meaningful if the shape type of the collider is a polygon. The view is invalidated if
+         * the collider is moved or its shape is changed.
+         * @return A view on the vertices of the polygon shape of the collider.
+         */
+        [[nodiscard]] constexpr Math::PolygonViewF Polygon() const noexcept
+        {
+            return { _polygonVertices.data(), _polygonVerticesCount };
+        }
+
+        /**
+         * @brief PolygonNormals is a method that gives the outward unit normals of the faces of the polygon
+         * shape of the collider, calculated once when the shape is set. The normal i is the normal of the face
+         * which goes from the vertex i to the vertex i + 1.
+         * @note Only meaningful if the shape type of the collider is a polygon. The bodies do not rotate, so the
+         * normals are also the normals of the polygon in world space.
+         * @return The normals of the faces of the polygon shape of the collider.
+         */
+        [[nodiscard]] constexpr const std::array<Math::Vec2F, MaxPolygonVertices>& PolygonNormals() const noexcept
+        {
+            return _polygonNormals;
+        }
+
         /**
          * @brief Shape is a method that gives the mathematical shape of the collider.
+         * @note The polygon case allocates its vertices, prefer the typed accessors (see GetShapeType).
          * @return The mathematical shape of the collider.
          */
-        [[nodiscard]] std::variant<Math::CircleF, Math::RectangleF, Math::PolygonF> Shape()
-        const noexcept { return _shape; }
+        [[nodiscard]] std::variant<Math::CircleF, Math::RectangleF, Math::PolygonF> Shape() const noexcept
+        {
+            switch (_shapeType)
+            {
+                case Math::ShapeType::Rectangle:
+                    return _rectangle;
+                case Math::ShapeType::Polygon:
+                    return Math::PolygonF(std::vector<Math::Vec2F>(_polygonVertices.begin(),
+                                                                   _polygonVertices.begin() + _polygonVerticesCount));
+                case Math::ShapeType::Circle:
+                case Math::ShapeType::None:
+                default:
+                    return _circle;
+            }
+        }
 
         /**
          * @brief SetShape is a method that replaces the current mathematical shape of the collider
          * with a circle shape given in parameter.
          * @param circle The new circle shape for the collider.
          */
-        void SetShape(Math::CircleF circle) noexcept { _shape = circle; }
+        constexpr void SetShape(const Math::CircleF circle) noexcept
+        {
+            _circle = circle;
+            _shapeType = Math::ShapeType::Circle;
+        }
 
         /**
          * @brief SetShape is a method that replaces the current mathematical shape of the collider
          * with rectangle shape given in parameter.
          * @param rectangle The new rectangle shape for the collider.
          */
-        void SetShape(Math::RectangleF rectangle) noexcept { _shape = rectangle; }
+        constexpr void SetShape(const Math::RectangleF rectangle) noexcept
+        {
+            _rectangle = rectangle;
+            _shapeType = Math::ShapeType::Rectangle;
+        }
 
         /**
          * @brief SetShape is a method that replaces the current mathematical shape of the collider
          * with a polygon shape given in parameter.
+         * @note Only the first MaxPolygonVertices vertices of the polygon are kept. The polygon must be convex,
+         * its vertices can be given clockwise or counterclockwise.
          * @param polygon The new polygon shape for the collider.
          */
-        void SetShape(Math::PolygonF polygon) noexcept { _shape = polygon; }
+        void SetShape(const Math::PolygonF& polygon) noexcept
+        {
+            _polygonVerticesCount = std::min(polygon.VerticesCount(), MaxPolygonVertices);
+            std::copy_n(polygon.Vertices().begin(), _polygonVerticesCount, _polygonVertices.begin());
+            _shapeType = Math::ShapeType::Polygon;
+
+            calculatePolygonNormals();
+        }
 
         /**
          * @brief GetBodyRef is a method that gives the body reference of the collider in the world.
@@ -123,6 +248,61 @@ namespace PhysicsEngine
         */
         constexpr void SetIsTrigger(const bool isTrigger) noexcept { _isTrigger = isTrigger; }
 
+        /**
+         * @brief IsBullet is a method that checks if the collider is a bullet (aka if its moves are swept
+         * against the static colliders so that it never goes through them, whatever its speed).
+         * @return True if the collider is a bullet.
+         */
+        [[nodiscard]] constexpr bool IsBullet() const noexcept { return _isBullet; }
+
+        /**
+        * @brief SetIsBullet is a method that replaces the current bullet state of the collider with the bullet
+        * state given in parameter.
+        * @note Only the circle colliders are swept.
+        * @param isBullet The new bullet state for the collider.
+        */
+        constexpr void SetIsBullet(const bool isBullet) noexcept { _isBullet = isBullet; }
+
+        /**
+         * @brief GetCollisionFilter is a method that gives the categories of the collider and the categories
+         * it can touch.
+         * @return The collision filter of the collider.
+         */
+        [[nodiscard]] constexpr const CollisionFilter& GetCollisionFilter() const noexcept { return _filter; }
+
+        /**
+        * @brief SetCollisionFilter is a method that replaces the current collision filter of the collider with
+        * the collision filter given in parameter.
+        * @param filter The new collision filter for the collider.
+        */
+        constexpr void SetCollisionFilter(const CollisionFilter filter) noexcept { _filter = filter; }
+
+        /**
+         * @brief CategoryBits is a method that gives the categories (aka collision layers) of the collider.
+         * @return The category bits of the collider.
+         */
+        [[nodiscard]] constexpr std::uint32_t CategoryBits() const noexcept { return _filter.CategoryBits; }
+
+        /**
+        * @brief SetCategoryBits is a method that replaces the current categories of the collider with the
+        * categories given in parameter.
+        * @param categoryBits The new category bits for the collider, one bit per collision layer.
+        */
+        constexpr void SetCategoryBits(const std::uint32_t categoryBits) noexcept { _filter.CategoryBits = categoryBits; }
+
+        /**
+         * @brief MaskBits is a method that gives the categories the collider can touch.
+         * @return The mask bits of the collider.
+         */
+        [[nodiscard]] constexpr std::uint32_t MaskBits() const noexcept { return _filter.MaskBits; }
+
+        /**
+        * @brief SetMaskBits is a method that replaces the current categories the collider can touch with the
+        * categories given in parameter.
+        * @param maskBits The new mask bits for the collider, one bit per collision layer.
+        */
+        constexpr void SetMaskBits(const std::uint32_t maskBits) noexcept { _filter.MaskBits = maskBits; }
+
         /**
          * @brief Enabled is a method that checks if the collider is valid (aka if it has a mathematical shape).
          * @return True if the collider is valid.
@@ -178,28 +358,4 @@ namespace PhysicsEngine
             return ColliderA < other.ColliderA || (ColliderA == other.ColliderA && ColliderB < other.ColliderB);
         }
     };
-
-    /**
-      * @brief ColliderHash is a custom hash function for the 'ColliderPair' objects 
-      * used as keys in unordered containers.
-      */
-    struct ColliderHash
-    {
-        /**
-         * @brief A custom hash operator that calculates the hash value for a `ColliderPair`.
-         * @param pair The `ColliderPair` object for which to calculate the hash.
-         * @return The hash value for the `ColliderPair`.
-         */
-        std::size_t operator()(const ColliderPair& pair) const noexcept
-        {
-            // Calculate the hash for the ColliderA's index.
-            const std::size_t hash1 = std::hash<int>{}(static_cast<int>(pair.ColliderA.Index));
-
-            // Calculate the hash for the ColliderB's index.
-            const std::size_t hash2 = std::hash<int>{}(static_cast<int>(pair.ColliderB.Index));
-
-            // Combine the two hash values to create a unique hash value for the ColliderPair.
-            return hash1 + hash2;
-        }
-    };
 }
\ No newline at end of file
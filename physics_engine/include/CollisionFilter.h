@@ -0,0 +1,127 @@
+/**
+ * @headerfile CollisionFilter.h
+ * This header file defines the collision filter of a collider (its category and mask bits) and the matrix of
+ * the collision layers which can touch each other, used by the broad phases to reject the pairs of colliders
+ * which never interact before they reach the narrow phase.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief CollisionFilter is a struct that stores the categories (aka collision layers, one per bit) a
+     * collider belongs to and the categories it can touch.
+     */
+    struct CollisionFilter
+    {
+        /**
+         * @brief DefaultCategoryBits is the category of a collider whose filter is not set: the first layer.
+         */
+        static constexpr std::uint32_t DefaultCategoryBits = 0x00000001;
+
+        /**
+         * @brief AllCategoryBits is the mask of a collider which can touch all the categories.
+         */
+        static constexpr std::uint32_t AllCategoryBits = 0xFFFFFFFF;
+
+        std::uint32_t CategoryBits = DefaultCategoryBits;
+        std::uint32_t MaskBits = AllCategoryBits;
+    };
+
+    /**
+     * @brief ShouldCollide is a function that checks if two colliders can touch according to their filters:
+     * each one must be in a category the other one can touch.
+     * @return True if the colliders can touch.
+     */
+    [[nodiscard]] constexpr bool ShouldCollide(const CollisionFilter& filterA, const CollisionFilter& filterB) noexcept
+    {
+        return (filterA.CategoryBits & filterB.MaskBits) != 0 && (filterB.CategoryBits & filterA.MaskBits) != 0;
+    }
+
+    /**
+     * @brief CollisionMatrix is a class that stores which pairs of collision layers can touch. It is symmetric
+     * and all the layers touch each other by default.
+     */
+    class CollisionMatrix
+    {
+    public:
+        /**
+         * @brief LayerCount is the number of collision layers, one per bit of the category bits.
+         */
+        static constexpr int LayerCount = 32;
+
+    private:
+        /**
+         * @brief The layer masks: the bit j of the mask i tells if the layers i and j can touch.
+         */
+        std::array<std::uint32_t, LayerCount> _layerMasks{};
+
+    public:
+        constexpr CollisionMatrix() noexcept
+        {
+            for (auto& layerMask : _layerMasks)
+            {
+                layerMask = CollisionFilter::AllCategoryBits;
+            }
+        }
+
+        /**
+         * @brief SetLayersCollide is a method that sets if the two layers given in parameter can touch.
+         * @param layerA The index of the first layer, in [0, LayerCount).
+         * @param layerB The index of the second layer, in [0, LayerCount), it can be the first one.
+         * @param collide Whether the colliders of the two layers can touch.
+         */
+        constexpr void SetLayersCollide(const int layerA, const int layerB, const bool collide) noexcept
+        {
+            if (collide)
+            {
+                _layerMasks[layerA] |= 1u << layerB;
+                _layerMasks[layerB] |= 1u << layerA;
+            }
+            else
+            {
+                _layerMasks[layerA] &= ~(1u << layerB);
+                _layerMasks[layerB] &= ~(1u << layerA);
+            }
+        }
+
+        /**
+         * @brief LayersCollide is a method that checks if the two layers given in parameter can touch.
+         * @return True if the colliders of the two layers can touch.
+         */
+        [[nodiscard]] constexpr bool LayersCollide(const int layerA, const int layerB) const noexcept
+        {
+            return (_layerMasks[layerA] & 1u << layerB) != 0;
+        }
+
+        /**
+         * @brief Apply is a method that gives the filter given in parameter with a mask restricted to the
+         * layers that at least one of its categories can touch. Two applied filters pass ShouldCollide only if
+         * their own bits and the matrix both let them touch.
+         * @param filter The filter of a collider.
+         * @return The filter restricted by the matrix.
+         */
+        [[nodiscard]] constexpr CollisionFilter Apply(CollisionFilter filter) const noexcept
+        {
+            std::uint32_t layersMask = 0;
+
+            for (int layer = 0; layer < LayerCount; layer++)
+            {
+                if (filter.CategoryBits & 1u << layer)
+                {
+                    layersMask |= _layerMasks[layer];
+                }
+            }
+
+            filter.MaskBits &= layersMask;
+
+            return filter;
+        }
+    };
+}
@@ -0,0 +1,457 @@
+/**
+ * @headerfile ContactCache.h
+ * This header file defines the ContactCache class which remembers the pairs of colliders that were
+ * touching in the previous frame in order to know if a contact enters, stays or exits.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Collider.h"
+#include "ContactManifold.h"
+#include "FixedVector.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief ContactStatus is an enumeration that represents the state of a contact in the current frame
+     * compared to the previous frame.
+     */
+    enum class ContactStatus : std::uint8_t
+    {
+        Enter,
+        Stay,
+        AlreadyTouched
+    };
+
+    /**
+     * @brief Contact is a struct that stores a pair of colliders touching in the current frame (in the order
+     * it was discovered by the broad phase), whether the pair was not touching in the previous frame and the
+     * impulses stored for the pair in the previous frame.
+     */
+    struct Contact
+    {
+        ColliderPair Pair{};
+        bool IsNew = false;
+        ContactImpulse Impulse{};
+    };
+
+    /**
+     * @brief HashColliderPair is a function that calculates a hash value for a collider pair that does not
+     * depend on the order of the two colliders in the pair and that mixes their generation indices.
+     * @param pair The collider pair to hash.
+     * @return The hash value of the collider pair.
+     */
+    [[nodiscard]] std::uint64_t HashColliderPair(const ColliderPair& pair) noexcept;
+
+    /**
+     * @brief CanonicalPair is a function that orders the two colliders of the pair so that the collider
+     * A is always the lowest one.
+     */
+    [[nodiscard]] constexpr ColliderPair CanonicalPair(const ColliderPair& pair) noexcept
+    {
+        return pair.ColliderB < pair.ColliderA ? ColliderPair{ pair.ColliderB, pair.ColliderA } : pair;
+    }
+
+    /**
+     * @brief ContactCache is a class that stores the pairs of colliders touching each other across frames
+     * in an open-addressing hash table (linear probing) keyed by the canonical (min, max) collider pair.
+     * Each entry is stamped with the frame in which it was last touched, so the pairs that stopped
+     * touching are found with a single sweep over the pairs of the previous frame.
+     * The memory is allocated at Init and only grows when the table becomes too loaded, so a frame
+     * does not allocate anything.
+     * @tparam Capacity The maximum number of contacts in a frame. When it is not zero, the table and the
+     * arrays are stored in place in the cache with room for this number of contacts, so that the cache can be
+     * copied with a memcpy. Exceeding it terminates the program. With zero, the memory grows with the
+     * allocator.
+     */
+    template<std::size_t Capacity = 0>
+    class BasicContactCache
+    {
+    private:
+        /**
+         * @brief Slot is a struct that stores an entry of the hash table. A stamp of 0 means that the
+         * slot is empty.
+         */
+        struct Slot
+        {
+            ColliderPair Key{};
+            std::uint32_t Stamp = 0;
+            ContactImpulse Impulse{};
+        };
+
+        /**
+         * @brief MinSlotCount is the minimum number of slots of the hash table. It must be a power of two.
+         */
+        static constexpr std::size_t _minSlotCount = 16;
+
+        /**
+         * @brief SlotCountFor is a function that gives the number of slots of the hash table for the contact
+         * count given in parameter. The pairs of the previous frame stay in the table until EndFrame, so it must
+         * be able to hold twice the contact count while keeping the load factor under 1/2 to have short probe
+         * sequences.
+         */
+        [[nodiscard]] static constexpr std::size_t slotCountFor(const std::size_t contactCount) noexcept
+        {
+            std::size_t slotCount = _minSlotCount;
+            while (slotCount < contactCount * 4)
+            {
+                slotCount *= 2;
+            }
+
+            return slotCount;
+        }
+
+        static constexpr std::size_t _slotCapacity = Capacity == 0 ? 0 : slotCountFor(Capacity);
+
+        template<typename T, std::size_t ArrayCapacity>
+        using CacheArray = std::conditional_t<Capacity == 0, AllocVector<T>, FixedVector<T, ArrayCapacity>>;
+
+    public:
+        using ContactArray = CacheArray<Contact, Capacity>;
+        using PairArray = CacheArray<ColliderPair, Capacity>;
+
+    private:
+        CacheArray<Slot, _slotCapacity> _slots;
+        ContactArray _contacts;
+        PairArray _previousPairs;
+        PairArray _exitedPairs;
+
+        std::size_t _size = 0;
+        std::uint32_t _frame = 0;
+
+        /**
+         * @brief findSlot is a method that gives the index of the slot which contains the pair or the index
+         * of the empty slot where the pair should be inserted.
+         * @param key The canonical collider pair to look for.
+         * @return The index of the slot.
+         */
+        [[nodiscard]] std::size_t findSlot(const ColliderPair& key) const noexcept;
+
+        /**
+         * @brief erase is a method that removes the pair from the hash table by shifting back the following
+         * entries of its probe sequence (no tombstones).
+         * @param key The canonical collider pair to remove.
+         */
+        void erase(const ColliderPair& key) noexcept;
+
+        /**
+         * @brief rehash is a method that resizes the hash table to the slot count given in parameter
+         * and re-inserts all its entries. It is only used without a capacity.
+         * @param slotCount The new number of slots, must be a power of two.
+         */
+        void rehash(std::size_t slotCount) noexcept;
+
+    public:
+        BasicContactCache() noexcept = default;
+
+        explicit BasicContactCache(Allocator& allocator) noexcept :
+            _slots{ StandardAllocator<Slot>{allocator} },
+            _contacts{ StandardAllocator<Contact>{allocator} },
+            _previousPairs{ StandardAllocator<ColliderPair>{allocator} },
+            _exitedPairs{ StandardAllocator<ColliderPair>{allocator} } {}
+
+        /**
+         * @brief Init is a method that allocates the memory needed to store the number of contacts given
+         * in parameter without allocating during the frames.
+         * @param contactCount The expected maximum number of simultaneous contacts, ignored with a capacity.
+         */
+        void Init(std::size_t contactCount) noexcept;
+
+        /**
+         * @brief BeginFrame is a method that starts a new frame. The contacts of the previous frame
+         * are cleared and each pair touched from now on is stamped with the new frame.
+         */
+        void BeginFrame() noexcept;
+
+        /**
+         * @brief Touch is a method that registers a pair of colliders touching in the current frame.
+         * @param pair The pair of colliders touching.
+         * @return Enter if the pair was not touching in the previous frame, Stay if it was and
+         * AlreadyTouched if the pair was already registered in the current frame.
+         */
+        ContactStatus Touch(const ColliderPair& pair) noexcept;
+
+        /**
+         * @brief StoreImpulse is a method that stores the impulses of the solver for a pair touched in the
+         * current frame, so that they are given back with the contact of the next frame.
+         * @param pair The pair of colliders touching.
+         * @param impulse The impulses accumulated by the solver on the contact.
+         */
+        void StoreImpulse(const ColliderPair& pair, const ContactImpulse& impulse) noexcept;
+
+        /**
+         * @brief EndFrame is a method that removes from the cache all pairs that were touching in the
+         * previous frame but not in the current one and stores them in the exited pairs (in the order
+         * they were discovered in the previous frame).
+         */
+        void EndFrame() noexcept;
+
+        /**
+         * @brief Clear is a method that removes all pairs from the cache but keeps its memory.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief Deinit is a method that removes all pairs from the cache and releases its memory.
+         */
+        void Deinit() noexcept;
+
+        /**
+         * @brief Contains is a method that checks if the pair is stored in the cache.
+         * @param pair The pair of colliders to look for.
+         * @return True if the pair is stored in the cache.
+         */
+        [[nodiscard]] bool Contains(const ColliderPair& pair) const noexcept;
+
+        /**
+         * @brief Contacts is a method that gives the pairs touched in the current frame in the order they
+         * were touched.
+         * @return The contacts of the current frame.
+         */
+        [[nodiscard]] const ContactArray& Contacts() const noexcept { return _contacts; }
+
+        /**
+         * @brief ExitedPairs is a method that gives the pairs that stopped touching in the last frame
+         * ended with EndFrame.
+         * @return The pairs that stopped touching.
+         */
+        [[nodiscard]] const PairArray& ExitedPairs() const noexcept { return _exitedPairs; }
+
+        /**
+         * @brief Size is a method that gives the number of pairs stored in the cache.
+         * @return The number of pairs stored in the cache.
+         */
+        [[nodiscard]] std::size_t Size() const noexcept { return _size; }
+
+        /**
+         * @brief SlotCount is a method that gives the number of slots of the hash table.
+         * @return The number of slots of the hash table.
+         */
+        [[nodiscard]] std::size_t SlotCount() const noexcept { return _slots.size(); }
+    };
+
+    /**
+     * @brief AreSamePair is a function that checks if the two pairs have the same colliders in the same order.
+     */
+    [[nodiscard]] constexpr bool AreSamePair(const ColliderPair& a, const ColliderPair& b) noexcept
+    {
+        return a.ColliderA == b.ColliderA && a.ColliderB == b.ColliderB;
+    }
+
+    template<std::size_t Capacity>
+    void BasicContactCache<Capacity>::Init(const std::size_t contactCount) noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        const auto slotCount = Capacity == 0 ? slotCountFor(contactCount) : _slotCapacity;
+
+        _slots.assign(slotCount, Slot{});
+        _contacts.reserve(contactCount);
+        _previousPairs.reserve(contactCount);
+        _exitedPairs.reserve(contactCount);
+
+        _size = 0;
+        _frame = 0;
+    }
+
+    template<std::size_t Capacity>
+    std::size_t BasicContactCache<Capacity>::findSlot(const ColliderPair& key) const noexcept
+    {
+        const std::size_t mask = _slots.size() - 1;
+        std::size_t idx = HashColliderPair(key) & mask;
+
+        while (_slots[idx].Stamp != 0 && !AreSamePair(_slots[idx].Key, key))
+        {
+            idx = (idx + 1) & mask;
+        }
+
+        return idx;
+    }
+
+    template<std::size_t Capacity>
+    void BasicContactCache<Capacity>::BeginFrame() noexcept
+    {
+        if (_slots.empty())
+        {
+            Init(0);
+        }
+
+        _frame++;
+        _contacts.clear();
+    }
+
+    template<std::size_t Capacity>
+    ContactStatus BasicContactCache<Capacity>::Touch(const ColliderPair& pair) noexcept
+    {
+        const auto key = CanonicalPair(pair);
+
+        // With a capacity, the table is sized for twice the contacts of a frame and never grows, more contacts
+        // than the capacity terminate the program when they are stored below.
+        if constexpr (Capacity == 0)
+        {
+            if ((_size + 1) * 2 > _slots.size())
+            {
+                rehash(_slots.size() * 2);
+            }
+        }
+
+        auto& slot = _slots[findSlot(key)];
+
+        if (slot.Stamp == _frame)
+        {
+            return ContactStatus::AlreadyTouched;
+        }
+
+        const bool isNew = slot.Stamp == 0;
+
+        if (isNew)
+        {
+            slot.Key = key;
+            slot.Impulse = ContactImpulse{};
+            _size++;
+        }
+
+        slot.Stamp = _frame;
+        _contacts.push_back(Contact{ pair, isNew, slot.Impulse });
+
+        return isNew ? ContactStatus::Enter : ContactStatus::Stay;
+    }
+
+    template<std::size_t Capacity>
+    void BasicContactCache<Capacity>::StoreImpulse(const ColliderPair& pair, const ContactImpulse& impulse) noexcept
+    {
+        auto& slot = _slots[findSlot(CanonicalPair(pair))];
+
+        if (slot.Stamp != _frame) return;
+
+        slot.Impulse = impulse;
+    }
+
+    template<std::size_t Capacity>
+    void BasicContactCache<Capacity>::EndFrame() noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        _exitedPairs.clear();
+
+        for (const auto& pair : _previousPairs)
+        {
+            const auto key = CanonicalPair(pair);
+
+            if (_slots[findSlot(key)].Stamp != _frame)
+            {
+                _exitedPairs.push_back(pair);
+                erase(key);
+            }
+        }
+
+        _previousPairs.clear();
+
+        for (const auto& contact : _contacts)
+        {
+            _previousPairs.push_back(contact.Pair);
+        }
+    }
+
+    template<std::size_t Capacity>
+    void BasicContactCache<Capacity>::erase(const ColliderPair& key) noexcept
+    {
+        const std::size_t mask = _slots.size() - 1;
+        std::size_t hole = findSlot(key);
+
+        if (_slots[hole].Stamp == 0) return;
+
+        _slots[hole] = Slot{};
+        _size--;
+
+        // Shift back the entries of the probe sequence that would not be found anymore because of the hole.
+        std::size_t idx = (hole + 1) & mask;
+
+        while (_slots[idx].Stamp != 0)
+        {
+            const std::size_t home = HashColliderPair(_slots[idx].Key) & mask;
+
+            // The entry can fill the hole if its home slot is not cyclically in ]hole, idx].
+            const bool canMove = hole <= idx ? (home <= hole || home > idx) : (home <= hole && home > idx);
+
+            if (canMove)
+            {
+                _slots[hole] = _slots[idx];
+                _slots[idx] = Slot{};
+                hole = idx;
+            }
+
+            idx = (idx + 1) & mask;
+        }
+    }
+
+    template<std::size_t Capacity>
+    void BasicContactCache<Capacity>::rehash(const std::size_t slotCount) noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        AllocVector<Slot> oldSlots{ _slots.get_allocator() };
+        oldSlots.swap(_slots);
+
+        _slots.assign(slotCount, Slot{});
+
+        for (const auto& slot : oldSlots)
+        {
+            if (slot.Stamp == 0) continue;
+
+            _slots[findSlot(slot.Key)] = slot;
+        }
+    }
+
+    template<std::size_t Capacity>
+    void BasicContactCache<Capacity>::Clear() noexcept
+    {
+        std::fill(_slots.begin(), _slots.end(), Slot{});
+        _contacts.clear();
+        _previousPairs.clear();
+        _exitedPairs.clear();
+
+        _size = 0;
+    }
+
+    template<std::size_t Capacity>
+    void BasicContactCache<Capacity>::Deinit() noexcept
+    {
+        _slots.clear();
+        _contacts.clear();
+        _previousPairs.clear();
+        _exitedPairs.clear();
+
+        _size = 0;
+        _frame = 0;
+    }
+
+    template<std::size_t Capacity>
+    bool BasicContactCache<Capacity>::Contains(const ColliderPair& pair) const noexcept
+    {
+        if (_slots.empty()) return false;
+
+        return _slots[findSlot(CanonicalPair(pair))].Stamp != 0;
+    }
+
+    extern template class BasicContactCache<>;
+
+    using ContactCache = BasicContactCache<>;
+}
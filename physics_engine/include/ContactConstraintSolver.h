@@ -0,0 +1,196 @@
+/**
+ * @headerfile ContactConstraintSolver.h
+ * This header file defines the ContactConstraintSolver class which resolves all the contacts of a frame
+ * together with sequential impulses.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Body.h"
+#include "ContactManifold.h"
+
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief ContactConstraintSolver is a class that resolves the contacts of a frame with sequential impulses.
+     * The bodies touched by a contact and the contacts are copied in contiguous arrays. The velocities are
+     * solved by several iterations over all the contacts, starting from the impulses of the previous frame
+     * (warm starting). The contacts are found after the bodies moved, so the positions are then integrated
+ * again with the change of velocity, as if the velocities were solved before the move. At last, the remaining
+ * penetrations are removed by a few iterations on the positions.
+     * @note The static bodies are never moved. Like in the rest of the world, the kinematic bodies are moved by
+     * their contacts according to their mass.
+     */
+    class ContactConstraintSolver
+    {
+    public:
+        /**
+         * @brief NoBody is the solver index of a world body which is not in the solver.
+         */
+        static constexpr std::uint32_t NoBody = 0xFFFFFFFF;
+
+        /**
+         * @brief NoConstraint is the index given for a contact which is not added to the solver.
+         */
+        static constexpr std::uint32_t NoConstraint = 0xFFFFFFFF;
+
+    private:
+        /**
+         * @brief SolverBody is a struct that stores the state of a body used by the solver.
+         */
+        struct SolverBody
+        {
+            Math::Vec2F Position = Math::Vec2F::Zero();
+            Math::Vec2F Velocity = Math::Vec2F::Zero();
+
+            /**
+             * @brief The velocity with which the position of the body was integrated in the frame.
+             */
+            Math::Vec2F IntegratedVelocity = Math::Vec2F::Zero();
+            float InverseMass = 0.f;
+            std::uint32_t WorldBodyIdx = 0;
+        };
+
+        /**
+         * @brief ContactConstraint is a struct that stores a contact between two solver bodies.
+         */
+        struct ContactConstraint
+        {
+            std::uint32_t BodyA = NoBody;
+            std::uint32_t BodyB = NoBody;
+
+            Math::Vec2F Normal = Math::Vec2F::Up();
+            Math::Vec2F Tangent = Math::Vec2F::Right();
+
+            /**
+             * @brief The inverse of the sum of the inverse masses of the two bodies.
+             */
+            float EffectiveMass = 0.f;
+            float Friction = 0.f;
+
+            /**
+             * @brief The normal velocity to reach, from the restitution of the relative velocity at the start
+             * of the frame.
+             */
+            float TargetVelocity = 0.f;
+
+            /**
+             * @brief The relative position of the bodies along the normal when the penetrations were measured.
+             */
+            float InitialSeparation = 0.f;
+
+            std::array<float, MaxManifoldPoints> Penetrations{};
+            ContactImpulse Impulse{};
+            int PointCount = 0;
+        };
+
+        AllocVector<SolverBody> _bodies;
+        AllocVector<std::uint32_t> _solverBodyIndices;
+        AllocVector<ContactConstraint> _constraints;
+
+        /**
+         * @brief LinearSlop is the penetration kept by the position correction so that the contacts stay
+         * touching from one frame to the next.
+         */
+        static constexpr float _linearSlop = 0.005f;
+
+        /**
+         * @brief PositionCorrectionFactor is the part of the penetration removed by a position iteration.
+         */
+        static constexpr float _positionCorrectionFactor = 0.2f;
+
+        /**
+         * @brief MaxPositionCorrection is the maximum distance a contact can move its bodies in one iteration,
+         * so that a deep penetration does not push the bodies too far.
+         */
+        static constexpr float _maxPositionCorrection = 0.2f;
+
+        [[nodiscard]] std::uint32_t addBody(std::uint32_t worldBodyIdx, const Body& body) noexcept;
+
+        void applyImpulse(const ContactConstraint& constraint, Math::Vec2F impulse) noexcept;
+
+    public:
+        explicit ContactConstraintSolver(Allocator& allocator) noexcept :
+            _bodies{ StandardAllocator<SolverBody>{allocator} },
+            _solverBodyIndices{ StandardAllocator<std::uint32_t>{allocator} },
+            _constraints{ StandardAllocator<ContactConstraint>{allocator} } {}
+
+        /**
+         * @brief Begin is a method that removes the contacts and the bodies of the previous frame.
+         * @param worldBodyCount The number of bodies of the world.
+         */
+        void Begin(std::size_t worldBodyCount) noexcept;
+
+        /**
+         * @brief AddContact is a method that adds the contact between the two bodies given in parameter.
+         * @param manifold The manifold of the contact, whose normal goes from the body B to the body A.
+         * @param impulse The impulses accumulated by the contact in the previous frame (zero for a new contact).
+         * @return The index of the constraint, or NoConstraint if the contact can not move any of its bodies.
+         */
+        std::uint32_t AddContact(std::uint32_t worldBodyIdxA, const Body& bodyA, const Collider& colliderA,
+                                 std::uint32_t worldBodyIdxB, const Body& bodyB, const Collider& colliderB,
+                                 const ContactManifold& manifold, const ContactImpulse& impulse) noexcept;
+
+        /**
+         * @brief Solve is a method that applies the impulses of the previous frame, then solves the velocities
+         * and the positions of the bodies.
+         * @param deltaTime The time step with which the positions of the bodies were integrated.
+         * @param velocityIterationCount The number of iterations over all the contacts to solve the velocities.
+         * @param positionIterationCount The number of iterations over all the contacts to remove the penetrations.
+         */
+        void Solve(float deltaTime, int velocityIterationCount, int positionIterationCount) noexcept;
+
+        /**
+         * @brief SolveVelocities is a method that runs one velocity iteration over all the contacts.
+         */
+        void SolveVelocities() noexcept;
+
+        /**
+         * @brief SolvePositions is a method that runs one position iteration over all the contacts.
+         */
+        void SolvePositions() noexcept;
+
+        /**
+         * @brief StoreBodies is a method that copies the new positions and velocities in the world bodies.
+         * @param bodies The bodies of the world.
+         */
+        template<typename BodyArray>
+        void StoreBodies(BodyArray& bodies) const noexcept
+        {
+            for (const auto& solverBody : _bodies)
+            {
+                auto& body = bodies[solverBody.WorldBodyIdx];
+
+                body.SetPosition(solverBody.Position);
+                body.SetVelocity(solverBody.Velocity);
+            }
+        }
+
+        /**
+         * @brief Impulse is a method that gives the impulses accumulated by the constraint given in parameter.
+         * @param constraintIdx The index of the constraint given by AddContact.
+         * @return The impulses accumulated by the constraint.
+         */
+        [[nodiscard]] const ContactImpulse& Impulse(std::uint32_t constraintIdx) const noexcept
+        {
+            return _constraints[constraintIdx].Impulse;
+        }
+
+        /**
+         * @brief ConstraintCount is a method that gives the number of contacts of the frame.
+         * @return The number of contacts of the frame.
+         */
+        [[nodiscard]] std::size_t ConstraintCount() const noexcept { return _constraints.size(); }
+
+        /**
+         * @brief BodyCount is a method that gives the number of bodies touched by the contacts of the frame.
+         * @return The number of bodies touched by the contacts of the frame.
+         */
+        [[nodiscard]] std::size_t BodyCount() const noexcept { return _bodies.size(); }
+    };
+}
@@ -0,0 +1,65 @@
+/**
+ * @headerfile ContactEvent.h
+ * This header file defines the contact events written by the world during an update in a flat buffer, which
+ * the game reads after the update instead of receiving the callbacks of a contact listener.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Collider.h"
+#include "Vec2.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief ContactEventType is an enumeration of what happened to a pair of colliders in the last update.
+     */
+    enum class ContactEventType : std::uint8_t
+    {
+        TriggerEnter,
+        TriggerStay,
+        TriggerExit,
+        CollisionEnter,
+        CollisionStay,
+        CollisionExit
+    };
+
+    /**
+     * @brief ContactEvent is a struct that stores an event of a pair of colliders. The normal goes from the
+     * collider B to the collider A and the normal impulse is the sum of the impulses applied by the solver on
+     * the contact points. They are zero for the triggers, the exits and the contacts which were not solved
+     * (between sleeping bodies).
+     */
+    struct ContactEvent
+    {
+        ColliderPair Pair{};
+        Math::Vec2F Normal = Math::Vec2F::Zero();
+        float NormalImpulse = 0.f;
+        ContactEventType Type = ContactEventType::CollisionEnter;
+    };
+
+    /**
+     * @brief ContactEventSpan is a struct that views the contact events of the last update. It is invalidated
+     * by the next update of the world.
+     */
+    struct ContactEventSpan
+    {
+        const ContactEvent* Data = nullptr;
+        std::size_t Size = 0;
+
+        [[nodiscard]] constexpr const ContactEvent* begin() const noexcept { return Data; }
+        [[nodiscard]] constexpr const ContactEvent* end() const noexcept { return Data + Size; }
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return Size; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return Size == 0; }
+
+        [[nodiscard]] constexpr const ContactEvent& operator[](const std::size_t idx) const noexcept
+        {
+            return Data[idx];
+        }
+    };
+}
@@ -1,7 +1,7 @@
 /**
  * @headerfile ContactListener.h
  * This header file defines the ContactListener class which is an interface for 
- * handling collider collision events.
+ * handling collider collision events, and the function which calls it for the events of an update.
  *
  * @author Olivier Pachoud
  */
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Collider.h"
+#include "ContactEvent.h"
 #include "Vec2.h"
 
 namespace PhysicsEngine
@@ -58,4 +59,12 @@ namespace PhysicsEngine
       */
        virtual void OnCollisionExit(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept = 0;
     };
-}
\ No newline at end of file
+
+    /**
+     * @brief DispatchContactEvents is a function that calls the callback of the listener matching each event
+     * given in parameter, in their order. The collision stay events have no callback and are skipped.
+     * @param events The contact events of an update of the world.
+     * @param contactListener The listener to call.
+     */
+    void DispatchContactEvents(ContactEventSpan events, ContactListener& contactListener) noexcept;
+}
@@ -0,0 +1,64 @@
+/**
+ * @headerfile ContactManifold.h
+ * This header file defines the contact manifold of two touching colliders and the function which
+ * calculates it.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Body.h"
+#include "Collider.h"
+
+#include <array>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief MaxManifoldPoints is the maximum number of contact points of a manifold.
+     */
+    constexpr int MaxManifoldPoints = 2;
+
+    /**
+     * @brief ContactPoint is a struct that stores a point of a contact in world space and the depth of the
+     * penetration of the two colliders at this point.
+     */
+    struct ContactPoint
+    {
+        Math::Vec2F Position = Math::Vec2F::Zero();
+        float Penetration = 0.f;
+    };
+
+    /**
+     * @brief ContactManifold is a struct that stores the contact points of two touching colliders A and B. The
+     * normal goes from B to A, so moving A along the normal separates the colliders.
+     */
+    struct ContactManifold
+    {
+        Math::Vec2F Normal = Math::Vec2F::Up();
+        std::array<ContactPoint, MaxManifoldPoints> Points{};
+        int PointCount = 0;
+    };
+
+    /**
+     * @brief ContactImpulse is a struct that stores the impulses accumulated by the solver on each point of a
+     * manifold, along the normal and along the tangent. They are kept from one frame to the next to warm start
+     * the solver.
+     */
+    struct ContactImpulse
+    {
+        std::array<float, MaxManifoldPoints> Normal{};
+        std::array<float, MaxManifoldPoints> Tangent{};
+    };
+
+    /**
+     * @brief CalculateManifold is a function that calculates the contact points of the two colliders given in
+     * parameter, with their offsets and the positions of their bodies.
+     * @note The contacts with a polygon are found with the separating axis theorem on the cached face normals of
+     * the polygon, and the points of two polygons by clipping the incident face by the reference face.
+     * @return The manifold of the contact, without points if the colliders do not touch.
+     */
+    [[nodiscard]] ContactManifold CalculateManifold(const Collider& colliderA, const Body& bodyA,
+                                                    const Collider& colliderB, const Body& bodyB) noexcept;
+}
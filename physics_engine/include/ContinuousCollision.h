@@ -0,0 +1,67 @@
+/**
+ * @headerfile ContinuousCollision.h
+ * This header file defines the functions which calculate the time of impact of a moving circle against a
+ * shape at rest, used to stop the fast colliders from going through thin colliders and to cast rays and
+ * circles in the world.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "ConvexPolygon.h"
+#include "Shape.h"
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief TimeOfImpact is a struct that stores the first contact of a moving shape against a shape at rest.
+     * The time is a fraction of the translation of the moving shape, in [0, 1]. The normal goes from the shape
+     * at rest to the moving shape.
+     */
+    struct TimeOfImpact
+    {
+        bool Hit = false;
+        float Time = 1.f;
+        Math::Vec2F Normal = Math::Vec2F::Up();
+    };
+
+    /**
+     * @brief SweptCircleTimeOfImpact is a function that calculates when a circle moved by the translation given
+     * in parameter first touches another circle.
+     * @note A circle already touching the other circle at its start position does not hit it.
+     * @param circle The moving circle at its start position.
+     * @param translation The translation of the moving circle during the frame.
+     * @param target The circle at rest.
+     * @return The first contact of the moving circle, if any.
+     */
+    [[nodiscard]] TimeOfImpact SweptCircleTimeOfImpact(const Math::CircleF& circle, Math::Vec2F translation,
+                                                       const Math::CircleF& target) noexcept;
+
+    /**
+     * @brief SweptCircleTimeOfImpact is a function that calculates when a circle moved by the translation given
+     * in parameter first touches a rectangle. The rectangle is grown by the radius of the circle (with rounded
+     * corners) and the center of the circle is cast against it.
+     * @note A circle already touching the rectangle at its start position does not hit it.
+     * @param circle The moving circle at its start position.
+     * @param translation The translation of the moving circle during the frame.
+     * @param target The rectangle at rest.
+     * @return The first contact of the moving circle, if any.
+     */
+    [[nodiscard]] TimeOfImpact SweptCircleTimeOfImpact(const Math::CircleF& circle, Math::Vec2F translation,
+                                                       const Math::RectangleF& target) noexcept;
+
+    /**
+     * @brief SweptCircleTimeOfImpact is a function that calculates when a circle moved by the translation given
+     * in parameter first touches a convex polygon. The center of the circle is cast against the faces of the
+     * polygon pushed out by the radius and against the circles of its vertices.
+     * @note A circle already touching the polygon at its start position does not hit it. A circle with a radius
+     * of zero is a ray.
+     * @param circle The moving circle at its start position.
+     * @param translation The translation of the moving circle.
+     * @param target The polygon at rest, in world space.
+     * @return The first contact of the moving circle, if any.
+     */
+    [[nodiscard]] TimeOfImpact SweptCircleTimeOfImpact(const Math::CircleF& circle, Math::Vec2F translation,
+                                                       const ConvexPolygon& target) noexcept;
+}
@@ -0,0 +1,70 @@
+/**
+ * @headerfile ConvexPolygon.h
+ * This header file defines the ConvexPolygon struct, a polygon or rectangle collider in world space with the
+ * normals of its faces, and the separating axis functions which test two convex polygons.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Collider.h"
+
+#include <array>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief ConvexPolygon is a struct that stores the vertices of a polygon collider (or of the 4 corners of a
+     * rectangle collider) in world space on the stack, and points to the normals of its faces which are cached
+     * by the collider, so that the separating axis tests neither allocate memory nor compute any normal.
+     */
+    struct ConvexPolygon
+    {
+        std::array<Math::Vec2F, Collider::MaxPolygonVertices> Vertices{};
+        const Math::Vec2F* Normals = nullptr;
+        int VerticesCount = 0;
+
+        /**
+         * @brief View is a method that gives a view on the vertices of the polygon.
+         * @return A view on the vertices of the polygon.
+         */
+        [[nodiscard]] Math::PolygonViewF View() const noexcept { return { Vertices.data(), VerticesCount }; }
+    };
+
+    /**
+     * @brief MakeConvexPolygon is a function that gives the polygon of a polygon or rectangle collider in world
+     * space.
+     * @param collider The collider, its shape must be a polygon or a rectangle.
+     * @param position The position of the body of the collider plus the offset of the collider.
+     * @return The polygon of the collider in world space.
+     */
+    [[nodiscard]] ConvexPolygon MakeConvexPolygon(const Collider& collider, Math::Vec2F position) noexcept;
+
+    /**
+     * @brief IsSeparatingAxis is a function that checks if the projections of the two polygons on the axis given
+     * in parameter do not overlap.
+     * @param axis The axis to project the polygons on, it does not need to be normalized.
+     * @return True if the axis separates the polygons.
+     */
+    [[nodiscard]] bool IsSeparatingAxis(const ConvexPolygon& polygonA, const ConvexPolygon& polygonB,
+                                        Math::Vec2F axis) noexcept;
+
+    /**
+     * @brief FindSeparatingAxis is a function that looks for a face normal of one of the two polygons which
+     * separates them (separating axis theorem). The search stops at the first separating axis.
+     * @param separatingAxis The separating axis found, unchanged if the polygons overlap.
+     * @return True if a separating axis is found (aka if the polygons do not overlap).
+     */
+    [[nodiscard]] bool FindSeparatingAxis(const ConvexPolygon& polygonA, const ConvexPolygon& polygonB,
+                                          Math::Vec2F& separatingAxis) noexcept;
+
+    /**
+     * @brief FindMaxSeparation is a function that gives the face of the first polygon along which the second
+     * polygon is the most separated from it. The separation is negative if the polygons overlap along it.
+     * @param face The index of the face of the first polygon with the greatest separation.
+     * @return The greatest separation.
+     */
+    [[nodiscard]] float FindMaxSeparation(const ConvexPolygon& polygon, const ConvexPolygon& otherPolygon,
+                                          int& face) noexcept;
+}
@@ -0,0 +1,119 @@
+/**
+ * @headerfile FreeList.h
+ * This header file defines the FreeList class which keeps track of the unused slots of an array.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "FixedVector.h"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief FreeList is a class that stores the unused slots of an array in a singly linked list threaded
+     * through the slots (each unused slot stores the index of the next unused slot), so that taking or giving
+     * back a slot is done in constant time.
+     * @note The slots are taken in the reverse order in which they are given back, and the slots added by
+     * Grow are taken in increasing order.
+     * @tparam Capacity The maximum number of slots, stored in place in the list when it is not zero, so that
+     * the list can be copied with a memcpy. With zero, the slots grow with the allocator.
+     */
+    template<std::size_t Capacity = 0>
+    class BasicFreeList
+    {
+    public:
+        /**
+         * @brief NoSlot is the index of a slot that does not exist (the end of the list).
+         */
+        static constexpr std::uint32_t NoSlot = 0xFFFFFFFF;
+
+    private:
+        std::conditional_t<Capacity == 0, AllocVector<std::uint32_t>, FixedVector<std::uint32_t, Capacity>>
+            _nextFreeSlots;
+        std::uint32_t _head = NoSlot;
+        std::size_t _freeSlotCount = 0;
+
+    public:
+        BasicFreeList() noexcept = default;
+
+        explicit BasicFreeList(Allocator& allocator) noexcept :
+            _nextFreeSlots{ StandardAllocator<std::uint32_t>{allocator} } {}
+
+        /**
+         * @brief Grow is a method that adds the slots between the current slot count and the new one to the list.
+         * @param newSlotCount The new number of slots of the array, it must not be lower than the current one.
+         */
+        void Grow(const std::size_t newSlotCount) noexcept
+        {
+            const auto previousSlotCount = _nextFreeSlots.size();
+
+            _nextFreeSlots.resize(newSlotCount, NoSlot);
+
+            for (auto slot = newSlotCount; slot > previousSlotCount; slot--)
+            {
+                Release(static_cast<std::uint32_t>(slot - 1));
+            }
+        }
+
+        /**
+         * @brief Acquire is a method that takes the first unused slot of the list.
+         * @return The index of the slot or NoSlot if the list is empty.
+         */
+        [[nodiscard]] std::uint32_t Acquire() noexcept
+        {
+            const auto slot = _head;
+
+            if (slot != NoSlot)
+            {
+                _head = _nextFreeSlots[slot];
+                _nextFreeSlots[slot] = NoSlot;
+                _freeSlotCount--;
+            }
+
+            return slot;
+        }
+
+        /**
+         * @brief Release is a method that gives back a slot to the list.
+         * @param slot The index of the slot, it must not already be in the list.
+         */
+        void Release(const std::uint32_t slot) noexcept
+        {
+            _nextFreeSlots[slot] = _head;
+            _head = slot;
+            _freeSlotCount++;
+        }
+
+        /**
+         * @brief Reset is a method that empties the list and sets the number of slots of the array, all the
+         * slots are considered used until they are released.
+         * @param slotCount The number of slots of the array.
+         */
+        void Reset(const std::size_t slotCount = 0) noexcept
+        {
+            _nextFreeSlots.assign(slotCount, NoSlot);
+            _head = NoSlot;
+            _freeSlotCount = 0;
+        }
+
+        /**
+         * @brief FreeSlotCount is a method that gives the number of unused slots in the list.
+         * @return The number of unused slots.
+         */
+        [[nodiscard]] std::size_t FreeSlotCount() const noexcept { return _freeSlotCount; }
+
+        /**
+         * @brief SlotCount is a method that gives the number of slots (used or not) of the array.
+         * @return The number of slots of the array.
+         */
+        [[nodiscard]] std::size_t SlotCount() const noexcept { return _nextFreeSlots.size(); }
+    };
+
+    using FreeList = BasicFreeList<>;
+}
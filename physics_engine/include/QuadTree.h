@@ -1,6 +1,6 @@
 /**
  * @headerfile QuadTree.h
- * This header file defines the various data required to calculate the quad-tree which is an 
+ * This header file defines the various data required to calculate the quad-tree which is an
  * algorithm that divides the physical world into sub-spaces to facilitate comparison between physical objects.
  *
  * @author Olivier Pachoud
@@ -12,21 +12,28 @@
 #include "Collider.h"
 #include "UniquePtr.h"
 
+#include <array>
+#include <cstdint>
+
 namespace PhysicsEngine
 {
     /**
      * @brief SimplifiedCollider is a struct that stores the data of a collider in a simplified way (aka it stores
-     * its collider reference in the world and its shape in a rectangle form).
+     * its collider reference in the world, its shape in a rectangle form and its collision filter).
      */
     struct SimplifiedCollider
     {
         ColliderRef ColRef{0, 0};
         Math::RectangleF Rectangle{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
+        CollisionFilter Filter{};
     };
 
     /**
-     * @brief QuadNode is a struct representing a node in a quad-tree data structure used for spatial 
-     partitioning in a 2D space.
+     * @brief QuadNode is a struct representing a node in a quad-tree data structure used for spatial
+     * partitioning in a 2D space.
+     * @note The node does not own any memory: its children are indices in the quad-tree node array and its
+     * colliders are a range of the quad-tree collider array. The colliders of the node come first in its
+     * range, followed by the colliders of its children sub-trees in depth-first order.
      */
     struct QuadNode
     {
@@ -41,16 +48,36 @@ namespace PhysicsEngine
          */
         static constexpr int BoundaryDivisionCount = 4;
 
-        Math::RectangleF Boundary{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
-        std::array<QuadNode*, BoundaryDivisionCount> Children{ nullptr, nullptr, nullptr, nullptr };
-        AllocVector<SimplifiedCollider> Colliders;
+        /**
+         * @brief NoChild is the child index of a node that is not subdivided.
+         */
+        static constexpr std::uint32_t NoChild = 0xFFFFFFFF;
+
+        std::array<std::uint32_t, BoundaryDivisionCount> Children{ NoChild, NoChild, NoChild, NoChild };
+
+        /**
+         * @brief ColliderOffset is the index of the first collider of the node in the quad-tree collider array.
+         */
+        std::uint32_t ColliderOffset = 0;
+
+        /**
+         * @brief ColliderCount is the number of colliders stored in the node itself.
+         */
+        std::uint32_t ColliderCount = 0;
+
+        /**
+         * @brief SubTreeColliderCount is the number of colliders stored in the node and all its descendants.
+         */
+        std::uint32_t SubTreeColliderCount = 0;
 
-        explicit QuadNode(Allocator& allocator) noexcept : 
-            Colliders{ StandardAllocator<SimplifiedCollider>{allocator} } {}
+        [[nodiscard]] constexpr bool HasChildren() const noexcept { return Children[0] != NoChild; }
     };
 
     /**
      * @brief QuadTree is a class that represents a quad-tree used for spatial partitioning of the world space.
+     * @note The tree is stored in flat arrays of trivially copyable data (nodes with 32-bit child indices,
+     * structure-of-arrays bounds and one contiguous collider array) so copying a quad-tree is only a few
+     * memory copies and the copy never points to the data of the source.
      */
     class QuadTree
     {
@@ -58,9 +85,34 @@ namespace PhysicsEngine
         HeapAllocator _heapAllocator;
 
         AllocVector<QuadNode> _nodes{ StandardAllocator<QuadNode>{_heapAllocator} };
+
+        // Boundaries of the nodes in structure-of-arrays form.
+        AllocVector<float> _nodeMinX{ StandardAllocator<float>{_heapAllocator} };
+        AllocVector<float> _nodeMinY{ StandardAllocator<float>{_heapAllocator} };
+        AllocVector<float> _nodeMaxX{ StandardAllocator<float>{_heapAllocator} };
+        AllocVector<float> _nodeMaxY{ StandardAllocator<float>{_heapAllocator} };
+
+        // Colliders inserted since the last clear, in insertion order.
+        AllocVector<SimplifiedCollider> _insertedColliders{ StandardAllocator<SimplifiedCollider>{_heapAllocator} };
+
+        // Colliders sorted by node in structure-of-arrays form.
+        AllocVector<ColliderRef> _colliderRefs{ StandardAllocator<ColliderRef>{_heapAllocator} };
+        AllocVector<float> _colMinX{ StandardAllocator<float>{_heapAllocator} };
+        AllocVector<float> _colMinY{ StandardAllocator<float>{_heapAllocator} };
+        AllocVector<float> _colMaxX{ StandardAllocator<float>{_heapAllocator} };
+        AllocVector<float> _colMaxY{ StandardAllocator<float>{_heapAllocator} };
+        AllocVector<CollisionFilter> _colFilters{ StandardAllocator<CollisionFilter>{_heapAllocator} };
+
+        // Scratch buffers of the counting pass (indices in the inserted colliders).
+        AllocVector<std::uint32_t> _order{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+        AllocVector<std::uint32_t> _sortedOrder{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+        AllocVector<std::uint8_t> _buckets{ StandardAllocator<std::uint8_t>{_heapAllocator} };
+
         AllocVector<ColliderPair> _possiblePairs{ StandardAllocator<ColliderPair>{_heapAllocator} };
 
-        int _nodeIndex = 1;
+        std::uint32_t _nodeIndex = 1;
+
+        bool _isBuilt = false;
 
         /**
          * @brief MaxDepth is the maximum depth of the quad-tree recursive space subdivision.
@@ -68,55 +120,92 @@ namespace PhysicsEngine
         static constexpr int _maxDepth = 5;
 
         /**
-         * @brief PossiblePairReserveFactor is the factor to mutliply with the total number of node in 
-         * the quad-tree to reserve this capacity in the _possiblePairs vector. 
+         * @brief PossiblePairReserveFactor is the factor to mutliply with the total number of node in
+         * the quad-tree to reserve this capacity in the _possiblePairs vector.
          * This factor totally arbitrary.
          */
         static constexpr float _possiblePairReserveFactor = 3.f;
 
         /**
-         * @brief insertInNode is a method that insert a collider in the node given in parameter
-         * (in its simplified shape) in the given node in parameter.
-         * @param node The node in which the collider must be inserted.
-         * @param simplifiedShape The simplified shape of the collider (aka its shape in rectangle).
-         * @param colliderRef The collider reference in the world.
+         * @brief buildNode is a method that distributes the colliders of a range of the order array between
+         * the node given in parameter and its children (subdividing the node if it has too many colliders).
+         * The distribution is done with a counting pass so that the colliders of the node come first in the
+         * range, followed by the colliders of each child.
+         * @param nodeIdx The index of the node in which the colliders must be distributed.
+         * @param begin The index of the first collider of the range in the order array.
+         * @param end The index after the last collider of the range in the order array.
          * @param depth The depth in which the node is.
          */
-        void insertInNode(QuadNode& node,
-                          Math::RectangleF simplifiedShape,
-                          ColliderRef colliderRef,
-                          int depth) noexcept;
+        void buildNode(std::uint32_t nodeIdx, std::uint32_t begin, std::uint32_t end, int depth) noexcept;
+
+        /**
+         * @brief subdivide is a method that calculates the boundaries of the four children of the node given
+         * in parameter and links them to the node.
+         * @param nodeIdx The index of the node to subdivide.
+         */
+        void subdivide(std::uint32_t nodeIdx) noexcept;
 
         /**
-         * @brief calculateNodePossiblePairs is a method that calculates the possible pair of collider
-         * in the node given in parameter.
-         * @param node
+         * @brief calculateNodePossiblePairs is a method that calculates the possible pairs between the
+         * colliders of the node given in parameter and the colliders of its whole sub-tree, then does the
+         * same for its children.
+         * @param node The node to compute the possible pairs of.
          */
         void calculateNodePossiblePairs(const QuadNode& node) noexcept;
 
         /**
-         * @brief calculateNodePossiblePairs is a method that calculates the possible pair of collider
-         * in the node given in parameter.
-         * @param node
+         * @brief calculateColliderPossiblePairs is a method that adds the pairs between the collider given in
+         * parameter and the colliders of a range of the collider array whose rectangles intersect its rectangle.
+         * The range is tested eight (AVX2) or four (SSE) colliders at a time when the intrinsics are available,
+         * and the pairs are added in the order of the range.
+         * @param colIdx The index of the collider in the collider array.
+         * @param begin The index of the first collider of the range.
+         * @param end The index after the last collider of the range.
          */
-        void calculateChildrenNodePossiblePairs(const QuadNode& node, SimplifiedCollider simplCol) noexcept;
+        void calculateColliderPossiblePairs(std::size_t colIdx, std::size_t begin, std::size_t end) noexcept;
+
+        /**
+         * @brief intersect is a method that checks if the colliders at the indices given in parameter
+         * in the collider array have intersecting rectangles.
+         */
+        [[nodiscard]] bool intersect(std::size_t colIdxA, std::size_t colIdxB) const noexcept
+        {
+            return !(_colMaxX[colIdxA] < _colMinX[colIdxB] || _colMinX[colIdxA] > _colMaxX[colIdxB] ||
+                     _colMaxY[colIdxA] < _colMinY[colIdxB] || _colMinY[colIdxA] > _colMaxY[colIdxB]);
+        }
 
     public:
         QuadTree() noexcept = default;
 
+        /**
+         * @brief The copy uses the memory of the destination quad-tree (and its allocator), never the memory
+         * of the source one.
+         */
+        QuadTree(const QuadTree& other) noexcept;
+        QuadTree& operator=(const QuadTree& other) noexcept;
+        ~QuadTree() noexcept = default;
+
         /**
          * @brief Init is a method that initialize the quad-tree by allocating the needed amount of memory to
          * store the quad-nodes.
+         * @param colliderCount The number of colliders to reserve memory for.
          */
-        void Init() noexcept;
+        void Init(std::size_t colliderCount = 0) noexcept;
 
         /**
-         * @brief Insert is a method that insert a collider (in its simplified shape) in the quad-tree from its
-         * root node.
+         * @brief Insert is a method that insert a collider (in its simplified shape) in the quad-tree.
+         * @note The colliders are distributed in the nodes when the possible pairs are calculated.
          * @param simplifiedShape The simplified shape of the collider (aka its shape in rectangle).
          * @param colliderRef The collider reference in the world.
+         * @param filter The collision filter of the collider, the pairs it should not touch are not emitted.
          */
-        void Insert(Math::RectangleF simplifiedShape, ColliderRef colliderRef) noexcept;
+        void Insert(Math::RectangleF simplifiedShape, ColliderRef colliderRef, CollisionFilter filter = {}) noexcept;
+
+        /**
+         * @brief Build is a method that distributes the inserted colliders in the nodes of the quad-tree
+         * from its root node. It does nothing if the tree is already built.
+         */
+        void Build() noexcept;
 
         /**
          * @brief CalculatePossiblePairs is a method which calculates the potential pairs of colliders in each
@@ -140,6 +229,43 @@ namespace PhysicsEngine
          */
         [[nodiscard]] const QuadNode& RootNode() const noexcept { return _nodes[0]; }
 
+        /**
+         * @brief Node is a method that gives the node at the index given in parameter.
+         * @param nodeIdx The index of the node in the node array.
+         * @return The node at the index given in parameter.
+         */
+        [[nodiscard]] const QuadNode& Node(const std::uint32_t nodeIdx) const noexcept { return _nodes[nodeIdx]; }
+
+        /**
+         * @brief NodeBoundary is a method that gives the boundary of the node at the index given in parameter.
+         * @param nodeIdx The index of the node in the node array.
+         * @return The boundary of the node.
+         */
+        [[nodiscard]] Math::RectangleF NodeBoundary(std::uint32_t nodeIdx) const noexcept
+        {
+            return { Math::Vec2F(_nodeMinX[nodeIdx], _nodeMinY[nodeIdx]),
+                     Math::Vec2F(_nodeMaxX[nodeIdx], _nodeMaxY[nodeIdx]) };
+        }
+
+        /**
+         * @brief NodeCount is a method that gives the number of nodes used by the quad-tree.
+         * @return The number of nodes used by the quad-tree.
+         */
+        [[nodiscard]] std::uint32_t NodeCount() const noexcept { return _nodeIndex; }
+
+        /**
+         * @brief ColliderAt is a method that gives the collider at the index given in parameter in the collider
+         * array of the built quad-tree (see QuadNode::ColliderOffset).
+         * @param colIdx The index of the collider in the collider array.
+         * @return The collider in its simplified shape.
+         */
+        [[nodiscard]] SimplifiedCollider ColliderAt(std::size_t colIdx) const noexcept
+        {
+            return { _colliderRefs[colIdx],
+                     Math::RectangleF(Math::Vec2F(_colMinX[colIdx], _colMinY[colIdx]),
+                                      Math::Vec2F(_colMaxX[colIdx], _colMaxY[colIdx])) };
+        }
+
         /**
          * @brief SetRoodNodeBoundary is a method that sets the boundary of the root node (aka the first space
          * subdivision) to the new one given in parameter.
@@ -147,7 +273,10 @@ namespace PhysicsEngine
          */
         void SetRootNodeBoundary(const Math::RectangleF boundary) noexcept
         {
-            _nodes[0].Boundary = boundary;
+            _nodeMinX[0] = boundary.MinBound().X;
+            _nodeMinY[0] = boundary.MinBound().Y;
+            _nodeMaxX[0] = boundary.MaxBound().X;
+            _nodeMaxY[0] = boundary.MaxBound().Y;
         };
 
         /**
@@ -157,10 +286,69 @@ namespace PhysicsEngine
          */
         [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept { return _possiblePairs; }
 
+        /**
+         * @brief Query is a method that calls the visitor given in parameter with the reference of each collider
+         * of the built quad-tree whose simplified shape overlaps the box. The colliders can stick out of the
+         * root boundary, so the node sides lying on the root boundary are not used to skip a node.
+         * @note The quad-tree is not modified, so several threads can query it at once.
+         * @param bounds The box to look for colliders in.
+         * @param visitor The function called with the collider reference of each collider found.
+         */
+        template<typename Visitor>
+        void Query(const Math::RectangleF bounds, Visitor&& visitor) const noexcept
+        {
+            if (!_isBuilt) return;
+
+            const auto minBound = bounds.MinBound();
+            const auto maxBound = bounds.MaxBound();
+
+            // A node pops one entry and pushes its four children, so the stack holds at most three nodes per
+            // level plus the four children of the deepest subdivided node.
+            std::array<std::uint32_t, 3 * _maxDepth + QuadNode::BoundaryDivisionCount> stack{};
+            std::size_t stackSize = 0;
+
+            stack[stackSize++] = 0;
+
+            while (stackSize > 0)
+            {
+                const auto nodeIdx = stack[--stackSize];
+                const auto& node = _nodes[nodeIdx];
+
+                if (node.SubTreeColliderCount == 0) continue;
+
+                if (nodeIdx != 0 &&
+                    ((_nodeMaxX[nodeIdx] < minBound.X && _nodeMaxX[nodeIdx] != _nodeMaxX[0]) ||
+                     (_nodeMinX[nodeIdx] > maxBound.X && _nodeMinX[nodeIdx] != _nodeMinX[0]) ||
+                     (_nodeMaxY[nodeIdx] < minBound.Y && _nodeMaxY[nodeIdx] != _nodeMaxY[0]) ||
+                     (_nodeMinY[nodeIdx] > maxBound.Y && _nodeMinY[nodeIdx] != _nodeMinY[0])))
+                {
+                    continue;
+                }
+
+                for (auto i = node.ColliderOffset; i < node.ColliderOffset + node.ColliderCount; i++)
+                {
+                    if (_colMaxX[i] < minBound.X || _colMinX[i] > maxBound.X ||
+                        _colMaxY[i] < minBound.Y || _colMinY[i] > maxBound.Y)
+                    {
+                        continue;
+                    }
+
+                    visitor(_colliderRefs[i]);
+                }
+
+                if (!node.HasChildren()) continue;
+
+                for (auto childIt = node.Children.rbegin(); childIt != node.Children.rend(); ++childIt)
+                {
+                    stack[stackSize++] = *childIt;
+                }
+            }
+        }
+
         /**
          * @brief MaxDepth is a method that gives the maximum depth of the quad-tree recursive space subdivision.
          * @return The maximum depth of the quad-tree recursive space subdivision.
          */
         [[nodiscard]] static constexpr int MaxDepth() noexcept { return _maxDepth; }
     };
-}
\ No newline at end of file
+}
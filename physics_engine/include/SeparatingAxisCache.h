@@ -0,0 +1,84 @@
+/**
+ * @headerfile SeparatingAxisCache.h
+ * This header file defines the SeparatingAxisCache class which remembers the last axis that separated each
+ * pair of polygons, so that the narrow phase tests it first in the next frame.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Collider.h"
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief SeparatingAxisCache is a class that stores the last separating axis found for a pair of colliders
+     * in a direct-mapped table keyed by the hash of the pair: a pair whose slot is taken by another pair
+     * replaces it. An axis is only a hint (the pair is fully tested if it does not separate the colliders any
+     * more), so losing one never changes the result of the narrow phase.
+     * @note Find can be called from several threads at once, Store must be called from a single thread.
+     */
+    class SeparatingAxisCache
+    {
+    private:
+        /**
+         * @brief Slot is a struct that stores an entry of the table. A zero axis means that the slot is empty.
+         */
+        struct Slot
+        {
+            ColliderPair Key{};
+            Math::Vec2F Axis = Math::Vec2F::Zero();
+        };
+
+        AllocVector<Slot> _slots;
+
+        /**
+         * @brief MinSlotCount is the minimum number of slots of the table. It must be a power of two.
+         */
+        static constexpr std::size_t _minSlotCount = 64;
+
+    public:
+        explicit SeparatingAxisCache(Allocator& allocator) noexcept :
+            _slots{ StandardAllocator<Slot>{allocator} } {}
+
+        /**
+         * @brief Reserve is a method that grows the table so that the number of pairs given in parameter
+         * rarely share a slot. The stored axes are lost if the table grows.
+         * @param pairCount The number of pairs which may be stored.
+         */
+        void Reserve(std::size_t pairCount) noexcept;
+
+        /**
+         * @brief Find is a method that gives the last separating axis stored for the pair.
+         * @param pair The pair of colliders to look for.
+         * @return The separating axis of the pair, or a zero vector if none is stored.
+         */
+        [[nodiscard]] Math::Vec2F Find(const ColliderPair& pair) const noexcept;
+
+        /**
+         * @brief Store is a method that stores the separating axis of the pair, in place of the axis of the
+         * pair which had the same slot.
+         * @param pair The pair of colliders separated by the axis.
+         * @param axis The separating axis.
+         */
+        void Store(const ColliderPair& pair, Math::Vec2F axis) noexcept;
+
+        /**
+         * @brief Clear is a method that removes all axes from the cache but keeps its memory.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief Deinit is a method that removes all axes from the cache and releases its memory.
+         */
+        void Deinit() noexcept;
+
+        /**
+         * @brief SlotCount is a method that gives the number of slots of the table.
+         * @return The number of slots of the table.
+         */
+        [[nodiscard]] std::size_t SlotCount() const noexcept { return _slots.size(); }
+    };
+}
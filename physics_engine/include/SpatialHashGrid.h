@@ -0,0 +1,228 @@
+/**
+ * @headerfile SpatialHashGrid.h
+ * This header file defines the SpatialHashGrid class which is a broad phase that divides the world
+ * in uniform cells and only compares the colliders which share a cell.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Collider.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief SpatialHashGrid is a class that computes the possible pairs of colliders with a uniform grid
+     * whose cells are hashed in a fixed number of buckets, so the world does not need to be bounded.
+     * The grid is rebuilt each frame with a counting sort: the entries (a collider in a cell) are counted
+     * per bucket, then scattered in one contiguous array, so no cell owns any memory.
+     * A collider larger than a cell (like a wall) is inserted in all the cells it covers. A pair is only
+     * emitted in the cell containing the min corner of the intersection of the two boxes, which is covered
+     * by both colliders, so a pair is never emitted twice and no deduplication is needed.
+     */
+    class SpatialHashGrid
+    {
+    private:
+        /**
+         * @brief Item is a struct that stores a collider inserted in the grid and the range of cells
+         * it covers.
+         */
+        struct Item
+        {
+            ColliderRef ColRef{0, 0};
+            Math::Vec2F MinBound = Math::Vec2F::Zero();
+            Math::Vec2F MaxBound = Math::Vec2F::Zero();
+            CollisionFilter Filter{};
+            std::int32_t MinCellX = 0;
+            std::int32_t MinCellY = 0;
+            std::int32_t MaxCellX = 0;
+            std::int32_t MaxCellY = 0;
+        };
+
+        /**
+         * @brief Entry is a struct that stores a collider in a cell.
+         */
+        struct Entry
+        {
+            std::uint32_t ItemIdx = 0;
+            std::int32_t CellX = 0;
+            std::int32_t CellY = 0;
+        };
+
+        AllocVector<Item> _items;
+        AllocVector<Entry> _entries;
+        AllocVector<std::uint32_t> _bucketStarts;
+        AllocVector<ColliderPair> _possiblePairs;
+
+        float _cellSize = DefaultCellSize;
+        float _inverseCellSize = 1.f / DefaultCellSize;
+
+        /**
+         * @brief cellCoordinate is a method that gives the index of the cell containing the coordinate.
+         */
+        [[nodiscard]] std::int32_t cellCoordinate(float coordinate) const noexcept;
+
+        /**
+         * @brief bucketIndex is a method that gives the index of the bucket in which the cell is hashed.
+         */
+        [[nodiscard]] std::uint32_t bucketIndex(std::int32_t cellX, std::int32_t cellY) const noexcept;
+
+        /**
+         * @brief buildBuckets is a method that counts the entries of each bucket and scatters them in
+         * the entry array, so that the entries of a bucket are contiguous.
+         */
+        void buildBuckets() noexcept;
+
+    public:
+        /**
+         * @brief DefaultCellSize is the default size of a cell, which is the diameter of a player collider
+         * (the largest dynamic collider in the game).
+         */
+        static constexpr float DefaultCellSize = 0.52f;
+
+        explicit SpatialHashGrid(Allocator& allocator) noexcept :
+            _items{ StandardAllocator<Item>{allocator} },
+            _entries{ StandardAllocator<Entry>{allocator} },
+            _bucketStarts{ StandardAllocator<std::uint32_t>{allocator} },
+            _possiblePairs{ StandardAllocator<ColliderPair>{allocator} } {}
+
+        /**
+         * @brief Init is a method that allocates the memory needed to store the number of colliders given
+         * in parameter and sets the size of the cells.
+         * @param colliderCount The number of colliders to reserve memory for.
+         * @param cellSize The size of a cell, it should be close to the size of the typical collider.
+         */
+        void Init(std::size_t colliderCount, float cellSize = DefaultCellSize) noexcept;
+
+        /**
+         * @brief Insert is a method that adds a collider (in its simplified shape) to the grid.
+         * @note The colliders are distributed in the cells when the possible pairs are calculated.
+         * @param simplifiedShape The simplified shape of the collider (aka its shape in rectangle).
+         * @param colliderRef The collider reference in the world.
+         * @param filter The collision filter of the collider, the pairs it should not touch are not emitted.
+         */
+        void Insert(Math::RectangleF simplifiedShape, ColliderRef colliderRef, CollisionFilter filter = {}) noexcept;
+
+        /**
+         * @brief CalculatePossiblePairs is a method that distributes the inserted colliders in the cells and
+         * calculates the pairs of colliders whose simplified shapes overlap.
+         */
+        void CalculatePossiblePairs() noexcept;
+
+        /**
+         * @brief Clear is a method that removes all colliders from the grid but keeps its memory.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief Deinit is a method that removes all colliders from the grid and releases its memory.
+         */
+        void Deinit() noexcept;
+
+        /**
+         * @brief PossiblePairs is a method that gives the possible pairs of collider whose simplified shapes
+         * touch each other.
+         * @return The possible pairs of collider whose simplified shapes touch each other.
+         */
+        [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept { return _possiblePairs; }
+
+        /**
+         * @brief Query is a method that calls the visitor given in parameter with the reference of each collider
+         * whose simplified shape (as inserted in the last frame) overlaps the box. Like a pair, a collider is
+         * only visited in the cell containing the min corner of its intersection with the box. A box covering
+         * more cells than there are colliders tests all the colliders instead.
+         * @note The grid is not modified, so several threads can query it at once.
+         * @param bounds The box to look for colliders in.
+         * @param visitor The function called with the collider reference of each collider found.
+         */
+        template<typename Visitor>
+        void Query(const Math::RectangleF bounds, Visitor&& visitor) const noexcept
+        {
+            if (_entries.empty()) return;
+
+            const auto minBound = bounds.MinBound();
+            const auto maxBound = bounds.MaxBound();
+
+            const auto overlaps = [&minBound, &maxBound](const Item& item)
+            {
+                return !(item.MaxBound.X < minBound.X || item.MinBound.X > maxBound.X ||
+                         item.MaxBound.Y < minBound.Y || item.MinBound.Y > maxBound.Y);
+            };
+
+            const auto minCellX = cellCoordinate(minBound.X);
+            const auto minCellY = cellCoordinate(minBound.Y);
+            const auto maxCellX = cellCoordinate(maxBound.X);
+            const auto maxCellY = cellCoordinate(maxBound.Y);
+
+            const auto cellCount = (static_cast<double>(maxCellX) - minCellX + 1) *
+                                   (static_cast<double>(maxCellY) - minCellY + 1);
+
+            if (cellCount > static_cast<double>(_items.size()))
+            {
+                for (const auto& item : _items)
+                {
+                    if (overlaps(item))
+                    {
+                        visitor(item.ColRef);
+                    }
+                }
+
+                return;
+            }
+
+            for (auto cellY = minCellY; cellY <= maxCellY; cellY++)
+            {
+                for (auto cellX = minCellX; cellX <= maxCellX; cellX++)
+                {
+                    const auto bucket = bucketIndex(cellX, cellY);
+
+                    for (auto i = _bucketStarts[bucket]; i < _bucketStarts[bucket + 1]; i++)
+                    {
+                        const auto& entry = _entries[i];
+
+                        // Different cells can be hashed in the same bucket.
+                        if (entry.CellX != cellX || entry.CellY != cellY) continue;
+
+                        const auto& item = _items[entry.ItemIdx];
+
+                        if (!overlaps(item)) continue;
+
+                        if (cellCoordinate(std::max(item.MinBound.X, minBound.X)) != cellX ||
+                            cellCoordinate(std::max(item.MinBound.Y, minBound.Y)) != cellY)
+                        {
+                            continue;
+                        }
+
+                        visitor(item.ColRef);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief CellSize is a method that gives the size of the cells of the grid.
+         * @return The size of the cells of the grid.
+         */
+        [[nodiscard]] float CellSize() const noexcept { return _cellSize; }
+
+        /**
+         * @brief EntryCount is a method that gives the number of (collider, cell) entries of the last build.
+         * @return The number of entries of the last build.
+         */
+        [[nodiscard]] std::size_t EntryCount() const noexcept { return _entries.size(); }
+
+        /**
+         * @brief BucketCount is a method that gives the number of buckets in which the cells are hashed.
+         * @return The number of buckets.
+         */
+        [[nodiscard]] std::size_t BucketCount() const noexcept
+        {
+            return _bucketStarts.empty() ? 0 : _bucketStarts.size() - 1;
+        }
+    };
+}
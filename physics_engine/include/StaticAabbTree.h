@@ -0,0 +1,182 @@
+/**
+ * @headerfile StaticAabbTree.h
+ * This header file defines the StaticAabbTree class which stores the colliders of the static bodies in a
+ * bounding volume hierarchy built once, against which the moving colliders are queried at each frame.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Collider.h"
+
+#include <array>
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief StaticAabbTree is a class that stores the bounds of the static colliders in a bounding volume
+     * hierarchy built top-down by splitting the colliders at the median of the longest axis. The tree is only
+     * built when the static colliders change: between two builds, the moving colliders are queried against it
+     * and the pairs between two static colliders are never generated.
+     * @note Query can be called from several threads at once, Insert and Build must be called from a single thread.
+     */
+    class StaticAabbTree
+    {
+    public:
+        /**
+         * @brief MaxLeafSize is the maximum number of colliders stored in a leaf of the tree.
+         */
+        static constexpr std::uint32_t MaxLeafSize = 4;
+
+    private:
+        /**
+         * @brief Item is a struct that stores the bounds and the filter of a static collider.
+         */
+        struct Item
+        {
+            ColliderRef ColRef{0, 0};
+            Math::Vec2F MinBound = Math::Vec2F::Zero();
+            Math::Vec2F MaxBound = Math::Vec2F::Zero();
+            CollisionFilter Filter{};
+        };
+
+        /**
+         * @brief TreeNode is a struct that stores a node of the tree. A leaf stores the items [First, First +
+         * Count) and an internal node (with a count of 0) has its two children at the indices First and
+         * First + 1.
+         */
+        struct TreeNode
+        {
+            Math::Vec2F MinBound = Math::Vec2F::Zero();
+            Math::Vec2F MaxBound = Math::Vec2F::Zero();
+            std::uint32_t First = 0;
+            std::uint32_t Count = 0;
+
+            [[nodiscard]] constexpr bool IsLeaf() const noexcept { return Count != 0; }
+        };
+
+        AllocVector<Item> _items;
+        AllocVector<TreeNode> _nodes;
+
+        /**
+         * @brief MaxDepth is the maximum depth of the tree, the median splits keep it logarithmic.
+         */
+        static constexpr std::uint32_t _maxDepth = 64;
+
+        [[nodiscard]] static constexpr bool overlap(const Math::Vec2F minA, const Math::Vec2F maxA,
+                                                    const Math::Vec2F minB, const Math::Vec2F maxB) noexcept
+        {
+            return !(maxA.X < minB.X || minA.X > maxB.X || maxA.Y < minB.Y || minA.Y > maxB.Y);
+        }
+
+        /**
+         * @brief buildNode is a method that fits the node given in parameter to its items and splits it in
+         * two children if it has too many items.
+         * @param nodeIdx The index of the node to build.
+         */
+        void buildNode(std::uint32_t nodeIdx) noexcept;
+
+    public:
+        explicit StaticAabbTree(Allocator& allocator) noexcept :
+            _items{ StandardAllocator<Item>{allocator} },
+            _nodes{ StandardAllocator<TreeNode>{allocator} } {}
+
+        /**
+         * @brief Insert is a method that adds a static collider to the tree. It is only queried after the
+         * next call to Build.
+         * @param simplifiedShape The simplified shape of the collider (aka its shape in rectangle).
+         * @param colliderRef The collider reference in the world.
+         * @param filter The collision filter of the collider, the pairs it should not touch are not emitted.
+         */
+        void Insert(Math::RectangleF simplifiedShape, ColliderRef colliderRef, CollisionFilter filter = {}) noexcept;
+
+        /**
+         * @brief Build is a method that builds the tree from all the colliders inserted since the last call
+         * to Clear. The colliders are sorted by collider index first, so the tree does not depend on the
+         * insertion order.
+         */
+        void Build() noexcept;
+
+        /**
+         * @brief Query is a method that adds to the pairs given in parameter the pairs of the moving collider
+         * with each static collider whose simplified shape overlaps its own.
+         * @param simplifiedShape The simplified shape of the moving collider.
+         * @param colliderRef The collider reference of the moving collider in the world.
+         * @param filter The collision filter of the moving collider.
+         * @param pairs The pairs to add the pairs found to, the lower collider index is always the first one.
+         */
+        void Query(Math::RectangleF simplifiedShape, ColliderRef colliderRef, CollisionFilter filter,
+                   AllocVector<ColliderPair>& pairs) const noexcept;
+
+        /**
+         * @brief Query is a method that calls the visitor given in parameter with the reference and the filter
+         * of each static collider whose simplified shape overlaps the box.
+         * @param bounds The box to look for static colliders in.
+         * @param visitor The function called with the collider reference and the collision filter of each
+         * static collider found.
+         */
+        template<typename Visitor>
+        void Query(const Math::RectangleF bounds, Visitor&& visitor) const noexcept
+        {
+            if (_nodes.empty()) return;
+
+            const auto minBound = bounds.MinBound();
+            const auto maxBound = bounds.MaxBound();
+
+            // The stack is on the stack of the calling thread, so several threads can query the tree at once.
+            std::array<std::uint32_t, _maxDepth> stack{};
+            std::uint32_t stackSize = 0;
+
+            stack[stackSize++] = 0;
+
+            while (stackSize > 0)
+            {
+                const auto& node = _nodes[stack[--stackSize]];
+
+                if (!overlap(minBound, maxBound, node.MinBound, node.MaxBound)) continue;
+
+                if (!node.IsLeaf())
+                {
+                    stack[stackSize++] = node.First + 1;
+                    stack[stackSize++] = node.First;
+                    continue;
+                }
+
+                for (auto i = node.First; i < node.First + node.Count; i++)
+                {
+                    const auto& item = _items[i];
+
+                    if (overlap(minBound, maxBound, item.MinBound, item.MaxBound))
+                    {
+                        visitor(item.ColRef, item.Filter);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Clear is a method that removes all colliders from the tree but keeps its memory.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief Deinit is a method that removes all colliders from the tree and releases its memory.
+         */
+        void Deinit() noexcept;
+
+        /**
+         * @brief ColliderCount is a method that gives the number of static colliders in the tree.
+         * @return The number of static colliders in the tree.
+         */
+        [[nodiscard]] std::size_t ColliderCount() const noexcept { return _items.size(); }
+
+        /**
+         * @brief NodeCount is a method that gives the number of nodes of the tree.
+         * @return The number of nodes of the tree, 0 if it is not built or empty.
+         */
+        [[nodiscard]] std::size_t NodeCount() const noexcept { return _nodes.size(); }
+    };
+}
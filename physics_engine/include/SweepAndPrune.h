@@ -0,0 +1,202 @@
+/**
+ * @headerfile SweepAndPrune.h
+ * This header file defines the SweepAndPrune class which is a broad phase that sorts the bounds of the
+ * colliders along each axis and sweeps one of them to find the colliders whose bounds overlap.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Collider.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief SweepAndPrune is a class that computes the possible pairs of colliders with a sort-and-sweep
+     * algorithm. Each collider is a proxy (keyed by its index in the world) with two endpoints (min and max)
+     * on each axis. The endpoint lists are kept from one frame to the next and re-sorted with an insertion
+     * sort, which is almost linear because the bodies only move a little between two frames.
+     * @note The endpoints are sorted with a total order (value, then min before max, then proxy index),
+     * so the sorted lists, and therefore the possible pairs, only depend on the current bounds and never
+     * on the history of the lists.
+     */
+    class SweepAndPrune
+    {
+    private:
+        /**
+         * @brief Proxy is a struct that stores the bounds of a collider inserted in the sweep-and-prune.
+         * A stamp of 0 means that the proxy is not used.
+         */
+        struct Proxy
+        {
+            ColliderRef ColRef{0, 0};
+            std::array<float, 2> Min{};
+            std::array<float, 2> Max{};
+            CollisionFilter Filter{};
+            std::uint32_t Stamp = 0;
+            bool InLists = false;
+        };
+
+        /**
+         * @brief Endpoint is a struct that stores a bound of a proxy on an axis. The lowest bit of the data
+         * tells if it is the max bound, the other bits are the index of the proxy.
+         */
+        struct Endpoint
+        {
+            float Value = 0.f;
+            std::uint32_t Data = 0;
+
+            [[nodiscard]] constexpr std::uint32_t ProxyIdx() const noexcept { return Data >> 1; }
+            [[nodiscard]] constexpr bool IsMax() const noexcept { return (Data & 1) != 0; }
+
+            [[nodiscard]] constexpr bool operator<(const Endpoint& other) const noexcept
+            {
+                // Min endpoints come before max endpoints of the same value so that touching bounds overlap.
+                if (Value != other.Value) return Value < other.Value;
+                if (IsMax() != other.IsMax()) return other.IsMax();
+                return ProxyIdx() < other.ProxyIdx();
+            }
+        };
+
+        static constexpr int _axisCount = 2;
+
+        AllocVector<Proxy> _proxies;
+        std::array<AllocVector<Endpoint>, _axisCount> _endpoints;
+
+        // Proxies overlapping the sweep position and position of each proxy in this list.
+        AllocVector<std::uint32_t> _activeProxies;
+        AllocVector<std::uint32_t> _activePositions;
+
+        AllocVector<ColliderPair> _possiblePairs;
+
+        std::size_t _proxyCount = 0;
+        std::uint32_t _frame = 1;
+        int _sweepAxis = 0;
+
+        /**
+         * @brief updateEndpoints is a method that removes the endpoints of the proxies which were not
+         * inserted in the current frame, adds the ones of the new proxies and copies the current bounds
+         * of the proxies in the endpoints.
+         */
+        void updateEndpoints() noexcept;
+
+        /**
+         * @brief sortEndpoints is a method that sorts the endpoints of the axis given in parameter. It uses
+         * an insertion sort, unless a lot of endpoints were added since the last frame.
+         * @param axis The axis to sort.
+         * @param addedCount The number of endpoints added to the axis since the last frame.
+         */
+        void sortEndpoints(int axis, std::size_t addedCount) noexcept;
+
+        /**
+         * @brief sweep is a method that goes through the endpoints of the sweep axis and tests each proxy
+         * which starts against the proxies which have started but not ended yet.
+         */
+        void sweep() noexcept;
+
+    public:
+        explicit SweepAndPrune(Allocator& allocator) noexcept :
+            _proxies{ StandardAllocator<Proxy>{allocator} },
+            _endpoints{ AllocVector<Endpoint>{ StandardAllocator<Endpoint>{allocator} },
+                        AllocVector<Endpoint>{ StandardAllocator<Endpoint>{allocator} } },
+            _activeProxies{ StandardAllocator<std::uint32_t>{allocator} },
+            _activePositions{ StandardAllocator<std::uint32_t>{allocator} },
+            _possiblePairs{ StandardAllocator<ColliderPair>{allocator} } {}
+
+        /**
+         * @brief Init is a method that allocates the memory needed to store the number of colliders given
+         * in parameter.
+         * @param colliderCount The number of colliders to reserve memory for.
+         */
+        void Init(std::size_t colliderCount) noexcept;
+
+        /**
+         * @brief Insert is a method that sets the bounds of the collider (in its simplified shape) for the
+         * current frame. A collider which is not inserted before the next call to CalculatePossiblePairs is
+         * removed from the sweep-and-prune.
+         * @param simplifiedShape The simplified shape of the collider (aka its shape in rectangle).
+         * @param colliderRef The collider reference in the world.
+         * @param filter The collision filter of the collider, the pairs it should not touch are not emitted.
+         */
+        void Insert(Math::RectangleF simplifiedShape, ColliderRef colliderRef, CollisionFilter filter = {}) noexcept;
+
+        /**
+         * @brief CalculatePossiblePairs is a method that re-sorts the endpoints of the colliders inserted
+         * in the current frame and calculates the pairs of colliders whose simplified shapes overlap.
+         */
+        void CalculatePossiblePairs() noexcept;
+
+        /**
+         * @brief Clear is a method that removes all colliders from the sweep-and-prune but keeps its memory.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief Deinit is a method that removes all colliders from the sweep-and-prune and releases
+         * its memory.
+         */
+        void Deinit() noexcept;
+
+        /**
+         * @brief PossiblePairs is a method that gives the possible pairs of collider whose simplified shapes
+         * touch each other.
+         * @return The possible pairs of collider whose simplified shapes touch each other.
+         */
+        [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept { return _possiblePairs; }
+
+        /**
+         * @brief Query is a method that calls the visitor given in parameter with the reference of each collider
+         * whose simplified shape (as inserted in the last frame) overlaps the box. The sorted endpoints of the
+         * sweep axis are only read up to the first collider starting after the box.
+         * @note The sweep-and-prune is not modified, so several threads can query it at once.
+         * @param bounds The box to look for colliders in.
+         * @param visitor The function called with the collider reference of each collider found.
+         */
+        template<typename Visitor>
+        void Query(const Math::RectangleF bounds, Visitor&& visitor) const noexcept
+        {
+            const std::array<float, _axisCount> minBound = { bounds.MinBound().X, bounds.MinBound().Y };
+            const std::array<float, _axisCount> maxBound = { bounds.MaxBound().X, bounds.MaxBound().Y };
+
+            const auto& endpoints = _endpoints[_sweepAxis];
+            const auto end = std::upper_bound(endpoints.begin(), endpoints.end(), maxBound[_sweepAxis],
+                                              [](const float value, const Endpoint& endpoint)
+            {
+                return value < endpoint.Value;
+            });
+
+            for (auto it = endpoints.begin(); it != end; ++it)
+            {
+                if (it->IsMax()) continue;
+
+                const auto& proxy = _proxies[it->ProxyIdx()];
+
+                if (proxy.Max[0] < minBound[0] || proxy.Min[0] > maxBound[0] ||
+                    proxy.Max[1] < minBound[1] || proxy.Min[1] > maxBound[1])
+                {
+                    continue;
+                }
+
+                visitor(proxy.ColRef);
+            }
+        }
+
+        /**
+         * @brief ProxyCount is a method that gives the number of colliders in the sweep-and-prune.
+         * @return The number of colliders in the sweep-and-prune.
+         */
+        [[nodiscard]] std::size_t ProxyCount() const noexcept { return _proxyCount; }
+
+        /**
+         * @brief SweepAxis is a method that gives the axis swept in the last frame (0 for x and 1 for y).
+         * @return The axis swept in the last frame.
+         */
+        [[nodiscard]] int SweepAxis() const noexcept { return _sweepAxis; }
+    };
+}
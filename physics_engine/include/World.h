@@ -6,81 +6,571 @@
 
 #pragma once
 
+#include "AabbTree.h"
 #include "Body.h"
 #include "Collider.h"
+#include "ContactCache.h"
+#include "ContactConstraintSolver.h"
 #include "ContactSolver.h"
 #include "ContactListener.h"
+#include "ContinuousCollision.h"
+#include "ConvexPolygon.h"
+#include "FixedVector.h"
+#include "FreeList.h"
+#include "Hash.h"
+#include "JobSystem.h"
+#include "PagedVector.h"
 #include "QuadTree.h"
+#include "SeparatingAxisCache.h"
+#include "SpatialHashGrid.h"
+#include "StaticAabbTree.h"
+#include "SweepAndPrune.h"
+#include "WorldConfig.h"
+#include "WorldQuery.h"
 #include "WorldRefTypes.h"
 
+#include <array>
+#include <type_traits>
 #include <vector>
-#include <unordered_set>
 
 namespace PhysicsEngine
 {
     /**
-     * @brief World is a class that contains all the physical bodies in the program and calculates
+     * @brief WorldStorage is the array type used by the world to store its bodies and colliders. With the
+     * PHYSICS_PAGED_STORAGE definition (USE_PAGED_WORLD_STORAGE CMake option), the elements are stored in pages
+     * which are never moved, so the references given by GetBody and GetCollider stay valid when the world grows.
+     */
+#ifdef PHYSICS_PAGED_STORAGE
+    template<typename T>
+    using WorldStorage = PagedVector<T>;
+#else
+    template<typename T>
+    using WorldStorage = AllocVector<T>;
+#endif // PHYSICS_PAGED_STORAGE
+
+    /**
+     * @brief WorldArray is the array type used by a world whose configuration gives the capacity in parameter:
+     * the elements are stored in place when the capacity is set, in a WorldStorage otherwise.
+     */
+    template<typename T, std::size_t Capacity>
+    using WorldArray = std::conditional_t<Capacity == 0, WorldStorage<T>, FixedVector<T, Capacity>>;
+
+    /**
+     * @brief BasicWorld is a class that contains all the physical bodies in the program and calculates
      * their movements and changes in physical state.
+     * @tparam Config The configuration of the world chosen at compile time (see DefaultWorldConfig). The
+     * methods are defined in WorldImpl.h, which must be included where a new configuration is instantiated.
      */
-    class World
+    template<typename Config = DefaultWorldConfig>
+    class BasicWorld
     {
+        static_assert(std::is_same_v<typename Config::Scalar, float>, "The world only supports float scalars.");
+        static_assert(std::is_base_of_v<Allocator, typename Config::AllocatorType>,
+                      "The allocator of the world must inherit from Allocator.");
+        static_assert((Config::BroadPhaseTypes & BroadPhaseTypeBit(Config::DefaultBroadPhase)) != 0,
+                      "The default broad phase must be one of the broad phases of the world.");
+
+    public:
+        /**
+         * @brief State is a struct that stores what the simulation carries from one update to the next: the
+         * bodies, the colliders, their generations and unused slots, and the contact cache. The rest of the world
+         * (broad phases, static collider tree, narrow phase and solver arrays) is scratch rebuilt from it.
+         * @note When the configuration sets the capacities of the bodies, colliders and contacts, the state is
+         * stored in place and is trivially copyable, so that a snapshot is saved and restored with a memcpy.
+         */
+        struct State
+        {
+            WorldArray<Body, Config::MaxBodyCount> Bodies;
+            WorldArray<std::size_t, Config::MaxBodyCount> BodiesGenIndices;
+            BasicFreeList<Config::MaxBodyCount> FreeBodies;
+
+            WorldArray<Collider, Config::MaxColliderCount> Colliders;
+            WorldArray<std::size_t, Config::MaxColliderCount> CollidersGenIndices;
+            BasicFreeList<Config::MaxColliderCount> FreeColliders;
+
+            BasicContactCache<Config::MaxContactCount> PairCache;
+
+            State() noexcept = default;
+
+            explicit State(Allocator& allocator) noexcept :
+                Bodies{ StandardAllocator<Body>{allocator} },
+                BodiesGenIndices{ StandardAllocator<std::size_t>{allocator} },
+                FreeBodies{ allocator },
+                Colliders{ StandardAllocator<Collider>{allocator} },
+                CollidersGenIndices{ StandardAllocator<std::size_t>{allocator} },
+                FreeColliders{ allocator },
+                PairCache{ allocator } {}
+        };
+
+        /**
+         * @brief IsStateTriviallyCopyable is true if the state of the world is saved and restored with a memcpy.
+         */
+        static constexpr bool IsStateTriviallyCopyable = std::is_trivially_copyable_v<State>;
+
     private:
+        /**
+         * @brief DynamicBodyLanes is a struct that stores the state of the dynamic bodies in structure of arrays
+         * (one array per coordinate) so that they can be integrated four at a time. The arrays are padded
+         * to a multiple of four with bodies without mass.
+         */
+        struct DynamicBodyLanes
+        {
+            AllocVector<float> PositionsX;
+            AllocVector<float> PositionsY;
+            AllocVector<float> VelocitiesX;
+            AllocVector<float> VelocitiesY;
+            AllocVector<float> ForcesX;
+            AllocVector<float> ForcesY;
+            AllocVector<float> ImpulsesX;
+            AllocVector<float> ImpulsesY;
+            AllocVector<float> InverseMasses;
+            AllocVector<float> Dampings;
+
+            explicit DynamicBodyLanes(Allocator& allocator) noexcept :
+                PositionsX{ StandardAllocator<float>{allocator} },
+                PositionsY{ StandardAllocator<float>{allocator} },
+                VelocitiesX{ StandardAllocator<float>{allocator} },
+                VelocitiesY{ StandardAllocator<float>{allocator} },
+                ForcesX{ StandardAllocator<float>{allocator} },
+                ForcesY{ StandardAllocator<float>{allocator} },
+                ImpulsesX{ StandardAllocator<float>{allocator} },
+                ImpulsesY{ StandardAllocator<float>{allocator} },
+                InverseMasses{ StandardAllocator<float>{allocator} },
+                Dampings{ StandardAllocator<float>{allocator} } {}
+
+            /**
+             * @brief Resize is a method that resizes all the arrays to the lane count given in parameter.
+             */
+            void Resize(std::size_t laneCount) noexcept;
+        };
+
+        /**
+         * @brief BulletMotion is a struct that stores a bullet collider and the position of its body before
+         * the integration.
+         */
+        struct BulletMotion
+        {
+            std::uint32_t ColliderIdx = 0;
+            Math::Vec2F StartPosition = Math::Vec2F::Zero();
+        };
+
+        /**
+         * @brief StaticColliderRecord is a struct that stores what the static collider tree knows about a
+         * collider: if it is in the tree, and the generation and body position it was inserted with.
+         */
+        struct StaticColliderRecord
+        {
+            std::size_t GenerationIdx = 0;
+            Math::Vec2F Position = Math::Vec2F::Zero();
+            bool IsStatic = false;
+        };
+
         Math::Vec2F _gravity;
 
-        HeapAllocator _heapAllocator{};
+        typename Config::AllocatorType _heapAllocator{};
+
+        JobSystem _jobSystem{};
+
+        State _state{ _heapAllocator };
+
+        /**
+         * @brief The indices of the valid bodies grouped by body type, rebuilt at each update because the
+         * type of a body can be changed through its reference at any time.
+         */
+        AllocVector<std::uint32_t> _dynamicBodyIndices{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+        AllocVector<std::uint32_t> _kinematicBodyIndices{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+
+        DynamicBodyLanes _dynamicBodyLanes{ _heapAllocator };
+
+        static constexpr int _shapeTypeCount = static_cast<int>(Math::ShapeType::None);
+        static constexpr int _shapePairBucketCount = _shapeTypeCount * _shapeTypeCount;
+
+        using ShapePairBucketStarts = std::array<std::uint32_t, _shapePairBucketCount + 1>;
+
+        /**
+         * @brief The indices of the possible pairs sorted by shape pair bucket, the bucket of each pair and
+         * if each pair overlaps, used by the narrow phase.
+         */
+        AllocVector<std::uint32_t> _narrowPhaseOrder{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+        AllocVector<std::uint8_t> _pairBuckets{ StandardAllocator<std::uint8_t>{_heapAllocator} };
+        AllocVector<std::uint8_t> _pairOverlaps{ StandardAllocator<std::uint8_t>{_heapAllocator} };
+
+        /**
+         * @brief The separating axis found in the frame for each pair of polygons (or of a polygon and a
+         * rectangle), a zero vector if none was found, and the last separating axis of these pairs, tested first
+         * in the next frame.
+         */
+        AllocVector<Math::Vec2F> _pairSeparatingAxes{ StandardAllocator<Math::Vec2F>{_heapAllocator} };
+        SeparatingAxisCache _separatingAxisCache{ _heapAllocator };
+
+        /**
+         * @brief The events of the contacts and of the exited pairs of the contact cache, at the index of
+         * their contact.
+         */
+        AllocVector<ContactEventType> _contactEvents{ StandardAllocator<ContactEventType>{_heapAllocator} };
+        AllocVector<ContactEventType> _exitEvents{ StandardAllocator<ContactEventType>{_heapAllocator} };
+
+        /**
+         * @brief The contact events of the last update, in the order of the contact cache followed by the exited
+         * pairs. The buffer is cleared at the beginning of each update.
+         */
+        AllocVector<ContactEvent> _contactEventBuffer{ StandardAllocator<ContactEvent>{_heapAllocator} };
+
+        /**
+         * @brief The manifolds of the collision contacts and the index of their constraint in the solver, at the
+         * index of their contact.
+         */
+        AllocVector<ContactManifold> _contactManifolds{ StandardAllocator<ContactManifold>{_heapAllocator} };
+        AllocVector<std::uint32_t> _contactConstraints{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+
+        ContactConstraintSolver _contactConstraintSolver{ _heapAllocator };
+
+        int _velocityIterationCount = 8;
+        int _positionIterationCount = 3;
+
+        /**
+         * @brief The pairs of the previous frame between sleeping bodies (or a sleeping and a static body),
+         * which are kept touching without being tested again.
+         */
+        AllocVector<ColliderPair> _sleepingPairs{ StandardAllocator<ColliderPair>{_heapAllocator} };
+
+        /**
+         * @brief The bullets moved in the frame.
+         */
+        AllocVector<BulletMotion> _bulletMotions{ StandardAllocator<BulletMotion>{_heapAllocator} };
+
+        /**
+         * @brief The indices of the enabled colliders of the dynamic and kinematic bodies, rebuilt at each
+         * update, and of the enabled colliders of the static bodies, rebuilt with the static collider tree.
+         */
+        AllocVector<std::uint32_t> _movingColliderIndices{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+        AllocVector<std::uint32_t> _staticColliderIndices{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+
+        /**
+         * @brief The static colliders, kept out of the broad phase in a tree which is only rebuilt when one of
+         * them is added, removed or moved, the record of each collider in the tree, and the pairs of the
+         * moving colliders with the static ones found in the frame.
+         */
+        StaticAabbTree _staticColliderTree{ _heapAllocator };
+        AllocVector<StaticColliderRecord> _staticColliderRecords{ StandardAllocator<StaticColliderRecord>{_heapAllocator} };
+        AllocVector<ColliderPair> _staticPairs{ StandardAllocator<ColliderPair>{_heapAllocator} };
+        bool _isStaticColliderTreeDirty = true;
+
+        /**
+         * @brief The pairs of the broad phase followed by the pairs with the static colliders.
+         */
+        AllocVector<ColliderPair> _possiblePairs{ StandardAllocator<ColliderPair>{_heapAllocator} };
+
+        /**
+         * @brief If the broad phase and the static collider tree hold all the colliders of the world, as they
+         * were at the last update. Otherwise the queries test all the colliders.
+         */
+        bool _isBroadPhaseUpToDate = false;
 
-        AllocVector<Body> _bodies{ StandardAllocator<Body>{_heapAllocator} };
-        AllocVector<std::size_t> _bodiesGenIndices{ StandardAllocator<std::size_t>{_heapAllocator} };
+        /**
+         * @brief The union-find parent of each body and the lowest sleep time of each island, at the index of
+         * the island root body.
+         */
+        AllocVector<std::uint32_t> _islandParents{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+        AllocVector<float> _islandSleepTimes{ StandardAllocator<float>{_heapAllocator} };
 
-        AllocVector<Collider> _colliders{ StandardAllocator<Collider>{_heapAllocator} };
-        AllocVector<std::size_t> _collidersGenIndices{ StandardAllocator<std::size_t>{_heapAllocator} };
+        /**
+         * @brief The collision layers which can touch each other, applied to the collision filters of the
+         * colliders when they are inserted in the broad phase.
+         */
+        CollisionMatrix _collisionMatrix{};
 
-        AllocVector<ColliderPair> _colliderPairs{ StandardAllocator<ColliderPair>{_heapAllocator} };
+        bool _isSleepingEnabled = true;
+        float _linearSleepTolerance = DefaultLinearSleepTolerance;
+        float _timeToSleep = DefaultTimeToSleep;
 
         ContactListener* _contactListener = nullptr;
+        bool _areContactEventsEnabled = false;
+
+        BroadPhaseType _broadPhaseType = BroadPhaseType::QuadTree;
 
         QuadTree _quadTree{};
+        SweepAndPrune _sweepAndPrune{ _heapAllocator };
+        AabbTree _aabbTree{ _heapAllocator };
+        SpatialHashGrid _spatialHashGrid{ _heapAllocator };
 
         /*
         * @brief BodyAllocResizeFactor is the factor to mulitply with 
         * the current size of a vector to allocate it a larger size.
         */
         static constexpr float _bodyAllocResizeFactor = 2.f;
+
+        /**
+         * @brief The number of bodies, pairs and contacts processed by a job of the job system. The chunks are
+         * large enough so that a job costs more than taking it.
+         */
+        static constexpr std::size_t _integrationChunkSize = 256;
+        static constexpr std::size_t _overlapChunkSize = 128;
+        static constexpr std::size_t _contactEventChunkSize = 512;
+        static constexpr std::size_t _bulletChunkSize = 64;
+
+        /**
+         * @brief ContinuousPenetration is the depth by which a bullet stopped at its time of impact is left
+         * inside the collider it hits, so that the narrow phase finds the contact and the solver bounces it.
+         * It is lower than the linear slop of the solver.
+         */
+        static constexpr float _continuousPenetration = 0.0025f;
+
+        /**
+         * @brief QueryMargin is the margin added around the box of a query in the broad phase, so that the
+         * colliders pushed by the contact solver after the broad phase are still found. It is the largest
+         * position correction of the solver in one iteration.
+         */
+        static constexpr float _queryMargin = 0.2f;
       
+        /*
+        * @brief GroupBodiesByType is a method that fills the index arrays of the awake dynamic and kinematic bodies.
+        */
+        void groupBodiesByType() noexcept;
+
+        /*
+        * @brief IntegrateDynamicBodies is a method that copies the dynamic bodies in the lanes, integrates them
+        * four at a time and copies the new positions and velocities back in the bodies.
+        * @param deltaTime The time elapsed between two consecutive frames.
+        */
+        void integrateDynamicBodies(float deltaTime) noexcept;
+
+        /*
+        * @brief IntegrateKinematicBodies is a method that moves the kinematic bodies according to their velocity.
+        * @param deltaTime The time elapsed between two consecutive frames.
+        */
+        void integrateKinematicBodies(float deltaTime) noexcept;
+
+        /*
+        * @brief GroupCollidersByType is a method that fills the index array of the enabled colliders of the
+        * dynamic and kinematic bodies and rebuilds the static collider tree if a static collider was added,
+        * removed or moved since its last build.
+        */
+        void groupCollidersByType() noexcept;
+
+        /*
+        * @brief BuildStaticColliderTree is a method that inserts all the static colliders of the records in
+        * the static collider tree and builds it.
+        */
+        void buildStaticColliderTree() noexcept;
+
+        /*
+        * @brief BeginContinuousCollisions is a method that stores the start position of the awake bullets
+        * before they are integrated.
+        */
+        void beginContinuousCollisions() noexcept;
+
+        /*
+        * @brief SolveContinuousCollisions is a method that sweeps each bullet from its start position to its
+        * integrated position against the static colliders. A bullet which hits one is moved back to its first
+        * time of impact, slightly inside the static collider, so that the narrow phase resolves the hit.
+        */
+        void solveContinuousCollisions() noexcept;
+
         /*
         * @brief ResolveBroadPhase is a method that reduces the number of potential collision pairs 
-        * to a manageable subset using a quad-tree.
+        * to a manageable subset using the broad phase chosen at Init.
         */
         void resolveBroadPhase() noexcept;
 
+        /*
+        * @brief CalculateSimplifiedShape is a method that calculates the rectangle bounding the collider
+        * given in parameter in world space.
+        * @param collider The collider to bound.
+        * @return The simplified shape of the collider.
+        */
+        [[nodiscard]] Math::RectangleF calculateSimplifiedShape(const Collider& collider) const noexcept;
+
+        /*
+        * @brief PossiblePairs is a method that gives the possible pairs computed by the broad phase chosen at Init
+        * and by the static collider tree.
+        */
+        [[nodiscard]] const AllocVector<ColliderPair>& possiblePairs() const noexcept;
+
+        /*
+        * @brief QueryColliders is a method that calls the visitor given in parameter with the reference and the
+        * collider of each enabled collider whose simplified shape may overlap the box, found with the static
+        * collider tree and the broad phase of the last update.
+        */
+        template<typename Visitor>
+        void queryColliders(Math::RectangleF bounds, Visitor&& visitor) const noexcept;
+
         /*
         * @brief ResolveNarrowPhase is a method that determines the precise details 
         * of the collisions between pairs of objects identified in the broad phase.
+        * @param deltaTime The time elapsed between two consecutive frames.
+        */
+        void resolveNarrowPhase(float deltaTime) noexcept;
+
+        /*
+        * @brief IsBroadPhaseEnabled is a method that checks if the broad phase given in parameter is compiled in
+        * the world configuration.
+        */
+        [[nodiscard]] static constexpr bool isBroadPhaseEnabled(BroadPhaseType type) noexcept
+        {
+            return (Config::BroadPhaseTypes & BroadPhaseTypeBit(type)) != 0;
+        }
+
+        /*
+        * @brief ActiveBroadPhaseType is a method that gives the broad phase used by the world. With a single broad phase
+        * in the configuration, it is a constant and the switches on it are resolved at compile time.
+        */
+        [[nodiscard]] constexpr BroadPhaseType activeBroadPhaseType() const noexcept
+        {
+            if constexpr ((Config::BroadPhaseTypes & (Config::BroadPhaseTypes - 1)) == 0)
+            {
+                return Config::DefaultBroadPhase;
+            }
+            else
+            {
+                return _broadPhaseType;
+            }
+        }
+
+        /*
+        * @brief IsShapeEnabled is a method that checks if the shape type given in parameter is tested by the
+        * narrow phase in the world configuration.
+        */
+        [[nodiscard]] static constexpr bool isShapeEnabled(Math::ShapeType type) noexcept
+        {
+            return type != Math::ShapeType::None && (Config::ShapeTypes & ShapeTypeBit(type)) != 0;
+        }
+
+        /*
+        * @brief ShapePairBucket is a method that gives the index of the bucket of the narrow phase in which
+        * the pairs of the two shape types given in parameter are tested.
+        * @return The index of the bucket or the bucket count if one of the shapes has no type or is not in the
+        * world configuration.
+        */
+        [[nodiscard]] static constexpr int shapePairBucket(Math::ShapeType typeA, Math::ShapeType typeB) noexcept
+        {
+            if (!isShapeEnabled(typeA) || !isShapeEnabled(typeB)) return _shapePairBucketCount;
+
+            return static_cast<int>(typeA) * _shapeTypeCount + static_cast<int>(typeB);
+        }
+
+        /*
+        * @brief DetectOverlaps is a method that sorts the pairs given in parameter by shape pair and checks
+        * which pairs overlap, bucket by bucket. The results are stored in the pair overlaps array.
+        * @param pairs The possible pairs of the broad phase.
+        */
+        void detectOverlaps(const AllocVector<ColliderPair>& pairs) noexcept;
+
+        /*
+        * @brief DetectOverlapsInRange is a method that checks which pairs of the range [begin, end) of the
+        * narrow phase order overlap. The range is split at the bucket limits.
+        * @param pairs The possible pairs of the broad phase.
+        * @param bucketStarts The index of the first pair of each bucket in the narrow phase order.
+        */
+        void detectOverlapsInRange(const AllocVector<ColliderPair>& pairs, const ShapePairBucketStarts& bucketStarts,
+                                   std::uint32_t begin, std::uint32_t end) noexcept;
+
+        /*
+        * @brief DetectBucketOverlaps is a method that checks which pairs of the bucket of the two shape types
+        * given in template parameter overlap, in the range [begin, end) of the narrow phase order.
+        * @param pairs The possible pairs of the broad phase.
+        * @param bucketStarts The index of the first pair of each bucket in the narrow phase order.
+        */
+        template<Math::ShapeType TypeA, Math::ShapeType TypeB>
+        void detectBucketOverlaps(const AllocVector<ColliderPair>& pairs, const ShapePairBucketStarts& bucketStarts,
+                                  std::uint32_t begin, std::uint32_t end) noexcept;
+
+        /*
+        * @brief GenerateContactEvents is a method that finds the event of each contact and of each exited pair
+        * of the contact cache.
+        */
+        void generateContactEvents() noexcept;
+
+        /*
+        * @brief SolveContacts is a method that resolves all the collision contacts together with the contact
+        * solver and keeps their impulses in the contact cache for the next frame.
+        * @param deltaTime The time elapsed between two consecutive frames.
+        */
+        void solveContacts(float deltaTime) noexcept;
+
+        /*
+        * @brief WriteContactEvents is a method that writes the events of the contacts and of the exited pairs in
+        * the contact event buffer, with the normals and the impulses of the solver.
+        */
+        void writeContactEvents() noexcept;
+
+        /*
+        * @brief IsContactDetectionEnabled is a method that checks if the update must find the contacts: only if
+        * a listener or the contact event buffer reads them.
+        */
+        [[nodiscard]] bool isContactDetectionEnabled() const noexcept
+        {
+            return _contactListener != nullptr || _areContactEventsEnabled;
+        }
+
+        /*
+        * @brief IsBodyActive is a method that checks if the body given in parameter is moved by the world
+        * (aka if it is an awake dynamic or kinematic body).
+        */
+        [[nodiscard]] static constexpr bool isBodyActive(const Body& body) noexcept
+        {
+            return body.IsAwake() && body.GetBodyType() != BodyType::Static;
+        }
+
+        /*
+        * @brief IsSleepingPair is a method that checks if none of the bodies of the two colliders given in
+        * parameter is active and at least one of them is sleeping. The contacts of such a pair do not change,
+        * so the pair is not tested nor solved.
+        */
+        [[nodiscard]] bool isSleepingPair(const Collider& colliderA, const Collider& colliderB) noexcept;
+
+        /*
+        * @brief KeepSleepingPairs is a method that touches again the pairs of the previous frame which are still
+        * sleeping, so that they stay in contact without being tested.
         */
-        void resolveNarrowPhase() noexcept;
+        void keepSleepingPairs() noexcept;
 
         /*
-        * @brief DetectOverlap is a function that check if the two colliders given in parameter overlap.
-        * @param colA The collider A.
-        * @param colB The collider B.
-        * @return True if the two colliders overlap.
+        * @brief UpdateIslands is a method that groups the bodies touching each other in islands with a
+        * union-find over the collision contacts. An island whose bodies have all been almost at rest for the
+        * time to sleep is put to sleep, and an island with an awake body moving is woken up.
+        * @param deltaTime The time elapsed between two consecutive frames.
         */
-        bool detectOverlap(const Collider& colA, const Collider& colB) noexcept;
+        void updateIslands(float deltaTime) noexcept;
+
+        /*
+        * @brief FindIsland is a method that gives the root body of the island of the body given in parameter
+        * and halves the path to the root.
+        */
+        [[nodiscard]] std::uint32_t findIsland(std::uint32_t bodyIdx) noexcept;
 
     public:
-        World() noexcept = default;
+        /**
+         * @brief DefaultLinearSleepTolerance is the default speed under which a body is considered at rest.
+         */
+        static constexpr float DefaultLinearSleepTolerance = 0.01f;
+
+        /**
+         * @brief DefaultTimeToSleep is the default time during which all the bodies of an island must be at rest
+         * before the island falls asleep.
+         */
+        static constexpr float DefaultTimeToSleep = 0.5f;
+
+        BasicWorld() noexcept = default;
 
         /**
          * @brief Init is a method that pre-allocates memory for the desired number of bodies by creating invalid
          * bodies (aka bodies with negative mass).
          * @param preAllocatedBodyCount The number of bodies to pre-allocate in memory. Default value is 100.
+         * @param broadPhaseType The algorithm used to find the possible pairs of colliders. Default value is
+         * the default broad phase of the configuration, the quad-tree by default. A broad phase which is not
+         * in the configuration is replaced by the default one.
+         * @param threadCount The number of threads updating the world, including the calling thread. The
+         * result of an update does not depend on it. Default value is 1 (the world is updated on the calling
+         * thread only).
          */
-        void Init(Math::Vec2F gravity = Math::Vec2F::Zero(), int preAllocatedBodyCount = 100) noexcept;
+        void Init(Math::Vec2F gravity = Math::Vec2F::Zero(), int preAllocatedBodyCount = 100,
+                  BroadPhaseType broadPhaseType = Config::DefaultBroadPhase, int threadCount = 1) noexcept;
 
         /**
-         * @brief Update is a method that calculates the new velocities of all the world's valid bodies
+         * @brief Update is a method that calculates the new velocities of all the world's valid awake bodies
          * according to their acceleration (calculated with 'F / m = a'), and their new positions according
-         * to their new velocities.
+         * to their new velocities. The islands of bodies at rest are then put to sleep.
          * @param deltaTime The time elapsed between two consecutive frames.
          */
         void Update(float deltaTime) noexcept;
@@ -90,6 +580,38 @@ namespace PhysicsEngine
          */
         void Deinit() noexcept;
 
+        /**
+         * @brief SaveState is a method that copies the simulation state of the world in the snapshot given in
+         * parameter. With a trivially copyable state, it is a single memcpy which does not allocate.
+         * @param snapshot The state in which the world is saved.
+         */
+        void SaveState(State& snapshot) const noexcept;
+
+        /**
+         * @brief RestoreState is a method that replaces the simulation state of the world by the snapshot given
+         * in parameter, saved by this world or by another one initialized the same way. The broad phases are
+         * cleared, so the next updates do not depend on the replaced state, and they are rebuilt with the static
+         * collider tree at the next update. The contact events of the last update are cleared. The settings of the
+         * world (gravity, collision layers, sleeping, solver iterations) are not part of the snapshot.
+         * @param snapshot The state to restore.
+         */
+        void RestoreState(const State& snapshot) noexcept;
+
+        /**
+         * @brief GetState is a method that gives the simulation state of the world, which can be restored in
+         * another world.
+         */
+        [[nodiscard]] const State& GetState() const noexcept { return _state; }
+
+        /**
+         * @brief HashState is a method that adds the simulation state of the world to the hash given in parameter:
+         * the bodies, the colliders with their generation indices and the contacts with their impulses.
+         * @note The arrays are walked in place but their elements are hashed field by field, the padding bytes of
+         * the bodies and the colliders are not copied reliably and must not change the hash.
+         * @param hash The hash to which the state is added.
+         */
+        void HashState(XxHash64& hash) const noexcept;
+
         /**
         * @brief Gravity is a method that gives the gravity of the world.
         * @return The gravity of the world.
@@ -110,9 +632,31 @@ namespace PhysicsEngine
          */
         void SetContactListener(ContactListener* contactListener) noexcept { _contactListener = contactListener; }
 
+        /**
+         * @brief SetContactEventsEnabled is a method that sets if the world finds the contacts at each update and
+         * writes their events in the contact event buffer, even without a contact listener.
+         * @param areContactEventsEnabled Whether the contact events are written without a contact listener.
+         */
+        void SetContactEventsEnabled(const bool areContactEventsEnabled) noexcept
+        {
+            _areContactEventsEnabled = areContactEventsEnabled;
+        }
+
+        /**
+         * @brief ContactEvents is a method that gives the contact events of the last update: the enter and stay
+         * events in the order of the contact cache, then the exit events. The contact listener, if any, was
+         * called with the same events at the end of the update.
+         * @return A view of the contact events, invalidated by the next update.
+         */
+        [[nodiscard]] ContactEventSpan ContactEvents() const noexcept
+        {
+            return ContactEventSpan{ _contactEventBuffer.data(), _contactEventBuffer.size() };
+        }
+
         /**
          * @brief CreateBody is a method that creates a body in the world and returns a BodyRef to this body.
          * @note Body position, velocity and forces are set to (0, 0) by default and mass is set to 1 by default.
+         * With a maximum body count in the configuration, creating one body more terminates the program.
          * @return A BodyRef to the body in the world (see BodyRef).
          */
         [[nodiscard]] BodyRef CreateBody() noexcept;
@@ -134,7 +678,7 @@ namespace PhysicsEngine
          * @brief GetBodyCount is a method that gives the number of allocated bodies.
          * @return The number of allocated bodies.
          */
-        [[nodiscard]] std::size_t GetBodyCount() const noexcept { return _bodies.size(); }
+        [[nodiscard]] std::size_t GetBodyCount() const noexcept { return _state.Bodies.size(); }
 
         /**
          * @brief GetCollider is a method that gives the collider corresponding to the collider reference
@@ -154,6 +698,8 @@ namespace PhysicsEngine
         /**
          * @brief CreateCollider is a method that creates a collider in the world and returns a
          * collider reference to this collider.
+         * @note With a maximum collider count in the configuration, creating one collider more terminates the
+         * program.
          * @param bodyRef The body reference to the body on which the collider would be attached.
          * @return A collider reference to the collider in the world (see ColliderRef).
          */
@@ -164,6 +710,180 @@ namespace PhysicsEngine
          * @return The quad-tree of the world.
          */
         [[nodiscard]] const QuadTree& GetQuadTree() const noexcept { return _quadTree; }
+
+        /**
+         * @brief GetBroadPhaseType is a method that gives the algorithm used by the world to find the
+         * possible pairs of colliders.
+         * @return The broad phase type chosen at Init.
+         */
+        [[nodiscard]] BroadPhaseType GetBroadPhaseType() const noexcept { return _broadPhaseType; }
+
+        /**
+         * @brief SetSolverIterations is a method that sets the number of iterations of the contact solver.
+         * More iterations make the stacks and the crowds of bodies more stable.
+         * @param velocityIterationCount The number of iterations solving the velocities. Default value is 8.
+         * @param positionIterationCount The number of iterations removing the penetrations. Default value is 3.
+         */
+        void SetSolverIterations(const int velocityIterationCount, const int positionIterationCount) noexcept
+        {
+            _velocityIterationCount = velocityIterationCount;
+            _positionIterationCount = positionIterationCount;
+        }
+
+        /**
+         * @brief GetVelocityIterationCount is a method that gives the number of iterations solving the velocities.
+         * @return The number of iterations solving the velocities.
+         */
+        [[nodiscard]] int GetVelocityIterationCount() const noexcept { return _velocityIterationCount; }
+
+        /**
+         * @brief GetPositionIterationCount is a method that gives the number of iterations removing the
+         * penetrations.
+         * @return The number of iterations removing the penetrations.
+         */
+        [[nodiscard]] int GetPositionIterationCount() const noexcept { return _positionIterationCount; }
+
+        /**
+         * @brief SetSleepingEnabled is a method that allows or forbids the islands of bodies at rest to fall
+         * asleep. Forbidding it wakes all the bodies up.
+         * @param isSleepingEnabled Whether the bodies can sleep or not. Default value is true.
+         */
+        void SetSleepingEnabled(bool isSleepingEnabled) noexcept;
+
+        /**
+         * @brief IsSleepingEnabled is a method that checks if the islands of bodies at rest can fall asleep.
+         * @return True if the bodies can sleep.
+         */
+        [[nodiscard]] bool IsSleepingEnabled() const noexcept { return _isSleepingEnabled; }
+
+        /**
+         * @brief SetSleepParameters is a method that sets when an island of bodies falls asleep.
+         * @param linearSleepTolerance The speed under which a body is considered at rest.
+         * @param timeToSleep The time during which all the bodies of an island must be at rest before it
+         * falls asleep.
+         */
+        void SetSleepParameters(const float linearSleepTolerance, const float timeToSleep) noexcept
+        {
+            _linearSleepTolerance = linearSleepTolerance;
+            _timeToSleep = timeToSleep;
+        }
+
+        /**
+         * @brief GetAwakeBodyCount is a method that gives the number of valid dynamic and kinematic bodies
+         * which are awake.
+         * @return The number of awake bodies.
+         */
+        [[nodiscard]] std::size_t GetAwakeBodyCount() const noexcept;
+
+        /**
+         * @brief SetLayersCollide is a method that sets if the colliders of the two collision layers given in
+         * parameter can touch. The pairs of layers which cannot touch are rejected by the broad phase, whatever
+         * the mask bits of their colliders.
+         * @param layerA The index of the first layer, in [0, CollisionMatrix::LayerCount).
+         * @param layerB The index of the second layer, in [0, CollisionMatrix::LayerCount).
+         * @param collide Whether the colliders of the two layers can touch. All the layers touch by default.
+         */
+        void SetLayersCollide(const int layerA, const int layerB, const bool collide) noexcept
+        {
+            _collisionMatrix.SetLayersCollide(layerA, layerB, collide);
+            _isStaticColliderTreeDirty = true;
+        }
+
+        /**
+         * @brief GetCollisionMatrix is a method that gives which collision layers can touch each other.
+         * @return The collision matrix of the world.
+         */
+        [[nodiscard]] const CollisionMatrix& GetCollisionMatrix() const noexcept { return _collisionMatrix; }
+
+        /**
+         * @brief SetCollisionMatrix is a method that replaces the collision matrix of the world.
+         * @param collisionMatrix The new collision matrix of the world.
+         */
+        void SetCollisionMatrix(const CollisionMatrix& collisionMatrix) noexcept
+        {
+            _collisionMatrix = collisionMatrix;
+            _isStaticColliderTreeDirty = true;
+        }
+
+        /**
+         * @brief InvalidateStaticColliders is a method that makes the world rebuild its static collider tree
+         * at the next update. The world finds by itself the static colliders added, removed, disabled or
+         * whose body moved, but it must be told when the shape, the offset or the filter of a static collider
+         * is changed.
+         */
+        void InvalidateStaticColliders() noexcept { _isStaticColliderTreeDirty = true; }
+
+        /**
+         * @brief GetStaticColliderCount is a method that gives the number of static colliders in the static
+         * collider tree, kept out of the broad phase.
+         * @return The number of static colliders of the last update.
+         */
+        [[nodiscard]] std::size_t GetStaticColliderCount() const noexcept { return _staticColliderTree.ColliderCount(); }
+
+        /**
+         * @brief RayCast is a method that gives the first collider hit by the ray going from the origin to the
+         * origin plus the translation. A collider containing the origin is not hit.
+         * @note The queries do not modify the world, so several threads can run them at once as long as the
+         * world is not updated or modified. The moving colliders are found where the last update left them.
+         * @param origin The start of the ray.
+         * @param translation The direction and the length of the ray.
+         * @param filter The colliders the ray can hit. The triggers are ignored by default.
+         * @return The first hit of the ray, if any.
+         */
+        [[nodiscard]] RayCastHit RayCast(Math::Vec2F origin, Math::Vec2F translation,
+                                         QueryFilter filter = {}) const noexcept;
+
+        /**
+         * @brief CircleCast is a method that gives the first collider hit by the circle moved by the translation.
+         * A collider touching the circle at its start position is not hit.
+         * @param circle The circle at its start position.
+         * @param translation The translation of the circle.
+         * @param filter The colliders the circle can hit. The triggers are ignored by default.
+         * @return The first hit of the circle, if any.
+         */
+        [[nodiscard]] RayCastHit CircleCast(const Math::CircleF& circle, Math::Vec2F translation,
+                                            QueryFilter filter = {}) const noexcept;
+
+        /**
+         * @brief QueryAABB is a method that finds the colliders whose simplified shapes overlap the box.
+         * @param bounds The box to look for colliders in.
+         * @param colliderRefs The buffer which receives the references of the colliders found.
+         * @param capacity The number of references the buffer can hold, the colliders found beyond it are
+         * only counted.
+         * @param filter The colliders which can be found. The triggers are ignored by default.
+         * @return The number of colliders found, which can be greater than the capacity.
+         */
+        std::size_t QueryAABB(Math::RectangleF bounds, ColliderRef* colliderRefs, std::size_t capacity,
+                              QueryFilter filter = {}) const noexcept;
+
+        /**
+         * @brief RayCasts is a method that casts all the rays given in parameter (see RayCast).
+         * @param inputs The rays to cast.
+         * @param hits The buffer which receives the hit of each ray, at the index of the ray.
+         * @param count The number of rays.
+         */
+        void RayCasts(const RayCastInput* inputs, RayCastHit* hits, std::size_t count) const noexcept;
+
+        /**
+         * @brief CircleCasts is a method that casts all the circles given in parameter (see CircleCast).
+         * @param inputs The circles to cast.
+         * @param hits The buffer which receives the hit of each circle, at the index of the circle.
+         * @param count The number of circles.
+         */
+        void CircleCasts(const CircleCastInput* inputs, RayCastHit* hits, std::size_t count) const noexcept;
+
+        /**
+         * @brief GetThreadCount is a method that gives the number of threads updating the world.
+         * @return The thread count chosen at Init.
+         */
+        [[nodiscard]] int GetThreadCount() const noexcept { return _jobSystem.ThreadCount(); }
     };
-}
 
+    extern template class BasicWorld<DefaultWorldConfig>;
+
+    /**
+     * @brief World is the world with the default configuration, which supports all the broad phases and
+     * shapes and grows with the heap allocator.
+     */
+    using World = BasicWorld<DefaultWorldConfig>;
+}
@@ -0,0 +1,98 @@
+/**
+ * @headerfile WorldConfig.h
+ * This header file defines the configuration of the world chosen at compile time: the broad phases and the
+ * shapes it supports, the capacity of its storage and its allocator.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Shape.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief BroadPhaseType is an enumeration of the algorithms the world can use to find the possible
+     * pairs of colliding colliders.
+     */
+    enum class BroadPhaseType : std::uint8_t
+    {
+        QuadTree,
+        SweepAndPrune,
+        AabbTree,
+        SpatialHash
+    };
+
+    /**
+     * @brief BroadPhaseTypeBit is a function that gives the bit of the broad phase type given in parameter in
+     * the broad phase mask of a world configuration.
+     */
+    [[nodiscard]] constexpr std::uint8_t BroadPhaseTypeBit(const BroadPhaseType type) noexcept
+    {
+        return static_cast<std::uint8_t>(1u << static_cast<int>(type));
+    }
+
+    /**
+     * @brief ShapeTypeBit is a function that gives the bit of the shape type given in parameter in the shape
+     * mask of a world configuration.
+     */
+    [[nodiscard]] constexpr std::uint8_t ShapeTypeBit(const Math::ShapeType type) noexcept
+    {
+        return static_cast<std::uint8_t>(1u << static_cast<int>(type));
+    }
+
+    constexpr std::uint8_t AllBroadPhaseTypeBits = BroadPhaseTypeBit(BroadPhaseType::QuadTree) |
+                                                   BroadPhaseTypeBit(BroadPhaseType::SweepAndPrune) |
+                                                   BroadPhaseTypeBit(BroadPhaseType::AabbTree) |
+                                                   BroadPhaseTypeBit(BroadPhaseType::SpatialHash);
+
+    constexpr std::uint8_t AllShapeTypeBits = ShapeTypeBit(Math::ShapeType::Circle) |
+                                              ShapeTypeBit(Math::ShapeType::Rectangle) |
+                                              ShapeTypeBit(Math::ShapeType::Polygon);
+
+    /**
+     * @brief DefaultWorldConfig is the configuration of the world which supports everything: all the broad
+     * phases and the shapes, and storage growing with the heap allocator. A configuration can inherit from it
+     * and hide only the members it changes.
+     */
+    struct DefaultWorldConfig
+    {
+        /**
+         * @brief Scalar is the type of the numbers of the simulation. The shapes and the solver are written
+         * for float, it is the only scalar supported.
+         */
+        using Scalar = float;
+
+        /**
+         * @brief AllocatorType is the allocator of the world arrays, it must inherit from Allocator.
+         */
+        using AllocatorType = HeapAllocator;
+
+        /**
+         * @brief BroadPhaseTypes is the mask of the broad phases the world can use, the code of the others is
+         * not compiled. A broad phase asked at Init which is not in the mask is replaced by the default one.
+         */
+        static constexpr std::uint8_t BroadPhaseTypes = AllBroadPhaseTypeBits;
+        static constexpr BroadPhaseType DefaultBroadPhase = BroadPhaseType::QuadTree;
+
+        /**
+         * @brief ShapeTypes is the mask of the shapes the narrow phase tests, the code of the pairs of the other
+         * shapes is not compiled and these pairs never touch.
+         */
+        static constexpr std::uint8_t ShapeTypes = AllShapeTypeBits;
+
+        /**
+         * @brief The maximum number of bodies, colliders and contacts in a frame, stored in place in fixed arrays.
+         * A capacity of 0 means that the arrays grow with the allocator. When the three are set, the state of the
+         * world is trivially copyable (see BasicWorld::SaveState).
+         */
+        static constexpr std::size_t MaxBodyCount = 0;
+        static constexpr std::size_t MaxColliderCount = 0;
+        static constexpr std::size_t MaxContactCount = 0;
+    };
+}
@@ -0,0 +1,1726 @@
+/**
+ * @headerfile WorldImpl.h
+ * This header defines the methods of the world class template. It is included by World.cpp, which compiles the
+ * default world, and by the translation unit instantiating a world with another configuration.
+ * @author Olivier
+ */
+
+#pragma once
+
+#include "World.h"
+#include "NScalar.h"
+#include "NVec2.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#include <TracyC.h>
+#endif // TRACY_ENABLE
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace PhysicsEngine
+{
+    template<typename Config>
+    void BasicWorld<Config>::Init(Math::Vec2F gravity, int preallocatedBodyCount, BroadPhaseType broadPhaseType,
+                                  int threadCount) noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        _gravity = gravity;
+        _broadPhaseType = isBroadPhaseEnabled(broadPhaseType) ? broadPhaseType : Config::DefaultBroadPhase;
+
+        _jobSystem.Start(threadCount);
+
+        if (preallocatedBodyCount < 0) preallocatedBodyCount = 0;
+
+        // The fixed arrays cannot hold more than their capacity.
+        auto preallocatedColliderCount = preallocatedBodyCount;
+
+        if constexpr (Config::MaxBodyCount != 0)
+        {
+            preallocatedBodyCount = std::min(preallocatedBodyCount, static_cast<int>(Config::MaxBodyCount));
+        }
+
+        if constexpr (Config::MaxColliderCount != 0)
+        {
+            preallocatedColliderCount = std::min(preallocatedColliderCount, static_cast<int>(Config::MaxColliderCount));
+        }
+
+        _state.Bodies.resize(preallocatedBodyCount, Body());
+        _state.BodiesGenIndices.resize(preallocatedBodyCount, 0);
+        _dynamicBodyIndices.reserve(preallocatedBodyCount);
+        _kinematicBodyIndices.reserve(preallocatedBodyCount);
+
+        _state.Colliders.resize(preallocatedColliderCount, Collider());
+        _state.CollidersGenIndices.resize(preallocatedColliderCount, 0);
+
+        // Thread the free lists through the unused slots, in decreasing order so the first slots are used first.
+        _state.FreeBodies.Reset(preallocatedBodyCount);
+        _state.FreeColliders.Reset(preallocatedColliderCount);
+
+        for (auto slot = static_cast<std::uint32_t>(preallocatedBodyCount); slot > 0; slot--)
+        {
+            if (!_state.Bodies[slot - 1].IsValid())
+            {
+                _state.FreeBodies.Release(slot - 1);
+            }
+        }
+
+        for (auto slot = static_cast<std::uint32_t>(preallocatedColliderCount); slot > 0; slot--)
+        {
+            if (!_state.Colliders[slot - 1].IsInitialized())
+            {
+                _state.FreeColliders.Release(slot - 1);
+            }
+        }
+
+        _state.PairCache.Init(preallocatedBodyCount);
+        _separatingAxisCache.Reserve(preallocatedBodyCount);
+
+        switch (activeBroadPhaseType())
+        {
+            case BroadPhaseType::QuadTree:
+                _quadTree.Init(preallocatedBodyCount);
+                break;
+            case BroadPhaseType::SweepAndPrune:
+                _sweepAndPrune.Init(preallocatedBodyCount);
+                break;
+            case BroadPhaseType::AabbTree:
+                _aabbTree.Init(preallocatedBodyCount);
+                break;
+            case BroadPhaseType::SpatialHash:
+                _spatialHashGrid.Init(preallocatedBodyCount);
+                break;
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::Update(const float deltaTime) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        groupBodiesByType();
+
+        // Without contact detection the broad phase is not run, so the queries cannot use it.
+        _isBroadPhaseUpToDate = false;
+        _contactEventBuffer.clear();
+
+        if (isContactDetectionEnabled())
+        {
+            groupCollidersByType();
+            beginContinuousCollisions();
+        }
+
+        integrateDynamicBodies(deltaTime);
+        integrateKinematicBodies(deltaTime);
+
+        if (isContactDetectionEnabled())
+        {
+            solveContinuousCollisions();
+            resolveBroadPhase();
+            resolveNarrowPhase(deltaTime);
+        }
+
+        updateIslands(deltaTime);
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::DynamicBodyLanes::Resize(const std::size_t laneCount) noexcept
+    {
+        PositionsX.resize(laneCount);
+        PositionsY.resize(laneCount);
+        VelocitiesX.resize(laneCount);
+        VelocitiesY.resize(laneCount);
+        ForcesX.resize(laneCount);
+        ForcesY.resize(laneCount);
+        ImpulsesX.resize(laneCount);
+        ImpulsesY.resize(laneCount);
+        InverseMasses.resize(laneCount);
+        Dampings.resize(laneCount);
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::groupBodiesByType() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_state.Bodies.size());
+    #endif
+
+        _dynamicBodyIndices.clear();
+        _kinematicBodyIndices.clear();
+
+        for (std::uint32_t i = 0; i < _state.Bodies.size(); i++)
+        {
+            const auto& body = _state.Bodies[i];
+
+            // The sleeping bodies are not integrated.
+            if (!body.IsValid() || !body.IsAwake()) continue;
+
+            switch (body.GetBodyType())
+            {
+                case BodyType::Dynamic:
+                    _dynamicBodyIndices.push_back(i);
+                    break;
+                case BodyType::Kinematic:
+                    _kinematicBodyIndices.push_back(i);
+                    break;
+                case BodyType::Static:
+                case BodyType::None:
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Load is a function that reads four consecutive lanes of the arrays given in parameter.
+     */
+    static Math::FourVec2F load(const float* xs, const float* ys) noexcept
+    {
+        return { { xs[0], xs[1], xs[2], xs[3] }, { ys[0], ys[1], ys[2], ys[3] } };
+    }
+
+    /**
+     * @brief Store is a function that writes the vectors given in parameter in four consecutive lanes of the arrays.
+     */
+    static void store(const Math::FourVec2F& vecs, float* xs, float* ys) noexcept
+    {
+        std::copy(vecs.X().begin(), vecs.X().end(), xs);
+        std::copy(vecs.Y().begin(), vecs.Y().end(), ys);
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::integrateDynamicBodies(const float deltaTime) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_dynamicBodyIndices.size());
+    #endif
+
+        const auto bodyCount = _dynamicBodyIndices.size();
+
+        // Round up to a multiple of four, the padding lanes are zeroed so they stay at rest.
+        const auto laneCount = (bodyCount + 3) & ~static_cast<std::size_t>(3);
+
+        auto& lanes = _dynamicBodyLanes;
+        lanes.Resize(laneCount);
+
+        const Math::FourVec2F deltaTimes(Math::Vec2F(deltaTime, deltaTime));
+        const Math::FourScalarF ones(1.f);
+        const Math::FourScalarF deltaTimeScalars(deltaTime);
+
+        // Each job integrates its own groups of four lanes, so the bodies are split between the threads
+        // without sharing any lane.
+        _jobSystem.ParallelFor(laneCount / 4, _integrationChunkSize / 4,
+                               [&](const std::size_t groupBegin, const std::size_t groupEnd)
+        {
+            const auto laneBegin = groupBegin * 4;
+            const auto laneEnd = groupEnd * 4;
+
+            for (auto lane = std::max(bodyCount, laneBegin); lane < laneEnd; lane++)
+            {
+                lanes.PositionsX[lane] = lanes.PositionsY[lane] = 0.f;
+                lanes.VelocitiesX[lane] = lanes.VelocitiesY[lane] = 0.f;
+                lanes.ForcesX[lane] = lanes.ForcesY[lane] = 0.f;
+                lanes.ImpulsesX[lane] = lanes.ImpulsesY[lane] = 0.f;
+                lanes.InverseMasses[lane] = lanes.Dampings[lane] = 0.f;
+            }
+
+            for (auto lane = laneBegin; lane < std::min(bodyCount, laneEnd); lane++)
+            {
+                auto& body = _state.Bodies[_dynamicBodyIndices[lane]];
+
+                body.ApplyForce(_gravity);
+
+                const auto position = body.Position();
+                const auto velocity = body.Velocity();
+                const auto forces = body.Forces();
+                const auto impulses = body.Impulses();
+
+                lanes.PositionsX[lane] = position.X;
+                lanes.PositionsY[lane] = position.Y;
+                lanes.VelocitiesX[lane] = velocity.X;
+                lanes.VelocitiesY[lane] = velocity.Y;
+                lanes.ForcesX[lane] = forces.X;
+                lanes.ForcesY[lane] = forces.Y;
+                lanes.ImpulsesX[lane] = impulses.X;
+                lanes.ImpulsesY[lane] = impulses.Y;
+                lanes.InverseMasses[lane] = body.InverseMass();
+                lanes.Dampings[lane] = body.Damping();
+            }
+
+            // The operations are the same (and in the same order) as the ones of a single body, so the
+            // result does not depend on the lane of the body.
+            for (auto lane = laneBegin; lane < laneEnd; lane += 4)
+            {
+                auto position = load(&lanes.PositionsX[lane], &lanes.PositionsY[lane]);
+                auto velocity = load(&lanes.VelocitiesX[lane], &lanes.VelocitiesY[lane]);
+                const auto forces = load(&lanes.ForcesX[lane], &lanes.ForcesY[lane]);
+                const auto impulses = load(&lanes.ImpulsesX[lane], &lanes.ImpulsesY[lane]);
+
+                const Math::FourScalarF inverseMasses({ lanes.InverseMasses[lane], lanes.InverseMasses[lane + 1],
+                                                        lanes.InverseMasses[lane + 2], lanes.InverseMasses[lane + 3] });
+                const Math::FourScalarF dampings({ lanes.Dampings[lane], lanes.Dampings[lane + 1],
+                                                   lanes.Dampings[lane + 2], lanes.Dampings[lane + 3] });
+
+                // a = F / m
+                const auto acceleration = forces * inverseMasses.Scalars();
+
+                // Change velocity according to the acceleration over the delta time and to the impulses.
+                velocity = velocity + acceleration * deltaTimes;
+                velocity = velocity + impulses;
+
+                // Change position according to velocity and delta time.
+                position = position + velocity * deltaTimes;
+
+                // Remove the impulses from the velocity and apply damping according to delta time.
+                velocity = velocity - impulses;
+                velocity = velocity * (ones - dampings * deltaTimeScalars).Scalars();
+
+                store(position, &lanes.PositionsX[lane], &lanes.PositionsY[lane]);
+                store(velocity, &lanes.VelocitiesX[lane], &lanes.VelocitiesY[lane]);
+            }
+
+            for (auto lane = laneBegin; lane < std::min(bodyCount, laneEnd); lane++)
+            {
+                auto& body = _state.Bodies[_dynamicBodyIndices[lane]];
+
+                body.SetPosition(Math::Vec2F(lanes.PositionsX[lane], lanes.PositionsY[lane]));
+                body.SetVelocity(Math::Vec2F(lanes.VelocitiesX[lane], lanes.VelocitiesY[lane]));
+                body.ResetForces();
+                body.ResetImpulses();
+            }
+        });
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::integrateKinematicBodies(const float deltaTime) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_kinematicBodyIndices.size());
+    #endif
+
+        // Kinematic bodies are not impacted by forces.
+        _jobSystem.ParallelFor(_kinematicBodyIndices.size(), _integrationChunkSize,
+                               [&](const std::size_t begin, const std::size_t end)
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                auto& body = _state.Bodies[_kinematicBodyIndices[i]];
+
+                // Change position according to velocity and delta time.
+                body.SetPosition(body.Position() + body.Velocity() * deltaTime);
+            }
+        });
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::groupCollidersByType() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_state.Colliders.size());
+    #endif
+
+        _movingColliderIndices.clear();
+
+        if (_staticColliderRecords.size() < _state.Colliders.size())
+        {
+            _staticColliderRecords.resize(_state.Colliders.size(), StaticColliderRecord{});
+        }
+
+        // Only the type, generation and position of the colliders are compared, the bounds of the static
+        // colliders are not calculated again unless one of them changed.
+        for (std::uint32_t i = 0; i < _state.Colliders.size(); i++)
+        {
+            const auto& collider = _state.Colliders[i];
+
+            StaticColliderRecord record;
+
+            if (collider.Enabled())
+            {
+                const auto& body = GetBody(collider.GetBodyRef());
+
+                if (body.GetBodyType() == BodyType::Static)
+                {
+                    record.GenerationIdx = _state.CollidersGenIndices[i];
+                    record.Position = body.Position();
+                    record.IsStatic = true;
+                }
+                else
+                {
+                    _movingColliderIndices.push_back(i);
+                }
+            }
+
+            auto& previousRecord = _staticColliderRecords[i];
+
+            if (record.IsStatic != previousRecord.IsStatic || record.GenerationIdx != previousRecord.GenerationIdx ||
+                record.Position != previousRecord.Position)
+            {
+                previousRecord = record;
+                _isStaticColliderTreeDirty = true;
+            }
+        }
+
+        if (_isStaticColliderTreeDirty)
+        {
+            buildStaticColliderTree();
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::buildStaticColliderTree() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        _staticColliderTree.Clear();
+        _staticColliderIndices.clear();
+
+        for (std::uint32_t i = 0; i < _state.Colliders.size(); i++)
+        {
+            if (!_staticColliderRecords[i].IsStatic) continue;
+
+            const auto& collider = _state.Colliders[i];
+
+            _staticColliderIndices.push_back(i);
+            _staticColliderTree.Insert(calculateSimplifiedShape(collider), ColliderRef{ i, _state.CollidersGenIndices[i] },
+                                       _collisionMatrix.Apply(collider.GetCollisionFilter()));
+        }
+
+        _staticColliderTree.Build();
+        _isStaticColliderTreeDirty = false;
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::beginContinuousCollisions() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        _bulletMotions.clear();
+
+        for (const auto colliderIdx : _movingColliderIndices)
+        {
+            const auto& collider = _state.Colliders[colliderIdx];
+
+            if (!collider.IsBullet() || collider.IsTrigger() || collider.GetShapeType() != Math::ShapeType::Circle) continue;
+
+            const auto& body = GetBody(collider.GetBodyRef());
+
+            if (body.IsValid() && body.IsAwake())
+            {
+                _bulletMotions.push_back(BulletMotion{ colliderIdx, body.Position() });
+            }
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::solveContinuousCollisions() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_bulletMotions.size());
+    #endif
+
+        if (_staticColliderIndices.empty()) return;
+
+        // Each bullet only moves its own body, so the bullets are split between the threads.
+        _jobSystem.ParallelFor(_bulletMotions.size(), _bulletChunkSize,
+                               [&](const std::size_t begin, const std::size_t end)
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                const auto& motion = _bulletMotions[i];
+                const auto& bullet = _state.Colliders[motion.ColliderIdx];
+                auto& body = GetBody(bullet.GetBodyRef());
+
+                const auto translation = body.Position() - motion.StartPosition;
+
+                if (translation.SquareLength() <= 0.f) continue;
+
+                const auto circle = bullet.Circle() + motion.StartPosition + bullet.Offset();
+                const auto bulletFilter = _collisionMatrix.Apply(bullet.GetCollisionFilter());
+
+                TimeOfImpact firstImpact;
+
+                for (const auto staticColliderIdx : _staticColliderIndices)
+                {
+                    const auto& staticCollider = _state.Colliders[staticColliderIdx];
+
+                    if (staticCollider.IsTrigger()) continue;
+                    if (!ShouldCollide(bulletFilter, _collisionMatrix.Apply(staticCollider.GetCollisionFilter()))) continue;
+
+                    const auto staticPosition = GetBody(staticCollider.GetBodyRef()).Position() + staticCollider.Offset();
+
+                    TimeOfImpact impact;
+
+                    switch (staticCollider.GetShapeType())
+                    {
+                        case Math::ShapeType::Circle:
+                            impact = SweptCircleTimeOfImpact(circle, translation, staticCollider.Circle() + staticPosition);
+                            break;
+                        case Math::ShapeType::Rectangle:
+                            impact = SweptCircleTimeOfImpact(circle, translation, staticCollider.Rectangle() + staticPosition);
+                            break;
+                        case Math::ShapeType::Polygon:
+                        case Math::ShapeType::None:
+                            break;
+                    }
+
+                    // The first collider in the collider order wins on a tie, whatever the thread.
+                    if (impact.Hit && impact.Time < firstImpact.Time)
+                    {
+                        firstImpact = impact;
+                    }
+                }
+
+                if (!firstImpact.Hit) continue;
+
+                body.SetPosition(motion.StartPosition + translation * firstImpact.Time -
+                                 firstImpact.Normal * _continuousPenetration);
+            }
+        });
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::resolveBroadPhase() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        switch (activeBroadPhaseType())
+        {
+            case BroadPhaseType::QuadTree:
+            {
+            #ifdef TRACY_ENABLE
+                ZoneNamedN(SetRoodNodeBoundary, "SetRootNodeBoundary", true);
+                ZoneValue(_movingColliderIndices.size());
+            #endif
+
+                _quadTree.Clear();
+
+                // Sets the minimum and maximum collision zone limits of the world rectangle to floating maximum and
+                // lowest values.
+                Math::Vec2F worldMinBound(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+                Math::Vec2F worldMaxBound(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+
+                // Adjust the size of the collision zone in the world rectangle to the most distant moving bodies,
+                // the static colliders are not in the quad-tree.
+                for (const auto colliderIdx : _movingColliderIndices)
+                {
+                    const auto& collider = _state.Colliders[colliderIdx];
+                    const auto colCenter = GetBody(collider.GetBodyRef()).Position();
+
+                    if (worldMinBound.X > colCenter.X)
+                    {
+                        worldMinBound.X = colCenter.X;
+                    }
+
+                    if (worldMaxBound.X < colCenter.X)
+                    {
+                        worldMaxBound.X = colCenter.X;
+                    }
+
+                    if (worldMinBound.Y > colCenter.Y)
+                    {
+                        worldMinBound.Y = colCenter.Y;
+                    }
+
+                    if (worldMaxBound.Y < colCenter.Y)
+                    {
+                        worldMaxBound.Y = colCenter.Y;
+                    }
+                }
+
+                // Set the first rectangle of the quad-tree to calculated collision area rectangle.
+                _quadTree.SetRootNodeBoundary(Math::RectangleF(worldMinBound, worldMaxBound));
+                break;
+            }
+
+            case BroadPhaseType::SpatialHash:
+                _spatialHashGrid.Clear();
+                break;
+
+            case BroadPhaseType::SweepAndPrune:
+            case BroadPhaseType::AabbTree:
+                // The sweep-and-prune and the AABB tree keep their data from the previous frame.
+                break;
+        }
+
+    #ifdef TRACY_ENABLE
+            ZoneNamedN(InsertCollidersInBroadPhase, "InsertCollidersInBroadPhase", true);
+            ZoneValue(_movingColliderIndices.size());
+    #endif
+
+        _staticPairs.clear();
+
+        // Only the moving colliders are inserted in the broad phase, and each one is queried against the static
+        // collider tree, so the pairs of two static colliders are never generated.
+        for (const auto colliderIdx : _movingColliderIndices)
+        {
+            const ColliderRef colliderRef = {colliderIdx, _state.CollidersGenIndices[colliderIdx]};
+            const auto& collider = _state.Colliders[colliderIdx];
+
+            const auto simplifiedShape = calculateSimplifiedShape(collider);
+            const auto filter = _collisionMatrix.Apply(collider.GetCollisionFilter());
+
+            _staticColliderTree.Query(simplifiedShape, colliderRef, filter, _staticPairs);
+
+            switch (activeBroadPhaseType())
+            {
+                case BroadPhaseType::QuadTree:
+                    _quadTree.Insert(simplifiedShape, colliderRef, filter);
+                    break;
+                case BroadPhaseType::SweepAndPrune:
+                    _sweepAndPrune.Insert(simplifiedShape, colliderRef, filter);
+                    break;
+                case BroadPhaseType::AabbTree:
+                    _aabbTree.Insert(simplifiedShape, colliderRef, false, filter);
+                    break;
+                case BroadPhaseType::SpatialHash:
+                    _spatialHashGrid.Insert(simplifiedShape, colliderRef, filter);
+                    break;
+            }
+        } // For int i < colliders.size().
+
+        const AllocVector<ColliderPair>* broadPhasePairs = nullptr;
+
+        switch (activeBroadPhaseType())
+        {
+            case BroadPhaseType::QuadTree:
+                _quadTree.CalculatePossiblePairs();
+                broadPhasePairs = &_quadTree.PossiblePairs();
+                break;
+            case BroadPhaseType::SweepAndPrune:
+                _sweepAndPrune.CalculatePossiblePairs();
+                broadPhasePairs = &_sweepAndPrune.PossiblePairs();
+                break;
+            case BroadPhaseType::AabbTree:
+                _aabbTree.CalculatePossiblePairs();
+                broadPhasePairs = &_aabbTree.PossiblePairs();
+                break;
+            case BroadPhaseType::SpatialHash:
+                _spatialHashGrid.CalculatePossiblePairs();
+                broadPhasePairs = &_spatialHashGrid.PossiblePairs();
+                break;
+        }
+
+        _possiblePairs.clear();
+        _possiblePairs.insert(_possiblePairs.end(), broadPhasePairs->begin(), broadPhasePairs->end());
+        _possiblePairs.insert(_possiblePairs.end(), _staticPairs.begin(), _staticPairs.end());
+
+        _isBroadPhaseUpToDate = true;
+    }
+
+    template<typename Config>
+    Math::RectangleF BasicWorld<Config>::calculateSimplifiedShape(const Collider& collider) const noexcept
+    {
+        switch (collider.GetShapeType())
+        {
+            case Math::ShapeType::Circle:
+            {
+            #ifdef TRACY_ENABLE
+                   ZoneNamedN(SimplifyCircle, "SimplifyCircle", true);
+            #endif
+                const auto radius = collider.Circle().Radius();
+
+                return Math::RectangleF::FromCenter(_state.Bodies[collider.GetBodyRef().Index].Position() + collider.Offset(),
+                                                    Math::Vec2F(radius, radius));
+            } // Case circle.
+
+            case Math::ShapeType::Rectangle:
+            {
+            #ifdef TRACY_ENABLE
+                   ZoneNamedN(SimplifyRectangle, "SimplifyRectangle", true);
+            #endif
+
+                return collider.Rectangle() + _state.Bodies[collider.GetBodyRef().Index].Position() + collider.Offset();
+            } // Case rectangle.
+
+            case Math::ShapeType::Polygon:
+            {
+            #ifdef TRACY_ENABLE
+                ZoneNamedN(SimplifyPolygon, "SimplifyPolygon", true);
+            #endif
+
+                Math::Vec2F minVertex(std::numeric_limits<float>::max(),
+                                      std::numeric_limits<float>::max());
+
+                Math::Vec2F maxVertex(std::numeric_limits<float>::lowest(),
+                                      std::numeric_limits<float>::lowest());
+
+                const auto position = _state.Bodies[collider.GetBodyRef().Index].Position();
+
+                for (const auto& localVertex : collider.Polygon())
+                {
+                    const auto vertex = localVertex + position + collider.Offset();
+
+                    if (minVertex.X > vertex.X)
+                    {
+                        minVertex.X = vertex.X;
+                    }
+
+                    if (maxVertex.X < vertex.X)
+                    {
+                        maxVertex.X = vertex.X;
+                    }
+
+                    if (minVertex.Y > vertex.Y)
+                    {
+                        minVertex.Y = vertex.Y;
+                    }
+
+
+                    if (maxVertex.Y < vertex.Y)
+                    {
+                        maxVertex.Y = vertex.Y;
+                    }
+                } // For range vertex.
+
+                return { minVertex, maxVertex };
+            } // Case polygon.
+
+            default:
+                return { Math::Vec2F::Zero(), Math::Vec2F::Zero() };
+        } // Switch collider shape type.
+    }
+
+    template<typename Config>
+    const AllocVector<ColliderPair>& BasicWorld<Config>::possiblePairs() const noexcept
+    {
+        return _possiblePairs;
+    }
+
+    /**
+     * @brief PassesQueryFilter is a function that checks if a query with the filter given in parameter can find
+     * the collider.
+     */
+    static bool passesQueryFilter(const Collider& collider, const QueryFilter& filter) noexcept
+    {
+        return (collider.CategoryBits() & filter.MaskBits) != 0 && (filter.IncludeTriggers || !collider.IsTrigger());
+    }
+
+    template<typename Config>
+    template<typename Visitor>
+    void BasicWorld<Config>::queryColliders(const Math::RectangleF bounds, Visitor&& visitor) const noexcept
+    {
+        const auto visitCollider = [&](const ColliderRef colliderRef)
+        {
+            // The collider may have been destroyed or disabled since the last update.
+            if (_state.CollidersGenIndices[colliderRef.Index] != colliderRef.GenerationIdx) return;
+
+            const auto& collider = _state.Colliders[colliderRef.Index];
+
+            if (!collider.Enabled()) return;
+
+            visitor(colliderRef, collider);
+        };
+
+        if (!_isBroadPhaseUpToDate)
+        {
+            for (std::size_t i = 0; i < _state.Colliders.size(); i++)
+            {
+                visitCollider(ColliderRef{ i, _state.CollidersGenIndices[i] });
+            }
+
+            return;
+        }
+
+        _staticColliderTree.Query(bounds, [&](const ColliderRef colliderRef, CollisionFilter)
+        {
+            visitCollider(colliderRef);
+        });
+
+        const Math::RectangleF movingBounds(bounds.MinBound() - Math::Vec2F(_queryMargin, _queryMargin),
+                                            bounds.MaxBound() + Math::Vec2F(_queryMargin, _queryMargin));
+
+        switch (activeBroadPhaseType())
+        {
+            case BroadPhaseType::QuadTree:
+                _quadTree.Query(movingBounds, visitCollider);
+                break;
+            case BroadPhaseType::SweepAndPrune:
+                _sweepAndPrune.Query(movingBounds, visitCollider);
+                break;
+            case BroadPhaseType::AabbTree:
+                _aabbTree.Query(movingBounds, visitCollider);
+                break;
+            case BroadPhaseType::SpatialHash:
+                _spatialHashGrid.Query(movingBounds, visitCollider);
+                break;
+        }
+    }
+
+    template<typename Config>
+    RayCastHit BasicWorld<Config>::RayCast(const Math::Vec2F origin, const Math::Vec2F translation,
+                                           const QueryFilter filter) const noexcept
+    {
+        return CircleCast(Math::CircleF(origin, 0.f), translation, filter);
+    }
+
+    template<typename Config>
+    RayCastHit BasicWorld<Config>::CircleCast(const Math::CircleF& circle, const Math::Vec2F translation,
+                                              const QueryFilter filter) const noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        RayCastHit hit;
+
+        const auto radius = circle.Radius();
+        const auto start = circle.Center();
+        const auto end = start + translation;
+
+        const Math::RectangleF sweptBounds(
+            Math::Vec2F(std::min(start.X, end.X) - radius, std::min(start.Y, end.Y) - radius),
+            Math::Vec2F(std::max(start.X, end.X) + radius, std::max(start.Y, end.Y) + radius));
+
+        queryColliders(sweptBounds, [&](const ColliderRef colliderRef, const Collider& collider)
+        {
+            if (!passesQueryFilter(collider, filter)) return;
+
+            const auto position = _state.Bodies[collider.GetBodyRef().Index].Position() + collider.Offset();
+
+            TimeOfImpact impact;
+
+            switch (collider.GetShapeType())
+            {
+                case Math::ShapeType::Circle:
+                    impact = SweptCircleTimeOfImpact(circle, translation, collider.Circle() + position);
+                    break;
+                case Math::ShapeType::Rectangle:
+                    impact = SweptCircleTimeOfImpact(circle, translation, collider.Rectangle() + position);
+                    break;
+                case Math::ShapeType::Polygon:
+                    impact = SweptCircleTimeOfImpact(circle, translation, MakeConvexPolygon(collider, position));
+                    break;
+                case Math::ShapeType::None:
+                    break;
+            }
+
+            if (!impact.Hit) return;
+
+            // The lowest collider index wins on a tie, whatever the order in which the broad phase gives them.
+            if (hit.Hit && (impact.Time > hit.Fraction ||
+                (impact.Time == hit.Fraction && colliderRef.Index > hit.ColRef.Index)))
+            {
+                return;
+            }
+
+            hit.ColRef = colliderRef;
+            hit.Normal = impact.Normal;
+            hit.Fraction = impact.Time;
+            hit.Point = start + translation * impact.Time - impact.Normal * radius;
+            hit.Hit = true;
+        });
+
+        return hit;
+    }
+
+    template<typename Config>
+    std::size_t BasicWorld<Config>::QueryAABB(const Math::RectangleF bounds, ColliderRef* colliderRefs, const std::size_t capacity,
+                                              const QueryFilter filter) const noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        std::size_t count = 0;
+
+        queryColliders(bounds, [&](const ColliderRef colliderRef, const Collider& collider)
+        {
+            if (!passesQueryFilter(collider, filter)) return;
+            if (!Math::Intersect(calculateSimplifiedShape(collider), bounds)) return;
+
+            if (count < capacity)
+            {
+                colliderRefs[count] = colliderRef;
+            }
+
+            count++;
+        });
+
+        return count;
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::RayCasts(const RayCastInput* inputs, RayCastHit* hits, const std::size_t count) const noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(count);
+    #endif
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            hits[i] = RayCast(inputs[i].Origin, inputs[i].Translation, inputs[i].Filter);
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::CircleCasts(const CircleCastInput* inputs, RayCastHit* hits, const std::size_t count) const noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(count);
+    #endif
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            hits[i] = CircleCast(inputs[i].Circle, inputs[i].Translation, inputs[i].Filter);
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::resolveNarrowPhase(const float deltaTime) noexcept
+    {
+        #ifdef TRACY_ENABLE
+                ZoneScoped;
+        #endif
+
+        const auto& possiblePairs = this->possiblePairs();
+
+        #ifdef TRACY_ENABLE
+                ZoneValue(possiblePairs.size());
+        #endif
+
+        detectOverlaps(possiblePairs);
+
+        // The sleeping pairs are found in the contacts of the previous frame, before they are cleared.
+        _sleepingPairs.clear();
+
+        for (const auto& contact : _state.PairCache.Contacts())
+        {
+            const auto& pair = contact.Pair;
+
+            if (_state.CollidersGenIndices[pair.ColliderA.Index] != pair.ColliderA.GenerationIdx ||
+                _state.CollidersGenIndices[pair.ColliderB.Index] != pair.ColliderB.GenerationIdx)
+            {
+                continue;
+            }
+
+            const auto& colliderA = _state.Colliders[pair.ColliderA.Index];
+            const auto& colliderB = _state.Colliders[pair.ColliderB.Index];
+
+            if (colliderA.Enabled() && colliderB.Enabled() && isSleepingPair(colliderA, colliderB))
+            {
+                _sleepingPairs.push_back(pair);
+            }
+        }
+
+        _state.PairCache.BeginFrame();
+        keepSleepingPairs();
+
+        // The contacts are touched in the order of the broad phase pairs, whatever the shape buckets order.
+        for (std::size_t i = 0; i < possiblePairs.size(); i++)
+        {
+            if (_pairOverlaps[i])
+            {
+                _state.PairCache.Touch(possiblePairs[i]);
+            }
+        }
+
+        // The pairs of the previous frame which were not touched in this frame exit.
+        _state.PairCache.EndFrame();
+
+        generateContactEvents();
+        solveContacts(deltaTime);
+        writeContactEvents();
+
+        // The listener is not thread safe, so it is called on the calling thread once the step is done.
+        if (_contactListener)
+        {
+            DispatchContactEvents(ContactEvents(), *_contactListener);
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::generateContactEvents() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        const auto& contacts = _state.PairCache.Contacts();
+        const auto& exitedPairs = _state.PairCache.ExitedPairs();
+
+        _contactEvents.resize(contacts.size());
+        _exitEvents.resize(exitedPairs.size());
+        _contactManifolds.resize(contacts.size());
+
+        _jobSystem.ParallelFor(contacts.size(), _contactEventChunkSize,
+                               [&](const std::size_t begin, const std::size_t end)
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                const auto& contact = contacts[i];
+                const bool isTrigger = GetCollider(contact.Pair.ColliderA).IsTrigger() ||
+                                       GetCollider(contact.Pair.ColliderB).IsTrigger();
+
+                // If there was no collision in the previous frame -> Enter, else -> Stay.
+                if (isTrigger)
+                {
+                    _contactEvents[i] = contact.IsNew ? ContactEventType::TriggerEnter : ContactEventType::TriggerStay;
+                }
+                else
+                {
+                    _contactEvents[i] = contact.IsNew ? ContactEventType::CollisionEnter : ContactEventType::CollisionStay;
+
+                    const auto& colliderA = GetCollider(contact.Pair.ColliderA);
+                    const auto& colliderB = GetCollider(contact.Pair.ColliderB);
+
+                    // The contacts between sleeping bodies are not solved.
+                    if (isSleepingPair(colliderA, colliderB)) continue;
+
+                    _contactManifolds[i] = CalculateManifold(colliderA, GetBody(colliderA.GetBodyRef()),
+                                                             colliderB, GetBody(colliderB.GetBodyRef()));
+                }
+            }
+        });
+
+        _jobSystem.ParallelFor(exitedPairs.size(), _contactEventChunkSize,
+                               [&](const std::size_t begin, const std::size_t end)
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                const bool isTrigger = GetCollider(exitedPairs[i].ColliderA).IsTrigger() ||
+                                       GetCollider(exitedPairs[i].ColliderB).IsTrigger();
+
+                _exitEvents[i] = isTrigger ? ContactEventType::TriggerExit : ContactEventType::CollisionExit;
+            }
+        });
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::solveContacts(const float deltaTime) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        const auto& contacts = _state.PairCache.Contacts();
+
+        _contactConstraintSolver.Begin(_state.Bodies.size());
+        _contactConstraints.assign(contacts.size(), ContactConstraintSolver::NoConstraint);
+
+        // The constraints are added in the order of the contact cache, so the solver result does not depend on
+        // the number of threads.
+        for (std::size_t i = 0; i < contacts.size(); i++)
+        {
+            if (_contactEvents[i] != ContactEventType::CollisionEnter &&
+                _contactEvents[i] != ContactEventType::CollisionStay)
+            {
+                continue;
+            }
+
+            const auto& colliderA = GetCollider(contacts[i].Pair.ColliderA);
+            const auto& colliderB = GetCollider(contacts[i].Pair.ColliderB);
+
+            if (isSleepingPair(colliderA, colliderB)) continue;
+
+            const auto bodyRefA = colliderA.GetBodyRef();
+            const auto bodyRefB = colliderB.GetBodyRef();
+
+            _contactConstraints[i] = _contactConstraintSolver.AddContact(
+                    static_cast<std::uint32_t>(bodyRefA.Index), GetBody(bodyRefA), colliderA,
+                    static_cast<std::uint32_t>(bodyRefB.Index), GetBody(bodyRefB), colliderB,
+                    _contactManifolds[i], contacts[i].Impulse);
+        }
+
+        _contactConstraintSolver.Solve(deltaTime, _velocityIterationCount, _positionIterationCount);
+        _contactConstraintSolver.StoreBodies(_state.Bodies);
+
+        for (std::size_t i = 0; i < contacts.size(); i++)
+        {
+            if (_contactConstraints[i] != ContactConstraintSolver::NoConstraint)
+            {
+                _state.PairCache.StoreImpulse(contacts[i].Pair, _contactConstraintSolver.Impulse(_contactConstraints[i]));
+            }
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::writeContactEvents() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        const auto& contacts = _state.PairCache.Contacts();
+        const auto& exitedPairs = _state.PairCache.ExitedPairs();
+
+        _contactEventBuffer.resize(contacts.size() + exitedPairs.size());
+
+        for (std::size_t i = 0; i < contacts.size(); i++)
+        {
+            auto& event = _contactEventBuffer[i];
+            event.Pair = contacts[i].Pair;
+            event.Type = _contactEvents[i];
+            event.Normal = Math::Vec2F::Zero();
+            event.NormalImpulse = 0.f;
+
+            // Only the solved contacts have a manifold of this frame.
+            if (_contactConstraints[i] == ContactConstraintSolver::NoConstraint) continue;
+
+            event.Normal = _contactManifolds[i].Normal;
+
+            for (const auto normalImpulse : _contactConstraintSolver.Impulse(_contactConstraints[i]).Normal)
+            {
+                event.NormalImpulse += normalImpulse;
+            }
+        }
+
+        for (std::size_t i = 0; i < exitedPairs.size(); i++)
+        {
+            auto& event = _contactEventBuffer[contacts.size() + i];
+            event.Pair = exitedPairs[i];
+            event.Type = _exitEvents[i];
+            event.Normal = Math::Vec2F::Zero();
+            event.NormalImpulse = 0.f;
+        }
+    }
+
+    template<typename Config>
+    bool BasicWorld<Config>::isSleepingPair(const Collider& colliderA, const Collider& colliderB) noexcept
+    {
+        const auto& bodyA = GetBody(colliderA.GetBodyRef());
+        const auto& bodyB = GetBody(colliderB.GetBodyRef());
+
+        return !isBodyActive(bodyA) && !isBodyActive(bodyB) && (!bodyA.IsAwake() || !bodyB.IsAwake());
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::keepSleepingPairs() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_sleepingPairs.size());
+    #endif
+
+        for (const auto& pair : _sleepingPairs)
+        {
+            _state.PairCache.Touch(pair);
+        }
+    }
+
+    template<typename Config>
+    std::uint32_t BasicWorld<Config>::findIsland(std::uint32_t bodyIdx) noexcept
+    {
+        while (_islandParents[bodyIdx] != bodyIdx)
+        {
+            _islandParents[bodyIdx] = _islandParents[_islandParents[bodyIdx]];
+            bodyIdx = _islandParents[bodyIdx];
+        }
+
+        return bodyIdx;
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::updateIslands(const float deltaTime) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        if (!_isSleepingEnabled) return;
+
+        const auto bodyCount = static_cast<std::uint32_t>(_state.Bodies.size());
+
+        _islandParents.resize(bodyCount);
+        _islandSleepTimes.assign(bodyCount, std::numeric_limits<float>::max());
+
+        const auto squareSleepTolerance = _linearSleepTolerance * _linearSleepTolerance;
+
+        for (std::uint32_t i = 0; i < bodyCount; i++)
+        {
+            _islandParents[i] = i;
+
+            auto& body = _state.Bodies[i];
+
+            if (!body.IsValid() || !isBodyActive(body)) continue;
+
+            // The sleep timer of a sleeping body is kept, so it never keeps its island awake.
+            if (body.Velocity().SquareLength() > squareSleepTolerance)
+            {
+                body.SetSleepTime(0.f);
+            }
+            else
+            {
+                body.SetSleepTime(body.SleepTime() + deltaTime);
+            }
+        }
+
+        // Only the collisions link the bodies, the static bodies and the triggers do not.
+        if (isContactDetectionEnabled())
+        {
+            const auto& contacts = _state.PairCache.Contacts();
+
+            for (std::size_t i = 0; i < contacts.size(); i++)
+            {
+                if (_contactEvents[i] != ContactEventType::CollisionEnter &&
+                    _contactEvents[i] != ContactEventType::CollisionStay)
+                {
+                    continue;
+                }
+
+                const auto bodyIdxA = static_cast<std::uint32_t>(GetCollider(contacts[i].Pair.ColliderA).GetBodyRef().Index);
+                const auto bodyIdxB = static_cast<std::uint32_t>(GetCollider(contacts[i].Pair.ColliderB).GetBodyRef().Index);
+
+                if (_state.Bodies[bodyIdxA].GetBodyType() == BodyType::Static ||
+                    _state.Bodies[bodyIdxB].GetBodyType() == BodyType::Static)
+                {
+                    continue;
+                }
+
+                const auto islandA = findIsland(bodyIdxA);
+                const auto islandB = findIsland(bodyIdxB);
+
+                // The lowest body index is the root, so the islands do not depend on the order of the contacts.
+                _islandParents[std::max(islandA, islandB)] = std::min(islandA, islandB);
+            }
+        }
+
+        for (std::uint32_t i = 0; i < bodyCount; i++)
+        {
+            const auto& body = _state.Bodies[i];
+
+            if (!body.IsValid() || body.GetBodyType() == BodyType::Static) continue;
+
+            auto& islandSleepTime = _islandSleepTimes[findIsland(i)];
+            islandSleepTime = std::min(islandSleepTime, body.SleepTime());
+        }
+
+        for (std::uint32_t i = 0; i < bodyCount; i++)
+        {
+            auto& body = _state.Bodies[i];
+
+            if (!body.IsValid() || body.GetBodyType() == BodyType::Static) continue;
+
+            body.SetAwake(_islandSleepTimes[findIsland(i)] < _timeToSleep);
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::SetSleepingEnabled(const bool isSleepingEnabled) noexcept
+    {
+        _isSleepingEnabled = isSleepingEnabled;
+
+        if (_isSleepingEnabled) return;
+
+        for (std::size_t i = 0; i < _state.Bodies.size(); i++)
+        {
+            _state.Bodies[i].SetAwake(true);
+        }
+    }
+
+    template<typename Config>
+    std::size_t BasicWorld<Config>::GetAwakeBodyCount() const noexcept
+    {
+        std::size_t awakeBodyCount = 0;
+
+        for (std::size_t i = 0; i < _state.Bodies.size(); i++)
+        {
+            if (_state.Bodies[i].IsValid() && isBodyActive(_state.Bodies[i]))
+            {
+                awakeBodyCount++;
+            }
+        }
+
+        return awakeBodyCount;
+    }
+
+    /**
+     * @brief WorldShape is a function that gives the shape of the collider given in parameter in world space.
+     */
+    template<Math::ShapeType Type>
+    static auto worldShape(const Collider& collider, const Body& body) noexcept
+    {
+        if constexpr (Type == Math::ShapeType::Circle)
+        {
+            return collider.Circle() + collider.Offset() + body.Position();
+        }
+        else if constexpr (Type == Math::ShapeType::Rectangle)
+        {
+            return collider.Rectangle() + collider.Offset() + body.Position();
+        }
+        else
+        {
+            return MakeConvexPolygon(collider, collider.Offset() + body.Position());
+        }
+    }
+
+    static Math::CircleF intersectable(const Math::CircleF& circle) noexcept { return circle; }
+    static Math::RectangleF intersectable(const Math::RectangleF& rectangle) noexcept { return rectangle; }
+    static Math::PolygonViewF intersectable(const ConvexPolygon& polygon) noexcept { return polygon.View(); }
+
+    /**
+     * @brief IsSeparatingAxisPair is a function that checks if the pair of shapes is tested with the separating
+     * axis theorem on the cached face normals, aka if one shape is a polygon and the other a polygon or a rectangle.
+     */
+    static constexpr bool isSeparatingAxisPair(const Math::ShapeType typeA, const Math::ShapeType typeB) noexcept
+    {
+        return (typeA == Math::ShapeType::Polygon && typeB != Math::ShapeType::Circle) ||
+               (typeB == Math::ShapeType::Polygon && typeA != Math::ShapeType::Circle);
+    }
+
+    template<typename Config>
+    template<Math::ShapeType TypeA, Math::ShapeType TypeB>
+    void BasicWorld<Config>::detectBucketOverlaps(const AllocVector<ColliderPair>& pairs, const ShapePairBucketStarts& bucketStarts,
+                                                  const std::uint32_t begin, const std::uint32_t end) noexcept
+    {
+        // The pairs of the shapes which are not in the world configuration are never in a bucket.
+        if constexpr (isShapeEnabled(TypeA) && isShapeEnabled(TypeB))
+        {
+            constexpr auto bucket = shapePairBucket(TypeA, TypeB);
+
+            const auto bucketEnd = std::min(bucketStarts[bucket + 1], end);
+
+            for (auto i = std::max(bucketStarts[bucket], begin); i < bucketEnd; i++)
+            {
+                const auto pairIdx = _narrowPhaseOrder[i];
+                const auto& colA = GetCollider(pairs[pairIdx].ColliderA);
+                const auto& colB = GetCollider(pairs[pairIdx].ColliderB);
+
+                if constexpr (isSeparatingAxisPair(TypeA, TypeB))
+                {
+                    const auto polygonA = MakeConvexPolygon(colA, colA.Offset() + GetBody(colA.GetBodyRef()).Position());
+                    const auto polygonB = MakeConvexPolygon(colB, colB.Offset() + GetBody(colB.GetBodyRef()).Position());
+
+                    _pairSeparatingAxes[pairIdx] = Math::Vec2F::Zero();
+
+                    // The last separating axis of the pair most often still separates it (early-out).
+                    const auto lastAxis = _separatingAxisCache.Find(pairs[pairIdx]);
+
+                    if (lastAxis != Math::Vec2F::Zero() && IsSeparatingAxis(polygonA, polygonB, lastAxis))
+                    {
+                        _pairOverlaps[pairIdx] = false;
+                        continue;
+                    }
+
+                    Math::Vec2F separatingAxis = Math::Vec2F::Zero();
+                    const bool isSeparated = FindSeparatingAxis(polygonA, polygonB, separatingAxis);
+
+                    _pairOverlaps[pairIdx] = !isSeparated;
+                    _pairSeparatingAxes[pairIdx] = separatingAxis;
+                }
+                else
+                {
+                    const auto shapeA = worldShape<TypeA>(colA, GetBody(colA.GetBodyRef()));
+                    const auto shapeB = worldShape<TypeB>(colB, GetBody(colB.GetBodyRef()));
+
+                    _pairOverlaps[pairIdx] = Math::Intersect(intersectable(shapeA), intersectable(shapeB));
+                }
+            }
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::detectOverlapsInRange(const AllocVector<ColliderPair>& pairs, const ShapePairBucketStarts& bucketStarts,
+                                                   const std::uint32_t begin, const std::uint32_t end) noexcept
+    {
+        using Math::ShapeType;
+
+        detectBucketOverlaps<ShapeType::Circle, ShapeType::Circle>(pairs, bucketStarts, begin, end);
+        detectBucketOverlaps<ShapeType::Circle, ShapeType::Rectangle>(pairs, bucketStarts, begin, end);
+        detectBucketOverlaps<ShapeType::Circle, ShapeType::Polygon>(pairs, bucketStarts, begin, end);
+        detectBucketOverlaps<ShapeType::Rectangle, ShapeType::Circle>(pairs, bucketStarts, begin, end);
+        detectBucketOverlaps<ShapeType::Rectangle, ShapeType::Rectangle>(pairs, bucketStarts, begin, end);
+        detectBucketOverlaps<ShapeType::Rectangle, ShapeType::Polygon>(pairs, bucketStarts, begin, end);
+        detectBucketOverlaps<ShapeType::Polygon, ShapeType::Circle>(pairs, bucketStarts, begin, end);
+        detectBucketOverlaps<ShapeType::Polygon, ShapeType::Rectangle>(pairs, bucketStarts, begin, end);
+        detectBucketOverlaps<ShapeType::Polygon, ShapeType::Polygon>(pairs, bucketStarts, begin, end);
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::detectOverlaps(const AllocVector<ColliderPair>& pairs) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        constexpr int bucketCount = _shapePairBucketCount;
+
+        const auto pairCount = static_cast<std::uint32_t>(pairs.size());
+
+        _pairOverlaps.assign(pairCount, 0);
+        _pairSeparatingAxes.resize(pairCount);
+        _narrowPhaseOrder.resize(pairCount);
+        _pairBuckets.resize(pairCount);
+        _separatingAxisCache.Reserve(pairCount);
+
+        // Counting sort of the pairs by shape pair, so that each bucket is tested by the same code.
+        ShapePairBucketStarts bucketStarts{};
+
+        for (std::uint32_t i = 0; i < pairCount; i++)
+        {
+            const auto& colliderA = GetCollider(pairs[i].ColliderA);
+            const auto& colliderB = GetCollider(pairs[i].ColliderB);
+
+            // A pair with a shape without type gets the bucket count and never overlaps. A sleeping pair is not
+            // tested either, its contact is kept from the previous frame.
+            const auto bucket = isSleepingPair(colliderA, colliderB) ? bucketCount :
+                                shapePairBucket(colliderA.GetShapeType(), colliderB.GetShapeType());
+
+            _pairBuckets[i] = static_cast<std::uint8_t>(bucket);
+
+            if (bucket < bucketCount)
+            {
+                bucketStarts[bucket + 1]++;
+            }
+        }
+
+        for (int bucket = 1; bucket <= bucketCount; bucket++)
+        {
+            bucketStarts[bucket] += bucketStarts[bucket - 1];
+        }
+
+        auto writeOffsets = bucketStarts;
+
+        for (std::uint32_t i = 0; i < pairCount; i++)
+        {
+            if (_pairBuckets[i] < bucketCount)
+            {
+                _narrowPhaseOrder[writeOffsets[_pairBuckets[i]]++] = i;
+            }
+        }
+
+        // Each pair writes its own overlap, so the jobs can test any range of the sorted pairs.
+        _jobSystem.ParallelFor(bucketStarts[bucketCount], _overlapChunkSize,
+                               [&](const std::size_t begin, const std::size_t end)
+        {
+            detectOverlapsInRange(pairs, bucketStarts, static_cast<std::uint32_t>(begin),
+                                  static_cast<std::uint32_t>(end));
+        });
+
+        // The new separating axes are stored after the jobs, in the order of the pairs, so that the cache content
+        // does not depend on the number of threads.
+        for (int bucket = 0; bucket < bucketCount; bucket++)
+        {
+            const auto typeA = static_cast<Math::ShapeType>(bucket / _shapeTypeCount);
+            const auto typeB = static_cast<Math::ShapeType>(bucket % _shapeTypeCount);
+
+            if (!isSeparatingAxisPair(typeA, typeB)) continue;
+
+            for (auto i = bucketStarts[bucket]; i < bucketStarts[bucket + 1]; i++)
+            {
+                const auto pairIdx = _narrowPhaseOrder[i];
+
+                if (_pairSeparatingAxes[pairIdx] != Math::Vec2F::Zero())
+                {
+                    _separatingAxisCache.Store(pairs[pairIdx], _pairSeparatingAxes[pairIdx]);
+                }
+            }
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::Deinit() noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        _state.Bodies.clear();
+        _state.BodiesGenIndices.clear();
+        _dynamicBodyIndices.clear();
+        _kinematicBodyIndices.clear();
+        _dynamicBodyLanes.Resize(0);
+
+        _state.FreeBodies.Reset();
+
+        _state.Colliders.clear();
+        _state.CollidersGenIndices.clear();
+        _state.FreeColliders.Reset();
+        _state.PairCache.Deinit();
+        _separatingAxisCache.Deinit();
+
+        _narrowPhaseOrder.clear();
+        _pairBuckets.clear();
+        _pairOverlaps.clear();
+        _pairSeparatingAxes.clear();
+        _contactEvents.clear();
+        _exitEvents.clear();
+        _contactEventBuffer.clear();
+        _contactManifolds.clear();
+        _contactConstraints.clear();
+        _contactConstraintSolver.Begin(0);
+        _sleepingPairs.clear();
+        _bulletMotions.clear();
+        _movingColliderIndices.clear();
+        _staticColliderIndices.clear();
+        _staticColliderTree.Deinit();
+        _staticColliderRecords.clear();
+        _staticPairs.clear();
+        _possiblePairs.clear();
+        _isStaticColliderTreeDirty = true;
+        _isBroadPhaseUpToDate = false;
+        _islandParents.clear();
+        _islandSleepTimes.clear();
+
+        _contactListener = nullptr;
+        _areContactEventsEnabled = false;
+        _jobSystem.Stop();
+
+        _quadTree.Deinit();
+        _sweepAndPrune.Deinit();
+        _aabbTree.Deinit();
+        _spatialHashGrid.Deinit();
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::SaveState(State& snapshot) const noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        if constexpr (IsStateTriviallyCopyable)
+        {
+            std::memcpy(&snapshot, &_state, sizeof(State));
+        }
+        else
+        {
+            snapshot = _state;
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::RestoreState(const State& snapshot) noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        if constexpr (IsStateTriviallyCopyable)
+        {
+            std::memcpy(&_state, &snapshot, sizeof(State));
+        }
+        else
+        {
+            _state = snapshot;
+        }
+
+        // The scratch structures describe the state which was replaced. The separating axes are only an early-out
+        // of the narrow phase, they are found again.
+        _isStaticColliderTreeDirty = true;
+        _isBroadPhaseUpToDate = false;
+        _separatingAxisCache.Clear();
+        _contactEventBuffer.clear();
+
+        // The sweep-and-prune and the AABB tree keep their proxies from one frame to the next, they start again
+        // from the restored state like in a world which was just initialized.
+        switch (activeBroadPhaseType())
+        {
+            case BroadPhaseType::SweepAndPrune:
+                _sweepAndPrune.Clear();
+                break;
+            case BroadPhaseType::AabbTree:
+                _aabbTree.Clear();
+                break;
+            case BroadPhaseType::QuadTree:
+            case BroadPhaseType::SpatialHash:
+                // Rebuilt at each update.
+                break;
+        }
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::HashState(XxHash64& hash) const noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        hash.UpdateValue(_state.Bodies.size());
+
+        for (const auto& body : _state.Bodies)
+        {
+            hash.UpdateValue(body.Position());
+            hash.UpdateValue(body.Velocity());
+            hash.UpdateValue(body.Forces());
+            hash.UpdateValue(body.Impulses());
+            hash.UpdateValue(body.Mass());
+            hash.UpdateValue(body.Damping());
+            hash.UpdateValue(body.SleepTime());
+            hash.UpdateValue(static_cast<std::uint8_t>(body.GetBodyType()));
+            hash.UpdateValue(body.IsAwake());
+        }
+
+        hash.Update(_state.BodiesGenIndices.data(), _state.BodiesGenIndices.size() * sizeof(std::size_t));
+
+        hash.UpdateValue(_state.Colliders.size());
+
+        for (const auto& collider : _state.Colliders)
+        {
+            const auto shapeType = collider.GetShapeType();
+            hash.UpdateValue(static_cast<std::uint8_t>(shapeType));
+
+            switch (shapeType)
+            {
+                case Math::ShapeType::Circle:
+                    hash.UpdateValue(collider.Circle());
+                    break;
+                case Math::ShapeType::Rectangle:
+                    hash.UpdateValue(collider.Rectangle());
+                    break;
+                case Math::ShapeType::Polygon:
+                {
+                    const auto polygon = collider.Polygon();
+                    hash.UpdateValue(polygon.VerticesCount());
+                    hash.Update(polygon.begin(), polygon.VerticesCount() * sizeof(Math::Vec2F));
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            hash.UpdateValue(collider.GetBodyRef());
+            hash.UpdateValue(collider.Offset());
+            hash.UpdateValue(collider.GetCollisionFilter());
+            hash.UpdateValue(collider.Restitution());
+            hash.UpdateValue(collider.Friction());
+            hash.UpdateValue(collider.IsTrigger());
+            hash.UpdateValue(collider.IsBullet());
+            hash.UpdateValue(collider.Enabled());
+            hash.UpdateValue(collider.IsInitialized());
+        }
+
+        hash.Update(_state.CollidersGenIndices.data(), _state.CollidersGenIndices.size() * sizeof(std::size_t));
+
+        const auto& contacts = _state.PairCache.Contacts();
+        hash.UpdateValue(contacts.size());
+
+        for (const auto& contact : contacts)
+        {
+            hash.UpdateValue(contact.Pair);
+            hash.UpdateValue(contact.IsNew);
+            hash.UpdateValue(contact.Impulse);
+        }
+    }
+
+    template<typename Config>
+    [[nodiscard]] BodyRef BasicWorld<Config>::CreateBody() noexcept
+    {
+        auto index = _state.FreeBodies.Acquire();
+
+        if (index == FreeList::NoSlot)
+        {
+            // No unused body, grow the arrays and use the first new slot.
+            const std::size_t previousSize = _state.Bodies.size();
+            auto newSize = std::max(static_cast<std::size_t>(static_cast<float>(previousSize) * _bodyAllocResizeFactor),
+                                    previousSize + 1);
+
+            if constexpr (Config::MaxBodyCount != 0)
+            {
+                // Past the capacity of the fixed arrays, the resize fails and terminates the program.
+                newSize = std::max(std::min(newSize, Config::MaxBodyCount), previousSize + 1);
+            }
+
+            _state.Bodies.resize(newSize, Body());
+            _state.BodiesGenIndices.resize(newSize, 0);
+            _state.FreeBodies.Grow(newSize);
+
+            index = _state.FreeBodies.Acquire();
+        }
+
+        _state.Bodies[index].SetMass(1.f);
+
+        return BodyRef{index, _state.BodiesGenIndices[index]};
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::DestroyBody(BodyRef bodyRef) noexcept
+    {
+        // A body destroyed twice must not be added twice to the free list.
+        if (_state.BodiesGenIndices[bodyRef.Index] != bodyRef.GenerationIdx) return;
+
+        _state.Bodies[bodyRef.Index] = Body();
+        _state.BodiesGenIndices[bodyRef.Index]++;
+        _state.FreeBodies.Release(static_cast<std::uint32_t>(bodyRef.Index));
+    }
+
+    template<typename Config>
+    Body& BasicWorld<Config>::GetBody(BodyRef bodyRef)
+    {
+        if (_state.BodiesGenIndices[bodyRef.Index] != bodyRef.GenerationIdx)
+        {
+            throw std::runtime_error("Null body reference exception");
+        }
+
+        return _state.Bodies[bodyRef.Index];
+    }
+
+    template<typename Config>
+    Collider& BasicWorld<Config>::GetCollider(ColliderRef colliderRef)
+    {
+        if (_state.CollidersGenIndices[colliderRef.Index] != colliderRef.GenerationIdx)
+        {
+            throw std::runtime_error("Null collider reference exception");
+        }
+
+        return _state.Colliders[colliderRef.Index];
+    }
+
+    template<typename Config>
+    ColliderRef BasicWorld<Config>::CreateCollider(BodyRef bodyRef) noexcept
+    {
+        auto colliderIdx = _state.FreeColliders.Acquire();
+
+        if (colliderIdx == FreeList::NoSlot)
+        {
+            // No unused collider, grow the arrays and use the first new slot.
+            const std::size_t previousSize = _state.Colliders.size();
+            auto newSize = std::max(static_cast<std::size_t>(static_cast<float>(previousSize) * _bodyAllocResizeFactor),
+                                    previousSize + 1);
+
+            if constexpr (Config::MaxColliderCount != 0)
+            {
+                // Past the capacity of the fixed arrays, the resize fails and terminates the program.
+                newSize = std::max(std::min(newSize, Config::MaxColliderCount), previousSize + 1);
+            }
+
+            _state.Colliders.resize(newSize, Collider());
+            _state.CollidersGenIndices.resize(newSize, 0);
+            _state.FreeColliders.Grow(newSize);
+
+            colliderIdx = _state.FreeColliders.Acquire();
+        }
+
+        auto& collider = _state.Colliders[colliderIdx];
+
+        collider.SetIsInitialized(true);
+        collider.SetEnabled(true);
+        collider.SetBodyRef(bodyRef);
+
+        // The new collider is not in the broad phase until the next update.
+        _isBroadPhaseUpToDate = false;
+
+        ColliderRef colRef = {colliderIdx, _state.CollidersGenIndices[colliderIdx]};
+
+        return colRef;
+    }
+
+    template<typename Config>
+    void BasicWorld<Config>::DestroyCollider(ColliderRef colRef) noexcept
+    {
+        // A collider destroyed twice must not be added twice to the free list.
+        if (_state.CollidersGenIndices[colRef.Index] != colRef.GenerationIdx) return;
+
+        _state.Colliders[colRef.Index] = Collider();
+        _state.CollidersGenIndices[colRef.Index]++;
+        _state.FreeColliders.Release(static_cast<std::uint32_t>(colRef.Index));
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * @headerfile WorldQuery.h
+ * This header file defines the inputs and the results of the ray casts, circle casts and box queries of the
+ * world.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "CollisionFilter.h"
+#include "Shape.h"
+#include "WorldRefTypes.h"
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief QueryFilter is a struct that stores which colliders a query can find: the colliders in at least
+     * one of the categories of the mask, and the triggers only if they are included.
+     */
+    struct QueryFilter
+    {
+        std::uint32_t MaskBits = CollisionFilter::AllCategoryBits;
+        bool IncludeTriggers = false;
+    };
+
+    /**
+     * @brief RayCastInput is a struct that stores a ray going from its origin to its origin plus its translation.
+     */
+    struct RayCastInput
+    {
+        Math::Vec2F Origin = Math::Vec2F::Zero();
+        Math::Vec2F Translation = Math::Vec2F::Zero();
+        QueryFilter Filter{};
+    };
+
+    /**
+     * @brief CircleCastInput is a struct that stores a circle moved from its center to its center plus its
+     * translation.
+     */
+    struct CircleCastInput
+    {
+        Math::CircleF Circle{ Math::Vec2F::Zero(), 0.f };
+        Math::Vec2F Translation = Math::Vec2F::Zero();
+        QueryFilter Filter{};
+    };
+
+    /**
+     * @brief RayCastHit is a struct that stores the first collider hit by a ray or a circle cast. The fraction is
+     * the part of the translation done before the hit, in [0, 1]. The point is on the surface of the collider
+     * hit and the normal goes from the collider to the cast shape.
+     */
+    struct RayCastHit
+    {
+        ColliderRef ColRef{ 0, 0 };
+        Math::Vec2F Point = Math::Vec2F::Zero();
+        Math::Vec2F Normal = Math::Vec2F::Zero();
+        float Fraction = 1.f;
+        bool Hit = false;
+    };
+}
@@ -0,0 +1,511 @@
+#include "AabbTree.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+#include <algorithm>
+#include <vector>
+
+namespace PhysicsEngine
+{
+    static constexpr Math::Vec2F minVec(const Math::Vec2F a, const Math::Vec2F b) noexcept
+    {
+        return { std::min(a.X, b.X), std::min(a.Y, b.Y) };
+    }
+
+    static constexpr Math::Vec2F maxVec(const Math::Vec2F a, const Math::Vec2F b) noexcept
+    {
+        return { std::max(a.X, b.X), std::max(a.Y, b.Y) };
+    }
+
+    static constexpr float perimeter(const Math::Vec2F minBound, const Math::Vec2F maxBound) noexcept
+    {
+        return 2.f * (maxBound.X - minBound.X + maxBound.Y - minBound.Y);
+    }
+
+    static constexpr bool overlap(const Math::Vec2F minA, const Math::Vec2F maxA,
+                                  const Math::Vec2F minB, const Math::Vec2F maxB) noexcept
+    {
+        return !(maxA.X < minB.X || minA.X > maxB.X || maxA.Y < minB.Y || minA.Y > maxB.Y);
+    }
+
+    void AabbTree::Init(const std::size_t colliderCount) noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        _proxies.resize(std::max(_proxies.size(), colliderCount), Proxy{});
+
+        // A tree with n leaves has n - 1 internal nodes.
+        _nodes.reserve(colliderCount * 2);
+        _stack.reserve(64);
+        _possiblePairs.reserve(colliderCount);
+    }
+
+    std::uint32_t AabbTree::allocateNode() noexcept
+    {
+        if (_freeNode == NullNode)
+        {
+            _nodes.push_back(TreeNode{});
+            return static_cast<std::uint32_t>(_nodes.size() - 1);
+        }
+
+        const auto nodeIdx = _freeNode;
+        _freeNode = _nodes[nodeIdx].Parent;
+        _nodes[nodeIdx] = TreeNode{};
+
+        return nodeIdx;
+    }
+
+    void AabbTree::freeNode(const std::uint32_t nodeIdx) noexcept
+    {
+        _nodes[nodeIdx] = TreeNode{};
+        _nodes[nodeIdx].Parent = _freeNode;
+        _freeNode = nodeIdx;
+    }
+
+    void AabbTree::Insert(const Math::RectangleF simplifiedShape, const ColliderRef colliderRef,
+                          const bool isStatic, const CollisionFilter filter) noexcept
+    {
+        if (colliderRef.Index >= _proxies.size())
+        {
+            _proxies.resize(std::max(colliderRef.Index + 1, _proxies.size() * 2), Proxy{});
+        }
+
+        const auto proxyIdx = static_cast<std::uint32_t>(colliderRef.Index);
+        auto& proxy = _proxies[proxyIdx];
+
+        if (proxy.Stamp == 0)
+        {
+            _proxyCount++;
+        }
+
+        proxy.ColRef = colliderRef;
+        proxy.MinBound = simplifiedShape.MinBound();
+        proxy.MaxBound = simplifiedShape.MaxBound();
+        proxy.Filter = filter;
+        proxy.Stamp = _frame;
+
+        if (proxy.Leaf != NullNode)
+        {
+            auto& leaf = _nodes[proxy.Leaf];
+
+            // The collider is still inside its fat box, the tree does not change. A leaf whose body type
+            // changed is re-inserted to update the static flags of its ancestors.
+            if (leaf.IsStatic == isStatic &&
+                leaf.MinBound.X <= proxy.MinBound.X && leaf.MinBound.Y <= proxy.MinBound.Y &&
+                leaf.MaxBound.X >= proxy.MaxBound.X && leaf.MaxBound.Y >= proxy.MaxBound.Y)
+            {
+                return;
+            }
+
+            removeLeaf(proxy.Leaf);
+            leaf.IsStatic = isStatic;
+        }
+        else
+        {
+            const auto leafIdx = allocateNode();
+            auto& leaf = _nodes[leafIdx];
+            leaf.Height = 0;
+            leaf.ProxyIdx = proxyIdx;
+            leaf.IsStatic = isStatic;
+
+            proxy.Leaf = leafIdx;
+        }
+
+        const Math::Vec2F margin(_aabbMargin, _aabbMargin);
+        auto& leaf = _nodes[proxy.Leaf];
+        leaf.MinBound = proxy.MinBound - margin;
+        leaf.MaxBound = proxy.MaxBound + margin;
+
+        insertLeaf(proxy.Leaf);
+        _movedCount++;
+    }
+
+    void AabbTree::insertLeaf(const std::uint32_t leaf) noexcept
+    {
+        if (_root == NullNode)
+        {
+            _root = leaf;
+            _nodes[leaf].Parent = NullNode;
+            return;
+        }
+
+        const auto leafMin = _nodes[leaf].MinBound;
+        const auto leafMax = _nodes[leaf].MaxBound;
+
+        // Find the best sibling by descending the tree with the cost of the perimeters it would add.
+        std::uint32_t index = _root;
+
+        while (!_nodes[index].IsLeaf())
+        {
+            const auto& node = _nodes[index];
+
+            const float area = perimeter(node.MinBound, node.MaxBound);
+            const float combinedArea = perimeter(minVec(node.MinBound, leafMin), maxVec(node.MaxBound, leafMax));
+
+            // Cost of creating a new parent for this node and the leaf.
+            const float cost = 2.f * combinedArea;
+
+            // Minimum cost of pushing the leaf further down the tree.
+            const float inheritanceCost = 2.f * (combinedArea - area);
+
+            float childCosts[2];
+            const std::uint32_t children[2] = { node.Child1, node.Child2 };
+
+            for (int i = 0; i < 2; i++)
+            {
+                const auto& child = _nodes[children[i]];
+                const float childArea = perimeter(minVec(child.MinBound, leafMin), maxVec(child.MaxBound, leafMax));
+
+                childCosts[i] = child.IsLeaf() ?
+                                childArea + inheritanceCost :
+                                childArea - perimeter(child.MinBound, child.MaxBound) + inheritanceCost;
+            }
+
+            if (cost < childCosts[0] && cost < childCosts[1])
+            {
+                break;
+            }
+
+            index = childCosts[0] < childCosts[1] ? children[0] : children[1];
+        }
+
+        const auto sibling = index;
+
+        // Create a new parent for the sibling and the leaf.
+        const auto oldParent = _nodes[sibling].Parent;
+        const auto newParent = allocateNode();
+
+        auto& newParentNode = _nodes[newParent];
+        newParentNode.Parent = oldParent;
+        newParentNode.MinBound = minVec(leafMin, _nodes[sibling].MinBound);
+        newParentNode.MaxBound = maxVec(leafMax, _nodes[sibling].MaxBound);
+        newParentNode.Height = _nodes[sibling].Height + 1;
+        newParentNode.IsStatic = _nodes[sibling].IsStatic && _nodes[leaf].IsStatic;
+        newParentNode.Child1 = sibling;
+        newParentNode.Child2 = leaf;
+
+        replaceChild(oldParent, sibling, newParent);
+
+        _nodes[sibling].Parent = newParent;
+        _nodes[leaf].Parent = newParent;
+
+        refitAncestors(newParent);
+    }
+
+    void AabbTree::removeLeaf(const std::uint32_t leaf) noexcept
+    {
+        if (leaf == _root)
+        {
+            _root = NullNode;
+            return;
+        }
+
+        const auto parent = _nodes[leaf].Parent;
+        const auto grandParent = _nodes[parent].Parent;
+        const auto sibling = _nodes[parent].Child1 == leaf ? _nodes[parent].Child2 : _nodes[parent].Child1;
+
+        // The sibling takes the place of the parent.
+        replaceChild(grandParent, parent, sibling);
+        _nodes[sibling].Parent = grandParent;
+        freeNode(parent);
+
+        refitAncestors(grandParent);
+
+        _nodes[leaf].Parent = NullNode;
+    }
+
+    void AabbTree::refitAncestors(std::uint32_t nodeIdx) noexcept
+    {
+        while (nodeIdx != NullNode)
+        {
+            nodeIdx = balance(nodeIdx);
+            fitNode(nodeIdx);
+
+            nodeIdx = _nodes[nodeIdx].Parent;
+        }
+    }
+
+    void AabbTree::fitNode(const std::uint32_t nodeIdx) noexcept
+    {
+        auto& node = _nodes[nodeIdx];
+        const auto& child1 = _nodes[node.Child1];
+        const auto& child2 = _nodes[node.Child2];
+
+        node.Height = 1 + std::max(child1.Height, child2.Height);
+        node.MinBound = minVec(child1.MinBound, child2.MinBound);
+        node.MaxBound = maxVec(child1.MaxBound, child2.MaxBound);
+        node.IsStatic = child1.IsStatic && child2.IsStatic;
+    }
+
+    std::uint32_t AabbTree::balance(const std::uint32_t iA) noexcept
+    {
+        auto& a = _nodes[iA];
+
+        if (a.IsLeaf() || a.Height < 2)
+        {
+            return iA;
+        }
+
+        const auto iB = a.Child1;
+        const auto iC = a.Child2;
+        auto& b = _nodes[iB];
+        auto& c = _nodes[iC];
+
+        const auto balanceFactor = c.Height - b.Height;
+
+        // Rotate C up.
+        if (balanceFactor > 1)
+        {
+            const auto iF = c.Child1;
+            const auto iG = c.Child2;
+
+            // Swap A and C.
+            c.Child1 = iA;
+            c.Parent = a.Parent;
+            a.Parent = iC;
+
+            // A's old parent should point to C.
+            replaceChild(c.Parent, iA, iC);
+
+            // The highest child of C stays under C, the other one goes under A.
+            const bool isFHigher = _nodes[iF].Height > _nodes[iG].Height;
+            const auto iKept = isFHigher ? iF : iG;
+            const auto iMoved = isFHigher ? iG : iF;
+
+            c.Child2 = iKept;
+            a.Child2 = iMoved;
+            _nodes[iMoved].Parent = iA;
+
+            fitNode(iA);
+            fitNode(iC);
+
+            return iC;
+        }
+
+        // Rotate B up.
+        if (balanceFactor < -1)
+        {
+            const auto iD = b.Child1;
+            const auto iE = b.Child2;
+
+            // Swap A and B.
+            b.Child1 = iA;
+            b.Parent = a.Parent;
+            a.Parent = iB;
+
+            // A's old parent should point to B.
+            replaceChild(b.Parent, iA, iB);
+
+            // The highest child of B stays under B, the other one goes under A.
+            const bool isDHigher = _nodes[iD].Height > _nodes[iE].Height;
+            const auto iKept = isDHigher ? iD : iE;
+            const auto iMoved = isDHigher ? iE : iD;
+
+            b.Child2 = iKept;
+            a.Child1 = iMoved;
+            _nodes[iMoved].Parent = iA;
+
+            fitNode(iA);
+            fitNode(iB);
+
+            return iB;
+        }
+
+        return iA;
+    }
+
+    void AabbTree::replaceChild(const std::uint32_t parentIdx, const std::uint32_t oldChild,
+                                const std::uint32_t newChild) noexcept
+    {
+        if (parentIdx == NullNode)
+        {
+            _root = newChild;
+            return;
+        }
+
+        auto& parent = _nodes[parentIdx];
+
+        if (parent.Child1 == oldChild)
+        {
+            parent.Child1 = newChild;
+        }
+        else
+        {
+            parent.Child2 = newChild;
+        }
+    }
+
+    void AabbTree::CalculatePossiblePairs() noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        // Remove the colliders that were not inserted in this frame.
+        for (auto& proxy : _proxies)
+        {
+            if (proxy.Stamp == 0 || proxy.Stamp == _frame) continue;
+
+            removeLeaf(proxy.Leaf);
+            freeNode(proxy.Leaf);
+
+            proxy = Proxy{};
+            _proxyCount--;
+        }
+
+        _possiblePairs.clear();
+        _stack.clear();
+
+        if (_root != NullNode)
+        {
+            _stack.push_back(NodePair{ _root, _root });
+        }
+
+        // Collide the tree with itself: a node pair (n, n) tests the leaves of the sub-tree between them
+        // and a node pair (a, b) tests the leaves of a against the leaves of b. Each pair of leaves is
+        // reached once, and the sub-trees containing only static colliders are never tested together.
+        while (!_stack.empty())
+        {
+            const auto nodePair = _stack.back();
+            _stack.pop_back();
+
+            const auto& nodeA = _nodes[nodePair.A];
+
+            if (nodePair.A == nodePair.B)
+            {
+                if (nodeA.IsLeaf() || nodeA.IsStatic) continue;
+
+                _stack.push_back(NodePair{ nodeA.Child2, nodeA.Child2 });
+                _stack.push_back(NodePair{ nodeA.Child1, nodeA.Child1 });
+                _stack.push_back(NodePair{ nodeA.Child1, nodeA.Child2 });
+                continue;
+            }
+
+            const auto& nodeB = _nodes[nodePair.B];
+
+            if (nodeA.IsStatic && nodeB.IsStatic) continue;
+            if (!overlap(nodeA.MinBound, nodeA.MaxBound, nodeB.MinBound, nodeB.MaxBound)) continue;
+
+            if (nodeA.IsLeaf() && nodeB.IsLeaf())
+            {
+                addPair(nodeA.ProxyIdx, nodeB.ProxyIdx);
+                continue;
+            }
+
+            // Descend in the largest node to keep the two boxes of similar sizes.
+            if (nodeB.IsLeaf() || (!nodeA.IsLeaf() &&
+                perimeter(nodeA.MinBound, nodeA.MaxBound) >= perimeter(nodeB.MinBound, nodeB.MaxBound)))
+            {
+                _stack.push_back(NodePair{ nodeA.Child2, nodePair.B });
+                _stack.push_back(NodePair{ nodeA.Child1, nodePair.B });
+            }
+            else
+            {
+                _stack.push_back(NodePair{ nodePair.A, nodeB.Child2 });
+                _stack.push_back(NodePair{ nodePair.A, nodeB.Child1 });
+            }
+        }
+
+        // The traversal order depends on the fat boxes, the rotations and the free nodes, sort the pairs
+        // so that two worlds in the same state solve their contacts in the same order.
+        std::sort(_possiblePairs.begin(), _possiblePairs.end());
+
+        _lastMovedCount = _movedCount;
+        _movedCount = 0;
+        _frame++;
+    }
+
+    void AabbTree::addPair(const std::uint32_t proxyIdxA, const std::uint32_t proxyIdxB) noexcept
+    {
+        const auto& proxyA = _proxies[std::min(proxyIdxA, proxyIdxB)];
+        const auto& proxyB = _proxies[std::max(proxyIdxA, proxyIdxB)];
+
+        // The fat boxes overlap, the tight ones may not.
+        if (overlap(proxyA.MinBound, proxyA.MaxBound, proxyB.MinBound, proxyB.MaxBound) &&
+            ShouldCollide(proxyA.Filter, proxyB.Filter))
+        {
+            _possiblePairs.push_back(ColliderPair{ proxyA.ColRef, proxyB.ColRef });
+        }
+    }
+
+    void AabbTree::Clear() noexcept
+    {
+        _nodes.clear();
+        std::fill(_proxies.begin(), _proxies.end(), Proxy{});
+        _stack.clear();
+        _possiblePairs.clear();
+
+        _root = NullNode;
+        _freeNode = NullNode;
+        _proxyCount = 0;
+        _movedCount = 0;
+        _lastMovedCount = 0;
+    }
+
+    void AabbTree::Deinit() noexcept
+    {
+        _nodes.clear();
+        _proxies.clear();
+        _stack.clear();
+        _possiblePairs.clear();
+
+        _root = NullNode;
+        _freeNode = NullNode;
+        _proxyCount = 0;
+        _movedCount = 0;
+        _lastMovedCount = 0;
+        _frame = 1;
+    }
+
+    bool AabbTree::Validate() const noexcept
+    {
+        if (_root == NullNode) return _proxyCount == 0;
+        if (_nodes[_root].Parent != NullNode) return false;
+
+        std::size_t leafCount = 0;
+
+        std::vector<std::uint32_t> stack;
+        stack.push_back(_root);
+
+        while (!stack.empty())
+        {
+            const auto nodeIdx = stack.back();
+            stack.pop_back();
+
+            const auto& node = _nodes[nodeIdx];
+
+            if (node.IsLeaf())
+            {
+                if (node.Height != 0 || _proxies[node.ProxyIdx].Leaf != nodeIdx) return false;
+
+                leafCount++;
+                continue;
+            }
+
+            const auto& child1 = _nodes[node.Child1];
+            const auto& child2 = _nodes[node.Child2];
+
+            if (child1.Parent != nodeIdx || child2.Parent != nodeIdx) return false;
+            if (node.Height != 1 + std::max(child1.Height, child2.Height)) return false;
+            if (node.IsStatic != (child1.IsStatic && child2.IsStatic)) return false;
+
+            for (const auto* child : { &child1, &child2 })
+            {
+                if (child->MinBound.X < node.MinBound.X || child->MinBound.Y < node.MinBound.Y ||
+                    child->MaxBound.X > node.MaxBound.X || child->MaxBound.Y > node.MaxBound.Y)
+                {
+                    return false;
+                }
+            }
+
+            stack.push_back(node.Child1);
+            stack.push_back(node.Child2);
+        }
+
+        return leafCount == _proxyCount;
+    }
+}
@@ -0,0 +1,26 @@
+#include "ContactCache.h"
+
+namespace PhysicsEngine
+{
+    std::uint64_t HashColliderPair(const ColliderPair& pair) noexcept
+    {
+        const auto key = CanonicalPair(pair);
+
+        // Pack each collider reference in 64 bits, then mix the two words with the splitmix64 finalizer.
+        const auto a = static_cast<std::uint64_t>(key.ColliderA.Index) |
+                       static_cast<std::uint64_t>(key.ColliderA.GenerationIdx) << 32;
+        const auto b = static_cast<std::uint64_t>(key.ColliderB.Index) |
+                       static_cast<std::uint64_t>(key.ColliderB.GenerationIdx) << 32;
+
+        std::uint64_t h = a * 0x9E3779B97F4A7C15ull ^ (b + 0x632BE59BD9B4E019ull);
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBull;
+        h ^= h >> 31;
+
+        return h;
+    }
+
+    template class BasicContactCache<>;
+}
@@ -0,0 +1,205 @@
+#include "ContactConstraintSolver.h"
+
+#include "Utility.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+#include <algorithm>
+#include <cmath>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief solverInverseMass is a function that gives the inverse mass of the body seen by the solver, which
+     * is zero for a static body.
+     */
+    static float solverInverseMass(const Body& body) noexcept
+    {
+        return body.GetBodyType() == BodyType::Dynamic || body.GetBodyType() == BodyType::Kinematic ?
+               body.InverseMass() : 0.f;
+    }
+
+    void ContactConstraintSolver::Begin(const std::size_t worldBodyCount) noexcept
+    {
+        // Only the bodies of the previous frame are reset, so a frame costs nothing for the bodies without contact.
+        for (const auto& solverBody : _bodies)
+        {
+            if (solverBody.WorldBodyIdx < _solverBodyIndices.size())
+            {
+                _solverBodyIndices[solverBody.WorldBodyIdx] = NoBody;
+            }
+        }
+
+        _bodies.clear();
+        _constraints.clear();
+
+        _solverBodyIndices.resize(worldBodyCount, NoBody);
+    }
+
+    std::uint32_t ContactConstraintSolver::addBody(const std::uint32_t worldBodyIdx, const Body& body) noexcept
+    {
+        auto& solverBodyIdx = _solverBodyIndices[worldBodyIdx];
+
+        if (solverBodyIdx == NoBody)
+        {
+            solverBodyIdx = static_cast<std::uint32_t>(_bodies.size());
+            _bodies.push_back(SolverBody{ body.Position(), body.Velocity(), body.Velocity(),
+                                          solverInverseMass(body), worldBodyIdx });
+        }
+
+        return solverBodyIdx;
+    }
+
+    std::uint32_t ContactConstraintSolver::AddContact(const std::uint32_t worldBodyIdxA, const Body& bodyA,
+                                                      const Collider& colliderA,
+                                                      const std::uint32_t worldBodyIdxB, const Body& bodyB,
+                                                      const Collider& colliderB,
+                                                      const ContactManifold& manifold,
+                                                      const ContactImpulse& impulse) noexcept
+    {
+        const auto inverseMassA = solverInverseMass(bodyA);
+        const auto inverseMassB = solverInverseMass(bodyB);
+
+        if (manifold.PointCount == 0 || inverseMassA + inverseMassB <= 0.f) return NoConstraint;
+
+        ContactConstraint constraint;
+        constraint.BodyA = addBody(worldBodyIdxA, bodyA);
+        constraint.BodyB = addBody(worldBodyIdxB, bodyB);
+        constraint.Normal = manifold.Normal;
+        constraint.Tangent = Math::Vec2F(-manifold.Normal.Y, manifold.Normal.X);
+        constraint.EffectiveMass = 1.f / (inverseMassA + inverseMassB);
+
+        // Same restitution as the former contact solver: the restitutions weighted by the masses.
+        const auto mA = bodyA.Mass(), mB = bodyB.Mass();
+        const auto restitution = (mA * colliderA.Restitution() + mB * colliderB.Restitution()) / (mA + mB);
+
+        // The colliders without friction have a negative friction.
+        if (colliderA.Friction() > 0.f && colliderB.Friction() > 0.f)
+        {
+            constraint.Friction = std::sqrt(colliderA.Friction() * colliderB.Friction());
+        }
+
+        const auto normalVelocity = (bodyA.Velocity() - bodyB.Velocity()).Dot(manifold.Normal);
+        constraint.TargetVelocity = normalVelocity < 0.f ? -normalVelocity * restitution : 0.f;
+        constraint.InitialSeparation = (bodyA.Position() - bodyB.Position()).Dot(manifold.Normal);
+
+        for (int i = 0; i < manifold.PointCount; i++)
+        {
+            constraint.Penetrations[i] = manifold.Points[i].Penetration;
+        }
+
+        constraint.Impulse = impulse;
+        constraint.PointCount = manifold.PointCount;
+
+        _constraints.push_back(constraint);
+
+        return static_cast<std::uint32_t>(_constraints.size() - 1);
+    }
+
+    void ContactConstraintSolver::applyImpulse(const ContactConstraint& constraint, const Math::Vec2F impulse) noexcept
+    {
+        auto& bodyA = _bodies[constraint.BodyA];
+        auto& bodyB = _bodies[constraint.BodyB];
+
+        bodyA.Velocity += impulse * bodyA.InverseMass;
+        bodyB.Velocity -= impulse * bodyB.InverseMass;
+    }
+
+    void ContactConstraintSolver::Solve(const float deltaTime, const int velocityIterationCount,
+                                        const int positionIterationCount) noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+        ZoneValue(_constraints.size());
+#endif // TRACY_ENABLE
+
+        // Warm start: the impulses of the previous frame are a good guess of the impulses of this frame.
+        for (const auto& constraint : _constraints)
+        {
+            for (int i = 0; i < constraint.PointCount; i++)
+            {
+                applyImpulse(constraint, constraint.Normal * constraint.Impulse.Normal[i] +
+                                         constraint.Tangent * constraint.Impulse.Tangent[i]);
+            }
+        }
+
+        for (int iteration = 0; iteration < velocityIterationCount; iteration++)
+        {
+            SolveVelocities();
+        }
+
+        // Move the bodies as if they had been integrated with the solved velocities.
+        for (auto& body : _bodies)
+        {
+            body.Position += (body.Velocity - body.IntegratedVelocity) * deltaTime;
+        }
+
+        for (int iteration = 0; iteration < positionIterationCount; iteration++)
+        {
+            SolvePositions();
+        }
+    }
+
+    void ContactConstraintSolver::SolveVelocities() noexcept
+    {
+        for (auto& constraint : _constraints)
+        {
+            const auto& bodyA = _bodies[constraint.BodyA];
+            const auto& bodyB = _bodies[constraint.BodyB];
+
+            for (int i = 0; i < constraint.PointCount; i++)
+            {
+                // The friction is solved first, it is limited by the normal impulse of the previous iteration.
+                if (constraint.Friction > 0.f)
+                {
+                    const auto tangentVelocity = (bodyA.Velocity - bodyB.Velocity).Dot(constraint.Tangent);
+                    const auto maxFriction = constraint.Friction * constraint.Impulse.Normal[i];
+
+                    const auto oldImpulse = constraint.Impulse.Tangent[i];
+                    constraint.Impulse.Tangent[i] = Math::Clamp(oldImpulse - tangentVelocity * constraint.EffectiveMass,
+                                                                -maxFriction, maxFriction);
+
+                    applyImpulse(constraint, constraint.Tangent * (constraint.Impulse.Tangent[i] - oldImpulse));
+                }
+
+                const auto normalVelocity = (bodyA.Velocity - bodyB.Velocity).Dot(constraint.Normal);
+
+                // The accumulated impulse can only push the bodies apart, so it is clamped and not the increment.
+                const auto oldImpulse = constraint.Impulse.Normal[i];
+                constraint.Impulse.Normal[i] = std::max(
+                        oldImpulse + (constraint.TargetVelocity - normalVelocity) * constraint.EffectiveMass, 0.f);
+
+                applyImpulse(constraint, constraint.Normal * (constraint.Impulse.Normal[i] - oldImpulse));
+            }
+        }
+    }
+
+    void ContactConstraintSolver::SolvePositions() noexcept
+    {
+        for (const auto& constraint : _constraints)
+        {
+            auto& bodyA = _bodies[constraint.BodyA];
+            auto& bodyB = _bodies[constraint.BodyB];
+
+            for (int i = 0; i < constraint.PointCount; i++)
+            {
+                // The bodies do not rotate, so the penetration only changes by their move along the normal.
+                const auto separation = (bodyA.Position - bodyB.Position).Dot(constraint.Normal) -
+                                        constraint.InitialSeparation;
+                const auto penetration = constraint.Penetrations[i] - separation;
+
+                const auto correction = Math::Clamp(_positionCorrectionFactor * (penetration - _linearSlop),
+                                                    0.f, _maxPositionCorrection);
+
+                if (correction <= 0.f) continue;
+
+                const auto move = constraint.Normal * (correction * constraint.EffectiveMass);
+
+                bodyA.Position += move * bodyA.InverseMass;
+                bodyB.Position -= move * bodyB.InverseMass;
+            }
+        }
+    }
+}
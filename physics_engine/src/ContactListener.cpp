@@ -0,0 +1,42 @@
+#include "ContactListener.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+namespace PhysicsEngine
+{
+    void DispatchContactEvents(const ContactEventSpan events, ContactListener& contactListener) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(events.size());
+    #endif
+
+        for (const auto& event : events)
+        {
+            const auto& pair = event.Pair;
+
+            switch (event.Type)
+            {
+                case ContactEventType::TriggerEnter:
+                    contactListener.OnTriggerEnter(pair.ColliderA, pair.ColliderB);
+                    break;
+                case ContactEventType::TriggerStay:
+                    contactListener.OnTriggerStay(pair.ColliderA, pair.ColliderB);
+                    break;
+                case ContactEventType::TriggerExit:
+                    contactListener.OnTriggerExit(pair.ColliderA, pair.ColliderB);
+                    break;
+                case ContactEventType::CollisionEnter:
+                    contactListener.OnCollisionEnter(pair.ColliderA, pair.ColliderB);
+                    break;
+                case ContactEventType::CollisionExit:
+                    contactListener.OnCollisionExit(pair.ColliderA, pair.ColliderB);
+                    break;
+                case ContactEventType::CollisionStay:
+                    break;
+            }
+        }
+    }
+}
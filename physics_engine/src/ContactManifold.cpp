@@ -0,0 +1,338 @@
+#include "ContactManifold.h"
+#include "ConvexPolygon.h"
+
+#include "Utility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace PhysicsEngine
+{
+    static ContactManifold circleCircleManifold(const Math::CircleF& circleA, const Math::CircleF& circleB) noexcept
+    {
+        ContactManifold manifold;
+
+        const auto delta = circleA.Center() - circleB.Center();
+        const auto radiusSum = circleA.Radius() + circleB.Radius();
+        const auto squareDistance = delta.SquareLength();
+
+        if (squareDistance > radiusSum * radiusSum) return manifold;
+
+        const auto distance = std::sqrt(squareDistance);
+
+        // Two circles with the same center are separated along the up axis.
+        manifold.Normal = distance > Math::Epsilon ? delta / distance : Math::Vec2F::Up();
+        manifold.Points[0].Position = circleB.Center() + manifold.Normal * circleB.Radius();
+        manifold.Points[0].Penetration = radiusSum - distance;
+        manifold.PointCount = 1;
+
+        return manifold;
+    }
+
+    static ContactManifold circleRectangleManifold(const Math::CircleF& circle, const Math::RectangleF& rectangle) noexcept
+    {
+        ContactManifold manifold;
+
+        const auto center = circle.Center();
+        const auto minBound = rectangle.MinBound();
+        const auto maxBound = rectangle.MaxBound();
+
+        const Math::Vec2F closestPoint(Math::Clamp(center.X, minBound.X, maxBound.X),
+                                       Math::Clamp(center.Y, minBound.Y, maxBound.Y));
+
+        const auto delta = center - closestPoint;
+        const auto squareDistance = delta.SquareLength();
+
+        if (squareDistance > circle.Radius() * circle.Radius()) return manifold;
+
+        const auto distance = std::sqrt(squareDistance);
+
+        if (distance > Math::Epsilon)
+        {
+            manifold.Normal = delta / distance;
+            manifold.Points[0].Position = closestPoint;
+            manifold.Points[0].Penetration = circle.Radius() - distance;
+        }
+        else
+        {
+            // The center is inside the rectangle: the circle is pushed out by the nearest side.
+            const std::array<float, 4> sideDistances = { center.X - minBound.X, maxBound.X - center.X,
+                                                         center.Y - minBound.Y, maxBound.Y - center.Y };
+            const std::array<Math::Vec2F, 4> sideNormals = { Math::Vec2F::Left(), Math::Vec2F::Right(),
+                                                             Math::Vec2F::Down(), Math::Vec2F::Up() };
+
+            const auto side = std::min_element(sideDistances.begin(), sideDistances.end()) - sideDistances.begin();
+
+            manifold.Normal = sideNormals[side];
+            manifold.Points[0].Position = center + manifold.Normal * sideDistances[side];
+            manifold.Points[0].Penetration = circle.Radius() + sideDistances[side];
+        }
+
+        manifold.PointCount = 1;
+
+        return manifold;
+    }
+
+    static ContactManifold rectangleRectangleManifold(const Math::RectangleF& rectA, const Math::RectangleF& rectB) noexcept
+    {
+        ContactManifold manifold;
+
+        const Math::Vec2F overlapMin(std::max(rectA.MinBound().X, rectB.MinBound().X),
+                                     std::max(rectA.MinBound().Y, rectB.MinBound().Y));
+        const Math::Vec2F overlapMax(std::min(rectA.MaxBound().X, rectB.MaxBound().X),
+                                     std::min(rectA.MaxBound().Y, rectB.MaxBound().Y));
+
+        const auto overlap = overlapMax - overlapMin;
+
+        if (overlap.X < 0.f || overlap.Y < 0.f) return manifold;
+
+        const auto delta = rectA.Center() - rectB.Center();
+
+        // The rectangles are separated along the axis of least penetration.
+        if (overlap.X < overlap.Y)
+        {
+            manifold.Normal = delta.X > 0.f ? Math::Vec2F::Right() : Math::Vec2F::Left();
+            manifold.Points[0].Penetration = overlap.X;
+        }
+        else
+        {
+            manifold.Normal = delta.Y > 0.f ? Math::Vec2F::Up() : Math::Vec2F::Down();
+            manifold.Points[0].Penetration = overlap.Y;
+        }
+
+        manifold.Points[0].Position = (overlapMin + overlapMax) * 0.5f;
+        manifold.PointCount = 1;
+
+        return manifold;
+    }
+
+    static ContactManifold circlePolygonManifold(const Math::CircleF& circle, const ConvexPolygon& polygon) noexcept
+    {
+        ContactManifold manifold;
+
+        const auto center = circle.Center();
+        const auto radius = circle.Radius();
+
+        // The face of the polygon the center is the farthest in front of.
+        float maxSeparation = std::numeric_limits<float>::lowest();
+        int face = 0;
+
+        for (int i = 0; i < polygon.VerticesCount; i++)
+        {
+            const auto separation = polygon.Normals[i].Dot(center - polygon.Vertices[i]);
+
+            if (separation > maxSeparation)
+            {
+                maxSeparation = separation;
+                face = i;
+            }
+        }
+
+        if (maxSeparation > radius) return manifold;
+
+        const auto vertex1 = polygon.Vertices[face];
+        const auto vertex2 = polygon.Vertices[(face + 1) % polygon.VerticesCount];
+
+        // The center is in front of the face or inside the polygon: the circle is pushed out along the face normal.
+        if (maxSeparation <= 0.f ||
+            ((center - vertex1).Dot(vertex2 - vertex1) > 0.f && (center - vertex2).Dot(vertex1 - vertex2) > 0.f))
+        {
+            manifold.Normal = polygon.Normals[face];
+            manifold.Points[0].Position = center - manifold.Normal * maxSeparation;
+            manifold.Points[0].Penetration = radius - maxSeparation;
+            manifold.PointCount = 1;
+
+            return manifold;
+        }
+
+        // Else the center is in the region of one of the vertices of the face.
+        const auto vertex = (center - vertex1).Dot(vertex2 - vertex1) <= 0.f ? vertex1 : vertex2;
+        const auto delta = center - vertex;
+        const auto squareDistance = delta.SquareLength();
+
+        if (squareDistance > radius * radius) return manifold;
+
+        const auto distance = std::sqrt(squareDistance);
+
+        manifold.Normal = distance > Math::Epsilon ? delta / distance : polygon.Normals[face];
+        manifold.Points[0].Position = vertex;
+        manifold.Points[0].Penetration = radius - distance;
+        manifold.PointCount = 1;
+
+        return manifold;
+    }
+
+    /**
+     * @brief clipSegment is a function that keeps the part of the segment behind the plane (aka where the
+     * dot product with the normal is lower than the offset). It gives the number of points kept.
+     */
+    static int clipSegment(std::array<Math::Vec2F, 2>& segment, const Math::Vec2F normal, const float offset) noexcept
+    {
+        const auto distance0 = segment[0].Dot(normal) - offset;
+        const auto distance1 = segment[1].Dot(normal) - offset;
+
+        std::array<Math::Vec2F, 2> clipped = segment;
+        int count = 0;
+
+        if (distance0 <= 0.f) clipped[count++] = segment[0];
+        if (distance1 <= 0.f) clipped[count++] = segment[1];
+
+        // The points are on both sides of the plane: the segment is cut at the plane.
+        if (distance0 * distance1 < 0.f && count < 2)
+        {
+            clipped[count++] = segment[0] + (segment[1] - segment[0]) * (distance0 / (distance0 - distance1));
+        }
+
+        segment = clipped;
+
+        return count;
+    }
+
+    static ContactManifold polygonPolygonManifold(const ConvexPolygon& polygonA, const ConvexPolygon& polygonB) noexcept
+    {
+        ContactManifold manifold;
+
+        int faceA = 0, faceB = 0;
+
+        const auto separationA = FindMaxSeparation(polygonA, polygonB, faceA);
+        if (separationA > 0.f) return manifold;
+
+        const auto separationB = FindMaxSeparation(polygonB, polygonA, faceB);
+        if (separationB > 0.f) return manifold;
+
+        // The reference face is the face of least penetration, with a tolerance so that it does not flip from one
+        // polygon to the other between two frames. The face of B is preferred because its normal is the normal of
+        // the manifold.
+        constexpr float relativeTolerance = 0.98f;
+        constexpr float absoluteTolerance = 0.001f;
+
+        const bool isReferenceB = separationA <= relativeTolerance * separationB + absoluteTolerance;
+
+        const auto& reference = isReferenceB ? polygonB : polygonA;
+        const auto& incident = isReferenceB ? polygonA : polygonB;
+        const auto referenceFace = isReferenceB ? faceB : faceA;
+        const auto referenceNormal = reference.Normals[referenceFace];
+
+        // The incident face is the face of the other polygon whose normal is the most opposed to the reference.
+        int incidentFace = 0;
+        float minDot = std::numeric_limits<float>::max();
+
+        for (int i = 0; i < incident.VerticesCount; i++)
+        {
+            const auto dot = incident.Normals[i].Dot(referenceNormal);
+
+            if (dot < minDot)
+            {
+                minDot = dot;
+                incidentFace = i;
+            }
+        }
+
+        std::array<Math::Vec2F, 2> incidentSegment = {
+            incident.Vertices[incidentFace], incident.Vertices[(incidentFace + 1) % incident.VerticesCount]
+        };
+
+        // The incident face is clipped by the side planes of the reference face.
+        const auto referenceVertex1 = reference.Vertices[referenceFace];
+        const auto referenceVertex2 = reference.Vertices[(referenceFace + 1) % reference.VerticesCount];
+        const auto referenceEdge = referenceVertex2 - referenceVertex1;
+        const auto referenceLength = referenceEdge.Length();
+
+        if (referenceLength <= Math::Epsilon) return manifold;
+
+        const auto tangent = referenceEdge / referenceLength;
+
+        if (clipSegment(incidentSegment, -tangent, -tangent.Dot(referenceVertex1)) < 2) return manifold;
+        if (clipSegment(incidentSegment, tangent, tangent.Dot(referenceVertex2)) < 2) return manifold;
+
+        manifold.Normal = isReferenceB ? referenceNormal : -referenceNormal;
+
+        // Only the clipped points behind the reference face touch.
+        const auto referenceOffset = referenceNormal.Dot(referenceVertex1);
+
+        for (const auto& point : incidentSegment)
+        {
+            const auto separation = referenceNormal.Dot(point) - referenceOffset;
+
+            if (separation <= 0.f)
+            {
+                manifold.Points[manifold.PointCount].Position = point;
+                manifold.Points[manifold.PointCount].Penetration = -separation;
+                manifold.PointCount++;
+            }
+        }
+
+        return manifold;
+    }
+
+    static ContactManifold flipped(ContactManifold manifold) noexcept
+    {
+        manifold.Normal = -manifold.Normal;
+        return manifold;
+    }
+
+    ContactManifold CalculateManifold(const Collider& colliderA, const Body& bodyA,
+                                      const Collider& colliderB, const Body& bodyB) noexcept
+    {
+        const auto positionA = bodyA.Position() + colliderA.Offset();
+        const auto positionB = bodyB.Position() + colliderB.Offset();
+
+        switch (colliderA.GetShapeType())
+        {
+            case Math::ShapeType::Circle:
+            {
+                const auto circleA = colliderA.Circle() + positionA;
+
+                switch (colliderB.GetShapeType())
+                {
+                    case Math::ShapeType::Circle:
+                        return circleCircleManifold(circleA, colliderB.Circle() + positionB);
+                    case Math::ShapeType::Rectangle:
+                        return circleRectangleManifold(circleA, colliderB.Rectangle() + positionB);
+                    case Math::ShapeType::Polygon:
+                        return circlePolygonManifold(circleA, MakeConvexPolygon(colliderB, positionB));
+                    default:
+                        return {};
+                }
+            } // Case circle A.
+
+            case Math::ShapeType::Rectangle:
+            {
+                const auto rectA = colliderA.Rectangle() + positionA;
+
+                switch (colliderB.GetShapeType())
+                {
+                    case Math::ShapeType::Circle:
+                        return flipped(circleRectangleManifold(colliderB.Circle() + positionB, rectA));
+                    case Math::ShapeType::Rectangle:
+                        return rectangleRectangleManifold(rectA, colliderB.Rectangle() + positionB);
+                    case Math::ShapeType::Polygon:
+                        return polygonPolygonManifold(MakeConvexPolygon(colliderA, positionA),
+                                                      MakeConvexPolygon(colliderB, positionB));
+                    default:
+                        return {};
+                }
+            } // Case rectangle A.
+
+            case Math::ShapeType::Polygon:
+            {
+                const auto polygonA = MakeConvexPolygon(colliderA, positionA);
+
+                switch (colliderB.GetShapeType())
+                {
+                    case Math::ShapeType::Circle:
+                        return flipped(circlePolygonManifold(colliderB.Circle() + positionB, polygonA));
+                    case Math::ShapeType::Rectangle:
+                    case Math::ShapeType::Polygon:
+                        return polygonPolygonManifold(polygonA, MakeConvexPolygon(colliderB, positionB));
+                    default:
+                        return {};
+                }
+            } // Case polygon A.
+
+            default:
+                return {};
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include "ContactSolver.h"
+#include "ContactManifold.h"
 
 namespace PhysicsEngine
 {
@@ -15,20 +16,38 @@ namespace PhysicsEngine
 
     void ContactSolver::CalculateContactProperties() noexcept
     {
-        const auto colShapeA = ColliderA->Shape();
-        const auto colShapeB = ColliderB->Shape();
+        // The contacts with a polygon are given by the deepest point of their manifold.
+        if (ColliderA->GetShapeType() == Math::ShapeType::Polygon ||
+            ColliderB->GetShapeType() == Math::ShapeType::Polygon)
+        {
+            const auto manifold = CalculateManifold(*ColliderA, *BodyA, *ColliderB, *BodyB);
+
+            Normal = manifold.Normal;
+            Penetration = 0.f;
+
+            for (int i = 0; i < manifold.PointCount; i++)
+            {
+                if (i == 0 || manifold.Points[i].Penetration > Penetration)
+                {
+                    Point = manifold.Points[i].Position;
+                    Penetration = manifold.Points[i].Penetration;
+                }
+            }
+
+            return;
+        }
 
-        switch (static_cast<Math::ShapeType>(colShapeA.index()))
+        switch (ColliderA->GetShapeType())
         {
         case Math::ShapeType::Circle:
         {
-            const auto circleA = std::get<Math::CircleF>(colShapeA) + BodyA->Position();
+            const auto circleA = ColliderA->Circle() + BodyA->Position();
 
-            switch (static_cast<Math::ShapeType>(colShapeB.index()))
+            switch (ColliderB->GetShapeType())
             {
             case Math::ShapeType::Circle:
             {
-                const auto circleB = std::get<Math::CircleF>(colShapeB) + BodyB->Position();
+                const auto circleB = ColliderB->Circle() + BodyB->Position();
                 const auto cA = circleA.Center(), cB = circleB.Center();
                 const auto rA = circleA.Radius(), rB = circleB.Radius();
 
@@ -46,7 +65,7 @@ namespace PhysicsEngine
 
             case Math::ShapeType::Rectangle:
             {
-                const auto rectB = std::get<Math::RectangleF>(colShapeB) +
+                const auto rectB = ColliderB->Rectangle() +
                     BodyB->Position();
 
                 const auto circleCenter = circleA.Center(), rectCenter = rectB.Center();
@@ -89,13 +108,13 @@ namespace PhysicsEngine
 
         case Math::ShapeType::Rectangle:
         {
-            const auto rectA = std::get<Math::RectangleF>(colShapeA) + BodyA->Position();
+            const auto rectA = ColliderA->Rectangle() + BodyA->Position();
 
-            switch (static_cast<Math::ShapeType>(colShapeB.index()))
+            switch (ColliderB->GetShapeType())
             {
             case Math::ShapeType::Circle:
             {
-                const auto circleB = std::get<Math::CircleF>(colShapeB) +
+                const auto circleB = ColliderB->Circle() +
                     BodyB->Position();
 
                 std::swap(BodyA, BodyB);
@@ -107,7 +126,7 @@ namespace PhysicsEngine
 
             case Math::ShapeType::Rectangle:
             {
-                const auto rectB = std::get<Math::RectangleF>(colShapeB) +
+                const auto rectB = ColliderB->Rectangle() +
                     BodyB->Position();
 
                 const auto cA = rectA.Center(), cB = rectB.Center();
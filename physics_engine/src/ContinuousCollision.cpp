@@ -0,0 +1,221 @@
+#include "ContinuousCollision.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief rayCircleTime is a function that gives the first time in [0, 1] at which the point moved by the
+     * translation enters the circle, or a negative time if it does not.
+     */
+    static float rayCircleTime(const Math::Vec2F point, const Math::Vec2F translation,
+                               const Math::Vec2F center, const float radius) noexcept
+    {
+        const auto delta = point - center;
+        const auto a = translation.SquareLength();
+        const auto b = delta.X * translation.X + delta.Y * translation.Y;
+        const auto c = delta.SquareLength() - radius * radius;
+
+        // The point must come closer to the center and the equation a * t^2 + 2b * t + c = 0 must have roots.
+        if (a <= 0.f || b >= 0.f) return -1.f;
+
+        const auto discriminant = b * b - a * c;
+
+        if (discriminant < 0.f) return -1.f;
+
+        const auto time = (-b - std::sqrt(discriminant)) / a;
+
+        return time <= 1.f ? time : -1.f;
+    }
+
+    TimeOfImpact SweptCircleTimeOfImpact(const Math::CircleF& circle, const Math::Vec2F translation,
+                                         const Math::CircleF& target) noexcept
+    {
+        TimeOfImpact toi;
+
+        if (Math::Intersect(circle, target)) return toi;
+
+        const auto time = rayCircleTime(circle.Center(), translation, target.Center(),
+                                        circle.Radius() + target.Radius());
+
+        if (time < 0.f) return toi;
+
+        const auto contactCenter = circle.Center() + translation * time;
+
+        toi.Hit = true;
+        toi.Time = time;
+        toi.Normal = (contactCenter - target.Center()).Normalized();
+
+        return toi;
+    }
+
+    TimeOfImpact SweptCircleTimeOfImpact(const Math::CircleF& circle, const Math::Vec2F translation,
+                                         const Math::RectangleF& target) noexcept
+    {
+        TimeOfImpact toi;
+
+        if (Math::Intersect(circle, target)) return toi;
+
+        const auto radius = circle.Radius();
+        const auto start = circle.Center();
+        const Math::Vec2F minBound = target.MinBound() - Math::Vec2F(radius, radius);
+        const Math::Vec2F maxBound = target.MaxBound() + Math::Vec2F(radius, radius);
+
+        // Slab test of the center against the rectangle grown by the radius.
+        float enterTime = 0.f;
+        float exitTime = 1.f;
+        Math::Vec2F normal = Math::Vec2F::Up();
+
+        const float starts[2] = { start.X, start.Y };
+        const float translations[2] = { translation.X, translation.Y };
+        const float mins[2] = { minBound.X, minBound.Y };
+        const float maxs[2] = { maxBound.X, maxBound.Y };
+
+        for (int axis = 0; axis < 2; axis++)
+        {
+            if (std::abs(translations[axis]) <= std::numeric_limits<float>::epsilon())
+            {
+                if (starts[axis] < mins[axis] || starts[axis] > maxs[axis]) return toi;
+
+                continue;
+            }
+
+            const auto inverseTranslation = 1.f / translations[axis];
+            auto nearTime = (mins[axis] - starts[axis]) * inverseTranslation;
+            auto farTime = (maxs[axis] - starts[axis]) * inverseTranslation;
+            auto nearSign = -1.f;
+
+            if (nearTime > farTime)
+            {
+                std::swap(nearTime, farTime);
+                nearSign = 1.f;
+            }
+
+            if (nearTime > enterTime)
+            {
+                enterTime = nearTime;
+                normal = axis == 0 ? Math::Vec2F(nearSign, 0.f) : Math::Vec2F(0.f, nearSign);
+            }
+
+            exitTime = std::min(exitTime, farTime);
+
+            if (enterTime > exitTime) return toi;
+        }
+
+        const auto contactCenter = start + translation * enterTime;
+
+        // In a corner region the grown rectangle is rounded: the center is cast against the circle of the corner.
+        const bool outsideX = contactCenter.X < target.MinBound().X || contactCenter.X > target.MaxBound().X;
+        const bool outsideY = contactCenter.Y < target.MinBound().Y || contactCenter.Y > target.MaxBound().Y;
+
+        if (outsideX && outsideY)
+        {
+            const Math::Vec2F corner(contactCenter.X < target.MinBound().X ? target.MinBound().X : target.MaxBound().X,
+                                     contactCenter.Y < target.MinBound().Y ? target.MinBound().Y : target.MaxBound().Y);
+
+            const auto time = rayCircleTime(start, translation, corner, radius);
+
+            if (time < 0.f) return toi;
+
+            toi.Hit = true;
+            toi.Time = time;
+            toi.Normal = (start + translation * time - corner).Normalized();
+
+            return toi;
+        }
+
+        toi.Hit = true;
+        toi.Time = enterTime;
+        toi.Normal = normal;
+
+        return toi;
+    }
+
+    /**
+     * @brief isCircleTouchingPolygon is a function that checks if the circle is inside the polygon or closer to
+     * one of its faces than its radius.
+     */
+    static bool isCircleTouchingPolygon(const Math::CircleF& circle, const ConvexPolygon& polygon) noexcept
+    {
+        const auto center = circle.Center();
+        const auto radius = circle.Radius();
+
+        bool isInside = true;
+
+        for (int i = 0; i < polygon.VerticesCount; i++)
+        {
+            if ((center - polygon.Vertices[i]).Dot(polygon.Normals[i]) > 0.f)
+            {
+                isInside = false;
+                break;
+            }
+        }
+
+        if (isInside) return true;
+
+        for (int i = 0; i < polygon.VerticesCount; i++)
+        {
+            const auto& vertex = polygon.Vertices[i];
+            const auto& nextVertex = polygon.Vertices[(i + 1) % polygon.VerticesCount];
+
+            if ((Math::ClosestPointOnSegment(vertex, nextVertex, center) - center).SquareLength() <= radius * radius)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    TimeOfImpact SweptCircleTimeOfImpact(const Math::CircleF& circle, const Math::Vec2F translation,
+                                         const ConvexPolygon& target) noexcept
+    {
+        TimeOfImpact toi;
+
+        if (target.VerticesCount < 3 || isCircleTouchingPolygon(circle, target)) return toi;
+
+        const auto radius = circle.Radius();
+        const auto start = circle.Center();
+
+        for (int i = 0; i < target.VerticesCount; i++)
+        {
+            const auto& vertex = target.Vertices[i];
+            const auto& nextVertex = target.Vertices[(i + 1) % target.VerticesCount];
+            const auto normal = target.Normals[i];
+
+            // The face pushed out by the radius can only be entered from its front side.
+            const auto approachSpeed = translation.Dot(normal);
+            const auto distance = (start - vertex).Dot(normal) - radius;
+
+            if (approachSpeed < 0.f && distance >= 0.f && distance <= -approachSpeed * toi.Time)
+            {
+                const auto time = distance / -approachSpeed;
+                const auto contactPoint = start + translation * time - normal * radius;
+                const auto edge = nextVertex - vertex;
+                const auto edgeParameter = (contactPoint - vertex).Dot(edge);
+
+                if (edgeParameter >= 0.f && edgeParameter <= edge.SquareLength())
+                {
+                    toi.Hit = true;
+                    toi.Time = time;
+                    toi.Normal = normal;
+                }
+            }
+
+            if (radius <= 0.f) continue;
+
+            const auto vertexTime = rayCircleTime(start, translation, vertex, radius);
+
+            if (vertexTime >= 0.f && (!toi.Hit || vertexTime < toi.Time))
+            {
+                toi.Hit = true;
+                toi.Time = vertexTime;
+                toi.Normal = (start + translation * vertexTime - vertex).Normalized();
+            }
+        }
+
+        return toi;
+    }
+}
@@ -0,0 +1,141 @@
+#include "ConvexPolygon.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief RectangleNormals are the normals of the faces of a rectangle whose corners are given
+     * counterclockwise from its min bound.
+     */
+    static constexpr std::array<Math::Vec2F, 4> rectangleNormals = {
+        Math::Vec2F::Down(), Math::Vec2F::Right(), Math::Vec2F::Up(), Math::Vec2F::Left()
+    };
+
+    ConvexPolygon MakeConvexPolygon(const Collider& collider, const Math::Vec2F position) noexcept
+    {
+        ConvexPolygon polygon;
+
+        if (collider.GetShapeType() == Math::ShapeType::Rectangle)
+        {
+            const auto rectangle = collider.Rectangle() + position;
+            const auto minBound = rectangle.MinBound();
+            const auto maxBound = rectangle.MaxBound();
+
+            polygon.Vertices[0] = minBound;
+            polygon.Vertices[1] = Math::Vec2F(maxBound.X, minBound.Y);
+            polygon.Vertices[2] = maxBound;
+            polygon.Vertices[3] = Math::Vec2F(minBound.X, maxBound.Y);
+            polygon.Normals = rectangleNormals.data();
+            polygon.VerticesCount = 4;
+
+            return polygon;
+        }
+
+        const auto vertices = collider.Polygon();
+
+        polygon.VerticesCount = vertices.VerticesCount();
+        polygon.Normals = collider.PolygonNormals().data();
+
+        for (int i = 0; i < polygon.VerticesCount; i++)
+        {
+            polygon.Vertices[i] = vertices[i] + position;
+        }
+
+        return polygon;
+    }
+
+    bool IsSeparatingAxis(const ConvexPolygon& polygonA, const ConvexPolygon& polygonB,
+                          const Math::Vec2F axis) noexcept
+    {
+        float minA = std::numeric_limits<float>::max(), maxA = std::numeric_limits<float>::lowest();
+        float minB = std::numeric_limits<float>::max(), maxB = std::numeric_limits<float>::lowest();
+
+        for (int i = 0; i < polygonA.VerticesCount; i++)
+        {
+            const auto projection = polygonA.Vertices[i].Dot(axis);
+
+            minA = std::min(minA, projection);
+            maxA = std::max(maxA, projection);
+        }
+
+        for (int i = 0; i < polygonB.VerticesCount; i++)
+        {
+            const auto projection = polygonB.Vertices[i].Dot(axis);
+
+            minB = std::min(minB, projection);
+            maxB = std::max(maxB, projection);
+        }
+
+        return maxA < minB || maxB < minA;
+    }
+
+    float FindMaxSeparation(const ConvexPolygon& polygon, const ConvexPolygon& otherPolygon, int& face) noexcept
+    {
+        float maxSeparation = std::numeric_limits<float>::lowest();
+        face = 0;
+
+        for (int i = 0; i < polygon.VerticesCount; i++)
+        {
+            const auto normal = polygon.Normals[i];
+            const auto faceProjection = polygon.Vertices[i].Dot(normal);
+
+            // The separation along a face is the distance from the face to the deepest vertex of the other polygon.
+            float separation = std::numeric_limits<float>::max();
+
+            for (int j = 0; j < otherPolygon.VerticesCount; j++)
+            {
+                separation = std::min(separation, otherPolygon.Vertices[j].Dot(normal) - faceProjection);
+            }
+
+            if (separation > maxSeparation)
+            {
+                maxSeparation = separation;
+                face = i;
+            }
+        }
+
+        return maxSeparation;
+    }
+
+    /**
+     * @brief findSeparatingFace is a function that gives the first face normal of the first polygon along which
+     * the second polygon is separated from it.
+     */
+    static bool findSeparatingFace(const ConvexPolygon& polygon, const ConvexPolygon& otherPolygon,
+                                   Math::Vec2F& separatingAxis) noexcept
+    {
+        for (int i = 0; i < polygon.VerticesCount; i++)
+        {
+            const auto normal = polygon.Normals[i];
+            const auto faceProjection = polygon.Vertices[i].Dot(normal);
+
+            bool isSeparated = true;
+
+            for (int j = 0; j < otherPolygon.VerticesCount; j++)
+            {
+                if (otherPolygon.Vertices[j].Dot(normal) <= faceProjection)
+                {
+                    isSeparated = false;
+                    break;
+                }
+            }
+
+            if (isSeparated)
+            {
+                separatingAxis = normal;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool FindSeparatingAxis(const ConvexPolygon& polygonA, const ConvexPolygon& polygonB,
+                            Math::Vec2F& separatingAxis) noexcept
+    {
+        return findSeparatingFace(polygonA, polygonB, separatingAxis) ||
+               findSeparatingFace(polygonB, polygonA, separatingAxis);
+    }
+}
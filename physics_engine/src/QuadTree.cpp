@@ -3,11 +3,14 @@
 //
 
 #include "QuadTree.h"
+#include "Intrinsics.h"
 
 #ifdef TRACY_ENABLE
 #include <Tracy.hpp>
 #endif // TRACY_ENABLE
 
+#include <algorithm>
+
 namespace PhysicsEngine
 {
     template<typename T>
@@ -23,7 +26,44 @@ namespace PhysicsEngine
         return result;
     }
 
-    void QuadTree::Init() noexcept
+    QuadTree::QuadTree(const QuadTree& other) noexcept
+    {
+        *this = other;
+    }
+
+    QuadTree& QuadTree::operator=(const QuadTree& other) noexcept
+    {
+        if (this == &other) return *this;
+
+        // The vectors keep their own allocator on copy-assignment, so only the data is copied.
+        _nodes = other._nodes;
+        _nodeMinX = other._nodeMinX;
+        _nodeMinY = other._nodeMinY;
+        _nodeMaxX = other._nodeMaxX;
+        _nodeMaxY = other._nodeMaxY;
+
+        _insertedColliders = other._insertedColliders;
+
+        _colliderRefs = other._colliderRefs;
+        _colMinX = other._colMinX;
+        _colMinY = other._colMinY;
+        _colMaxX = other._colMaxX;
+        _colMaxY = other._colMaxY;
+        _colFilters = other._colFilters;
+
+        _order = other._order;
+        _sortedOrder.resize(other._sortedOrder.size());
+        _buckets.resize(other._buckets.size());
+
+        _possiblePairs = other._possiblePairs;
+
+        _nodeIndex = other._nodeIndex;
+        _isBuilt = other._isBuilt;
+
+        return *this;
+    }
+
+    void QuadTree::Init(const std::size_t colliderCount) noexcept
     {
     #ifdef TRACY_ENABLE
             ZoneScoped;
@@ -31,133 +71,210 @@ namespace PhysicsEngine
 
         const auto quadCount = QuadCount(_maxDepth);
 
-        _nodes.resize(quadCount, QuadNode( _heapAllocator ));
+        _nodes.resize(quadCount, QuadNode());
+        _nodeMinX.resize(quadCount, 0.f);
+        _nodeMinY.resize(quadCount, 0.f);
+        _nodeMaxX.resize(quadCount, 0.f);
+        _nodeMaxY.resize(quadCount, 0.f);
 
-        for (auto& node : _nodes)
-        {
-            node.Colliders.reserve(QuadNode::MaxColliderNbr + 1);
-        }
+        _insertedColliders.reserve(colliderCount);
+
+        _colliderRefs.reserve(colliderCount);
+        _colMinX.reserve(colliderCount);
+        _colMinY.reserve(colliderCount);
+        _colMaxX.reserve(colliderCount);
+        _colMaxY.reserve(colliderCount);
+        _colFilters.reserve(colliderCount);
+
+        _order.reserve(colliderCount);
+        _sortedOrder.reserve(colliderCount);
+        _buckets.reserve(colliderCount);
+
+        _possiblePairs.reserve(static_cast<std::size_t>(static_cast<float>(quadCount) * _possiblePairReserveFactor));
     }
 
-    void QuadTree::Insert(Math::RectangleF simplifiedShape, ColliderRef colliderRef) noexcept
+    void QuadTree::Insert(Math::RectangleF simplifiedShape, ColliderRef colliderRef, CollisionFilter filter) noexcept
     {
-        insertInNode(_nodes[0], simplifiedShape, colliderRef, 0);
+        _insertedColliders.push_back(SimplifiedCollider{ colliderRef, simplifiedShape, filter });
+        _isBuilt = false;
     }
 
-    void QuadTree::insertInNode(QuadNode& node,
-        Math::RectangleF simplifiedShape,
-        ColliderRef colliderRef,
-        int depth) noexcept
+    void QuadTree::Build() noexcept
     {
-        #ifdef TRACY_ENABLE
-                ZoneScoped;
-        #endif
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
 
-        // If the node doesn't have any children.
-        if (node.Children[0] == nullptr)
+        if (_isBuilt) return;
+
+        const auto colliderCount = static_cast<std::uint32_t>(_insertedColliders.size());
+
+        // Reset the nodes used by the previous build, the root boundary is kept.
+        for (std::uint32_t i = 0; i < _nodeIndex; i++)
         {
-            // Add the simplified collider to the node.
-            SimplifiedCollider simplifiedCollider = { colliderRef, simplifiedShape };
-            node.Colliders.push_back(simplifiedCollider);
+            _nodes[i] = QuadNode();
+        }
 
-            // If the node has fewer colliders than the max number and the depth is not equal to the max depth.
-            if (node.Colliders.size() > QuadNode::MaxColliderNbr && depth != _maxDepth)
-            {
-            #ifdef TRACY_ENABLE
-                    ZoneNamed(SubDivision, "Sub-division", true);
-            #endif
-
-                // Subdivide the node rectangle in 4 rectangle.
-                const auto center = node.Boundary.Center();
-                const auto halfSize = node.Boundary.HalfSize();
-
-                const auto topMiddle = Math::Vec2F(center.X, center.Y + halfSize.Y);
-                const auto topRightCorner = center + halfSize;
-                const auto rightMiddle = Math::Vec2F(center.X + halfSize.X, center.Y);
-                const auto bottomMiddle = Math::Vec2F(center.X, center.Y - halfSize.Y);
-                const auto bottomLeftCorner = center - halfSize;
-                const auto leftMiddle = Math::Vec2F(center.X - halfSize.X, center.Y);
-
-                node.Children[0] = &_nodes[_nodeIndex];
-                node.Children[1] = &_nodes[_nodeIndex + 1];
-                node.Children[2] = &_nodes[_nodeIndex + 2];
-                node.Children[3] = &_nodes[_nodeIndex + 3];
-
-                _nodeIndex += 4;
-
-                node.Children[0]->Boundary = Math::RectangleF(leftMiddle, topMiddle);
-                node.Children[1]->Boundary = Math::RectangleF(center, topRightCorner);
-                node.Children[2]->Boundary = Math::RectangleF(bottomLeftCorner, center);
-                node.Children[3]->Boundary = Math::RectangleF(bottomMiddle, rightMiddle);
-                
-                std::array<SimplifiedCollider, QuadNode::MaxColliderNbr + 1> remainingColliders;
-                
-                for (std::size_t i = 0; i < QuadNode::MaxColliderNbr + 1; i++)
-                {
-                    remainingColliders[i] = node.Colliders[i];
-                }
+        _nodeIndex = 1;
 
-                node.Colliders.clear();
+        _order.resize(colliderCount);
+        _sortedOrder.resize(colliderCount);
+        _buckets.resize(colliderCount);
 
-                for (const auto& col : remainingColliders)
-                {
-                    int boundInterestCount = 0;
-                    QuadNode* intersectNode = nullptr;
-
-                    for (const auto& child : node.Children)
-                    {
-                        if (Math::Intersect(child->Boundary, col.Rectangle))
-                        {
-                            boundInterestCount++;
-                            intersectNode = child;
-                        }
-                    }
-
-                    if (boundInterestCount == 1)
-                    {
-                        insertInNode(*intersectNode, col.Rectangle, col.ColRef, depth + 1);
-                    }
-                    else
-                    {
-                        node.Colliders.push_back(col);
-                    }
-                }
-            }
+        for (std::uint32_t i = 0; i < colliderCount; i++)
+        {
+            _order[i] = i;
         }
 
-        // If the node has children.
-        else
+        buildNode(0, 0, colliderCount, 0);
+
+        // Gather the colliders in the order of the nodes.
+        _colliderRefs.resize(colliderCount);
+        _colMinX.resize(colliderCount);
+        _colMinY.resize(colliderCount);
+        _colMaxX.resize(colliderCount);
+        _colMaxY.resize(colliderCount);
+        _colFilters.resize(colliderCount);
+
+        for (std::uint32_t i = 0; i < colliderCount; i++)
+        {
+            const auto& simplCol = _insertedColliders[_order[i]];
+            const auto minBound = simplCol.Rectangle.MinBound();
+            const auto maxBound = simplCol.Rectangle.MaxBound();
+
+            _colliderRefs[i] = simplCol.ColRef;
+            _colMinX[i] = minBound.X;
+            _colMinY[i] = minBound.Y;
+            _colMaxX[i] = maxBound.X;
+            _colMaxY[i] = maxBound.Y;
+            _colFilters[i] = simplCol.Filter;
+        }
+
+        _isBuilt = true;
+    }
+
+    void QuadTree::buildNode(const std::uint32_t nodeIdx,
+                             const std::uint32_t begin,
+                             const std::uint32_t end,
+                             const int depth) noexcept
+    {
+        auto& node = _nodes[nodeIdx];
+
+        node.ColliderOffset = begin;
+        node.SubTreeColliderCount = end - begin;
+
+        // If the node has fewer colliders than the max number or the depth is equal to the max depth,
+        // all colliders stay in the node.
+        if (end - begin <= QuadNode::MaxColliderNbr || depth == _maxDepth)
+        {
+            node.ColliderCount = end - begin;
+            return;
+        }
+
+    #ifdef TRACY_ENABLE
+            ZoneNamed(SubDivision, "Sub-division", true);
+    #endif
+
+        subdivide(nodeIdx);
+
+        // Bucket 0 holds the colliders which stay in the node, bucket i + 1 the ones which fit in the child i.
+        constexpr int bucketCount = QuadNode::BoundaryDivisionCount + 1;
+        std::array<std::uint32_t, bucketCount> bucketSizes{};
+
+        for (std::uint32_t i = begin; i < end; i++)
         {
+            const auto rect = _insertedColliders[_order[i]].Rectangle;
+
             int boundInterestCount = 0;
-            QuadNode* intersectNode = nullptr;
+            std::uint8_t bucket = 0;
 
-            for (const auto& child : node.Children)
+            for (std::uint8_t childIdx = 0; childIdx < QuadNode::BoundaryDivisionCount; childIdx++)
             {
-                if (Math::Intersect(child->Boundary, simplifiedShape))
+                if (Math::Intersect(NodeBoundary(node.Children[childIdx]), rect))
                 {
                     boundInterestCount++;
-                    intersectNode = child;
+                    bucket = childIdx + 1;
                 }
             }
 
-            if (boundInterestCount == 1)
+            if (boundInterestCount != 1)
             {
-                insertInNode(*intersectNode, simplifiedShape, colliderRef, depth + 1);
-            }
-            else
-            {
-                SimplifiedCollider simplifiedCollider = { colliderRef, simplifiedShape };
-                node.Colliders.push_back(simplifiedCollider);
+                bucket = 0;
             }
+
+            _buckets[i] = bucket;
+            bucketSizes[bucket]++;
+        }
+
+        std::array<std::uint32_t, bucketCount> bucketOffsets{};
+        bucketOffsets[0] = begin;
+
+        for (int bucket = 1; bucket < bucketCount; bucket++)
+        {
+            bucketOffsets[bucket] = bucketOffsets[bucket - 1] + bucketSizes[bucket - 1];
+        }
+
+        // Stable scatter so the colliders keep their insertion order inside each node.
+        auto writeOffsets = bucketOffsets;
+
+        for (std::uint32_t i = begin; i < end; i++)
+        {
+            _sortedOrder[writeOffsets[_buckets[i]]++] = _order[i];
+        }
+
+        std::copy(_sortedOrder.begin() + begin, _sortedOrder.begin() + end, _order.begin() + begin);
+
+        node.ColliderCount = bucketSizes[0];
+
+        for (int childIdx = 0; childIdx < QuadNode::BoundaryDivisionCount; childIdx++)
+        {
+            buildNode(node.Children[childIdx],
+                      bucketOffsets[childIdx + 1],
+                      bucketOffsets[childIdx + 1] + bucketSizes[childIdx + 1],
+                      depth + 1);
         }
     }
 
+    void QuadTree::subdivide(const std::uint32_t nodeIdx) noexcept
+    {
+        // Subdivide the node rectangle in 4 rectangle. The outer sides of the children are copied from the node
+        // so that the sides lying on the root boundary keep exactly its values.
+        const Math::Vec2F minBound(_nodeMinX[nodeIdx], _nodeMinY[nodeIdx]);
+        const Math::Vec2F maxBound(_nodeMaxX[nodeIdx], _nodeMaxY[nodeIdx]);
+        const auto center = NodeBoundary(nodeIdx).Center();
+
+        const std::array<Math::RectangleF, QuadNode::BoundaryDivisionCount> childBoundaries{
+            Math::RectangleF(Math::Vec2F(minBound.X, center.Y), Math::Vec2F(center.X, maxBound.Y)),
+            Math::RectangleF(center, maxBound),
+            Math::RectangleF(minBound, center),
+            Math::RectangleF(Math::Vec2F(center.X, minBound.Y), Math::Vec2F(maxBound.X, center.Y))
+        };
+
+        for (std::uint32_t i = 0; i < QuadNode::BoundaryDivisionCount; i++)
+        {
+            const auto childIdx = _nodeIndex + i;
+
+            _nodes[nodeIdx].Children[i] = childIdx;
+
+            _nodeMinX[childIdx] = childBoundaries[i].MinBound().X;
+            _nodeMinY[childIdx] = childBoundaries[i].MinBound().Y;
+            _nodeMaxX[childIdx] = childBoundaries[i].MaxBound().X;
+            _nodeMaxY[childIdx] = childBoundaries[i].MaxBound().Y;
+        }
+
+        _nodeIndex += QuadNode::BoundaryDivisionCount;
+    }
+
     void QuadTree::CalculatePossiblePairs() noexcept
     {
     #ifdef TRACY_ENABLE
             ZoneScoped;
     #endif
 
+        Build();
+
+        _possiblePairs.clear();
+
         calculateNodePossiblePairs(_nodes[0]);
     }
 
@@ -167,62 +284,92 @@ namespace PhysicsEngine
             ZoneScoped;
     #endif
 
-        for (std::size_t i = 0; i < node.Colliders.size(); i++)
+        const std::size_t nodeEnd = node.ColliderOffset + node.ColliderCount;
+        const std::size_t subTreeEnd = node.ColliderOffset + node.SubTreeColliderCount;
+
+        // The colliders of the node are compared with the next colliders of the node and with all the
+        // colliders of the children nodes, which follow them in the collider array.
+        for (std::size_t i = node.ColliderOffset; i < nodeEnd; i++)
         {
-            auto& simplColA = node.Colliders[i];
+            calculateColliderPossiblePairs(i, i + 1, subTreeEnd);
+        }
 
-            for (std::size_t j = i + 1; j < node.Colliders.size(); j++)
+        // If the node has children.
+        if (node.HasChildren())
+        {
+            for (const auto childIdx : node.Children)
             {
-                auto& simplColB = node.Colliders[j];
-
-                if (Math::Intersect(simplColA.Rectangle, simplColB.Rectangle))
-                {
-                    _possiblePairs.push_back(ColliderPair{ simplColA.ColRef, simplColB.ColRef });
-                }
+                calculateNodePossiblePairs(_nodes[childIdx]);
             }
+        }
+    }
+
+    void QuadTree::calculateColliderPossiblePairs(const std::size_t colIdx,
+                                                  const std::size_t begin,
+                                                  const std::size_t end) noexcept
+    {
+        std::size_t j = begin;
+
+#if defined(__AVX2__)
+        const __m256 minX8 = _mm256_set1_ps(_colMinX[colIdx]);
+        const __m256 minY8 = _mm256_set1_ps(_colMinY[colIdx]);
+        const __m256 maxX8 = _mm256_set1_ps(_colMaxX[colIdx]);
+        const __m256 maxY8 = _mm256_set1_ps(_colMaxY[colIdx]);
+
+        for (; j + 8 <= end; j += 8)
+        {
+            // Same comparisons as the scalar intersect (not less / not greater) so NaN bounds give the same result.
+            __m256 overlap = _mm256_cmp_ps(maxX8, _mm256_loadu_ps(&_colMinX[j]), _CMP_NLT_UQ);
+            overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(minX8, _mm256_loadu_ps(&_colMaxX[j]), _CMP_NGT_UQ));
+            overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(maxY8, _mm256_loadu_ps(&_colMinY[j]), _CMP_NLT_UQ));
+            overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(minY8, _mm256_loadu_ps(&_colMaxY[j]), _CMP_NGT_UQ));
+
+            const auto mask = _mm256_movemask_ps(overlap);
 
-            // If the node has children, we need to compare the simplified collider with the 
-            // colliders in the children nodes.
-            if (node.Children[0] != nullptr)
+            if (mask == 0) continue;
+
+            for (int lane = 0; lane < 8; lane++)
             {
-                for (const auto& childNode : node.Children)
+                if ((mask & (1 << lane)) && ShouldCollide(_colFilters[colIdx], _colFilters[j + lane]))
                 {
-                    calculateChildrenNodePossiblePairs(*childNode, simplColA);
+                    _possiblePairs.push_back(ColliderPair{ _colliderRefs[colIdx], _colliderRefs[j + lane] });
                 }
             }
         }
+#endif // __AVX2__
 
-        // If the node has children.
-        if (node.Children[0] != nullptr)
+#if defined(__SSE__)
+        const __m128 minX4 = _mm_set1_ps(_colMinX[colIdx]);
+        const __m128 minY4 = _mm_set1_ps(_colMinY[colIdx]);
+        const __m128 maxX4 = _mm_set1_ps(_colMaxX[colIdx]);
+        const __m128 maxY4 = _mm_set1_ps(_colMaxY[colIdx]);
+
+        for (; j + 4 <= end; j += 4)
         {
-            for (const auto& child : node.Children)
-            {
-                calculateNodePossiblePairs(*child);
-            }
-        }
-    }
+            __m128 overlap = _mm_cmpnlt_ps(maxX4, _mm_loadu_ps(&_colMinX[j]));
+            overlap = _mm_and_ps(overlap, _mm_cmpngt_ps(minX4, _mm_loadu_ps(&_colMaxX[j])));
+            overlap = _mm_and_ps(overlap, _mm_cmpnlt_ps(maxY4, _mm_loadu_ps(&_colMinY[j])));
+            overlap = _mm_and_ps(overlap, _mm_cmpngt_ps(minY4, _mm_loadu_ps(&_colMaxY[j])));
 
-    void QuadTree::calculateChildrenNodePossiblePairs(const QuadNode& node, SimplifiedCollider simplCol) noexcept
-    {
-    #ifdef TRACY_ENABLE
-            ZoneScoped;
-    #endif
+            const auto mask = _mm_movemask_ps(overlap);
 
-        // For each colliders in the current node, compare it with the simplified collider from its parent node.
-        for (const auto& nodeSimplCol : node.Colliders)
-        {
-            if (Math::Intersect(simplCol.Rectangle, nodeSimplCol.Rectangle))
+            if (mask == 0) continue;
+
+            for (int lane = 0; lane < 4; lane++)
             {
-                _possiblePairs.push_back(ColliderPair{ simplCol.ColRef, nodeSimplCol.ColRef });
+                if ((mask & (1 << lane)) && ShouldCollide(_colFilters[colIdx], _colFilters[j + lane]))
+                {
+                    _possiblePairs.push_back(ColliderPair{ _colliderRefs[colIdx], _colliderRefs[j + lane] });
+                }
             }
         }
+#endif // __SSE__
 
-        // If the current node has children, we need to compare the simplified collider from its parent node with its children.
-        if (node.Children[0] != nullptr)
+        for (; j < end; j++)
         {
-            for (const auto& child : node.Children)
+            if (intersect(colIdx, j) && ShouldCollide(_colFilters[colIdx], _colFilters[j]))
             {
-                calculateChildrenNodePossiblePairs(*child, simplCol);
+                _possiblePairs.push_back(ColliderPair{ _colliderRefs[colIdx], _colliderRefs[j] });
             }
         }
     }
@@ -233,16 +380,24 @@ namespace PhysicsEngine
         ZoneScoped;
     #endif // TRACY_ENABLE
 
-        for (auto& node : _nodes)
+        for (std::uint32_t i = 0; i < _nodeIndex; i++)
         {
-            node.Colliders.clear();
-
-            std::fill(node.Children.begin(), node.Children.end(), nullptr);
+            _nodes[i] = QuadNode();
         }
 
         _nodeIndex = 1;
 
+        _insertedColliders.clear();
+        _colliderRefs.clear();
+        _colMinX.clear();
+        _colMinY.clear();
+        _colMaxX.clear();
+        _colMaxY.clear();
+        _colFilters.clear();
+
         _possiblePairs.clear();
+
+        _isBuilt = false;
     }
 
     void QuadTree::Deinit() noexcept
@@ -252,9 +407,27 @@ namespace PhysicsEngine
 #endif // TRACY_ENABLE
 
         _nodes.clear();
+        _nodeMinX.clear();
+        _nodeMinY.clear();
+        _nodeMaxX.clear();
+        _nodeMaxY.clear();
+
+        _insertedColliders.clear();
+        _colliderRefs.clear();
+        _colMinX.clear();
+        _colMinY.clear();
+        _colMaxX.clear();
+        _colMaxY.clear();
+        _colFilters.clear();
+
+        _order.clear();
+        _sortedOrder.clear();
+        _buckets.clear();
 
         _nodeIndex = 1;
 
         _possiblePairs.clear();
+
+        _isBuilt = false;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,59 @@
+#include "SeparatingAxisCache.h"
+#include "ContactCache.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+#include <algorithm>
+
+namespace PhysicsEngine
+{
+    void SeparatingAxisCache::Reserve(const std::size_t pairCount) noexcept
+    {
+        // The table keeps a load factor under 1/2 so that few pairs lose their axis to another pair.
+        std::size_t slotCount = std::max(_slots.size(), _minSlotCount);
+        while (slotCount < pairCount * 2)
+        {
+            slotCount *= 2;
+        }
+
+        if (slotCount == _slots.size()) return;
+
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        _slots.assign(slotCount, Slot{});
+    }
+
+    Math::Vec2F SeparatingAxisCache::Find(const ColliderPair& pair) const noexcept
+    {
+        if (_slots.empty()) return Math::Vec2F::Zero();
+
+        const auto& slot = _slots[HashColliderPair(pair) & (_slots.size() - 1)];
+
+        return slot.Key == pair ? slot.Axis : Math::Vec2F::Zero();
+    }
+
+    void SeparatingAxisCache::Store(const ColliderPair& pair, const Math::Vec2F axis) noexcept
+    {
+        if (_slots.empty()) return;
+
+        auto& slot = _slots[HashColliderPair(pair) & (_slots.size() - 1)];
+
+        slot.Key = pair;
+        slot.Axis = axis;
+    }
+
+    void SeparatingAxisCache::Clear() noexcept
+    {
+        std::fill(_slots.begin(), _slots.end(), Slot{});
+    }
+
+    void SeparatingAxisCache::Deinit() noexcept
+    {
+        _slots.clear();
+        _slots.shrink_to_fit();
+    }
+}
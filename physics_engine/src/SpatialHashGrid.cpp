@@ -0,0 +1,194 @@
+#include "SpatialHashGrid.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+#include <algorithm>
+#include <cmath>
+
+namespace PhysicsEngine
+{
+    static constexpr std::size_t minBucketCount = 64;
+
+    void SpatialHashGrid::Init(const std::size_t colliderCount, const float cellSize) noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        _cellSize = cellSize;
+        _inverseCellSize = 1.f / cellSize;
+
+        // Most colliders are smaller than a cell, so they cover at most four cells.
+        _items.reserve(colliderCount);
+        _entries.reserve(colliderCount * 4);
+        _possiblePairs.reserve(colliderCount);
+
+        std::size_t bucketCount = minBucketCount;
+        while (bucketCount < colliderCount * 2)
+        {
+            bucketCount *= 2;
+        }
+
+        _bucketStarts.assign(bucketCount + 1, 0);
+    }
+
+    std::int32_t SpatialHashGrid::cellCoordinate(const float coordinate) const noexcept
+    {
+        return static_cast<std::int32_t>(std::floor(coordinate * _inverseCellSize));
+    }
+
+    std::uint32_t SpatialHashGrid::bucketIndex(const std::int32_t cellX, const std::int32_t cellY) const noexcept
+    {
+        const auto hash = static_cast<std::uint32_t>(cellX) * 73856093u ^ static_cast<std::uint32_t>(cellY) * 19349663u;
+
+        // The bucket count is a power of two.
+        return hash & static_cast<std::uint32_t>(BucketCount() - 1);
+    }
+
+    void SpatialHashGrid::Insert(const Math::RectangleF simplifiedShape, const ColliderRef colliderRef,
+                                 const CollisionFilter filter) noexcept
+    {
+        Item item;
+        item.ColRef = colliderRef;
+        item.MinBound = simplifiedShape.MinBound();
+        item.MaxBound = simplifiedShape.MaxBound();
+        item.Filter = filter;
+        item.MinCellX = cellCoordinate(item.MinBound.X);
+        item.MinCellY = cellCoordinate(item.MinBound.Y);
+        item.MaxCellX = cellCoordinate(item.MaxBound.X);
+        item.MaxCellY = cellCoordinate(item.MaxBound.Y);
+
+        _items.push_back(item);
+    }
+
+    void SpatialHashGrid::buildBuckets() noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        std::size_t entryCount = 0;
+
+        for (const auto& item : _items)
+        {
+            entryCount += static_cast<std::size_t>(item.MaxCellX - item.MinCellX + 1) *
+                          static_cast<std::size_t>(item.MaxCellY - item.MinCellY + 1);
+        }
+
+        // Keep at least two buckets per entry so that few cells share a bucket.
+        std::size_t bucketCount = std::max(BucketCount(), minBucketCount);
+        while (bucketCount < entryCount * 2)
+        {
+            bucketCount *= 2;
+        }
+
+        _bucketStarts.assign(bucketCount + 1, 0);
+        _entries.resize(entryCount);
+
+        // Count the entries of each bucket (shifted by one to do the prefix sum in place).
+        for (const auto& item : _items)
+        {
+            for (auto cellY = item.MinCellY; cellY <= item.MaxCellY; cellY++)
+            {
+                for (auto cellX = item.MinCellX; cellX <= item.MaxCellX; cellX++)
+                {
+                    _bucketStarts[bucketIndex(cellX, cellY) + 1]++;
+                }
+            }
+        }
+
+        for (std::size_t bucket = 1; bucket <= bucketCount; bucket++)
+        {
+            _bucketStarts[bucket] += _bucketStarts[bucket - 1];
+        }
+
+        // Scatter the entries, each bucket start is used as a write cursor and ends at the next bucket start.
+        for (std::uint32_t itemIdx = 0; itemIdx < _items.size(); itemIdx++)
+        {
+            const auto& item = _items[itemIdx];
+
+            for (auto cellY = item.MinCellY; cellY <= item.MaxCellY; cellY++)
+            {
+                for (auto cellX = item.MinCellX; cellX <= item.MaxCellX; cellX++)
+                {
+                    _entries[_bucketStarts[bucketIndex(cellX, cellY)]++] = Entry{ itemIdx, cellX, cellY };
+                }
+            }
+        }
+
+        // Shift back the cursors to get the bucket starts.
+        for (std::size_t bucket = bucketCount; bucket > 0; bucket--)
+        {
+            _bucketStarts[bucket] = _bucketStarts[bucket - 1];
+        }
+
+        _bucketStarts[0] = 0;
+    }
+
+    void SpatialHashGrid::CalculatePossiblePairs() noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        buildBuckets();
+
+        _possiblePairs.clear();
+
+        const auto bucketCount = BucketCount();
+
+        for (std::size_t bucket = 0; bucket < bucketCount; bucket++)
+        {
+            const auto bucketEnd = _bucketStarts[bucket + 1];
+
+            for (auto i = _bucketStarts[bucket]; i < bucketEnd; i++)
+            {
+                const auto& entryA = _entries[i];
+                const auto& itemA = _items[entryA.ItemIdx];
+
+                for (auto j = i + 1; j < bucketEnd; j++)
+                {
+                    const auto& entryB = _entries[j];
+
+                    // Different cells can be hashed in the same bucket.
+                    if (entryA.CellX != entryB.CellX || entryA.CellY != entryB.CellY) continue;
+
+                    const auto& itemB = _items[entryB.ItemIdx];
+
+                    if (itemA.MaxBound.X < itemB.MinBound.X || itemA.MinBound.X > itemB.MaxBound.X ||
+                        itemA.MaxBound.Y < itemB.MinBound.Y || itemA.MinBound.Y > itemB.MaxBound.Y ||
+                        !ShouldCollide(itemA.Filter, itemB.Filter))
+                    {
+                        continue;
+                    }
+
+                    // Only the cell containing the min corner of the intersection emits the pair.
+                    if (cellCoordinate(std::max(itemA.MinBound.X, itemB.MinBound.X)) != entryA.CellX ||
+                        cellCoordinate(std::max(itemA.MinBound.Y, itemB.MinBound.Y)) != entryA.CellY)
+                    {
+                        continue;
+                    }
+
+                    _possiblePairs.push_back(ColliderPair{ itemA.ColRef, itemB.ColRef });
+                }
+            }
+        }
+    }
+
+    void SpatialHashGrid::Clear() noexcept
+    {
+        _items.clear();
+        _entries.clear();
+        _possiblePairs.clear();
+    }
+
+    void SpatialHashGrid::Deinit() noexcept
+    {
+        _items.clear();
+        _entries.clear();
+        _bucketStarts.clear();
+        _possiblePairs.clear();
+    }
+}
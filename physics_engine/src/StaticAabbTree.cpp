@@ -0,0 +1,137 @@
+#include "StaticAabbTree.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+#include <algorithm>
+
+namespace PhysicsEngine
+{
+    void StaticAabbTree::Insert(const Math::RectangleF simplifiedShape, const ColliderRef colliderRef,
+                                const CollisionFilter filter) noexcept
+    {
+        Item item;
+        item.ColRef = colliderRef;
+        item.MinBound = simplifiedShape.MinBound();
+        item.MaxBound = simplifiedShape.MaxBound();
+        item.Filter = filter;
+
+        _items.push_back(item);
+    }
+
+    void StaticAabbTree::Build() noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+        ZoneValue(_items.size());
+#endif // TRACY_ENABLE
+
+        _nodes.clear();
+
+        if (_items.empty()) return;
+
+        std::sort(_items.begin(), _items.end(), [](const Item& itemA, const Item& itemB)
+        {
+            return itemA.ColRef.Index < itemB.ColRef.Index;
+        });
+
+        // The leaves of a split node hold at least two items, so the tree has at most n nodes.
+        _nodes.reserve(_items.size());
+
+        TreeNode root;
+        root.First = 0;
+        root.Count = static_cast<std::uint32_t>(_items.size());
+        _nodes.push_back(root);
+
+        buildNode(0);
+    }
+
+    void StaticAabbTree::buildNode(const std::uint32_t nodeIdx) noexcept
+    {
+        const auto first = _nodes[nodeIdx].First;
+        const auto count = _nodes[nodeIdx].Count;
+
+        auto minBound = _items[first].MinBound;
+        auto maxBound = _items[first].MaxBound;
+
+        for (auto i = first + 1; i < first + count; i++)
+        {
+            minBound.X = std::min(minBound.X, _items[i].MinBound.X);
+            minBound.Y = std::min(minBound.Y, _items[i].MinBound.Y);
+            maxBound.X = std::max(maxBound.X, _items[i].MaxBound.X);
+            maxBound.Y = std::max(maxBound.Y, _items[i].MaxBound.Y);
+        }
+
+        _nodes[nodeIdx].MinBound = minBound;
+        _nodes[nodeIdx].MaxBound = maxBound;
+
+        if (count <= MaxLeafSize) return;
+
+        // Split at the median of the centers along the longest axis of the node, the collider index breaks
+        // the ties so that the split does not depend on the sort algorithm.
+        const bool splitX = maxBound.X - minBound.X >= maxBound.Y - minBound.Y;
+
+        std::sort(_items.begin() + first, _items.begin() + first + count, [splitX](const Item& itemA, const Item& itemB)
+        {
+            const auto centerA = splitX ? itemA.MinBound.X + itemA.MaxBound.X : itemA.MinBound.Y + itemA.MaxBound.Y;
+            const auto centerB = splitX ? itemB.MinBound.X + itemB.MaxBound.X : itemB.MinBound.Y + itemB.MaxBound.Y;
+
+            if (centerA != centerB) return centerA < centerB;
+
+            return itemA.ColRef.Index < itemB.ColRef.Index;
+        });
+
+        const auto children = static_cast<std::uint32_t>(_nodes.size());
+        const auto halfCount = count / 2;
+
+        TreeNode child1;
+        child1.First = first;
+        child1.Count = halfCount;
+
+        TreeNode child2;
+        child2.First = first + halfCount;
+        child2.Count = count - halfCount;
+
+        _nodes.push_back(child1);
+        _nodes.push_back(child2);
+
+        _nodes[nodeIdx].First = children;
+        _nodes[nodeIdx].Count = 0;
+
+        buildNode(children);
+        buildNode(children + 1);
+    }
+
+    void StaticAabbTree::Query(const Math::RectangleF simplifiedShape, const ColliderRef colliderRef,
+                               const CollisionFilter filter, AllocVector<ColliderPair>& pairs) const noexcept
+    {
+        Query(simplifiedShape, [&](const ColliderRef staticColliderRef, const CollisionFilter staticFilter)
+        {
+            if (!ShouldCollide(filter, staticFilter)) return;
+
+            if (colliderRef.Index < staticColliderRef.Index)
+            {
+                pairs.push_back(ColliderPair{ colliderRef, staticColliderRef });
+            }
+            else
+            {
+                pairs.push_back(ColliderPair{ staticColliderRef, colliderRef });
+            }
+        });
+    }
+
+    void StaticAabbTree::Clear() noexcept
+    {
+        _items.clear();
+        _nodes.clear();
+    }
+
+    void StaticAabbTree::Deinit() noexcept
+    {
+        _items.clear();
+        _items.shrink_to_fit();
+        _nodes.clear();
+        _nodes.shrink_to_fit();
+    }
+}
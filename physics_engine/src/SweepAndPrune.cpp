@@ -0,0 +1,267 @@
+#include "SweepAndPrune.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+#include <algorithm>
+
+namespace PhysicsEngine
+{
+    static constexpr std::uint32_t noActivePosition = 0xFFFFFFFF;
+
+    void SweepAndPrune::Init(const std::size_t colliderCount) noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        _proxies.resize(std::max(_proxies.size(), colliderCount), Proxy{});
+        _activePositions.resize(_proxies.size(), noActivePosition);
+        _activeProxies.reserve(colliderCount);
+
+        for (auto& endpoints : _endpoints)
+        {
+            endpoints.reserve(colliderCount * 2);
+        }
+
+        _possiblePairs.reserve(colliderCount);
+    }
+
+    void SweepAndPrune::Insert(const Math::RectangleF simplifiedShape, const ColliderRef colliderRef,
+                               const CollisionFilter filter) noexcept
+    {
+        if (colliderRef.Index >= _proxies.size())
+        {
+            _proxies.resize(std::max(colliderRef.Index + 1, _proxies.size() * 2), Proxy{});
+            _activePositions.resize(_proxies.size(), noActivePosition);
+        }
+
+        auto& proxy = _proxies[colliderRef.Index];
+
+        if (proxy.Stamp == 0)
+        {
+            _proxyCount++;
+        }
+
+        const auto minBound = simplifiedShape.MinBound();
+        const auto maxBound = simplifiedShape.MaxBound();
+
+        proxy.ColRef = colliderRef;
+        proxy.Min = { minBound.X, minBound.Y };
+        proxy.Max = { maxBound.X, maxBound.Y };
+        proxy.Filter = filter;
+        proxy.Stamp = _frame;
+    }
+
+    void SweepAndPrune::CalculatePossiblePairs() noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        updateEndpoints();
+        sweep();
+
+        _frame++;
+    }
+
+    void SweepAndPrune::updateEndpoints() noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        // Remove the endpoints of the proxies that were not inserted in this frame.
+        for (auto& endpoints : _endpoints)
+        {
+            const auto it = std::remove_if(endpoints.begin(), endpoints.end(),
+                [this](const Endpoint& endpoint)
+            {
+                return _proxies[endpoint.ProxyIdx()].Stamp != _frame;
+            });
+
+            endpoints.erase(it, endpoints.end());
+        }
+
+        // Add the endpoints of the new proxies at the end of the lists, the sort moves them to their place.
+        std::size_t addedCount = 0;
+
+        for (std::uint32_t proxyIdx = 0; proxyIdx < _proxies.size(); proxyIdx++)
+        {
+            auto& proxy = _proxies[proxyIdx];
+
+            if (proxy.Stamp != _frame)
+            {
+                if (proxy.Stamp != 0)
+                {
+                    proxy = Proxy{};
+                    _proxyCount--;
+                }
+
+                continue;
+            }
+
+            if (proxy.InLists) continue;
+
+            for (auto& endpoints : _endpoints)
+            {
+                endpoints.push_back(Endpoint{ 0.f, proxyIdx << 1 });
+                endpoints.push_back(Endpoint{ 0.f, proxyIdx << 1 | 1 });
+            }
+
+            proxy.InLists = true;
+            addedCount += 2;
+        }
+
+        // Copy the current bounds in the endpoints and choose the axis with the largest spread of the
+        // collider centers to sweep, as it is the one along which the fewest bounds overlap.
+        std::array<float, _axisCount> spreads{};
+
+        for (int axis = 0; axis < _axisCount; axis++)
+        {
+            auto& endpoints = _endpoints[axis];
+
+            float sum = 0.f;
+            float squaredSum = 0.f;
+
+            for (auto& endpoint : endpoints)
+            {
+                const auto& proxy = _proxies[endpoint.ProxyIdx()];
+                endpoint.Value = endpoint.IsMax() ? proxy.Max[axis] : proxy.Min[axis];
+
+                if (!endpoint.IsMax())
+                {
+                    const float center = (proxy.Min[axis] + proxy.Max[axis]) * 0.5f;
+                    sum += center;
+                    squaredSum += center * center;
+                }
+            }
+
+            if (_proxyCount != 0)
+            {
+                const auto count = static_cast<float>(_proxyCount);
+                spreads[axis] = squaredSum / count - (sum / count) * (sum / count);
+            }
+
+            sortEndpoints(axis, addedCount);
+        }
+
+        _sweepAxis = spreads[1] > spreads[0] ? 1 : 0;
+    }
+
+    void SweepAndPrune::sortEndpoints(const int axis, const std::size_t addedCount) noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        auto& endpoints = _endpoints[axis];
+
+        // The insertion sort moves each added endpoint through the whole list, so a full sort is faster
+        // when a lot of colliders were added (e.g. in the first frame).
+        if (addedCount * 8 > endpoints.size())
+        {
+            std::sort(endpoints.begin(), endpoints.end());
+            return;
+        }
+
+        for (std::size_t i = 1; i < endpoints.size(); i++)
+        {
+            const auto endpoint = endpoints[i];
+            std::size_t j = i;
+
+            while (j > 0 && endpoint < endpoints[j - 1])
+            {
+                endpoints[j] = endpoints[j - 1];
+                j--;
+            }
+
+            endpoints[j] = endpoint;
+        }
+    }
+
+    void SweepAndPrune::sweep() noexcept
+    {
+#ifdef TRACY_ENABLE
+        ZoneScoped;
+#endif // TRACY_ENABLE
+
+        _possiblePairs.clear();
+        _activeProxies.clear();
+
+        const int otherAxis = 1 - _sweepAxis;
+
+        for (const auto& endpoint : _endpoints[_sweepAxis])
+        {
+            const auto proxyIdx = endpoint.ProxyIdx();
+
+            if (endpoint.IsMax())
+            {
+                // Swap the proxy with the last active one to remove it in constant time.
+                const auto position = _activePositions[proxyIdx];
+                const auto lastProxyIdx = _activeProxies.back();
+
+                _activeProxies[position] = lastProxyIdx;
+                _activePositions[lastProxyIdx] = position;
+                _activeProxies.pop_back();
+                _activePositions[proxyIdx] = noActivePosition;
+
+                continue;
+            }
+
+            const auto& proxy = _proxies[proxyIdx];
+
+            // The active proxies overlap the new one on the sweep axis, only the other axis must be tested.
+            for (const auto activeProxyIdx : _activeProxies)
+            {
+                const auto& activeProxy = _proxies[activeProxyIdx];
+
+                if (activeProxy.Max[otherAxis] < proxy.Min[otherAxis] ||
+                    activeProxy.Min[otherAxis] > proxy.Max[otherAxis] ||
+                    !ShouldCollide(activeProxy.Filter, proxy.Filter))
+                {
+                    continue;
+                }
+
+                _possiblePairs.push_back(ColliderPair{ activeProxy.ColRef, proxy.ColRef });
+            }
+
+            _activePositions[proxyIdx] = static_cast<std::uint32_t>(_activeProxies.size());
+            _activeProxies.push_back(proxyIdx);
+        }
+    }
+
+    void SweepAndPrune::Clear() noexcept
+    {
+        std::fill(_proxies.begin(), _proxies.end(), Proxy{});
+        std::fill(_activePositions.begin(), _activePositions.end(), noActivePosition);
+
+        for (auto& endpoints : _endpoints)
+        {
+            endpoints.clear();
+        }
+
+        _activeProxies.clear();
+        _possiblePairs.clear();
+
+        _proxyCount = 0;
+    }
+
+    void SweepAndPrune::Deinit() noexcept
+    {
+        _proxies.clear();
+        _activePositions.clear();
+
+        for (auto& endpoints : _endpoints)
+        {
+            endpoints.clear();
+        }
+
+        _activeProxies.clear();
+        _possiblePairs.clear();
+
+        _proxyCount = 0;
+        _frame = 1;
+    }
+}
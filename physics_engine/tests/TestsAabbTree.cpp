@@ -0,0 +1,319 @@
+#include "AabbTree.h"
+#include "QuadTree.h"
+
+#include "gtest/gtest.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+struct ColliderNumberFixture : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(AabbTree, ColliderNumberFixture, testing::Values(0, 1, 10, 100, 321, 1000));
+
+/**
+ * @brief TestCollider is a struct that stores a collider inserted in the tree in the tests.
+ */
+struct TestCollider
+{
+    SimplifiedCollider Collider;
+    bool IsStatic = false;
+};
+
+std::vector<ColliderPair> SortedPairs(const AllocVector<ColliderPair>& pairs)
+{
+    std::vector<ColliderPair> sortedPairs;
+
+    for (const auto& pair : pairs)
+    {
+        sortedPairs.push_back(pair.ColliderB < pair.ColliderA ? ColliderPair{ pair.ColliderB, pair.ColliderA } : pair);
+    }
+
+    std::sort(sortedPairs.begin(), sortedPairs.end());
+
+    return sortedPairs;
+}
+
+void ExpectSamePairs(const AabbTree& aabbTree, const std::vector<TestCollider>& colliders)
+{
+    std::vector<ColliderPair> expectedPairs;
+
+    for (std::size_t i = 0; i < colliders.size(); i++)
+    {
+        for (std::size_t j = i + 1; j < colliders.size(); j++)
+        {
+            if (colliders[i].IsStatic && colliders[j].IsStatic) continue;
+
+            if (Intersect(colliders[i].Collider.Rectangle, colliders[j].Collider.Rectangle))
+            {
+                expectedPairs.push_back(ColliderPair{ colliders[i].Collider.ColRef, colliders[j].Collider.ColRef });
+            }
+        }
+    }
+
+    std::sort(expectedPairs.begin(), expectedPairs.end());
+
+    EXPECT_TRUE(std::is_sorted(aabbTree.PossiblePairs().begin(), aabbTree.PossiblePairs().end()));
+
+    const auto treePairs = SortedPairs(aabbTree.PossiblePairs());
+
+    ASSERT_EQ(treePairs.size(), expectedPairs.size());
+
+    for (std::size_t i = 0; i < treePairs.size(); i++)
+    {
+        EXPECT_EQ(treePairs[i].ColliderA, expectedPairs[i].ColliderA);
+        EXPECT_EQ(treePairs[i].ColliderB, expectedPairs[i].ColliderB);
+    }
+}
+
+std::vector<TestCollider> CreateRandomColliders(const std::size_t colNbr)
+{
+    std::vector<TestCollider> colliders;
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        const Vec2F center(Random::Range(0.f, 12.8f), Random::Range(0.f, 7.2f));
+
+        // One collider out of ten is a large static wall.
+        const bool isStatic = i % 10 == 0;
+        const auto halfSize = isStatic ? Vec2F(Random::Range(0.5f, 6.4f), 0.1f) :
+                                         Vec2F(Random::Range(0.125f, 0.26f), Random::Range(0.125f, 0.26f));
+
+        colliders.push_back(TestCollider{ SimplifiedCollider{ ColliderRef{i, 0}, RectangleF::FromCenter(center, halfSize) },
+                                          isStatic });
+    }
+
+    return colliders;
+}
+
+TEST(AabbTree, Init)
+{
+    AabbTree aabbTree{ TestHeapAllocator };
+    aabbTree.Init(10);
+
+    EXPECT_EQ(aabbTree.ProxyCount(), 0);
+    EXPECT_EQ(aabbTree.Height(), -1);
+    EXPECT_TRUE(aabbTree.Validate());
+}
+
+TEST_P(ColliderNumberFixture, MatchesBruteForceWhileMoving)
+{
+    AabbTree aabbTree{ TestHeapAllocator };
+    aabbTree.Init(GetParam());
+
+    auto colliders = CreateRandomColliders(GetParam());
+
+    for (int frame = 0; frame < 10; frame++)
+    {
+        for (const auto& col : colliders)
+        {
+            aabbTree.Insert(col.Collider.Rectangle, col.Collider.ColRef, col.IsStatic);
+        }
+
+        aabbTree.CalculatePossiblePairs();
+
+        EXPECT_EQ(aabbTree.ProxyCount(), colliders.size());
+        EXPECT_TRUE(aabbTree.Validate());
+        ExpectSamePairs(aabbTree, colliders);
+
+        for (auto& col : colliders)
+        {
+            if (col.IsStatic) continue;
+
+            const Vec2F move(Random::Range(-0.3f, 0.3f), Random::Range(-0.3f, 0.3f));
+            col.Collider.Rectangle = RectangleF(col.Collider.Rectangle.MinBound() + move,
+                                                col.Collider.Rectangle.MaxBound() + move);
+        }
+    }
+}
+
+TEST_P(ColliderNumberFixture, RemovesCollidersNotInserted)
+{
+    AabbTree aabbTree{ TestHeapAllocator };
+    aabbTree.Init(GetParam());
+
+    const auto colliders = CreateRandomColliders(GetParam());
+
+    for (const auto& col : colliders)
+    {
+        aabbTree.Insert(col.Collider.Rectangle, col.Collider.ColRef, col.IsStatic);
+    }
+
+    aabbTree.CalculatePossiblePairs();
+
+    std::vector<TestCollider> remainingColliders;
+
+    for (std::size_t i = 0; i < colliders.size(); i += 3)
+    {
+        remainingColliders.push_back(colliders[i]);
+    }
+
+    for (const auto& col : remainingColliders)
+    {
+        aabbTree.Insert(col.Collider.Rectangle, col.Collider.ColRef, col.IsStatic);
+    }
+
+    aabbTree.CalculatePossiblePairs();
+
+    EXPECT_EQ(aabbTree.ProxyCount(), remainingColliders.size());
+    EXPECT_TRUE(aabbTree.Validate());
+    ExpectSamePairs(aabbTree, remainingColliders);
+}
+
+TEST(AabbTree, SmallMovesDoNotReinsert)
+{
+    AabbTree aabbTree{ TestHeapAllocator };
+    aabbTree.Init(100);
+
+    auto colliders = CreateRandomColliders(100);
+
+    for (const auto& col : colliders)
+    {
+        aabbTree.Insert(col.Collider.Rectangle, col.Collider.ColRef, col.IsStatic);
+    }
+
+    aabbTree.CalculatePossiblePairs();
+
+    EXPECT_EQ(aabbTree.MovedProxyCount(), colliders.size());
+
+    // A move smaller than the fat margin keeps the leaves where they are.
+    for (auto& col : colliders)
+    {
+        const Vec2F move(0.05f, -0.05f);
+        aabbTree.Insert(RectangleF(col.Collider.Rectangle.MinBound() + move,
+                                   col.Collider.Rectangle.MaxBound() + move), col.Collider.ColRef, col.IsStatic);
+    }
+
+    aabbTree.CalculatePossiblePairs();
+
+    EXPECT_EQ(aabbTree.MovedProxyCount(), 0);
+
+    // A larger move re-inserts the leaves.
+    for (auto& col : colliders)
+    {
+        const Vec2F move(1.f, 0.f);
+        aabbTree.Insert(RectangleF(col.Collider.Rectangle.MinBound() + move,
+                                   col.Collider.Rectangle.MaxBound() + move), col.Collider.ColRef, col.IsStatic);
+    }
+
+    aabbTree.CalculatePossiblePairs();
+
+    EXPECT_EQ(aabbTree.MovedProxyCount(), colliders.size());
+    EXPECT_TRUE(aabbTree.Validate());
+}
+
+TEST(AabbTree, StaysBalancedWithSortedInsertion)
+{
+    constexpr std::size_t colNbr = 1024;
+
+    AabbTree aabbTree{ TestHeapAllocator };
+    aabbTree.Init(colNbr);
+
+    // Colliders on a line are the worst case of a tree without rotations.
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        const auto x = static_cast<float>(i);
+        aabbTree.Insert(RectangleF(Vec2F(x, 0.f), Vec2F(x + 0.5f, 0.5f)), ColliderRef{i, 0});
+    }
+
+    aabbTree.CalculatePossiblePairs();
+
+    EXPECT_TRUE(aabbTree.Validate());
+    EXPECT_LE(aabbTree.Height(), 2 * static_cast<int>(std::log2(colNbr)));
+}
+
+TEST(AabbTree, SkipsStaticPairs)
+{
+    AabbTree aabbTree{ TestHeapAllocator };
+    aabbTree.Init(3);
+
+    aabbTree.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(12.8f, 0.2f)), ColliderRef{0, 0}, true);
+    aabbTree.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(0.2f, 7.2f)), ColliderRef{1, 0}, true);
+    aabbTree.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(0.5f, 0.5f)), ColliderRef{2, 0});
+
+    aabbTree.CalculatePossiblePairs();
+
+    const auto pairs = SortedPairs(aabbTree.PossiblePairs());
+
+    ASSERT_EQ(pairs.size(), 2);
+    EXPECT_EQ(pairs[0], (ColliderPair{ ColliderRef{0, 0}, ColliderRef{2, 0} }));
+    EXPECT_EQ(pairs[1], (ColliderPair{ ColliderRef{1, 0}, ColliderRef{2, 0} }));
+}
+
+TEST(AabbTree, OrderDoesNotDependOnHistory)
+{
+    const auto colliders = CreateRandomColliders(200);
+
+    // The first tree sees the colliders moving and half of them removed for a frame, which re-inserts the
+    // leaves, rotates the tree and reuses the free nodes. The second one only sees their final position.
+    AabbTree movingTree{ TestHeapAllocator };
+    movingTree.Init(colliders.size());
+
+    for (int frame = 0; frame < 5; frame++)
+    {
+        for (std::size_t i = 0; i < colliders.size(); i++)
+        {
+            if (frame == 2 && i % 2 == 0) continue;
+
+            const auto& col = colliders[i];
+            const Vec2F move(0.5f * static_cast<float>(5 - frame), 0.f);
+            movingTree.Insert(RectangleF(col.Collider.Rectangle.MinBound() + move,
+                                         col.Collider.Rectangle.MaxBound() + move), col.Collider.ColRef, col.IsStatic);
+        }
+
+        movingTree.CalculatePossiblePairs();
+    }
+
+    for (const auto& col : colliders)
+    {
+        movingTree.Insert(col.Collider.Rectangle, col.Collider.ColRef, col.IsStatic);
+    }
+
+    movingTree.CalculatePossiblePairs();
+
+    AabbTree freshTree{ TestHeapAllocator };
+    freshTree.Init(colliders.size());
+
+    for (const auto& col : colliders)
+    {
+        freshTree.Insert(col.Collider.Rectangle, col.Collider.ColRef, col.IsStatic);
+    }
+
+    freshTree.CalculatePossiblePairs();
+
+    ASSERT_EQ(movingTree.PossiblePairs().size(), freshTree.PossiblePairs().size());
+
+    for (std::size_t i = 0; i < freshTree.PossiblePairs().size(); i++)
+    {
+        EXPECT_EQ(movingTree.PossiblePairs()[i].ColliderA, freshTree.PossiblePairs()[i].ColliderA);
+        EXPECT_EQ(movingTree.PossiblePairs()[i].ColliderB, freshTree.PossiblePairs()[i].ColliderB);
+    }
+}
+
+TEST(AabbTree, Clear)
+{
+    AabbTree aabbTree{ TestHeapAllocator };
+    aabbTree.Init(100);
+
+    for (const auto& col : CreateRandomColliders(100))
+    {
+        aabbTree.Insert(col.Collider.Rectangle, col.Collider.ColRef, col.IsStatic);
+    }
+
+    aabbTree.CalculatePossiblePairs();
+    aabbTree.Clear();
+
+    EXPECT_EQ(aabbTree.ProxyCount(), 0);
+    EXPECT_EQ(aabbTree.Height(), -1);
+    EXPECT_TRUE(aabbTree.Validate());
+
+    aabbTree.CalculatePossiblePairs();
+
+    EXPECT_EQ(aabbTree.PossiblePairs().size(), 0);
+}
@@ -2,6 +2,9 @@
 
 #include "gtest/gtest.h"
 
+#include <type_traits>
+#include <vector>
+
 using namespace Math;
 using namespace PhysicsEngine;
 
@@ -15,8 +18,6 @@ struct FloatFixture : public ::testing::TestWithParam<float> {};
 
 struct PairOfRefFixture : public ::testing::TestWithParam<std::pair<ColliderRef, ColliderRef>> {};
 
-struct ColliderPairFixture : public ::testing::TestWithParam<ColliderPair> {};
-
 struct PairOfColliderPairFixture : public ::testing::TestWithParam<std::pair<ColliderPair, ColliderPair>> {};
 
 INSTANTIATE_TEST_SUITE_P(Collider, ColliderAttributesFixture, testing::Values(
@@ -58,16 +59,6 @@ INSTANTIATE_TEST_SUITE_P(Collider, PairOfRefFixture, testing::Values(
         std::pair{ ColliderRef{50, 34}, ColliderRef{98, 100}}
 ));
 
-INSTANTIATE_TEST_SUITE_P(Collider, ColliderPairFixture, testing::Values(
-        ColliderPair{
-                ColliderRef{0, 0},
-                ColliderRef{0, 0}},
-       ColliderPair{
-                ColliderRef{10, 20},
-                ColliderRef{80, 30}}
-
-));
-
 INSTANTIATE_TEST_SUITE_P(Collider, PairOfColliderPairFixture, testing::Values(
         std::pair{ ColliderPair{
             ColliderRef{0, 0},
@@ -113,6 +104,82 @@ TEST_P(ColliderShapeFixture, GetAndSetShape)
     }
 }
 
+TEST_P(ColliderShapeFixture, TypedShapeAccessors)
+{
+    auto [circle, rect, poly] = GetParam();
+
+    Collider col;
+
+    col.SetShape(circle);
+    EXPECT_EQ(col.GetShapeType(), ShapeType::Circle);
+    EXPECT_EQ(col.Circle().Center(), circle.Center());
+    EXPECT_FLOAT_EQ(col.Circle().Radius(), circle.Radius());
+
+    col.SetShape(rect);
+    EXPECT_EQ(col.GetShapeType(), ShapeType::Rectangle);
+    EXPECT_EQ(col.Rectangle().MinBound(), rect.MinBound());
+    EXPECT_EQ(col.Rectangle().MaxBound(), rect.MaxBound());
+
+    col.SetShape(poly);
+    EXPECT_EQ(col.GetShapeType(), ShapeType::Polygon);
+    ASSERT_EQ(col.Polygon().VerticesCount(), poly.VerticesCount());
+
+    for (int i = 0; i < poly.VerticesCount(); i++)
+    {
+        EXPECT_EQ(col.Polygon()[i], poly.Vertices()[i]);
+    }
+
+    EXPECT_EQ(std::get<PolygonF>(col.Shape()).VerticesCount(), poly.VerticesCount());
+}
+
+TEST(Collider, PolygonIsStoredInTheCollider)
+{
+    static_assert(std::is_trivially_copyable_v<Collider>);
+
+    std::vector<Vec2F> vertices;
+
+    for (int i = 0; i < Collider::MaxPolygonVertices + 2; i++)
+    {
+        vertices.emplace_back(static_cast<float>(i), static_cast<float>(-i));
+    }
+
+    Collider col;
+    col.SetShape(PolygonF(vertices));
+
+    // The vertices after the maximum are ignored.
+    ASSERT_EQ(col.Polygon().VerticesCount(), Collider::MaxPolygonVertices);
+
+    // A copy does not share its vertices with the source.
+    Collider copy = col;
+    col.SetShape(PolygonF({Vec2F::Zero(), Vec2F::One(), Vec2F::Up()}));
+
+    for (int i = 0; i < Collider::MaxPolygonVertices; i++)
+    {
+        EXPECT_EQ(copy.Polygon()[i], vertices[i]);
+    }
+}
+
+TEST(Collider, PolygonNormalsPointOutwards)
+{
+    const std::vector<Vec2F> counterclockwise = { Vec2F(-1.f, -1.f), Vec2F(1.f, -1.f), Vec2F(1.f, 1.f), Vec2F(-1.f, 1.f) };
+    const std::vector<Vec2F> clockwise(counterclockwise.rbegin(), counterclockwise.rend());
+
+    for (const auto& vertices : { counterclockwise, clockwise })
+    {
+        Collider col;
+        col.SetShape(PolygonF(vertices));
+
+        for (int i = 0; i < col.Polygon().VerticesCount(); i++)
+        {
+            const auto faceCenter = (col.Polygon()[i] + col.Polygon()[(i + 1) % 4]) * 0.5f;
+
+            // The normal of a face of a square centered on the origin is its direction from the origin.
+            EXPECT_NEAR(col.PolygonNormals()[i].X, faceCenter.X, 0.0001f);
+            EXPECT_NEAR(col.PolygonNormals()[i].Y, faceCenter.Y, 0.0001f);
+        }
+    }
+}
+
 TEST_P(RefFixture, GetAndSetBodyRef)
 {
     auto [idx, genIdx] = GetParam();
@@ -159,6 +226,51 @@ TEST(Collider, IsTrigger)
     EXPECT_TRUE(collider.IsTrigger());
 }
 
+TEST(Collider, CollisionFilter)
+{
+    Collider col;
+
+    EXPECT_EQ(col.CategoryBits(), CollisionFilter::DefaultCategoryBits);
+    EXPECT_EQ(col.MaskBits(), CollisionFilter::AllCategoryBits);
+
+    col.SetCategoryBits(0b0100);
+    col.SetMaskBits(0b0011);
+
+    EXPECT_EQ(col.GetCollisionFilter().CategoryBits, 0b0100u);
+    EXPECT_EQ(col.GetCollisionFilter().MaskBits, 0b0011u);
+
+    // Both colliders must accept the category of the other one.
+    EXPECT_TRUE(ShouldCollide(col.GetCollisionFilter(), CollisionFilter{ 0b0001, 0b0100 }));
+    EXPECT_FALSE(ShouldCollide(col.GetCollisionFilter(), CollisionFilter{ 0b0001, 0b0010 }));
+    EXPECT_FALSE(ShouldCollide(col.GetCollisionFilter(), CollisionFilter{ 0b1000, 0b0100 }));
+}
+
+TEST(CollisionMatrix, ApplyRestrictsTheMask)
+{
+    CollisionMatrix matrix;
+
+    EXPECT_TRUE(matrix.LayersCollide(3, 5));
+
+    matrix.SetLayersCollide(3, 5, false);
+    matrix.SetLayersCollide(2, 2, false);
+
+    EXPECT_FALSE(matrix.LayersCollide(5, 3));
+    EXPECT_FALSE(matrix.LayersCollide(2, 2));
+
+    const CollisionFilter layer3{ 1u << 3, CollisionFilter::AllCategoryBits };
+    const CollisionFilter layer5{ 1u << 5, CollisionFilter::AllCategoryBits };
+    const CollisionFilter layer2{ 1u << 2, CollisionFilter::AllCategoryBits };
+
+    EXPECT_FALSE(ShouldCollide(matrix.Apply(layer3), matrix.Apply(layer5)));
+    EXPECT_FALSE(ShouldCollide(matrix.Apply(layer2), matrix.Apply(layer2)));
+    EXPECT_TRUE(ShouldCollide(matrix.Apply(layer2), matrix.Apply(layer5)));
+
+    // A collider in several layers touches the layers at least one of them can touch.
+    const CollisionFilter layers3And4{ 1u << 3 | 1u << 4, CollisionFilter::AllCategoryBits };
+
+    EXPECT_TRUE(ShouldCollide(matrix.Apply(layers3And4), matrix.Apply(layer5)));
+}
+
 TEST(ColliderPair, ColliderPairDefaultConstructor)
 {
     ColliderPair colliderPair{};
@@ -195,19 +307,3 @@ TEST_P(PairOfColliderPairFixture, IsLowerOperator)
 
     EXPECT_EQ(colPair1 < colPair2, isLower);
 }
-
-TEST_P(ColliderPairFixture, HashOperator)
-{
-    auto colPair = GetParam();
-
-    ColliderHash colliderHash;
-
-    std::size_t h = colliderHash(colPair);
-
-    const std::size_t hash1 = std::hash<int>{}(static_cast<int>(colPair.ColliderA.Index));
-    const std::size_t hash2 = std::hash<int>{}(static_cast<int>(colPair.ColliderB.Index));
-
-    const auto hashExpected = hash1 + hash2;
-
-    EXPECT_EQ(h, hashExpected);
-}
\ No newline at end of file
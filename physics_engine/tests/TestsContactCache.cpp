@@ -0,0 +1,179 @@
+#include "ContactCache.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace PhysicsEngine;
+
+static HeapAllocator TestHeapAllocator;
+
+struct ColliderPairFixture : public ::testing::TestWithParam<ColliderPair> {};
+
+struct ContactCountFixture : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(ContactCache, ColliderPairFixture, testing::Values(
+        ColliderPair{
+                ColliderRef{0, 0},
+                ColliderRef{0, 0}},
+        ColliderPair{
+                ColliderRef{10, 20},
+                ColliderRef{80, 30}},
+        ColliderPair{
+                ColliderRef{3, 1},
+                ColliderRef{1, 3}}
+));
+
+INSTANTIATE_TEST_SUITE_P(ContactCache, ContactCountFixture, testing::Values(0, 1, 8, 100, 1000));
+
+TEST_P(ColliderPairFixture, HashIsSymmetric)
+{
+    auto colPair = GetParam();
+    ColliderPair swappedPair{ colPair.ColliderB, colPair.ColliderA };
+
+    EXPECT_EQ(HashColliderPair(colPair), HashColliderPair(swappedPair));
+}
+
+TEST_P(ColliderPairFixture, HashDependsOnGeneration)
+{
+    auto colPair = GetParam();
+    ColliderPair otherGenPair = colPair;
+    otherGenPair.ColliderA.GenerationIdx++;
+
+    EXPECT_NE(HashColliderPair(colPair), HashColliderPair(otherGenPair));
+}
+
+TEST(ContactCache, HashDoesNotCollideOnIndexSum)
+{
+    // The sum of the indices is the same for both pairs.
+    ColliderPair pair1{ ColliderRef{1, 0}, ColliderRef{4, 0} };
+    ColliderPair pair2{ ColliderRef{2, 0}, ColliderRef{3, 0} };
+
+    EXPECT_NE(HashColliderPair(pair1), HashColliderPair(pair2));
+}
+
+TEST(ContactCache, EnterStayExit)
+{
+    ContactCache cache{ TestHeapAllocator };
+    cache.Init(4);
+
+    ColliderPair pair{ ColliderRef{0, 0}, ColliderRef{1, 0} };
+
+    cache.BeginFrame();
+    EXPECT_EQ(cache.Touch(pair), ContactStatus::Enter);
+    cache.EndFrame();
+    EXPECT_TRUE(cache.ExitedPairs().empty());
+    EXPECT_EQ(cache.Size(), 1);
+
+    cache.BeginFrame();
+    EXPECT_EQ(cache.Touch(ColliderPair{ pair.ColliderB, pair.ColliderA }), ContactStatus::Stay);
+    EXPECT_EQ(cache.Touch(pair), ContactStatus::AlreadyTouched);
+    cache.EndFrame();
+    EXPECT_TRUE(cache.ExitedPairs().empty());
+    ASSERT_EQ(cache.Contacts().size(), 1);
+    EXPECT_FALSE(cache.Contacts()[0].IsNew);
+
+    cache.BeginFrame();
+    cache.EndFrame();
+    ASSERT_EQ(cache.ExitedPairs().size(), 1);
+    EXPECT_EQ(cache.ExitedPairs()[0].ColliderA, pair.ColliderB);
+    EXPECT_EQ(cache.ExitedPairs()[0].ColliderB, pair.ColliderA);
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_FALSE(cache.Contains(pair));
+}
+
+TEST_P(ContactCountFixture, MatchesLinearSearch)
+{
+    const int contactCount = GetParam();
+
+    ContactCache cache{ TestHeapAllocator };
+    cache.Init(contactCount);
+
+    const auto slotCount = cache.SlotCount();
+
+    std::vector<ColliderPair> previousPairs;
+
+    for (int frame = 0; frame < 10; frame++)
+    {
+        // Every frame touches a sliding window of pairs, so some enter, some stay and some exit.
+        std::vector<ColliderPair> newPairs;
+        for (int i = frame; i < contactCount + frame; i++)
+        {
+            if ((i + frame) % 3 == 0) continue;
+            newPairs.push_back(ColliderPair{ ColliderRef{static_cast<std::size_t>(i), 0},
+                                             ColliderRef{static_cast<std::size_t>(i * 7 + 1), 0} });
+        }
+
+        cache.BeginFrame();
+
+        for (const auto& newPair : newPairs)
+        {
+            const bool wasTouching = std::find(previousPairs.begin(), previousPairs.end(), newPair) !=
+                                     previousPairs.end();
+            EXPECT_EQ(cache.Touch(newPair), wasTouching ? ContactStatus::Stay : ContactStatus::Enter);
+        }
+
+        cache.EndFrame();
+
+        std::vector<ColliderPair> exitedPairs;
+        for (const auto& previousPair : previousPairs)
+        {
+            if (std::find(newPairs.begin(), newPairs.end(), previousPair) == newPairs.end())
+            {
+                exitedPairs.push_back(previousPair);
+            }
+        }
+
+        ASSERT_EQ(cache.ExitedPairs().size(), exitedPairs.size());
+        for (std::size_t i = 0; i < exitedPairs.size(); i++)
+        {
+            EXPECT_EQ(cache.ExitedPairs()[i].ColliderA, exitedPairs[i].ColliderA);
+            EXPECT_EQ(cache.ExitedPairs()[i].ColliderB, exitedPairs[i].ColliderB);
+        }
+
+        EXPECT_EQ(cache.Size(), newPairs.size());
+
+        previousPairs = newPairs;
+    }
+
+    // The table was sized at Init and never had to grow.
+    EXPECT_EQ(cache.SlotCount(), slotCount);
+}
+
+TEST(ContactCache, Grows)
+{
+    ContactCache cache{ TestHeapAllocator };
+    cache.Init(0);
+
+    cache.BeginFrame();
+    for (std::size_t i = 0; i < 500; i++)
+    {
+        EXPECT_EQ(cache.Touch(ColliderPair{ ColliderRef{i, 0}, ColliderRef{i + 1, 0} }), ContactStatus::Enter);
+    }
+    cache.EndFrame();
+
+    EXPECT_EQ(cache.Size(), 500);
+    EXPECT_GE(cache.SlotCount(), 1000);
+
+    for (std::size_t i = 0; i < 500; i++)
+    {
+        EXPECT_TRUE(cache.Contains(ColliderPair{ ColliderRef{i + 1, 0}, ColliderRef{i, 0} }));
+    }
+}
+
+TEST(ContactCache, Deinit)
+{
+    ContactCache cache{ TestHeapAllocator };
+    cache.Init(10);
+
+    cache.BeginFrame();
+    cache.Touch(ColliderPair{ ColliderRef{0, 0}, ColliderRef{1, 0} });
+    cache.EndFrame();
+
+    cache.Deinit();
+
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_EQ(cache.SlotCount(), 0);
+    EXPECT_TRUE(cache.Contacts().empty());
+}
@@ -0,0 +1,335 @@
+#include "ContactConstraintSolver.h"
+#include "World.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+class NullContactListener : public ContactListener
+{
+public:
+    void OnTriggerEnter(ColliderRef, ColliderRef) noexcept override {}
+    void OnTriggerStay(ColliderRef, ColliderRef) noexcept override {}
+    void OnTriggerExit(ColliderRef, ColliderRef) noexcept override {}
+    void OnCollisionEnter(ColliderRef, ColliderRef) noexcept override {}
+    void OnCollisionExit(ColliderRef, ColliderRef) noexcept override {}
+};
+
+TEST(ContactManifold, CircleCircle)
+{
+    Collider colliderA, colliderB;
+    colliderA.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+    colliderB.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+
+    const Body bodyA(Vec2F(0.8f, 0.f), Vec2F::Zero(), 1.f);
+    const Body bodyB(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+
+    const auto manifold = CalculateManifold(colliderA, bodyA, colliderB, bodyB);
+
+    ASSERT_EQ(manifold.PointCount, 1);
+    EXPECT_FLOAT_EQ(manifold.Normal.X, 1.f);
+    EXPECT_FLOAT_EQ(manifold.Normal.Y, 0.f);
+    EXPECT_FLOAT_EQ(manifold.Points[0].Penetration, 0.2f);
+    EXPECT_FLOAT_EQ(manifold.Points[0].Position.X, 0.5f);
+
+    const Body farBody(Vec2F(2.f, 0.f), Vec2F::Zero(), 1.f);
+
+    EXPECT_EQ(CalculateManifold(colliderA, farBody, colliderB, bodyB).PointCount, 0);
+}
+
+TEST(ContactManifold, RectangleCircleUsesOffsets)
+{
+    Collider rectCollider, circleCollider;
+    rectCollider.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+    rectCollider.SetOffset(Vec2F(10.f, 0.f));
+    circleCollider.SetShape(CircleF(Vec2F::Zero(), 0.25f));
+
+    // The circle touches the top side of the rectangle moved by its offset.
+    const Body rectBody(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    const Body circleBody(Vec2F(10.f, 0.7f), Vec2F::Zero(), 1.f);
+
+    const auto manifold = CalculateManifold(rectCollider, rectBody, circleCollider, circleBody);
+
+    ASSERT_EQ(manifold.PointCount, 1);
+
+    // The normal goes from the circle (B) to the rectangle (A).
+    EXPECT_NEAR(manifold.Normal.X, 0.f, 0.0001f);
+    EXPECT_NEAR(manifold.Normal.Y, -1.f, 0.0001f);
+    EXPECT_NEAR(manifold.Points[0].Penetration, 0.05f, 0.0001f);
+}
+
+TEST(ContactManifold, RectangleRectangleLeastPenetrationAxis)
+{
+    Collider colliderA, colliderB;
+    colliderA.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+    colliderB.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+
+    const Body bodyA(Vec2F(0.2f, 0.9f), Vec2F::Zero(), 1.f);
+    const Body bodyB(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+
+    const auto manifold = CalculateManifold(colliderA, bodyA, colliderB, bodyB);
+
+    ASSERT_EQ(manifold.PointCount, 1);
+    EXPECT_FLOAT_EQ(manifold.Normal.Y, 1.f);
+    EXPECT_NEAR(manifold.Points[0].Penetration, 0.1f, 0.0001f);
+}
+
+static PolygonF squarePolygon(const float halfSize) noexcept
+{
+    return PolygonF({ Vec2F(-halfSize, -halfSize), Vec2F(halfSize, -halfSize),
+                      Vec2F(halfSize, halfSize), Vec2F(-halfSize, halfSize) });
+}
+
+TEST(ContactManifold, PolygonPolygonClipsIncidentFace)
+{
+    Collider colliderA, colliderB;
+    colliderA.SetShape(squarePolygon(0.5f));
+    colliderB.SetShape(PolygonF({ Vec2F(-2.f, -0.5f), Vec2F(2.f, -0.5f), Vec2F(2.f, 0.5f), Vec2F(-2.f, 0.5f) }));
+
+    // A small box sinks 0.1 into a wide ground: its bottom face touches at its two corners.
+    const Body bodyA(Vec2F(0.3f, 0.9f), Vec2F::Zero(), 1.f);
+    const Body bodyB(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+
+    const auto manifold = CalculateManifold(colliderA, bodyA, colliderB, bodyB);
+
+    ASSERT_EQ(manifold.PointCount, 2);
+    EXPECT_NEAR(manifold.Normal.X, 0.f, 0.0001f);
+    EXPECT_NEAR(manifold.Normal.Y, 1.f, 0.0001f);
+
+    const auto minX = std::min(manifold.Points[0].Position.X, manifold.Points[1].Position.X);
+    const auto maxX = std::max(manifold.Points[0].Position.X, manifold.Points[1].Position.X);
+
+    EXPECT_NEAR(minX, -0.2f, 0.0001f);
+    EXPECT_NEAR(maxX, 0.8f, 0.0001f);
+    EXPECT_NEAR(manifold.Points[0].Penetration, 0.1f, 0.0001f);
+    EXPECT_NEAR(manifold.Points[1].Penetration, 0.1f, 0.0001f);
+
+    const Body farBody(Vec2F(0.3f, 1.1f), Vec2F::Zero(), 1.f);
+
+    EXPECT_EQ(CalculateManifold(colliderA, farBody, colliderB, bodyB).PointCount, 0);
+}
+
+TEST(ContactManifold, RectanglePolygonClipsToOverlap)
+{
+    Collider rectCollider, polygonCollider;
+    rectCollider.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+    polygonCollider.SetShape(squarePolygon(0.5f));
+
+    // The polygon hangs over the right side of the rectangle and sinks 0.2 into its top.
+    const Body rectBody(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    const Body polygonBody(Vec2F(0.7f, 0.8f), Vec2F::Zero(), 1.f);
+
+    const auto manifold = CalculateManifold(rectCollider, rectBody, polygonCollider, polygonBody);
+
+    ASSERT_EQ(manifold.PointCount, 2);
+
+    // The normal goes from the polygon (B) to the rectangle (A).
+    EXPECT_NEAR(manifold.Normal.X, 0.f, 0.0001f);
+    EXPECT_NEAR(manifold.Normal.Y, -1.f, 0.0001f);
+
+    for (int i = 0; i < manifold.PointCount; i++)
+    {
+        EXPECT_GE(manifold.Points[i].Position.X, 0.2f - 0.0001f);
+        EXPECT_LE(manifold.Points[i].Position.X, 0.5f + 0.0001f);
+        EXPECT_NEAR(manifold.Points[i].Penetration, 0.2f, 0.0001f);
+    }
+}
+
+TEST(ContactManifold, CirclePolygonFaceAndVertex)
+{
+    Collider circleCollider, polygonCollider;
+    circleCollider.SetShape(CircleF(Vec2F::Zero(), 0.25f));
+    polygonCollider.SetShape(squarePolygon(0.5f));
+
+    const Body polygonBody(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+
+    const auto faceManifold = CalculateManifold(circleCollider, Body(Vec2F(0.1f, 0.7f), Vec2F::Zero(), 1.f),
+                                                polygonCollider, polygonBody);
+
+    ASSERT_EQ(faceManifold.PointCount, 1);
+    EXPECT_NEAR(faceManifold.Normal.Y, 1.f, 0.0001f);
+    EXPECT_NEAR(faceManifold.Points[0].Penetration, 0.05f, 0.0001f);
+    EXPECT_NEAR(faceManifold.Points[0].Position.X, 0.1f, 0.0001f);
+    EXPECT_NEAR(faceManifold.Points[0].Position.Y, 0.5f, 0.0001f);
+
+    // Near a corner the circle is pushed out from the vertex, and the normal flips with the order of the colliders.
+    const auto vertexManifold = CalculateManifold(polygonCollider, polygonBody, circleCollider,
+                                                  Body(Vec2F(0.65f, 0.65f), Vec2F::Zero(), 1.f));
+
+    ASSERT_EQ(vertexManifold.PointCount, 1);
+    EXPECT_NEAR(vertexManifold.Normal.X, -std::sqrt(0.5f), 0.0001f);
+    EXPECT_NEAR(vertexManifold.Normal.Y, -std::sqrt(0.5f), 0.0001f);
+    EXPECT_NEAR(vertexManifold.Points[0].Penetration, 0.25f - std::sqrt(0.045f), 0.0001f);
+
+    EXPECT_EQ(CalculateManifold(circleCollider, Body(Vec2F(0.7f, 0.7f), Vec2F::Zero(), 1.f),
+                                polygonCollider, polygonBody).PointCount, 0);
+}
+
+TEST(ContactConstraintSolver, ElasticHeadOnCollisionSwapsVelocities)
+{
+    Collider colliderA, colliderB;
+    colliderA.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+    colliderB.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+    colliderA.SetRestitution(1.f);
+    colliderB.SetRestitution(1.f);
+
+    std::vector<Body> bodies = { Body(Vec2F::Zero(), Vec2F(1.f, 0.f), 1.f),
+                                 Body(Vec2F(0.9f, 0.f), Vec2F(-2.f, 0.f), 1.f) };
+
+    ContactConstraintSolver solver{ TestHeapAllocator };
+    solver.Begin(bodies.size());
+
+    const auto manifold = CalculateManifold(colliderA, bodies[0], colliderB, bodies[1]);
+    const auto constraintIdx = solver.AddContact(0, bodies[0], colliderA, 1, bodies[1], colliderB,
+                                                 manifold, ContactImpulse{});
+
+    ASSERT_NE(constraintIdx, ContactConstraintSolver::NoConstraint);
+
+    solver.Solve(0.02f, 8, 3);
+    solver.StoreBodies(bodies);
+
+    EXPECT_NEAR(bodies[0].Velocity().X, -2.f, 0.0001f);
+    EXPECT_NEAR(bodies[1].Velocity().X, 1.f, 0.0001f);
+
+    // The penetration is partly removed and the bodies are pushed away from each other.
+    EXPECT_LT(bodies[0].Position().X, 0.f);
+    EXPECT_GT(bodies[1].Position().X, 0.9f);
+    EXPECT_NEAR(solver.Impulse(constraintIdx).Normal[0], 3.f, 0.0001f);
+}
+
+TEST(ContactConstraintSolver, StaticBodiesAreNotMoved)
+{
+    Collider colliderA, colliderB;
+    colliderA.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+    colliderB.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+    colliderA.SetRestitution(0.f);
+    colliderB.SetRestitution(0.f);
+
+    std::vector<Body> bodies = { Body(Vec2F::Zero(), Vec2F::Zero(), 1.f),
+                                 Body(Vec2F(0.f, 0.9f), Vec2F(0.f, -1.f), 1.f) };
+    bodies[0].SetBodyType(BodyType::Static);
+
+    ContactConstraintSolver solver{ TestHeapAllocator };
+    solver.Begin(bodies.size());
+
+    const auto manifold = CalculateManifold(colliderB, bodies[1], colliderA, bodies[0]);
+    solver.AddContact(1, bodies[1], colliderB, 0, bodies[0], colliderA, manifold, ContactImpulse{});
+    solver.Solve(0.02f, 8, 3);
+    solver.StoreBodies(bodies);
+
+    EXPECT_FLOAT_EQ(bodies[0].Position().Y, 0.f);
+    EXPECT_FLOAT_EQ(bodies[0].Velocity().Y, 0.f);
+    EXPECT_NEAR(bodies[1].Velocity().Y, 0.f, 0.0001f);
+    EXPECT_GT(bodies[1].Position().Y, 0.9f);
+
+    // Two static bodies can not be moved, so their contact is not added.
+    bodies[1].SetBodyType(BodyType::Static);
+    solver.Begin(bodies.size());
+
+    EXPECT_EQ(solver.AddContact(1, bodies[1], colliderB, 0, bodies[0], colliderA, manifold, ContactImpulse{}),
+              ContactConstraintSolver::NoConstraint);
+}
+
+TEST(ContactConstraintSolver, StackOfBoxesComesToRest)
+{
+    // A stack of boxes falling on a static floor at the 50 Hz tick of the game.
+    constexpr float deltaTime = 1.f / 50.f;
+    constexpr int boxCount = 5;
+
+    World world;
+    world.Init(Vec2F(0.f, -9.81f), boxCount + 1);
+
+    NullContactListener listener;
+    world.SetContactListener(&listener);
+
+    const auto floorRef = world.CreateBody();
+    world.GetBody(floorRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    world.GetBody(floorRef).SetBodyType(BodyType::Static);
+
+    auto& floorCollider = world.GetCollider(world.CreateCollider(floorRef));
+    floorCollider.SetShape(RectangleF(Vec2F(-5.f, -0.5f), Vec2F(5.f, 0.f)));
+    floorCollider.SetRestitution(0.f);
+
+    std::vector<BodyRef> boxRefs;
+
+    for (int i = 0; i < boxCount; i++)
+    {
+        const auto boxRef = world.CreateBody();
+        world.GetBody(boxRef) = Body(Vec2F(0.f, 0.5f + static_cast<float>(i) * 1.05f), Vec2F::Zero(), 1.f);
+
+        auto& collider = world.GetCollider(world.CreateCollider(boxRef));
+        collider.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+        collider.SetRestitution(0.f);
+
+        boxRefs.push_back(boxRef);
+    }
+
+    for (int frame = 0; frame < 250; frame++)
+    {
+        world.Update(deltaTime);
+    }
+
+    for (int i = 0; i < boxCount; i++)
+    {
+        const auto& box = world.GetBody(boxRefs[i]);
+
+        // Each box rests on the previous one, each contact keeps a penetration of a few millimeters.
+        EXPECT_NEAR(box.Position().Y, 0.5f + static_cast<float>(i), static_cast<float>(i + 1) * 0.006f);
+        EXPECT_NEAR(box.Velocity().Y, 0.f, 0.001f);
+    }
+}
+
+TEST(ContactConstraintSolver, PolygonBoxesRestOnPolygonFloor)
+{
+    constexpr float deltaTime = 1.f / 50.f;
+    constexpr int boxCount = 3;
+
+    World world;
+    world.Init(Vec2F(0.f, -9.81f), boxCount + 1);
+
+    NullContactListener listener;
+    world.SetContactListener(&listener);
+
+    const auto floorRef = world.CreateBody();
+    world.GetBody(floorRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    world.GetBody(floorRef).SetBodyType(BodyType::Static);
+
+    auto& floorCollider = world.GetCollider(world.CreateCollider(floorRef));
+    floorCollider.SetShape(PolygonF({ Vec2F(-5.f, -0.5f), Vec2F(5.f, -0.5f), Vec2F(5.f, 0.f), Vec2F(-5.f, 0.f) }));
+    floorCollider.SetRestitution(0.f);
+
+    std::vector<BodyRef> boxRefs;
+
+    for (int i = 0; i < boxCount; i++)
+    {
+        const auto boxRef = world.CreateBody();
+        world.GetBody(boxRef) = Body(Vec2F(0.f, 0.5f + static_cast<float>(i) * 1.05f), Vec2F::Zero(), 1.f);
+
+        auto& collider = world.GetCollider(world.CreateCollider(boxRef));
+        collider.SetShape(squarePolygon(0.5f));
+        collider.SetRestitution(0.f);
+
+        boxRefs.push_back(boxRef);
+    }
+
+    for (int frame = 0; frame < 250; frame++)
+    {
+        world.Update(deltaTime);
+    }
+
+    for (int i = 0; i < boxCount; i++)
+    {
+        const auto& box = world.GetBody(boxRefs[i]);
+
+        // The polygons stack like the rectangles: each face contact has two points.
+        EXPECT_NEAR(box.Position().X, 0.f, 0.001f);
+        EXPECT_NEAR(box.Position().Y, 0.5f + static_cast<float>(i), static_cast<float>(i + 1) * 0.006f);
+        EXPECT_NEAR(box.Velocity().Y, 0.f, 0.001f);
+    }
+}
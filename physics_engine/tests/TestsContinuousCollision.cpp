@@ -0,0 +1,127 @@
+#include "ContinuousCollision.h"
+
+#include "gtest/gtest.h"
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+TEST(ContinuousCollision, CircleHitsCircle)
+{
+    const CircleF circle(Vec2F::Zero(), 0.5f);
+    const CircleF target(Vec2F(4.f, 0.f), 1.f);
+
+    const auto impact = SweptCircleTimeOfImpact(circle, Vec2F(10.f, 0.f), target);
+
+    ASSERT_TRUE(impact.Hit);
+    EXPECT_NEAR(impact.Time, 0.25f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.X, -1.f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.Y, 0.f, 0.0001f);
+}
+
+TEST(ContinuousCollision, CircleMissesCircle)
+{
+    const CircleF circle(Vec2F::Zero(), 0.5f);
+
+    EXPECT_FALSE(SweptCircleTimeOfImpact(circle, Vec2F(10.f, 0.f), CircleF(Vec2F(4.f, 2.f), 1.f)).Hit);
+    EXPECT_FALSE(SweptCircleTimeOfImpact(circle, Vec2F(2.f, 0.f), CircleF(Vec2F(4.f, 0.f), 1.f)).Hit);
+    EXPECT_FALSE(SweptCircleTimeOfImpact(circle, Vec2F(-10.f, 0.f), CircleF(Vec2F(4.f, 0.f), 1.f)).Hit);
+}
+
+TEST(ContinuousCollision, OverlappingCircleDoesNotHit)
+{
+    const CircleF circle(Vec2F::Zero(), 0.5f);
+
+    EXPECT_FALSE(SweptCircleTimeOfImpact(circle, Vec2F(10.f, 0.f), CircleF(Vec2F(1.f, 0.f), 1.f)).Hit);
+}
+
+TEST(ContinuousCollision, CircleHitsRectangleFace)
+{
+    const CircleF circle(Vec2F(0.f, 1.f), 0.5f);
+    const RectangleF wall(Vec2F(4.f, 0.f), Vec2F(4.5f, 2.f));
+
+    const auto impact = SweptCircleTimeOfImpact(circle, Vec2F(10.f, 0.f), wall);
+
+    ASSERT_TRUE(impact.Hit);
+    EXPECT_NEAR(impact.Time, 0.35f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.X, -1.f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.Y, 0.f, 0.0001f);
+}
+
+TEST(ContinuousCollision, CircleHitsRectangleCorner)
+{
+    const CircleF circle(Vec2F(0.f, 2.3f), 0.5f);
+    const RectangleF wall(Vec2F(4.f, 0.f), Vec2F(4.5f, 2.f));
+
+    const auto impact = SweptCircleTimeOfImpact(circle, Vec2F(10.f, 0.f), wall);
+
+    // The center passes 0.3 above the corner, which is touched when the center is 0.4 before it.
+    ASSERT_TRUE(impact.Hit);
+    EXPECT_NEAR(impact.Time, 0.36f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.X, -0.8f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.Y, 0.6f, 0.0001f);
+}
+
+TEST(ContinuousCollision, CircleMissesRectangle)
+{
+    const CircleF circle(Vec2F(3.f, 1.75f), 0.5f);
+    const RectangleF wall(Vec2F(4.f, 0.f), Vec2F(4.5f, 2.f));
+
+    // The center goes through the grown rectangle but misses its rounded corner.
+    EXPECT_FALSE(SweptCircleTimeOfImpact(circle, Vec2F(2.f, 2.f), wall).Hit);
+    EXPECT_FALSE(SweptCircleTimeOfImpact(CircleF(Vec2F(0.f, 1.f), 0.5f), Vec2F(3.f, 0.f), wall).Hit);
+}
+
+TEST(ContinuousCollision, CircleHitsPolygonFace)
+{
+    // A triangle whose hypotenuse faces the top right.
+    Collider collider;
+    collider.SetShape(PolygonF({ Vec2F(0.f, 0.f), Vec2F(2.f, 0.f), Vec2F(0.f, 2.f) }));
+
+    const auto triangle = MakeConvexPolygon(collider, Vec2F::Zero());
+
+    // The circle moves toward the middle of the hypotenuse along its normal.
+    const Vec2F normal = Vec2F(1.f, 1.f).Normalized();
+    const CircleF circle(Vec2F(1.f, 1.f) + normal * 3.f, 0.5f);
+
+    const auto impact = SweptCircleTimeOfImpact(circle, normal * -5.f, triangle);
+
+    ASSERT_TRUE(impact.Hit);
+    EXPECT_NEAR(impact.Time, 0.5f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.X, normal.X, 0.0001f);
+    EXPECT_NEAR(impact.Normal.Y, normal.Y, 0.0001f);
+}
+
+TEST(ContinuousCollision, CircleHitsPolygonVertex)
+{
+    Collider collider;
+    collider.SetShape(PolygonF({ Vec2F(0.f, 0.f), Vec2F(2.f, 0.f), Vec2F(0.f, 2.f) }));
+
+    const auto triangle = MakeConvexPolygon(collider, Vec2F::Zero());
+
+    // The center passes 0.3 below the bottom left vertex, which is touched when the center is 0.4 before it.
+    const CircleF circle(Vec2F(-5.f, -0.3f), 0.5f);
+
+    const auto impact = SweptCircleTimeOfImpact(circle, Vec2F(10.f, 0.f), triangle);
+
+    ASSERT_TRUE(impact.Hit);
+    EXPECT_NEAR(impact.Time, 0.46f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.X, -0.8f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.Y, -0.6f, 0.0001f);
+}
+
+TEST(ContinuousCollision, RayMissesOrStartsInPolygon)
+{
+    Collider collider;
+    collider.SetShape(PolygonF({ Vec2F(0.f, 0.f), Vec2F(2.f, 0.f), Vec2F(0.f, 2.f) }));
+
+    const auto triangle = MakeConvexPolygon(collider, Vec2F::Zero());
+
+    EXPECT_FALSE(SweptCircleTimeOfImpact(CircleF(Vec2F(-1.f, 3.f), 0.f), Vec2F(5.f, 0.f), triangle).Hit);
+    EXPECT_FALSE(SweptCircleTimeOfImpact(CircleF(Vec2F(0.5f, 0.5f), 0.f), Vec2F(5.f, 0.f), triangle).Hit);
+
+    const auto impact = SweptCircleTimeOfImpact(CircleF(Vec2F(-1.f, 0.5f), 0.f), Vec2F(4.f, 0.f), triangle);
+
+    ASSERT_TRUE(impact.Hit);
+    EXPECT_NEAR(impact.Time, 0.25f, 0.0001f);
+    EXPECT_NEAR(impact.Normal.X, -1.f, 0.0001f);
+}
@@ -0,0 +1,114 @@
+#include "ConvexPolygon.h"
+#include "SeparatingAxisCache.h"
+
+#include "gtest/gtest.h"
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+static Collider triangleCollider() noexcept
+{
+    Collider collider;
+    collider.SetShape(PolygonF({ Vec2F(0.f, 0.f), Vec2F(1.f, 0.f), Vec2F(0.f, 1.f) }));
+
+    return collider;
+}
+
+TEST(ConvexPolygon, RectangleCornersAndNormals)
+{
+    Collider collider;
+    collider.SetShape(RectangleF(Vec2F(-1.f, -0.5f), Vec2F(1.f, 0.5f)));
+
+    const auto polygon = MakeConvexPolygon(collider, Vec2F(2.f, 0.f));
+
+    ASSERT_EQ(polygon.VerticesCount, 4);
+    EXPECT_EQ(polygon.Vertices[0], Vec2F(1.f, -0.5f));
+    EXPECT_EQ(polygon.Vertices[2], Vec2F(3.f, 0.5f));
+
+    for (int i = 0; i < polygon.VerticesCount; i++)
+    {
+        const auto edge = polygon.Vertices[(i + 1) % 4] - polygon.Vertices[i];
+
+        EXPECT_FLOAT_EQ(edge.Dot(polygon.Normals[i]), 0.f);
+        EXPECT_GT((polygon.Vertices[i] - Vec2F(2.f, 0.f)).Dot(polygon.Normals[i]), 0.f);
+    }
+}
+
+TEST(ConvexPolygon, SeparatingAxisMatchesIntersect)
+{
+    const auto collider = triangleCollider();
+    const auto polygonA = MakeConvexPolygon(collider, Vec2F::Zero());
+
+    const std::array<Vec2F, 5> positions = {
+        Vec2F(0.5f, 0.5f), Vec2F(0.6f, 0.6f), Vec2F(1.1f, 0.f), Vec2F(-0.9f, 0.5f), Vec2F(0.2f, -0.2f)
+    };
+
+    for (const auto& position : positions)
+    {
+        const auto polygonB = MakeConvexPolygon(collider, position);
+
+        Vec2F axis = Vec2F::Zero();
+        const bool isSeparated = FindSeparatingAxis(polygonA, polygonB, axis);
+
+        EXPECT_EQ(isSeparated, !Intersect(polygonA.View(), polygonB.View()));
+
+        if (isSeparated)
+        {
+            EXPECT_TRUE(IsSeparatingAxis(polygonA, polygonB, axis));
+            EXPECT_TRUE(IsSeparatingAxis(polygonB, polygonA, axis));
+        }
+    }
+}
+
+TEST(ConvexPolygon, MaxSeparation)
+{
+    Collider collider;
+    collider.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+
+    const auto polygonA = MakeConvexPolygon(collider, Vec2F::Zero());
+    const auto polygonB = MakeConvexPolygon(collider, Vec2F(0.2f, 1.5f));
+
+    int face = -1;
+
+    EXPECT_NEAR(FindMaxSeparation(polygonA, polygonB, face), 0.5f, 0.0001f);
+    EXPECT_EQ(polygonA.Normals[face], Vec2F::Up());
+}
+
+TEST(SeparatingAxisCache, StoreAndFind)
+{
+    SeparatingAxisCache cache(TestHeapAllocator);
+    cache.Reserve(10);
+
+    const ColliderPair pair{ ColliderRef{ 1, 0 }, ColliderRef{ 2, 0 } };
+    const ColliderPair swappedPair{ pair.ColliderB, pair.ColliderA };
+    const ColliderPair otherGenerationPair{ ColliderRef{ 1, 1 }, ColliderRef{ 2, 0 } };
+
+    EXPECT_EQ(cache.Find(pair), Vec2F::Zero());
+
+    cache.Store(pair, Vec2F::Up());
+
+    EXPECT_EQ(cache.Find(pair), Vec2F::Up());
+    EXPECT_EQ(cache.Find(swappedPair), Vec2F::Up());
+    EXPECT_EQ(cache.Find(otherGenerationPair), Vec2F::Zero());
+
+    cache.Clear();
+
+    EXPECT_EQ(cache.Find(pair), Vec2F::Zero());
+}
+
+TEST(SeparatingAxisCache, ReserveKeepsLoadUnderHalf)
+{
+    SeparatingAxisCache cache(TestHeapAllocator);
+    cache.Reserve(100);
+
+    const auto slotCount = cache.SlotCount();
+
+    EXPECT_GE(slotCount, 200);
+    EXPECT_EQ(slotCount & (slotCount - 1), 0);
+
+    cache.Reserve(50);
+
+    EXPECT_EQ(cache.SlotCount(), slotCount);
+}
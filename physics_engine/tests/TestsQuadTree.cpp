@@ -4,30 +4,41 @@
 #include "gtest/gtest.h"
 #include "Random.h"
 
+#include <memory>
+
 using namespace PhysicsEngine;
 using namespace Math;
 
-static HeapAllocator TestHeapAllocator;
-
 struct BoundaryFixture : public ::testing::TestWithParam<RectangleF> {};
 
 struct ColliderNumberFixture : public ::testing::TestWithParam<int> {};
 
 INSTANTIATE_TEST_SUITE_P(QuadTree, ColliderNumberFixture, testing::Values(0, 1, 10, 100, 100, 321, 14, 5789));
 
-TEST(QuadNode, DefaultConstructor)
+/**
+ * @brief ExpectedNode is a node of a pointer-based quad-tree which inserts the colliders one by one,
+ * used as a reference for the flat quad-tree.
+ */
+struct ExpectedNode
 {
-    QuadNode node{TestHeapAllocator};
+    RectangleF Boundary{Vec2F::Zero(), Vec2F::Zero()};
+    std::array<std::unique_ptr<ExpectedNode>, QuadNode::BoundaryDivisionCount> Children{};
+    std::vector<SimplifiedCollider> Colliders{};
+};
 
-    EXPECT_EQ(node.Boundary.MinBound(), Vec2F::Zero());
-    EXPECT_EQ(node.Boundary.MaxBound(), Vec2F::Zero());
+TEST(QuadNode, DefaultConstructor)
+{
+    QuadNode node;
 
     for (const auto& child : node.Children)
     {
-        EXPECT_EQ(child, nullptr);
+        EXPECT_EQ(child, QuadNode::NoChild);
     }
 
-    EXPECT_EQ(node.Colliders.size(), 0);
+    EXPECT_FALSE(node.HasChildren());
+    EXPECT_EQ(node.ColliderOffset, 0);
+    EXPECT_EQ(node.ColliderCount, 0);
+    EXPECT_EQ(node.SubTreeColliderCount, 0);
 }
 
 TEST(QuadTree, DefaultConstructor)
@@ -37,255 +48,122 @@ TEST(QuadTree, DefaultConstructor)
     EXPECT_EQ(quadTree.PossiblePairs().size(), 0);
 }
 
-void InitRecursive(const QuadNode& node)
-{
-    EXPECT_EQ(node.Colliders.capacity(), QuadNode::MaxColliderNbr + 1);
-
-    if (node.Children[0] != nullptr)
-    {
-        for (const auto& child : node.Children)
-        {
-            InitRecursive(*child);
-        }
-    }
-}
-
-template<typename T>
-constexpr T QuadCount(T depth)
-{
-    T result = 0;
-
-    for (T i = 0; i <= depth; i++)
-    {
-        result += Math::Pow(QuadNode::BoundaryDivisionCount, i);
-    }
-
-    return result;
-}
-
-void TestInit(std::vector<QuadNode>& expectedNodes)
-{
-    expectedNodes.resize(QuadCount(QuadTree::MaxDepth()), QuadNode({ TestHeapAllocator }));
-
-    for (auto& node : expectedNodes)
-    {
-        node.Colliders.reserve(QuadNode::MaxColliderNbr + 1);
-    }
-}
-
 TEST(QuadTree, Init)
 {
     QuadTree quadTree;
     quadTree.Init();
 
-    InitRecursive(quadTree.RootNode());
+    EXPECT_EQ(quadTree.NodeCount(), 1);
+    EXPECT_FALSE(quadTree.RootNode().HasChildren());
 }
 
-void CheckRecursive(const QuadNode& node, const QuadNode& expectedNode)
+void InsertRecursive(ExpectedNode& node, SimplifiedCollider simplCol, int depth) noexcept
 {
-    for (std::size_t i = 0; i < node.Colliders.size(); i++)
-    {
-        EXPECT_EQ(node.Colliders[i].Rectangle.MinBound(), expectedNode.Colliders[i].Rectangle.MinBound());
-        EXPECT_EQ(node.Colliders[i].Rectangle.MaxBound(), expectedNode.Colliders[i].Rectangle.MaxBound());
-        EXPECT_EQ(node.Colliders[i].ColRef, expectedNode.Colliders[i].ColRef);
-    }
-
-    if (node.Children[0] != nullptr)
-    {
-        for (std::size_t i = 0; i < node.Children.size(); i++)
-        {
-            CheckRecursive(*node.Children[i], *expectedNode.Children[i]);
-        }
-    }
-}
-
-void insertRecursive(std::vector<QuadNode>& expectedNodes,
-                     QuadNode& node,
-                     Math::RectangleF simplifiedShape,
-                     ColliderRef colliderRef,
-                     int depth,
-                     int maxDepth) noexcept
-{
-    int nodeIndex = 0;
-
     // If the node doesn't have any children.
     if (node.Children[0] == nullptr)
     {
-        // Add the simplified collider to the node.
-        SimplifiedCollider simplifiedCollider = {colliderRef, simplifiedShape};
-        node.Colliders.push_back(simplifiedCollider);
+        node.Colliders.push_back(simplCol);
 
-        // If the node has fewer colliders than the max number and the depth is not equal to the max depth.
-        if (node.Colliders.size() > QuadNode::MaxColliderNbr && depth != maxDepth)
+        if (node.Colliders.size() <= QuadNode::MaxColliderNbr || depth == QuadTree::MaxDepth())
         {
-            // Subdivide the node rectangle in 4 rectangle.
-            const auto center = node.Boundary.Center();
-            const auto halfSize = node.Boundary.HalfSize();
-
-            const auto topMiddle = Math::Vec2F(center.X, center.Y + halfSize.Y);
-            const auto topRightCorner = center + halfSize;
-            const auto rightMiddle = Math::Vec2F(center.X + halfSize.X, center.Y);
-            const auto bottomMiddle = Math::Vec2F(center.X, center.Y - halfSize.Y);
-            const auto bottomLeftCorner = center - halfSize;
-            const auto leftMiddle = Math::Vec2F(center.X - halfSize.X, center.Y);
-
-            expectedNodes[nodeIndex].Boundary = Math::RectangleF(leftMiddle, topMiddle);
-            expectedNodes[nodeIndex + 1].Boundary = Math::RectangleF(center, topRightCorner);
-            expectedNodes[nodeIndex + 2].Boundary = Math::RectangleF(bottomLeftCorner, center);
-            expectedNodes[nodeIndex + 3].Boundary = Math::RectangleF(bottomMiddle, rightMiddle);
-
-            node.Children[0] = &expectedNodes[nodeIndex];
-            node.Children[1] = &expectedNodes[nodeIndex + 1];
-            node.Children[2] = &expectedNodes[nodeIndex + 2];
-            node.Children[3] = &expectedNodes[nodeIndex + 3];
-
-            nodeIndex += 4;
-
-            std::vector<SimplifiedCollider> remainingColliders;
+            return;
+        }
 
-            for (const auto &col: node.Colliders)
-            {
-                int boundInterestCount = 0;
-                QuadNode *intersectNode = nullptr;
-
-                for (const auto &child: node.Children)
-                {
-                    if (Math::Intersect(child->Boundary, col.Rectangle))
-                    {
-                        boundInterestCount++;
-                        intersectNode = child;
-                    }
-                }
-
-                if (boundInterestCount == 1)
-                {
-                    insertRecursive(expectedNodes,
-                                    *intersectNode,
-                                    col.Rectangle,
-                                    col.ColRef,
-                                    depth + 1,
-                                    maxDepth);
-                }
-                else
-                {
-                    remainingColliders.push_back(col);
-                }
-            }
+        // Subdivide the node rectangle in 4 rectangle.
+        const auto center = node.Boundary.Center();
+        const auto halfSize = node.Boundary.HalfSize();
+
+        const auto topMiddle = Vec2F(center.X, center.Y + halfSize.Y);
+        const auto topRightCorner = center + halfSize;
+        const auto rightMiddle = Vec2F(center.X + halfSize.X, center.Y);
+        const auto bottomMiddle = Vec2F(center.X, center.Y - halfSize.Y);
+        const auto bottomLeftCorner = center - halfSize;
+        const auto leftMiddle = Vec2F(center.X - halfSize.X, center.Y);
+
+        const std::array<RectangleF, QuadNode::BoundaryDivisionCount> boundaries{
+            RectangleF(leftMiddle, topMiddle),
+            RectangleF(center, topRightCorner),
+            RectangleF(bottomLeftCorner, center),
+            RectangleF(bottomMiddle, rightMiddle)
+        };
+
+        for (std::size_t i = 0; i < QuadNode::BoundaryDivisionCount; i++)
+        {
+            node.Children[i] = std::make_unique<ExpectedNode>();
+            node.Children[i]->Boundary = boundaries[i];
+        }
 
-            node.Colliders.clear();
+        auto remainingColliders = std::move(node.Colliders);
+        node.Colliders.clear();
 
-            for (const auto& col : remainingColliders)
-            {
-                node.Colliders.push_back(col);
-            }
+        for (const auto& col : remainingColliders)
+        {
+            InsertRecursive(node, col, depth);
         }
+
+        return;
     }
 
     // If the node has children.
-    else
-    {
-        int boundInterestCount = 0;
-        QuadNode* intersectNode = nullptr;
+    int boundInterestCount = 0;
+    ExpectedNode* intersectNode = nullptr;
 
-        for (const auto& child : node.Children)
+    for (const auto& child : node.Children)
+    {
+        if (Intersect(child->Boundary, simplCol.Rectangle))
         {
-            if (Math::Intersect(child->Boundary, simplifiedShape))
-            {
-                boundInterestCount++;
-                intersectNode = child;
-            }
+            boundInterestCount++;
+            intersectNode = child.get();
         }
+    }
 
-        if (boundInterestCount == 1)
-        {
-            insertRecursive(expectedNodes,
-                            *intersectNode,
-                            simplifiedShape,
-                            colliderRef,
-                            depth + 1,
-                            maxDepth);
-        }
-        else
-        {
-            SimplifiedCollider simplifiedCollider = {colliderRef, simplifiedShape};
-            node.Colliders.push_back(simplifiedCollider);
-        }
+    if (boundInterestCount == 1)
+    {
+        InsertRecursive(*intersectNode, simplCol, depth + 1);
+    }
+    else
+    {
+        node.Colliders.push_back(simplCol);
     }
 }
 
-TEST_P(ColliderNumberFixture, Insert)
+void CheckRecursive(const QuadTree& quadTree, const QuadNode& node, const ExpectedNode& expectedNode)
 {
-    World world;
-    QuadTree quadTree;
-    const auto colNbr = GetParam();
-
-    std::vector<QuadNode> expectedNodes;
-
-    world.Init();
-    quadTree.Init();
-
-    std::vector<Collider> colliders;
-    colliders.reserve(colNbr);
-
-    TestInit(expectedNodes);
+    ASSERT_EQ(node.ColliderCount, expectedNode.Colliders.size());
 
-    for (std::size_t i = 0; i < colNbr; i++)
+    for (std::size_t i = 0; i < node.ColliderCount; i++)
     {
-        Math::Vec2F rndScreenPos(Math::Random::Range(1.f, 7.f),
-                                 Math::Random::Range(-1.f, -5.f));
-
-        Math::Vec2F rndVelocity(Math::Random::Range(-2.f, 2.f),
-                                Math::Random::Range(-2.f, 2.f));
-
-        // Body.
-        BodyRef bodyRef = world.CreateBody();
-        auto& body = world.GetBody(bodyRef);
-        body = PhysicsEngine::Body(rndScreenPos, rndVelocity, 1.f);
+        const auto simplCol = quadTree.ColliderAt(node.ColliderOffset + i);
 
-        // Collider.
-        ColliderRef colRef = world.CreateCollider(bodyRef);
-        auto& collider = world.GetCollider(colRef);
-        collider.SetIsTrigger(true);
-        collider.SetShape(Math::CircleF(Math::Vec2F::Zero(),
-                                        Math::Random::Range(0.1f, 0.15f)));
-
-        colliders.push_back(collider);
+        EXPECT_EQ(simplCol.Rectangle.MinBound(), expectedNode.Colliders[i].Rectangle.MinBound());
+        EXPECT_EQ(simplCol.Rectangle.MaxBound(), expectedNode.Colliders[i].Rectangle.MaxBound());
+        EXPECT_EQ(simplCol.ColRef, expectedNode.Colliders[i].ColRef);
     }
 
-    for (std::size_t i = 0; i < colliders.size(); i++)
-    {
-        ColliderRef colliderRef = {i, 0};
-        const auto& col = world.GetCollider(colliderRef);
-
-        const auto colShape = col.Shape();
+    ASSERT_EQ(node.HasChildren(), expectedNode.Children[0] != nullptr);
 
-        const auto circle = std::get<Math::CircleF>(colShape);
-        const auto radius = circle.Radius();
-        const auto simplifiedCircle = Math::RectangleF::FromCenter(
-                world.GetBody(col.GetBodyRef()).Position(),
-                Math::Vec2F(radius, radius));
+    if (node.HasChildren())
+    {
+        for (std::size_t i = 0; i < node.Children.size(); i++)
+        {
+            const auto boundary = quadTree.NodeBoundary(node.Children[i]);
 
-        quadTree.Insert(simplifiedCircle, colliderRef);
+            EXPECT_EQ(boundary.MinBound(), expectedNode.Children[i]->Boundary.MinBound());
+            EXPECT_EQ(boundary.MaxBound(), expectedNode.Children[i]->Boundary.MaxBound());
 
-        insertRecursive(expectedNodes,
-                        expectedNodes[0],
-                        simplifiedCircle,
-                        colliderRef,
-                        0,
-                        QuadTree::MaxDepth());
+            CheckRecursive(quadTree, quadTree.Node(node.Children[i]), *expectedNode.Children[i]);
+        }
     }
-
-    CheckRecursive(quadTree.RootNode(), expectedNodes[0]);
 }
 
 void CalculatePairsInChildrenNodes(std::vector<ColliderPair>& possiblePairs,
-    const QuadNode& node, 
+    const ExpectedNode& node,
     const SimplifiedCollider& simplCol) noexcept
 {
     // For each colliders in the current node, compare it with the simplified collider from its parent node.
     for (const auto& nodeSimplCol : node.Colliders)
     {
-        if (Math::Intersect(simplCol.Rectangle, nodeSimplCol.Rectangle))
+        if (Intersect(simplCol.Rectangle, nodeSimplCol.Rectangle))
         {
             possiblePairs.push_back(ColliderPair{ simplCol.ColRef, nodeSimplCol.ColRef });
         }
@@ -301,7 +179,7 @@ void CalculatePairsInChildrenNodes(std::vector<ColliderPair>& possiblePairs,
     }
 }
 
-void CalculatePairsInNode(std::vector<ColliderPair>& possiblePairs, const QuadNode& node) noexcept
+void CalculatePairsInNode(std::vector<ColliderPair>& possiblePairs, const ExpectedNode& node) noexcept
 {
     for (std::size_t i = 0; i < node.Colliders.size(); i++)
     {
@@ -311,7 +189,7 @@ void CalculatePairsInNode(std::vector<ColliderPair>& possiblePairs, const QuadNo
         {
             const auto& simplColB = node.Colliders[j];
 
-            if (Math::Intersect(simplColA.Rectangle, simplColB.Rectangle))
+            if (Intersect(simplColA.Rectangle, simplColB.Rectangle))
             {
                 possiblePairs.push_back(ColliderPair{simplColA.ColRef, simplColB.ColRef});
             }
@@ -337,67 +215,151 @@ void CalculatePairsInNode(std::vector<ColliderPair>& possiblePairs, const QuadNo
     }
 }
 
-TEST_P(ColliderNumberFixture, CalculatePossiblePairs)
+/**
+ * @brief CreateRandomColliders is a function that inserts random circle colliders (in their simplified
+ * shape) in the quad-tree and in the expected root node.
+ */
+void CreateRandomColliders(QuadTree& quadTree, ExpectedNode& expectedRoot, std::size_t colNbr)
+{
+    const RectangleF rootBoundary(Vec2F(0.f, -6.f), Vec2F(8.f, 0.f));
+
+    quadTree.SetRootNodeBoundary(rootBoundary);
+    expectedRoot.Boundary = rootBoundary;
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        Vec2F rndScreenPos(Random::Range(1.f, 7.f),
+                           Random::Range(-1.f, -5.f));
+
+        const auto radius = Random::Range(0.1f, 0.15f);
+        const auto simplifiedCircle = RectangleF::FromCenter(rndScreenPos, Vec2F(radius, radius));
+
+        ColliderRef colliderRef = {i, 0};
+
+        quadTree.Insert(simplifiedCircle, colliderRef);
+        InsertRecursive(expectedRoot, SimplifiedCollider{ colliderRef, simplifiedCircle }, 0);
+    }
+}
+
+TEST_P(ColliderNumberFixture, Insert)
 {
-    World world;
     QuadTree quadTree;
+    quadTree.Init();
+
+    ExpectedNode expectedRoot;
 
-    world.Init();
+    CreateRandomColliders(quadTree, expectedRoot, GetParam());
+
+    quadTree.Build();
+
+    EXPECT_EQ(quadTree.RootNode().SubTreeColliderCount, GetParam());
+
+    CheckRecursive(quadTree, quadTree.RootNode(), expectedRoot);
+}
+
+TEST_P(ColliderNumberFixture, CalculatePossiblePairs)
+{
+    QuadTree quadTree;
     quadTree.Init();
 
-    const auto colNbr = GetParam();
+    ExpectedNode expectedRoot;
 
-    std::vector<Collider> colliders;
-    colliders.reserve(colNbr);
+    CreateRandomColliders(quadTree, expectedRoot, GetParam());
 
     std::vector<ColliderPair> possiblePairs;
 
-    for (std::size_t i = 0; i < colNbr; i++)
+    quadTree.CalculatePossiblePairs();
+    CalculatePairsInNode(possiblePairs, expectedRoot);
+
+    const auto& quadPossiblePairs = quadTree.PossiblePairs();
+
+    ASSERT_EQ(quadPossiblePairs.size(), possiblePairs.size());
+
+    for (std::size_t  i = 0; i < quadPossiblePairs.size(); i++)
     {
-        Math::Vec2F rndScreenPos(Math::Random::Range(1.f, 7.f),
-                                 Math::Random::Range(-1.f, -5.f));
+        EXPECT_EQ(quadPossiblePairs[i].ColliderA, possiblePairs[i].ColliderA);
+        EXPECT_EQ(quadPossiblePairs[i].ColliderB, possiblePairs[i].ColliderB);
+    }
+}
 
-        Math::Vec2F rndVelocity(Math::Random::Range(-2.f, 2.f),
-                                Math::Random::Range(-2.f, 2.f));
+TEST_P(ColliderNumberFixture, CopyIsIndependent)
+{
+    auto quadTree = std::make_unique<QuadTree>();
+    quadTree->Init();
 
-        // Body.
-        BodyRef bodyRef = world.CreateBody();
-        auto& body = world.GetBody(bodyRef);
-        body = PhysicsEngine::Body(rndScreenPos, rndVelocity, 1.f);
+    ExpectedNode expectedRoot;
 
-        // Collider.
-        ColliderRef colRef = world.CreateCollider(bodyRef);
-        auto& collider = world.GetCollider(colRef);
-        collider.SetIsTrigger(true);
-        collider.SetShape(Math::CircleF(Math::Vec2F::Zero(),
-                                        Math::Random::Range(0.1f, 0.15f)));
+    CreateRandomColliders(*quadTree, expectedRoot, GetParam());
+    quadTree->CalculatePossiblePairs();
 
-        colliders.push_back(collider);
-    }
+    QuadTree copy;
+    copy.Init();
+    copy = *quadTree;
+
+    const std::vector<ColliderPair> expectedPairs(quadTree->PossiblePairs().begin(),
+                                                  quadTree->PossiblePairs().end());
 
-    for (std::size_t i = 0; i < colliders.size(); i++)
+    // The copy must not depend on the source anymore.
+    quadTree.reset();
+
+    CheckRecursive(copy, copy.RootNode(), expectedRoot);
+
+    copy.CalculatePossiblePairs();
+
+    ASSERT_EQ(copy.PossiblePairs().size(), expectedPairs.size());
+
+    for (std::size_t i = 0; i < expectedPairs.size(); i++)
     {
-        ColliderRef colliderRef = {i, 0};
-        const auto& col = world.GetCollider(colliderRef);
+        EXPECT_EQ(copy.PossiblePairs()[i].ColliderA, expectedPairs[i].ColliderA);
+        EXPECT_EQ(copy.PossiblePairs()[i].ColliderB, expectedPairs[i].ColliderB);
+    }
+}
 
-        const auto colShape = col.Shape();
+TEST(QuadTree, TouchingRectanglesArePairs)
+{
+    QuadTree quadTree;
+    quadTree.Init();
+    quadTree.SetRootNodeBoundary(RectangleF(Vec2F(0.f, 0.f), Vec2F(8.f, 1.f)));
 
-        const auto circle = std::get<Math::CircleF>(colShape);
-        const auto radius = circle.Radius();
-        const auto simplifiedCircle = Math::RectangleF::FromCenter(
-                world.GetBody(col.GetBodyRef()).Position(),
-                Math::Vec2F(radius, radius));
+    // A row of boxes which only touch their neighbours, the first one covers the whole row.
+    quadTree.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(8.f, 1.f)), ColliderRef{0, 0});
 
-        quadTree.Insert(simplifiedCircle, colliderRef);
+    for (std::size_t i = 1; i < QuadNode::MaxColliderNbr; i++)
+    {
+        quadTree.Insert(RectangleF(Vec2F(static_cast<float>(i), 0.f), Vec2F(static_cast<float>(i + 1), 1.f)),
+                        ColliderRef{i, 0});
     }
 
     quadTree.CalculatePossiblePairs();
-    CalculatePairsInNode(possiblePairs, quadTree.RootNode());
 
-    const auto& quadPossiblePairs = quadTree.PossiblePairs();
+    // The first box touches all the others and each other box touches the next one.
+    const auto boxCount = QuadNode::MaxColliderNbr;
+    ASSERT_EQ(quadTree.PossiblePairs().size(), (boxCount - 1) + (boxCount - 2));
 
-    for (std::size_t  i = 0; i < quadPossiblePairs.size(); i++)
+    for (std::size_t i = 1; i < boxCount; i++)
     {
-        EXPECT_EQ(quadPossiblePairs[i], possiblePairs[i]);
+        EXPECT_EQ(quadTree.PossiblePairs()[i - 1].ColliderA, (ColliderRef{0, 0}));
+        EXPECT_EQ(quadTree.PossiblePairs()[i - 1].ColliderB, (ColliderRef{i, 0}));
     }
-}
\ No newline at end of file
+}
+
+TEST(QuadTree, Clear)
+{
+    QuadTree quadTree;
+    quadTree.Init();
+
+    ExpectedNode expectedRoot;
+
+    CreateRandomColliders(quadTree, expectedRoot, 100);
+    quadTree.CalculatePossiblePairs();
+
+    quadTree.Clear();
+
+    EXPECT_EQ(quadTree.NodeCount(), 1);
+    EXPECT_FALSE(quadTree.RootNode().HasChildren());
+    EXPECT_EQ(quadTree.PossiblePairs().size(), 0);
+
+    quadTree.CalculatePossiblePairs();
+
+    EXPECT_EQ(quadTree.RootNode().SubTreeColliderCount, 0);
+}
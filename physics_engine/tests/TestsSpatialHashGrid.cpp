@@ -0,0 +1,158 @@
+#include "QuadTree.h"
+#include "SpatialHashGrid.h"
+
+#include "gtest/gtest.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+struct ColliderNumberFixture : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(SpatialHashGrid, ColliderNumberFixture, testing::Values(0, 1, 10, 100, 321, 1000));
+
+std::vector<ColliderPair> SortedPairs(const std::vector<ColliderPair>& pairs)
+{
+    std::vector<ColliderPair> sortedPairs;
+
+    for (const auto& pair : pairs)
+    {
+        sortedPairs.push_back(pair.ColliderB < pair.ColliderA ? ColliderPair{ pair.ColliderB, pair.ColliderA } : pair);
+    }
+
+    std::sort(sortedPairs.begin(), sortedPairs.end());
+
+    return sortedPairs;
+}
+
+void ExpectSamePairs(const SpatialHashGrid& grid, const std::vector<SimplifiedCollider>& colliders)
+{
+    std::vector<ColliderPair> expectedPairs;
+
+    for (std::size_t i = 0; i < colliders.size(); i++)
+    {
+        for (std::size_t j = i + 1; j < colliders.size(); j++)
+        {
+            if (Intersect(colliders[i].Rectangle, colliders[j].Rectangle))
+            {
+                expectedPairs.push_back(ColliderPair{ colliders[i].ColRef, colliders[j].ColRef });
+            }
+        }
+    }
+
+    expectedPairs = SortedPairs(expectedPairs);
+
+    // The sorted pairs are compared one by one, so a pair emitted twice would be detected.
+    const auto gridPairs = SortedPairs(std::vector<ColliderPair>(grid.PossiblePairs().begin(),
+                                                                 grid.PossiblePairs().end()));
+
+    ASSERT_EQ(gridPairs.size(), expectedPairs.size());
+
+    for (std::size_t i = 0; i < gridPairs.size(); i++)
+    {
+        EXPECT_EQ(gridPairs[i].ColliderA, expectedPairs[i].ColliderA);
+        EXPECT_EQ(gridPairs[i].ColliderB, expectedPairs[i].ColliderB);
+    }
+}
+
+TEST(SpatialHashGrid, Init)
+{
+    SpatialHashGrid grid{ TestHeapAllocator };
+    grid.Init(100, 0.5f);
+
+    EXPECT_FLOAT_EQ(grid.CellSize(), 0.5f);
+    EXPECT_GE(grid.BucketCount(), 200);
+    EXPECT_EQ(grid.EntryCount(), 0);
+}
+
+TEST_P(ColliderNumberFixture, MatchesBruteForce)
+{
+    const auto colNbr = static_cast<std::size_t>(GetParam());
+
+    SpatialHashGrid grid{ TestHeapAllocator };
+    grid.Init(colNbr);
+
+    std::vector<SimplifiedCollider> colliders;
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        // Some colliders are on the negative side of the world to test the negative cells.
+        const Vec2F center(Random::Range(-2.f, 12.8f), Random::Range(-2.f, 7.2f));
+        const auto radius = Random::Range(0.125f, 0.26f);
+
+        colliders.push_back(SimplifiedCollider{ ColliderRef{i, 0},
+                                                RectangleF::FromCenter(center, Vec2F(radius, radius)) });
+    }
+
+    for (const auto& col : colliders)
+    {
+        grid.Insert(col.Rectangle, col.ColRef);
+    }
+
+    grid.CalculatePossiblePairs();
+
+    ExpectSamePairs(grid, colliders);
+}
+
+TEST(SpatialHashGrid, LargeWallsAreInsertedInEachCell)
+{
+    SpatialHashGrid grid{ TestHeapAllocator };
+    grid.Init(10, 1.f);
+
+    std::vector<SimplifiedCollider> colliders = {
+        // Two walls crossing each other on several cells.
+        SimplifiedCollider{ ColliderRef{0, 0}, RectangleF(Vec2F(0.f, 0.f), Vec2F(12.8f, 0.5f)) },
+        SimplifiedCollider{ ColliderRef{1, 0}, RectangleF(Vec2F(0.f, 0.f), Vec2F(0.5f, 7.2f)) },
+        // A ball touching the first wall in its middle and a ball far from the walls.
+        SimplifiedCollider{ ColliderRef{2, 0}, RectangleF::FromCenter(Vec2F(6.4f, 0.6f), Vec2F(0.2f, 0.2f)) },
+        SimplifiedCollider{ ColliderRef{3, 0}, RectangleF::FromCenter(Vec2F(6.4f, 3.6f), Vec2F(0.2f, 0.2f)) },
+    };
+
+    for (const auto& col : colliders)
+    {
+        grid.Insert(col.Rectangle, col.ColRef);
+    }
+
+    grid.CalculatePossiblePairs();
+
+    // 13 cells for the first wall, 8 cells for the second one and 1 cell for each ball.
+    EXPECT_EQ(grid.EntryCount(), 13 + 8 + 1 + 1);
+    ExpectSamePairs(grid, colliders);
+}
+
+TEST(SpatialHashGrid, PairSpanningSeveralCellsIsEmittedOnce)
+{
+    SpatialHashGrid grid{ TestHeapAllocator };
+    grid.Init(2, 1.f);
+
+    // The two boxes share four cells.
+    grid.Insert(RectangleF(Vec2F(0.5f, 0.5f), Vec2F(2.5f, 2.5f)), ColliderRef{0, 0});
+    grid.Insert(RectangleF(Vec2F(0.2f, 0.2f), Vec2F(1.8f, 1.8f)), ColliderRef{1, 0});
+
+    grid.CalculatePossiblePairs();
+
+    EXPECT_EQ(grid.PossiblePairs().size(), 1);
+}
+
+TEST(SpatialHashGrid, Clear)
+{
+    SpatialHashGrid grid{ TestHeapAllocator };
+    grid.Init(2, 1.f);
+
+    grid.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(1.f, 1.f)), ColliderRef{0, 0});
+    grid.Insert(RectangleF(Vec2F(0.5f, 0.5f), Vec2F(1.5f, 1.5f)), ColliderRef{1, 0});
+    grid.CalculatePossiblePairs();
+
+    EXPECT_EQ(grid.PossiblePairs().size(), 1);
+
+    grid.Clear();
+    grid.CalculatePossiblePairs();
+
+    EXPECT_EQ(grid.PossiblePairs().size(), 0);
+    EXPECT_EQ(grid.EntryCount(), 0);
+}
@@ -0,0 +1,125 @@
+#include "QuadTree.h"
+#include "StaticAabbTree.h"
+
+#include "gtest/gtest.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+struct ColliderNumberFixture : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(StaticAabbTree, ColliderNumberFixture, testing::Values(0, 1, 4, 5, 10, 100, 321));
+
+TEST(StaticAabbTree, EmptyTreeHasNoNode)
+{
+    StaticAabbTree tree{ TestHeapAllocator };
+    tree.Build();
+
+    EXPECT_EQ(tree.ColliderCount(), 0);
+    EXPECT_EQ(tree.NodeCount(), 0);
+
+    AllocVector<ColliderPair> pairs{ StandardAllocator<ColliderPair>{TestHeapAllocator} };
+    tree.Query(RectangleF(Vec2F(0.f, 0.f), Vec2F(1.f, 1.f)), ColliderRef{0, 0}, CollisionFilter{}, pairs);
+
+    EXPECT_TRUE(pairs.empty());
+}
+
+TEST_P(ColliderNumberFixture, QueryMatchesBruteForce)
+{
+    StaticAabbTree tree{ TestHeapAllocator };
+
+    std::vector<SimplifiedCollider> staticColliders;
+
+    // The static colliders have the indices above the moving ones, and are inserted in reverse order.
+    for (int i = GetParam() - 1; i >= 0; i--)
+    {
+        const Vec2F center(Random::Range(0.f, 12.8f), Random::Range(0.f, 7.2f));
+        const Vec2F halfSize(Random::Range(0.1f, 1.5f), Random::Range(0.1f, 0.3f));
+
+        staticColliders.push_back(SimplifiedCollider{ ColliderRef{static_cast<std::size_t>(100 + i), 0},
+                                                      RectangleF::FromCenter(center, halfSize) });
+    }
+
+    for (const auto& col : staticColliders)
+    {
+        tree.Insert(col.Rectangle, col.ColRef);
+    }
+
+    tree.Build();
+
+    EXPECT_EQ(tree.ColliderCount(), GetParam());
+    EXPECT_LE(tree.NodeCount(), GetParam());
+
+    AllocVector<ColliderPair> pairs{ StandardAllocator<ColliderPair>{TestHeapAllocator} };
+
+    for (std::size_t i = 0; i < 50; i++)
+    {
+        const ColliderRef colRef{ i, 0 };
+        const auto rectangle = RectangleF::FromCenter(Vec2F(Random::Range(0.f, 12.8f), Random::Range(0.f, 7.2f)),
+                                                      Vec2F(0.25f, 0.25f));
+
+        pairs.clear();
+        tree.Query(rectangle, colRef, CollisionFilter{}, pairs);
+
+        std::vector<std::size_t> expectedIndices;
+
+        for (const auto& col : staticColliders)
+        {
+            if (Intersect(rectangle, col.Rectangle))
+            {
+                expectedIndices.push_back(col.ColRef.Index);
+            }
+        }
+
+        std::vector<std::size_t> foundIndices;
+
+        for (const auto& pair : pairs)
+        {
+            // The moving collider has the lowest index.
+            EXPECT_EQ(pair.ColliderA, colRef);
+            foundIndices.push_back(pair.ColliderB.Index);
+        }
+
+        std::sort(expectedIndices.begin(), expectedIndices.end());
+        std::sort(foundIndices.begin(), foundIndices.end());
+
+        EXPECT_EQ(foundIndices, expectedIndices);
+    }
+}
+
+TEST(StaticAabbTree, QueryRejectsFilteredColliders)
+{
+    StaticAabbTree tree{ TestHeapAllocator };
+
+    tree.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(12.8f, 0.5f)), ColliderRef{0, 0}, CollisionFilter{ 0b01 });
+    tree.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(0.5f, 7.2f)), ColliderRef{1, 0}, CollisionFilter{ 0b10 });
+    tree.Build();
+
+    AllocVector<ColliderPair> pairs{ StandardAllocator<ColliderPair>{TestHeapAllocator} };
+
+    // A ball in the corner touches both walls, but it can only touch the first category.
+    tree.Query(RectangleF::FromCenter(Vec2F(0.3f, 0.3f), Vec2F(0.2f, 0.2f)), ColliderRef{2, 0},
+               CollisionFilter{ 0b01, 0b01 }, pairs);
+
+    ASSERT_EQ(pairs.size(), 1);
+    EXPECT_EQ(pairs[0].ColliderA, (ColliderRef{0, 0}));
+    EXPECT_EQ(pairs[0].ColliderB, (ColliderRef{2, 0}));
+}
+
+TEST(StaticAabbTree, Clear)
+{
+    StaticAabbTree tree{ TestHeapAllocator };
+
+    tree.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(1.f, 1.f)), ColliderRef{0, 0});
+    tree.Build();
+    tree.Clear();
+
+    EXPECT_EQ(tree.ColliderCount(), 0);
+    EXPECT_EQ(tree.NodeCount(), 0);
+}
@@ -0,0 +1,253 @@
+#include "QuadTree.h"
+#include "SweepAndPrune.h"
+
+#include "gtest/gtest.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+struct ColliderNumberFixture : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(SweepAndPrune, ColliderNumberFixture, testing::Values(0, 1, 10, 100, 321, 1000));
+
+/**
+ * @brief SortedPairs is a function that orders each pair and the pairs between them to compare sets of pairs.
+ */
+std::vector<ColliderPair> SortedPairs(const std::vector<ColliderPair>& pairs)
+{
+    std::vector<ColliderPair> sortedPairs;
+
+    for (const auto& pair : pairs)
+    {
+        sortedPairs.push_back(pair.ColliderB < pair.ColliderA ? ColliderPair{ pair.ColliderB, pair.ColliderA } : pair);
+    }
+
+    std::sort(sortedPairs.begin(), sortedPairs.end());
+
+    return sortedPairs;
+}
+
+std::vector<ColliderPair> BruteForcePairs(const std::vector<SimplifiedCollider>& colliders)
+{
+    std::vector<ColliderPair> pairs;
+
+    for (std::size_t i = 0; i < colliders.size(); i++)
+    {
+        for (std::size_t j = i + 1; j < colliders.size(); j++)
+        {
+            if (Intersect(colliders[i].Rectangle, colliders[j].Rectangle))
+            {
+                pairs.push_back(ColliderPair{ colliders[i].ColRef, colliders[j].ColRef });
+            }
+        }
+    }
+
+    return SortedPairs(pairs);
+}
+
+void ExpectSamePairs(const SweepAndPrune& sweepAndPrune, const std::vector<SimplifiedCollider>& colliders)
+{
+    const std::vector<ColliderPair> pairs(sweepAndPrune.PossiblePairs().begin(), sweepAndPrune.PossiblePairs().end());
+    const auto sapPairs = SortedPairs(pairs);
+    const auto expectedPairs = BruteForcePairs(colliders);
+
+    ASSERT_EQ(sapPairs.size(), expectedPairs.size());
+
+    for (std::size_t i = 0; i < sapPairs.size(); i++)
+    {
+        EXPECT_EQ(sapPairs[i].ColliderA, expectedPairs[i].ColliderA);
+        EXPECT_EQ(sapPairs[i].ColliderB, expectedPairs[i].ColliderB);
+    }
+}
+
+TEST(SweepAndPrune, Init)
+{
+    SweepAndPrune sweepAndPrune{ TestHeapAllocator };
+    sweepAndPrune.Init(10);
+
+    EXPECT_EQ(sweepAndPrune.ProxyCount(), 0);
+    EXPECT_EQ(sweepAndPrune.PossiblePairs().size(), 0);
+}
+
+TEST(SweepAndPrune, TouchingBoundsOverlap)
+{
+    SweepAndPrune sweepAndPrune{ TestHeapAllocator };
+    sweepAndPrune.Init(2);
+
+    sweepAndPrune.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(1.f, 1.f)), ColliderRef{0, 0});
+    sweepAndPrune.Insert(RectangleF(Vec2F(1.f, 0.f), Vec2F(2.f, 1.f)), ColliderRef{1, 0});
+
+    sweepAndPrune.CalculatePossiblePairs();
+
+    EXPECT_EQ(sweepAndPrune.PossiblePairs().size(), 1);
+}
+
+TEST_P(ColliderNumberFixture, MatchesBruteForceWhileMoving)
+{
+    const auto colNbr = static_cast<std::size_t>(GetParam());
+
+    SweepAndPrune sweepAndPrune{ TestHeapAllocator };
+    sweepAndPrune.Init(colNbr);
+
+    std::vector<SimplifiedCollider> colliders;
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        const Vec2F center(Random::Range(0.f, 12.8f), Random::Range(0.f, 7.2f));
+        const auto radius = Random::Range(0.1f, 0.3f);
+
+        colliders.push_back(SimplifiedCollider{ ColliderRef{i, 0},
+                                                RectangleF::FromCenter(center, Vec2F(radius, radius)) });
+    }
+
+    for (int frame = 0; frame < 10; frame++)
+    {
+        for (const auto& collider : colliders)
+        {
+            sweepAndPrune.Insert(collider.Rectangle, collider.ColRef);
+        }
+
+        sweepAndPrune.CalculatePossiblePairs();
+
+        EXPECT_EQ(sweepAndPrune.ProxyCount(), colliders.size());
+        ExpectSamePairs(sweepAndPrune, colliders);
+
+        // Move the colliders a little, as bodies do between two frames.
+        for (auto& collider : colliders)
+        {
+            const Vec2F move(Random::Range(-0.05f, 0.05f), Random::Range(-0.05f, 0.05f));
+            collider.Rectangle = RectangleF(collider.Rectangle.MinBound() + move, collider.Rectangle.MaxBound() + move);
+        }
+    }
+}
+
+TEST_P(ColliderNumberFixture, RemovesCollidersNotInserted)
+{
+    const auto colNbr = static_cast<std::size_t>(GetParam());
+
+    SweepAndPrune sweepAndPrune{ TestHeapAllocator };
+    sweepAndPrune.Init(colNbr);
+
+    std::vector<SimplifiedCollider> colliders;
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        const Vec2F center(Random::Range(0.f, 6.f), Random::Range(0.f, 6.f));
+
+        colliders.push_back(SimplifiedCollider{ ColliderRef{i, 0},
+                                                RectangleF::FromCenter(center, Vec2F(0.2f, 0.2f)) });
+    }
+
+    for (const auto& collider : colliders)
+    {
+        sweepAndPrune.Insert(collider.Rectangle, collider.ColRef);
+    }
+
+    sweepAndPrune.CalculatePossiblePairs();
+
+    // Remove one collider out of two and replace the removed ones by a new generation of colliders.
+    std::vector<SimplifiedCollider> remainingColliders;
+
+    for (std::size_t i = 0; i < colliders.size(); i++)
+    {
+        if (i % 2 == 0)
+        {
+            remainingColliders.push_back(colliders[i]);
+        }
+        else if (i % 4 == 1)
+        {
+            auto newCollider = colliders[i];
+            newCollider.ColRef.GenerationIdx++;
+            remainingColliders.push_back(newCollider);
+        }
+    }
+
+    for (const auto& collider : remainingColliders)
+    {
+        sweepAndPrune.Insert(collider.Rectangle, collider.ColRef);
+    }
+
+    sweepAndPrune.CalculatePossiblePairs();
+
+    EXPECT_EQ(sweepAndPrune.ProxyCount(), remainingColliders.size());
+    ExpectSamePairs(sweepAndPrune, remainingColliders);
+}
+
+TEST(SweepAndPrune, OrderDoesNotDependOnHistory)
+{
+    std::vector<SimplifiedCollider> colliders;
+
+    for (std::size_t i = 0; i < 200; i++)
+    {
+        const Vec2F center(Random::Range(0.f, 4.f), Random::Range(0.f, 4.f));
+
+        colliders.push_back(SimplifiedCollider{ ColliderRef{i, 0},
+                                                RectangleF::FromCenter(center, Vec2F(0.2f, 0.2f)) });
+    }
+
+    // The first sweep-and-prune sees the colliders moving, the second one only sees their final position.
+    SweepAndPrune movingSap{ TestHeapAllocator };
+    movingSap.Init(colliders.size());
+
+    for (int frame = 0; frame < 5; frame++)
+    {
+        for (const auto& collider : colliders)
+        {
+            const Vec2F move(0.1f * static_cast<float>(5 - frame), 0.f);
+            movingSap.Insert(RectangleF(collider.Rectangle.MinBound() + move,
+                                        collider.Rectangle.MaxBound() + move), collider.ColRef);
+        }
+
+        movingSap.CalculatePossiblePairs();
+    }
+
+    for (const auto& collider : colliders)
+    {
+        movingSap.Insert(collider.Rectangle, collider.ColRef);
+    }
+
+    movingSap.CalculatePossiblePairs();
+
+    SweepAndPrune freshSap{ TestHeapAllocator };
+    freshSap.Init(colliders.size());
+
+    for (const auto& collider : colliders)
+    {
+        freshSap.Insert(collider.Rectangle, collider.ColRef);
+    }
+
+    freshSap.CalculatePossiblePairs();
+
+    ASSERT_EQ(movingSap.PossiblePairs().size(), freshSap.PossiblePairs().size());
+
+    for (std::size_t i = 0; i < freshSap.PossiblePairs().size(); i++)
+    {
+        EXPECT_EQ(movingSap.PossiblePairs()[i].ColliderA, freshSap.PossiblePairs()[i].ColliderA);
+        EXPECT_EQ(movingSap.PossiblePairs()[i].ColliderB, freshSap.PossiblePairs()[i].ColliderB);
+    }
+}
+
+TEST(SweepAndPrune, Clear)
+{
+    SweepAndPrune sweepAndPrune{ TestHeapAllocator };
+    sweepAndPrune.Init(2);
+
+    sweepAndPrune.Insert(RectangleF(Vec2F(0.f, 0.f), Vec2F(1.f, 1.f)), ColliderRef{0, 0});
+    sweepAndPrune.Insert(RectangleF(Vec2F(0.5f, 0.5f), Vec2F(2.f, 2.f)), ColliderRef{1, 0});
+    sweepAndPrune.CalculatePossiblePairs();
+
+    sweepAndPrune.Clear();
+
+    EXPECT_EQ(sweepAndPrune.ProxyCount(), 0);
+    EXPECT_EQ(sweepAndPrune.PossiblePairs().size(), 0);
+
+    sweepAndPrune.CalculatePossiblePairs();
+
+    EXPECT_EQ(sweepAndPrune.PossiblePairs().size(), 0);
+}
@@ -1,17 +1,51 @@
 #include "World.h"
+#include "WorldImpl.h"
 
 #include "gtest/gtest.h"
 #include "../../common/include/Metrics.h"
+#include "Random.h"
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <vector>
 
 using namespace PhysicsEngine;
 using namespace Math;
 
+/**
+ * @brief CircleWorldConfig is a world configuration which only tests the circles, with the quad tree and
+ * room for four bodies and colliders.
+ */
+struct CircleWorldConfig : DefaultWorldConfig
+{
+    static constexpr std::uint8_t BroadPhaseTypes = BroadPhaseTypeBit(BroadPhaseType::QuadTree);
+    static constexpr std::uint8_t ShapeTypes = ShapeTypeBit(ShapeType::Circle);
+    static constexpr std::size_t MaxBodyCount = 4;
+    static constexpr std::size_t MaxColliderCount = 4;
+};
+
+template class PhysicsEngine::BasicWorld<CircleWorldConfig>;
+
+/**
+ * @brief SnapshotWorldConfig is a world configuration whose state is stored in place, so that it is saved and
+ * restored with a memcpy.
+ */
+struct SnapshotWorldConfig : DefaultWorldConfig
+{
+    static constexpr std::size_t MaxBodyCount = 32;
+    static constexpr std::size_t MaxColliderCount = 32;
+    static constexpr std::size_t MaxContactCount = 64;
+};
+
+template class PhysicsEngine::BasicWorld<SnapshotWorldConfig>;
+
 struct IntFixture : public ::testing::TestWithParam<int>{};
 
 struct ArrayOfBody : public ::testing::TestWithParam<std::array<Body, 3>>{};
 
+struct BodyCountFixture : public ::testing::TestWithParam<int>{};
+
 class TestContactListener : public ContactListener
 {
 public:
@@ -223,6 +257,95 @@ TEST(World, CreateAndDestroyCircleCollider)
     EXPECT_THROW(nullCollider =  world.GetCollider(colRef2), std::runtime_error);
 }
 
+TEST(World, CreateBodyAfterEmptyInit)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 0);
+
+    auto bodyRef = world.CreateBody();
+    auto colRef = world.CreateCollider(bodyRef);
+
+    EXPECT_EQ(bodyRef.Index, 0);
+    EXPECT_EQ(colRef.Index, 0);
+    EXPECT_TRUE(world.GetBody(bodyRef).IsValid());
+    EXPECT_TRUE(world.GetCollider(colRef).Enabled());
+}
+
+TEST(World, DestroyedSlotsAreReusedFirst)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 4);
+
+    std::array<BodyRef, 4> bodyRefs{};
+
+    for (auto& bodyRef : bodyRefs)
+    {
+        bodyRef = world.CreateBody();
+    }
+
+    // The last destroyed slot is reused first.
+    world.DestroyBody(bodyRefs[1]);
+    world.DestroyBody(bodyRefs[3]);
+
+    // Destroying a body twice must not give its slot twice.
+    world.DestroyBody(bodyRefs[3]);
+
+    auto bodyRef = world.CreateBody();
+    EXPECT_EQ(bodyRef.Index, 3);
+    EXPECT_EQ(bodyRef.GenerationIdx, 1);
+
+    bodyRef = world.CreateBody();
+    EXPECT_EQ(bodyRef.Index, 1);
+    EXPECT_EQ(bodyRef.GenerationIdx, 1);
+
+    // No slot is free anymore, so the world grows.
+    bodyRef = world.CreateBody();
+    EXPECT_EQ(bodyRef.Index, 4);
+    EXPECT_EQ(bodyRef.GenerationIdx, 0);
+}
+
+TEST(World, CreateAndDestroyManyBodiesAndColliders)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 8);
+
+    std::vector<BodyRef> bodyRefs;
+    std::vector<ColliderRef> colRefs;
+
+    for (int frame = 0; frame < 50; frame++)
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            bodyRefs.push_back(world.CreateBody());
+            colRefs.push_back(world.CreateCollider(bodyRefs.back()));
+        }
+
+        // Destroy half of the bodies, like the projectiles hitting a wall.
+        for (int i = 0; i < 5; i++)
+        {
+            world.DestroyCollider(colRefs.front());
+            world.DestroyBody(bodyRefs.front());
+            colRefs.erase(colRefs.begin());
+            bodyRefs.erase(bodyRefs.begin());
+        }
+    }
+
+    std::vector<std::size_t> bodyIndices;
+
+    for (std::size_t i = 0; i < bodyRefs.size(); i++)
+    {
+        EXPECT_TRUE(world.GetBody(bodyRefs[i]).IsValid());
+        EXPECT_TRUE(world.GetCollider(colRefs[i]).Enabled());
+        EXPECT_EQ(world.GetCollider(colRefs[i]).GetBodyRef(), bodyRefs[i]);
+
+        bodyIndices.push_back(bodyRefs[i].Index);
+    }
+
+    // Two living bodies never share a slot.
+    std::sort(bodyIndices.begin(), bodyIndices.end());
+    EXPECT_EQ(std::adjacent_find(bodyIndices.begin(), bodyIndices.end()), bodyIndices.end());
+}
+
 TEST(World, UpdateCollisionDetectionCircle)
 {
     CircleF c1(Vec2F::Zero(), 0.5f);
@@ -587,4 +710,1074 @@ TEST(World, UpdateCollisionDetectionPolygonAndRect)
     EXPECT_FALSE(testContactListener.Enter);
     EXPECT_FALSE(testContactListener.Stay);
     EXPECT_TRUE(testContactListener.Exit);
-}
\ No newline at end of file
+}
+
+class TriggerEnterCounter : public ContactListener
+{
+public:
+    std::vector<ColliderPair> EnteredPairs;
+
+    void OnTriggerEnter(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override
+    {
+        EnteredPairs.push_back(ColliderPair{ colliderRefA, colliderRefB });
+    }
+
+    void OnTriggerStay(ColliderRef, ColliderRef) noexcept override {}
+    void OnTriggerExit(ColliderRef, ColliderRef) noexcept override {}
+    void OnCollisionEnter(ColliderRef, ColliderRef) noexcept override {}
+    void OnCollisionExit(ColliderRef, ColliderRef) noexcept override {}
+};
+
+TEST(World, UpdateCollisionDetectionMixedShapes)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 5);
+
+    TriggerEnterCounter listener;
+    world.SetContactListener(&listener);
+
+    const auto createTrigger = [&world](Vec2F position, Vec2F offset)
+    {
+        const auto bodyRef = world.CreateBody();
+        world.GetBody(bodyRef) = Body(position, Vec2F::Zero(), 1.f);
+
+        const auto colRef = world.CreateCollider(bodyRef);
+        world.GetCollider(colRef).SetIsTrigger(true);
+        world.GetCollider(colRef).SetOffset(offset);
+
+        return colRef;
+    };
+
+    // A circle, a rectangle and a polygon overlapping each other at the origin.
+    const auto circleRef = createTrigger(Vec2F::Zero(), Vec2F::Zero());
+    world.GetCollider(circleRef).SetShape(CircleF(Vec2F::Zero(), 0.5f));
+
+    const auto rectRef = createTrigger(Vec2F::Zero(), Vec2F::Zero());
+    world.GetCollider(rectRef).SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+
+    const auto polygonRef = createTrigger(Vec2F::Zero(), Vec2F::Zero());
+    world.GetCollider(polygonRef).SetShape(PolygonF({Vec2F(-0.3f, -0.3f), Vec2F(0.3f, -0.3f), Vec2F(0.f, 0.3f)}));
+
+    // A rectangle moved far from its body by its offset, which touches a circle far from the origin.
+    const auto offsetRectRef = createTrigger(Vec2F::Zero(), Vec2F(10.f, 0.f));
+    world.GetCollider(offsetRectRef).SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+
+    const auto farCircleRef = createTrigger(Vec2F(10.6f, 0.f), Vec2F::Zero());
+    world.GetCollider(farCircleRef).SetShape(CircleF(Vec2F::Zero(), 0.2f));
+
+    world.Update(0.1f);
+
+    const std::vector<ColliderPair> expectedPairs = {
+        ColliderPair{ circleRef, rectRef },
+        ColliderPair{ circleRef, polygonRef },
+        ColliderPair{ rectRef, polygonRef },
+        ColliderPair{ offsetRectRef, farCircleRef }
+    };
+
+    ASSERT_EQ(listener.EnteredPairs.size(), expectedPairs.size());
+
+    for (const auto& expectedPair : expectedPairs)
+    {
+        EXPECT_NE(std::find(listener.EnteredPairs.begin(), listener.EnteredPairs.end(), expectedPair),
+                  listener.EnteredPairs.end());
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(World, BodyCountFixture, testing::Values(1, 3, 4, 5, 17, 100));
+
+TEST_P(BodyCountFixture, UpdateMatchesSingleBodyIntegration)
+{
+    const auto bodyCount = GetParam();
+    constexpr float deltaTime = 0.02f;
+    const Vec2F gravity(0.f, -9.81f);
+
+    World world;
+    world.Init(gravity, bodyCount);
+
+    std::vector<BodyRef> bodyRefs;
+    std::vector<Body> expectedBodies;
+
+    for (int i = 0; i < bodyCount; i++)
+    {
+        const auto bodyRef = world.CreateBody();
+        auto& body = world.GetBody(bodyRef);
+
+        body = Body(Vec2F(Random::Range(-10.f, 10.f), Random::Range(-10.f, 10.f)),
+                    Vec2F(Random::Range(-5.f, 5.f), Random::Range(-5.f, 5.f)),
+                    Random::Range(0.5f, 5.f));
+        body.SetDamping(Random::Range(0.f, 2.f));
+
+        // Mix the body types so that the dynamic bodies are not contiguous.
+        body.SetBodyType(i % 5 == 3 ? BodyType::Kinematic : i % 7 == 6 ? BodyType::Static : BodyType::Dynamic);
+
+        body.ApplyForce(Vec2F(Random::Range(-3.f, 3.f), Random::Range(-3.f, 3.f)));
+        body.ApplyImpulse(Vec2F(Random::Range(-1.f, 1.f), Random::Range(-1.f, 1.f)));
+
+        bodyRefs.push_back(bodyRef);
+        expectedBodies.push_back(body);
+    }
+
+    for (auto& body : expectedBodies)
+    {
+        switch (body.GetBodyType())
+        {
+            case BodyType::Dynamic:
+            {
+                body.ApplyForce(gravity);
+
+                const Vec2F acceleration = body.Forces() * body.InverseMass();
+                body.SetVelocity(body.Velocity() + acceleration * deltaTime);
+                body.SetVelocity(body.Velocity() + body.Impulses());
+                body.SetPosition(body.Position() + body.Velocity() * deltaTime);
+                body.SetVelocity(body.Velocity() - body.Impulses());
+                body.SetVelocity(body.Velocity() * (1.0f - body.Damping() * deltaTime));
+                break;
+            }
+            case BodyType::Kinematic:
+                body.SetPosition(body.Position() + body.Velocity() * deltaTime);
+                break;
+            case BodyType::Static:
+            case BodyType::None:
+                break;
+        }
+    }
+
+    world.Update(deltaTime);
+
+    for (std::size_t i = 0; i < bodyRefs.size(); i++)
+    {
+        const auto& body = world.GetBody(bodyRefs[i]);
+        const auto& expectedBody = expectedBodies[i];
+
+        EXPECT_FLOAT_EQ(body.Position().X, expectedBody.Position().X);
+        EXPECT_FLOAT_EQ(body.Position().Y, expectedBody.Position().Y);
+        EXPECT_FLOAT_EQ(body.Velocity().X, expectedBody.Velocity().X);
+        EXPECT_FLOAT_EQ(body.Velocity().Y, expectedBody.Velocity().Y);
+
+        if (body.GetBodyType() == BodyType::Dynamic)
+        {
+            EXPECT_FLOAT_EQ(body.Forces().X, 0.f);
+            EXPECT_FLOAT_EQ(body.Forces().Y, 0.f);
+            EXPECT_FLOAT_EQ(body.Impulses().X, 0.f);
+            EXPECT_FLOAT_EQ(body.Impulses().Y, 0.f);
+        }
+    }
+}
+
+struct BroadPhaseFixture : public ::testing::TestWithParam<BroadPhaseType>{};
+
+INSTANTIATE_TEST_SUITE_P(World, BroadPhaseFixture, testing::Values(
+        BroadPhaseType::QuadTree,
+        BroadPhaseType::SweepAndPrune,
+        BroadPhaseType::AabbTree,
+        BroadPhaseType::SpatialHash
+        ));
+
+TEST_P(BroadPhaseFixture, UpdateCollisionDetection)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 2, GetParam());
+
+    EXPECT_EQ(world.GetBroadPhaseType(), GetParam());
+
+    TestContactListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+
+    auto colRef = world.CreateCollider(bodyRef);
+    auto& collider = world.GetCollider(colRef);
+    collider.SetIsTrigger(true);
+    collider.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+
+    auto bodyRef2 = world.CreateBody();
+    world.GetBody(bodyRef2) = Body(Vec2F(0.6f, 0.f), Vec2F::Zero(), 1);
+
+    auto colRef2 = world.CreateCollider(bodyRef2);
+    auto& collider2 = world.GetCollider(colRef2);
+    collider2.SetIsTrigger(true);
+    collider2.SetShape(RectangleF(Vec2F(-0.2f, -0.2f), Vec2F(0.2f, 0.2f)));
+
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Enter);
+
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Stay);
+
+    world.GetBody(bodyRef2).SetPosition(Math::Vec2F(10.f, 10.f));
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Exit);
+
+    world.GetBody(bodyRef2).SetPosition(Math::Vec2F(0.5f, 0.f));
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Enter);
+}
+
+/**
+ * @brief ContactRecorder is a contact listener that records all the events in the order they are received.
+ */
+class ContactRecorder : public ContactListener
+{
+public:
+    std::vector<std::pair<int, ColliderPair>> Events;
+
+    void OnTriggerEnter(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override
+    {
+        Events.emplace_back(0, ColliderPair{ colliderRefA, colliderRefB });
+    }
+
+    void OnTriggerStay(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override
+    {
+        Events.emplace_back(1, ColliderPair{ colliderRefA, colliderRefB });
+    }
+
+    void OnTriggerExit(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override
+    {
+        Events.emplace_back(2, ColliderPair{ colliderRefA, colliderRefB });
+    }
+
+    void OnCollisionEnter(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override
+    {
+        Events.emplace_back(3, ColliderPair{ colliderRefA, colliderRefB });
+    }
+
+    void OnCollisionExit(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override
+    {
+        Events.emplace_back(4, ColliderPair{ colliderRefA, colliderRefB });
+    }
+};
+
+struct ThreadCountFixture : public ::testing::TestWithParam<int>{};
+
+INSTANTIATE_TEST_SUITE_P(World, ThreadCountFixture, testing::Values(
+        2, 3, 8
+        ));
+
+TEST_P(ThreadCountFixture, UpdateDoesNotDependOnThreadCount)
+{
+    constexpr int bodyCount = 1000;
+    constexpr int frameCount = 30;
+
+    World serialWorld;
+    serialWorld.Init(Vec2F(0.f, -1.f), bodyCount, BroadPhaseType::SpatialHash);
+
+    World parallelWorld;
+    parallelWorld.Init(Vec2F(0.f, -1.f), bodyCount, BroadPhaseType::SpatialHash, GetParam());
+
+    EXPECT_EQ(serialWorld.GetThreadCount(), 1);
+    EXPECT_EQ(parallelWorld.GetThreadCount(), GetParam());
+
+    ContactRecorder serialRecorder;
+    serialWorld.SetContactListener(&serialRecorder);
+
+    ContactRecorder parallelRecorder;
+    parallelWorld.SetContactListener(&parallelRecorder);
+
+    std::vector<BodyRef> bodyRefs;
+
+    for (int i = 0; i < bodyCount; i++)
+    {
+        // A dense crowd of circles, rectangles and triangles, one out of three is a trigger.
+        const Vec2F position(Random::Range(0.f, 12.f), Random::Range(0.f, 7.f));
+        const Vec2F velocity(Random::Range(-1.f, 1.f), Random::Range(-1.f, 1.f));
+
+        for (auto* world : { &serialWorld, &parallelWorld })
+        {
+            const auto bodyRef = world->CreateBody();
+            world->GetBody(bodyRef) = Body(position, velocity, 1.f);
+
+            auto& collider = world->GetCollider(world->CreateCollider(bodyRef));
+            collider.SetIsTrigger(i % 3 == 0);
+
+            switch (i % 3)
+            {
+                case 0:
+                    collider.SetShape(CircleF(Vec2F::Zero(), 0.2f));
+                    break;
+                case 1:
+                    collider.SetShape(RectangleF(Vec2F(-0.2f, -0.2f), Vec2F(0.2f, 0.2f)));
+                    break;
+                default:
+                    collider.SetShape(PolygonF({ Vec2F(-0.2f, -0.2f), Vec2F(0.2f, -0.2f), Vec2F(0.f, 0.2f) }));
+                    break;
+            }
+
+            if (world == &serialWorld)
+            {
+                bodyRefs.push_back(bodyRef);
+            }
+        }
+    }
+
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+        serialWorld.Update(0.02f);
+        parallelWorld.Update(0.02f);
+    }
+
+    ASSERT_FALSE(serialRecorder.Events.empty());
+    ASSERT_EQ(serialRecorder.Events.size(), parallelRecorder.Events.size());
+
+    for (std::size_t i = 0; i < serialRecorder.Events.size(); i++)
+    {
+        EXPECT_EQ(serialRecorder.Events[i].first, parallelRecorder.Events[i].first);
+        EXPECT_EQ(serialRecorder.Events[i].second, parallelRecorder.Events[i].second);
+    }
+
+    // The bodies must be bit-identical, not only close.
+    for (const auto& bodyRef : bodyRefs)
+    {
+        const auto& serialBody = serialWorld.GetBody(bodyRef);
+        const auto& parallelBody = parallelWorld.GetBody(bodyRef);
+
+        EXPECT_EQ(serialBody.Position().X, parallelBody.Position().X);
+        EXPECT_EQ(serialBody.Position().Y, parallelBody.Position().Y);
+        EXPECT_EQ(serialBody.Velocity().X, parallelBody.Velocity().X);
+        EXPECT_EQ(serialBody.Velocity().Y, parallelBody.Velocity().Y);
+    }
+}
+
+TEST(World, BodyAtRestFallsAsleep)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 2);
+
+    const auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef).SetVelocity(Vec2F(1.f, 0.f));
+    world.GetBody(bodyRef).SetDamping(10.f);
+
+    EXPECT_TRUE(world.IsSleepingEnabled());
+    EXPECT_EQ(world.GetAwakeBodyCount(), 1);
+
+    for (int frame = 0; frame < 200; frame++)
+    {
+        world.Update(0.02f);
+    }
+
+    const auto& body = world.GetBody(bodyRef);
+
+    EXPECT_FALSE(body.IsAwake());
+    EXPECT_EQ(world.GetAwakeBodyCount(), 0);
+    EXPECT_EQ(body.Velocity(), Vec2F::Zero());
+
+    // A sleeping body is not moved, even by the gravity.
+    const auto position = body.Position();
+    world.SetGravity(Vec2F(0.f, -10.f));
+    world.Update(0.02f);
+
+    EXPECT_EQ(world.GetBody(bodyRef).Position(), position);
+}
+
+TEST(World, SleepingBodyWakesUpOnForceAndVelocity)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 2);
+
+    const auto bodyRef = world.CreateBody();
+
+    for (int frame = 0; frame < 30; frame++)
+    {
+        world.Update(0.02f);
+    }
+
+    ASSERT_FALSE(world.GetBody(bodyRef).IsAwake());
+
+    world.GetBody(bodyRef).ApplyForce(Vec2F(10.f, 0.f));
+
+    EXPECT_TRUE(world.GetBody(bodyRef).IsAwake());
+    EXPECT_FLOAT_EQ(world.GetBody(bodyRef).SleepTime(), 0.f);
+
+    world.Update(0.02f);
+
+    EXPECT_TRUE(world.GetBody(bodyRef).IsAwake());
+    EXPECT_GT(world.GetBody(bodyRef).Position().X, 0.f);
+
+    world.GetBody(bodyRef).SetAwake(false);
+
+    EXPECT_EQ(world.GetBody(bodyRef).Velocity(), Vec2F::Zero());
+
+    world.GetBody(bodyRef).SetVelocity(Vec2F(0.f, 1.f));
+
+    EXPECT_TRUE(world.GetBody(bodyRef).IsAwake());
+}
+
+TEST(World, SleepingIslandWakesUpOnContact)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 4);
+
+    TestContactListener listener;
+    world.SetContactListener(&listener);
+
+    // Two touching boxes form an island, a third one is launched at them.
+    std::array<BodyRef, 3> bodyRefs{};
+    const std::array<Vec2F, 3> positions = { Vec2F(0.f, 0.f), Vec2F(0.99f, 0.f), Vec2F(-3.f, 0.f) };
+
+    for (std::size_t i = 0; i < bodyRefs.size(); i++)
+    {
+        bodyRefs[i] = world.CreateBody();
+        world.GetBody(bodyRefs[i]).SetPosition(positions[i]);
+
+        const auto colRef = world.CreateCollider(bodyRefs[i]);
+        world.GetCollider(colRef).SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+        world.GetCollider(colRef).SetRestitution(0.f);
+    }
+
+    world.GetBody(bodyRefs[2]).SetAwake(false);
+
+    for (int frame = 0; frame < 40; frame++)
+    {
+        world.Update(0.02f);
+    }
+
+    ASSERT_FALSE(world.GetBody(bodyRefs[0]).IsAwake());
+    ASSERT_FALSE(world.GetBody(bodyRefs[1]).IsAwake());
+
+    world.GetBody(bodyRefs[2]).SetVelocity(Vec2F(10.f, 0.f));
+
+    for (int frame = 0; frame < 15; frame++)
+    {
+        world.Update(0.02f);
+    }
+
+    // The hit box wakes its whole island up.
+    EXPECT_TRUE(world.GetBody(bodyRefs[0]).IsAwake());
+    EXPECT_TRUE(world.GetBody(bodyRefs[1]).IsAwake());
+}
+
+TEST(World, SleepingContactsStayWithoutBeingTested)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 2);
+
+    ContactRecorder recorder;
+    world.SetContactListener(&recorder);
+
+    for (const auto& position : { Vec2F::Zero(), Vec2F(0.3f, 0.f) })
+    {
+        const auto bodyRef = world.CreateBody();
+        world.GetBody(bodyRef).SetPosition(position);
+
+        const auto colRef = world.CreateCollider(bodyRef);
+        world.GetCollider(colRef).SetShape(CircleF(Vec2F::Zero(), 0.2f));
+        world.GetCollider(colRef).SetIsTrigger(true);
+    }
+
+    for (int frame = 0; frame < 40; frame++)
+    {
+        world.Update(0.02f);
+    }
+
+    EXPECT_EQ(world.GetAwakeBodyCount(), 0);
+
+    // The trigger enters once and then only stays, it never exits while its bodies sleep.
+    ASSERT_EQ(recorder.Events.size(), 40);
+    EXPECT_EQ(recorder.Events.front().first, 0);
+
+    for (std::size_t i = 1; i < recorder.Events.size(); i++)
+    {
+        EXPECT_EQ(recorder.Events[i].first, 1);
+    }
+}
+
+TEST(World, SleepingIsDisabled)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 2);
+
+    const auto bodyRef = world.CreateBody();
+
+    for (int frame = 0; frame < 30; frame++)
+    {
+        world.Update(0.02f);
+    }
+
+    ASSERT_FALSE(world.GetBody(bodyRef).IsAwake());
+
+    world.SetSleepingEnabled(false);
+
+    EXPECT_TRUE(world.GetBody(bodyRef).IsAwake());
+
+    for (int frame = 0; frame < 30; frame++)
+    {
+        world.Update(0.02f);
+    }
+
+    EXPECT_TRUE(world.GetBody(bodyRef).IsAwake());
+}
+
+TEST(World, BulletDoesNotGoThroughThinWall)
+{
+    for (const bool isBullet : { true, false })
+    {
+        World world;
+        world.Init(Vec2F::Zero(), 2);
+
+        ContactRecorder recorder;
+        world.SetContactListener(&recorder);
+
+        const auto wallRef = world.CreateBody();
+        world.GetBody(wallRef).SetBodyType(BodyType::Static);
+        world.GetBody(wallRef).SetPosition(Vec2F(1.f, 0.f));
+        const auto wallColRef = world.CreateCollider(wallRef);
+        world.GetCollider(wallColRef).SetShape(RectangleF(Vec2F(-0.25f, -1.f), Vec2F(0.25f, 1.f)));
+
+        const auto bulletRef = world.CreateBody();
+        world.GetBody(bulletRef).SetBodyType(BodyType::Kinematic);
+        world.GetBody(bulletRef).SetVelocity(Vec2F(100.f, 0.f));
+        const auto bulletColRef = world.CreateCollider(bulletRef);
+        world.GetCollider(bulletColRef).SetShape(CircleF(Vec2F::Zero(), 0.125f));
+        world.GetCollider(bulletColRef).SetIsBullet(isBullet);
+
+        world.Update(0.02f);
+
+        const auto& position = world.GetBody(bulletRef).Position();
+
+        if (isBullet)
+        {
+            // The bullet stops against the wall instead of jumping 2 meters over it.
+            EXPECT_GT(position.X, 0.625f);
+            EXPECT_LT(position.X, 0.63f);
+            ASSERT_EQ(recorder.Events.size(), 1);
+            EXPECT_EQ(recorder.Events.front().first, 3);
+        }
+        else
+        {
+            EXPECT_NEAR(position.X, 2.f, 0.0001f);
+            EXPECT_TRUE(recorder.Events.empty());
+        }
+    }
+}
+
+TEST_P(BroadPhaseFixture, FilteredPairsAreRejected)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 3, GetParam());
+
+    ContactRecorder recorder;
+    world.SetContactListener(&recorder);
+
+    std::array<ColliderRef, 3> colRefs{};
+
+    for (auto& colRef : colRefs)
+    {
+        const auto bodyRef = world.CreateBody();
+        colRef = world.CreateCollider(bodyRef);
+        world.GetCollider(colRef).SetShape(CircleF(Vec2F::Zero(), 0.5f));
+        world.GetCollider(colRef).SetIsTrigger(true);
+    }
+
+    // The collider 1 is in the layer 1, the collider 2 is in the layer 0 but cannot touch it.
+    world.GetCollider(colRefs[1]).SetCategoryBits(1u << 1);
+    world.GetCollider(colRefs[2]).SetMaskBits(~1u);
+    world.SetLayersCollide(0, 1, false);
+
+    EXPECT_FALSE(world.GetCollisionMatrix().LayersCollide(1, 0));
+
+    world.Update(0.1f);
+
+    EXPECT_TRUE(recorder.Events.empty());
+
+    world.SetLayersCollide(0, 1, true);
+    world.Update(0.1f);
+
+    ASSERT_EQ(recorder.Events.size(), 2);
+
+    for (const auto& [event, pair] : recorder.Events)
+    {
+        EXPECT_EQ(event, 0);
+        EXPECT_TRUE(pair.ColliderA == colRefs[1] || pair.ColliderB == colRefs[1]);
+    }
+}
+
+TEST_P(BroadPhaseFixture, StaticPairsAreNeverGenerated)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 3, GetParam());
+
+    ContactRecorder recorder;
+    world.SetContactListener(&recorder);
+
+    std::array<BodyRef, 3> bodyRefs{};
+    std::array<ColliderRef, 3> colRefs{};
+
+    // Two overlapping static triggers and a dynamic trigger touching both.
+    for (std::size_t i = 0; i < bodyRefs.size(); i++)
+    {
+        bodyRefs[i] = world.CreateBody();
+        world.GetBody(bodyRefs[i]).SetBodyType(i < 2 ? BodyType::Static : BodyType::Dynamic);
+        world.GetBody(bodyRefs[i]).SetPosition(Vec2F(0.25f * static_cast<float>(i), 0.f));
+
+        colRefs[i] = world.CreateCollider(bodyRefs[i]);
+        world.GetCollider(colRefs[i]).SetShape(CircleF(Vec2F::Zero(), 0.5f));
+        world.GetCollider(colRefs[i]).SetIsTrigger(true);
+    }
+
+    world.Update(0.1f);
+
+    EXPECT_EQ(world.GetStaticColliderCount(), 2);
+    ASSERT_EQ(recorder.Events.size(), 2);
+
+    for (const auto& [event, pair] : recorder.Events)
+    {
+        EXPECT_EQ(event, 0);
+        EXPECT_TRUE(pair.ColliderA == colRefs[2] || pair.ColliderB == colRefs[2]);
+    }
+
+    // Moving a static body away is found without telling the world.
+    recorder.Events.clear();
+    world.GetBody(bodyRefs[0]).SetPosition(Vec2F(10.f, 0.f));
+    world.Update(0.1f);
+
+    ASSERT_EQ(recorder.Events.size(), 2);
+    EXPECT_EQ(recorder.Events[0].first, 1);
+    EXPECT_EQ(recorder.Events[1].first, 2);
+
+    // A static body becoming dynamic leaves the static colliders.
+    recorder.Events.clear();
+    world.GetBody(bodyRefs[0]).SetBodyType(BodyType::Dynamic);
+    world.GetBody(bodyRefs[0]).SetPosition(Vec2F(0.f, 0.f));
+    world.Update(0.1f);
+
+    // The new pairs of the first collider with the two others enter and the last pair stays.
+    EXPECT_EQ(world.GetStaticColliderCount(), 1);
+    EXPECT_EQ(recorder.Events.size(), 3);
+}
+
+/**
+ * @brief createQueryScene is a function that fills the world with static walls and a grid of dynamic bodies at
+ * rest which do not touch each other, so that an update does not move anything.
+ */
+static void createQueryScene(World& world)
+{
+    const std::array<RectangleF, 3> walls = {
+        RectangleF(Vec2F(0.f, 0.f), Vec2F(12.8f, 0.5f)),
+        RectangleF(Vec2F(0.f, 0.f), Vec2F(0.5f, 7.2f)),
+        RectangleF(Vec2F(6.3f, 3.f), Vec2F(7.1f, 3.8f))
+    };
+
+    for (const auto& wall : walls)
+    {
+        const auto bodyRef = world.CreateBody();
+        world.GetBody(bodyRef).SetBodyType(BodyType::Static);
+
+        const auto colRef = world.CreateCollider(bodyRef);
+        world.GetCollider(colRef).SetShape(wall);
+    }
+
+    for (int y = 0; y < 6; y++)
+    {
+        for (int x = 0; x < 10; x++)
+        {
+            if (x == 5 && y == 2) continue;
+
+            const auto bodyRef = world.CreateBody();
+            world.GetBody(bodyRef).SetPosition(Vec2F(1.2f + static_cast<float>(x) * 1.1f,
+                                                     1.2f + static_cast<float>(y) * 1.1f));
+
+            auto& collider = world.GetCollider(world.CreateCollider(bodyRef));
+            collider.SetIsTrigger((x + y) % 4 == 0);
+
+            switch ((x + y) % 3)
+            {
+                case 0:
+                    collider.SetShape(CircleF(Vec2F::Zero(), 0.1f + static_cast<float>(x % 4) * 0.1f));
+                    break;
+                case 1:
+                    collider.SetShape(RectangleF::FromCenter(Vec2F::Zero(), Vec2F(0.3f, 0.2f)));
+                    break;
+                default:
+                    collider.SetShape(PolygonF({ Vec2F(-0.3f, -0.3f), Vec2F(0.3f, -0.3f), Vec2F(0.f, 0.3f) }));
+                    break;
+            }
+        }
+    }
+}
+
+TEST(World, RayCastHitsTheFirstCollider)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 10);
+
+    createQueryScene(world);
+
+    // The middle wall replaces the grid cell at (6.7, 3.4), the ray goes down onto its top side.
+    const auto hit = world.RayCast(Vec2F(6.7f, 3.95f), Vec2F(0.f, -10.f));
+
+    ASSERT_TRUE(hit.Hit);
+    EXPECT_NEAR(hit.Point.X, 6.7f, 0.0001f);
+    EXPECT_NEAR(hit.Point.Y, 3.8f, 0.0001f);
+    EXPECT_NEAR(hit.Normal.Y, 1.f, 0.0001f);
+    EXPECT_NEAR(hit.Fraction, 0.015f, 0.0001f);
+
+    // The ray starts in the middle wall, which is not hit, so it hits the circle of the grid cell below.
+    const auto nextHit = world.RayCast(Vec2F(6.7f, 3.4f), Vec2F(0.f, -10.f));
+
+    ASSERT_TRUE(nextHit.Hit);
+    EXPECT_NEAR(nextHit.Point.Y, 2.5f, 0.0001f);
+    EXPECT_FALSE(nextHit.ColRef == hit.ColRef);
+
+    // All the colliders are in the default category, so a query on another category finds nothing.
+    const auto wallHit = world.RayCast(Vec2F(3.f, 6.f), Vec2F(0.f, -10.f), QueryFilter{ 0b10 });
+
+    EXPECT_FALSE(wallHit.Hit);
+}
+
+TEST_P(BroadPhaseFixture, QueriesMatchBruteForce)
+{
+    // The world with a contact listener uses its broad phase, the other one tests all its colliders.
+    World broadPhaseWorld;
+    broadPhaseWorld.Init(Vec2F::Zero(), 70, GetParam());
+
+    World bruteForceWorld;
+    bruteForceWorld.Init(Vec2F::Zero(), 70, GetParam());
+
+    ContactRecorder recorder;
+    broadPhaseWorld.SetContactListener(&recorder);
+
+    for (auto* world : { &broadPhaseWorld, &bruteForceWorld })
+    {
+        createQueryScene(*world);
+        world->Update(0.02f);
+    }
+
+    EXPECT_TRUE(recorder.Events.empty());
+
+    constexpr std::size_t castCount = 200;
+
+    std::vector<RayCastInput> rays(castCount);
+    std::vector<CircleCastInput> circles(castCount);
+
+    for (std::size_t i = 0; i < castCount; i++)
+    {
+        const Vec2F origin(Random::Range(-1.f, 13.f), Random::Range(-1.f, 8.f));
+        const Vec2F translation(Random::Range(-6.f, 6.f), Random::Range(-6.f, 6.f));
+        const QueryFilter filter{ CollisionFilter::AllCategoryBits, i % 2 == 0 };
+
+        rays[i] = RayCastInput{ origin, translation, filter };
+        circles[i] = CircleCastInput{ CircleF(origin, Random::Range(0.05f, 0.3f)), translation, filter };
+    }
+
+    std::vector<RayCastHit> broadPhaseHits(castCount), bruteForceHits(castCount);
+
+    for (int castType = 0; castType < 2; castType++)
+    {
+        if (castType == 0)
+        {
+            broadPhaseWorld.RayCasts(rays.data(), broadPhaseHits.data(), castCount);
+            bruteForceWorld.RayCasts(rays.data(), bruteForceHits.data(), castCount);
+        }
+        else
+        {
+            broadPhaseWorld.CircleCasts(circles.data(), broadPhaseHits.data(), castCount);
+            bruteForceWorld.CircleCasts(circles.data(), bruteForceHits.data(), castCount);
+        }
+
+        std::size_t hitCount = 0;
+
+        for (std::size_t i = 0; i < castCount; i++)
+        {
+            ASSERT_EQ(broadPhaseHits[i].Hit, bruteForceHits[i].Hit);
+
+            if (!bruteForceHits[i].Hit) continue;
+
+            EXPECT_EQ(broadPhaseHits[i].ColRef, bruteForceHits[i].ColRef);
+            EXPECT_FLOAT_EQ(broadPhaseHits[i].Fraction, bruteForceHits[i].Fraction);
+            hitCount++;
+        }
+
+        EXPECT_GT(hitCount, castCount / 4);
+    }
+
+    std::array<ColliderRef, 64> broadPhaseRefs{}, bruteForceRefs{};
+
+    for (int i = 0; i < 50; i++)
+    {
+        const auto bounds = RectangleF::FromCenter(Vec2F(Random::Range(0.f, 12.8f), Random::Range(0.f, 7.2f)),
+                                                   Vec2F(Random::Range(0.1f, 2.f), Random::Range(0.1f, 2.f)));
+
+        const auto broadPhaseCount = broadPhaseWorld.QueryAABB(bounds, broadPhaseRefs.data(), broadPhaseRefs.size());
+        const auto bruteForceCount = bruteForceWorld.QueryAABB(bounds, bruteForceRefs.data(), bruteForceRefs.size());
+
+        ASSERT_EQ(broadPhaseCount, bruteForceCount);
+        ASSERT_LE(broadPhaseCount, broadPhaseRefs.size());
+
+        std::sort(broadPhaseRefs.begin(), broadPhaseRefs.begin() + broadPhaseCount);
+        std::sort(bruteForceRefs.begin(), bruteForceRefs.begin() + bruteForceCount);
+
+        for (std::size_t j = 0; j < broadPhaseCount; j++)
+        {
+            EXPECT_EQ(broadPhaseRefs[j], bruteForceRefs[j]);
+        }
+    }
+}
+
+TEST(World, ContactEventsMatchListener)
+{
+    // The same scene is stepped with a listener and with the contact event buffer only.
+    World listenerWorld;
+    listenerWorld.Init(Vec2F::Zero(), 3);
+
+    World eventWorld;
+    eventWorld.Init(Vec2F::Zero(), 3);
+    eventWorld.SetContactEventsEnabled(true);
+
+    ContactRecorder recorder;
+    listenerWorld.SetContactListener(&recorder);
+
+    std::array<BodyRef, 3> bodyRefs{};
+
+    for (auto* world : { &listenerWorld, &eventWorld })
+    {
+        // Two circles move toward each other and a trigger overlaps the first one.
+        bodyRefs[0] = world->CreateBody();
+        world->GetBody(bodyRefs[0]) = Body(Vec2F(0.f, 0.f), Vec2F(1.f, 0.f), 1);
+        auto& firstCircle = world->GetCollider(world->CreateCollider(bodyRefs[0]));
+        firstCircle.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+        firstCircle.SetRestitution(0.f);
+
+        bodyRefs[1] = world->CreateBody();
+        world->GetBody(bodyRefs[1]) = Body(Vec2F(0.9f, 0.f), Vec2F(-1.f, 0.f), 1);
+        auto& secondCircle = world->GetCollider(world->CreateCollider(bodyRefs[1]));
+        secondCircle.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+        secondCircle.SetRestitution(0.f);
+
+        bodyRefs[2] = world->CreateBody();
+        world->GetBody(bodyRefs[2]) = Body(Vec2F(0.f, 1.f), Vec2F::Zero(), 1);
+        auto& trigger = world->GetCollider(world->CreateCollider(bodyRefs[2]));
+        trigger.SetShape(CircleF(Vec2F::Zero(), 0.6f));
+        trigger.SetIsTrigger(true);
+    }
+
+    for (int step = 0; step < 4; step++)
+    {
+        if (step == 3)
+        {
+            for (auto* world : { &listenerWorld, &eventWorld })
+            {
+                world->GetBody(bodyRefs[1]).SetPosition(Vec2F(10.f, 10.f));
+                world->GetBody(bodyRefs[2]).SetPosition(Vec2F(-10.f, 10.f));
+            }
+        }
+
+        recorder.Events.clear();
+        listenerWorld.Update(0.02f);
+        eventWorld.Update(0.02f);
+
+        // The listener receives the events of its own buffer.
+        ASSERT_EQ(listenerWorld.ContactEvents().size(), eventWorld.ContactEvents().size());
+
+        std::vector<std::pair<int, ColliderPair>> events;
+
+        for (const auto& event : eventWorld.ContactEvents())
+        {
+            switch (event.Type)
+            {
+                case ContactEventType::TriggerEnter: events.emplace_back(0, event.Pair); break;
+                case ContactEventType::TriggerStay: events.emplace_back(1, event.Pair); break;
+                case ContactEventType::TriggerExit: events.emplace_back(2, event.Pair); break;
+                case ContactEventType::CollisionEnter: events.emplace_back(3, event.Pair); break;
+                case ContactEventType::CollisionExit: events.emplace_back(4, event.Pair); break;
+                case ContactEventType::CollisionStay: break;
+            }
+
+            const bool isSolved = event.Type == ContactEventType::CollisionEnter ||
+                                  event.Type == ContactEventType::CollisionStay;
+
+            if (isSolved)
+            {
+                // The normal goes from the second circle to the first one, which are pushed apart.
+                EXPECT_NEAR(event.Normal.X, -1.f, 0.0001f);
+                EXPECT_GE(event.NormalImpulse, 0.f);
+            }
+            else
+            {
+                EXPECT_FLOAT_EQ(event.NormalImpulse, 0.f);
+            }
+        }
+
+        ASSERT_EQ(events.size(), recorder.Events.size());
+
+        for (std::size_t i = 0; i < events.size(); i++)
+        {
+            EXPECT_EQ(events[i].first, recorder.Events[i].first);
+            EXPECT_EQ(events[i].second, recorder.Events[i].second);
+        }
+
+        if (step == 0)
+        {
+            ASSERT_EQ(events.size(), 2);
+            EXPECT_GT(eventWorld.ContactEvents()[0].NormalImpulse + eventWorld.ContactEvents()[1].NormalImpulse, 0.f);
+        }
+    }
+
+    EXPECT_EQ(recorder.Events.size(), 2);
+
+    // Without listener nor contact events, the contacts are not detected.
+    eventWorld.SetContactEventsEnabled(false);
+    eventWorld.GetBody(bodyRefs[1]).SetPosition(Vec2F(0.9f, 0.f));
+    eventWorld.Update(0.02f);
+
+    EXPECT_TRUE(eventWorld.ContactEvents().empty());
+}
+
+TEST(World, ConfigRestrictsShapesAndBroadPhases)
+{
+    BasicWorld<CircleWorldConfig> world;
+    world.Init(Vec2F::Zero(), 10, BroadPhaseType::SweepAndPrune);
+    world.SetContactEventsEnabled(true);
+
+    // The broad phase which is not in the configuration is replaced by the default one.
+    EXPECT_EQ(world.GetBroadPhaseType(), BroadPhaseType::QuadTree);
+
+    const std::array<Vec2F, 4> positions = { Vec2F(1.f, 1.f), Vec2F(1.2f, 1.f), Vec2F(3.f, 1.f), Vec2F(3.2f, 1.f) };
+    std::array<ColliderRef, 4> colRefs{};
+
+    for (std::size_t i = 0; i < positions.size(); i++)
+    {
+        const auto bodyRef = world.CreateBody();
+        world.GetBody(bodyRef) = Body(positions[i], Vec2F::Zero(), 1.f);
+
+        colRefs[i] = world.CreateCollider(bodyRef);
+        auto& collider = world.GetCollider(colRefs[i]);
+        collider.SetIsTrigger(true);
+
+        if (i < 2)
+        {
+            collider.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+        }
+        else
+        {
+            collider.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+        }
+    }
+
+    world.Update(0.1f);
+
+    // Only the circles touch, the rectangles are not in the configuration.
+    const auto events = world.ContactEvents();
+
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].Type, ContactEventType::TriggerEnter);
+    EXPECT_TRUE(events[0].Pair.ColliderA == colRefs[0]);
+    EXPECT_TRUE(events[0].Pair.ColliderB == colRefs[1]);
+}
+
+TEST_P(BroadPhaseFixture, RestoredStateReplaysTheSameUpdates)
+{
+    using SnapshotWorld = BasicWorld<SnapshotWorldConfig>;
+
+    static_assert(SnapshotWorld::IsStateTriviallyCopyable);
+
+    SnapshotWorld world;
+    world.Init(Vec2F(0.f, -9.81f), 16, GetParam());
+    world.SetContactEventsEnabled(true);
+
+    const auto groundRef = world.CreateBody();
+    world.GetBody(groundRef).SetBodyType(BodyType::Static);
+    auto& ground = world.GetCollider(world.CreateCollider(groundRef));
+    ground.SetShape(RectangleF(Vec2F(0.f, -1.f), Vec2F(10.f, 0.f)));
+    ground.SetRestitution(0.f);
+
+    std::vector<BodyRef> bodyRefs;
+
+    for (int i = 0; i < 12; i++)
+    {
+        const auto bodyRef = world.CreateBody();
+        world.GetBody(bodyRef) = Body(Vec2F(1.f + 0.7f * static_cast<float>(i % 6), 0.6f + 0.9f * static_cast<float>(i / 6)),
+                                      Vec2F::Zero(), 1.f);
+        bodyRefs.push_back(bodyRef);
+
+        auto& collider = world.GetCollider(world.CreateCollider(bodyRef));
+        collider.SetRestitution(0.f);
+
+        if (i % 2 == 0)
+        {
+            collider.SetShape(CircleF(Vec2F::Zero(), 0.3f));
+        }
+        else
+        {
+            collider.SetShape(RectangleF(Vec2F(-0.3f, -0.3f), Vec2F(0.3f, 0.3f)));
+        }
+    }
+
+    for (int frame = 0; frame < 20; frame++)
+    {
+        world.Update(1.f / 50.f);
+    }
+
+    SnapshotWorld::State snapshot;
+    world.SaveState(snapshot);
+
+    // The bytes of the state, padding included, are copied.
+    EXPECT_EQ(std::memcmp(&snapshot, &world.GetState(), sizeof(SnapshotWorld::State)), 0);
+
+    auto hashState = [](const SnapshotWorld& hashedWorld)
+    {
+        XxHash64 hash;
+        hashedWorld.HashState(hash);
+        return hash.Digest();
+    };
+
+    const auto snapshotHash = hashState(world);
+
+    auto simulate = [&](SnapshotWorld& simulatedWorld)
+    {
+        std::vector<Vec2F> positions;
+        std::size_t eventCount = 0;
+
+        for (int frame = 0; frame < 30; frame++)
+        {
+            simulatedWorld.Update(1.f / 50.f);
+            eventCount += simulatedWorld.ContactEvents().size();
+
+            for (const auto& bodyRef : bodyRefs)
+            {
+                positions.push_back(simulatedWorld.GetBody(bodyRef).Position());
+            }
+        }
+
+        // A body destroyed after the snapshot comes back with the restore.
+        simulatedWorld.DestroyBody(bodyRefs[0]);
+
+        return std::make_pair(positions, eventCount);
+    };
+
+    const auto firstRun = simulate(world);
+    const auto firstRunHash = hashState(world);
+
+    EXPECT_NE(firstRunHash, snapshotHash);
+
+    // The broad phase of the world kept the history of the first run, the one of the fresh world has none.
+    world.RestoreState(snapshot);
+
+    SnapshotWorld freshWorld;
+    freshWorld.Init(Vec2F(0.f, -9.81f), 16, GetParam());
+    freshWorld.SetContactEventsEnabled(true);
+    freshWorld.RestoreState(snapshot);
+
+    EXPECT_NO_THROW(static_cast<void>(world.GetBody(bodyRefs[0])));
+    EXPECT_EQ(hashState(world), snapshotHash);
+    EXPECT_EQ(hashState(freshWorld), snapshotHash);
+
+    for (auto* replayWorld : { &world, &freshWorld })
+    {
+        const auto replay = simulate(*replayWorld);
+
+        EXPECT_EQ(hashState(*replayWorld), firstRunHash);
+
+        EXPECT_GT(firstRun.second, 0);
+        EXPECT_EQ(firstRun.second, replay.second);
+        ASSERT_EQ(firstRun.first.size(), replay.first.size());
+
+        for (std::size_t i = 0; i < firstRun.first.size(); i++)
+        {
+            EXPECT_EQ(firstRun.first[i], replay.first[i]);
+        }
+    }
+}